@@ -77,9 +77,9 @@ void task2(void* pdata)
   int Task1State = 0;
   alt_u64 t;
   int i = 0;
-  float milliseconds = 0;
-  float totaltime = 0;
-  float averagetime = 0;
+  alt_u32 microseconds = 0;   // integer only, the tiny core has no FPU
+  alt_u32 totaltime = 0;
+  alt_u32 averagetime = 0;
 
   while(1)
     { 
@@ -88,16 +88,16 @@ void task2(void* pdata)
 
       PERF_STOP_MEASURING(PERFORMANCE_COUNTER_BASE);
       t = perf_get_total_time((void*)PERFORMANCE_COUNTER_BASE);
-      milliseconds = 1000 * (float)t / (float)alt_get_cpu_freq();
+      microseconds = (alt_u32)t / (alt_get_cpu_freq() / 1000000);
       if (i < 100) {
-        if (0.9 < milliseconds && milliseconds < 1.3) {
+        if (900 < microseconds && microseconds < 1300) {
           i++;
-          totaltime += milliseconds;
+          totaltime += microseconds;
         }
       }
       else {
         averagetime = totaltime / 100;
-        printf("Average Time: %f\n", averagetime);
+        printf("Average Time: %lu.%03lu\n", averagetime / 1000, averagetime % 1000);
       }
 
 
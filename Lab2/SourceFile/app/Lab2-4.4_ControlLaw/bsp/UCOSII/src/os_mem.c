@@ -76,7 +76,7 @@ OS_MEM  *OSMemCreate (void *addr, INT32U nblks, INT32U blksize, INT8U *perr)
         *perr = OS_ERR_MEM_INVALID_ADDR;
         return ((OS_MEM *)0);
     }
-    if (((INT32U)addr & (sizeof(void *) - 1)) != 0){  /* Must be pointer size aligned                  */
+    if (((unsigned long)addr & (sizeof(void *) - 1)) != 0) { /* Must be pointer size aligned           */
         *perr = OS_ERR_MEM_INVALID_ADDR;
         return ((OS_MEM *)0);
     }
@@ -100,11 +100,11 @@ OS_MEM  *OSMemCreate (void *addr, INT32U nblks, INT32U blksize, INT8U *perr)
         return ((OS_MEM *)0);
     }
     plink = (void **)addr;                            /* Create linked list of free memory blocks      */
-    pblk  = (INT8U *)((INT32U)addr + blksize);
+    pblk  = (INT8U *)addr + blksize;
     for (i = 0; i < (nblks - 1); i++) {
        *plink = (void *)pblk;                         /* Save pointer to NEXT block in CURRENT block   */
         plink = (void **)pblk;                        /* Position to  NEXT      block                  */
-        pblk  = (INT8U *)((INT32U)pblk + blksize);    /* Point to the FOLLOWING block                  */
+        pblk += blksize;                              /* Point to the FOLLOWING block                  */
     }
     *plink              = (void *)0;                  /* Last memory block points to NULL              */
     pmem->OSMemAddr     = addr;                       /* Store start address of memory partition       */
@@ -135,6 +135,7 @@ enum active {on = 2, off = 1};
 int delay; // Delay of HW-timer 
 INT16U led_green = 0; // Green LEDs
 INT32U led_red = 0;   // Red LEDs
+enum active inactive = off; // Initial state of the switch and button signals
 
 
 /*
@@ -286,12 +287,13 @@ void VehicleTask(void* pdata)
   // variables relevant to the model and its simulation on top of the RTOS
   INT8U err;  
   void* msg;
-  INT8U* throttle; 
+  INT8U idle_throttle = 0; // Used until the first throttle message arrives
+  INT8U* throttle = &idle_throttle; 
   INT16S acceleration;  
   INT16U position = 0; 
   INT16S velocity = 0; 
-  enum active* brake_pedal = off;
-  enum active* engine = off;
+  enum active* brake_pedal = &inactive;
+  enum active* engine = &inactive;
 
   printf("Vehicle task created!\n");
 
@@ -376,12 +378,12 @@ void ControlTask(void* pdata)
   void* msg;
   INT16S* current_velocity;
 
-  enum active *gas_pedal = off;
-  enum active *top_gear = off;
-  enum active *cruise_button = off;
-  enum active *engine = off;
+  enum active *gas_pedal = &inactive;
+  enum active *top_gear = &inactive;
+  enum active *cruise_button = &inactive;
+  enum active *engine = &inactive;
   enum active enginestate = off;
-  enum active *brake = off;
+  enum active *brake = &inactive;
   enum active brakestate = off;
   enum active cruise_activated = off;
 
@@ -672,13 +674,13 @@ void StartTask(void* pdata)
   // Mailboxes
   Mbox_Throttle = OSMboxCreate((void*) 0); /* Empty Mailbox - Throttle */
   Mbox_Velocity = OSMboxCreate((void*) 0); /* Empty Mailbox - Velocity */
-  Mbox_Brake = OSMboxCreate((void*) 1); /* Empty Mailbox - Velocity */
-  Mbox_BrakeButton = OSMboxCreate((void*) 1);
-  Mbox_Engine = OSMboxCreate((void*) 1); /* Empty Mailbox - Engine */
-  Mbox_EngineSwitch = OSMboxCreate((void*) 1);
-  Mbox_Gas = OSMboxCreate((void*) 1);
-  Mbox_Gear = OSMboxCreate((void*) 1);
-  Mbox_Cruise = OSMboxCreate((void*) 1);
+  Mbox_Brake = OSMboxCreate((void*) &inactive); /* Empty Mailbox - Velocity */
+  Mbox_BrakeButton = OSMboxCreate((void*) &inactive);
+  Mbox_Engine = OSMboxCreate((void*) &inactive); /* Empty Mailbox - Engine */
+  Mbox_EngineSwitch = OSMboxCreate((void*) &inactive);
+  Mbox_Gas = OSMboxCreate((void*) &inactive);
+  Mbox_Gear = OSMboxCreate((void*) &inactive);
+  Mbox_Cruise = OSMboxCreate((void*) &inactive);
 
   /*
    * Create statistics task
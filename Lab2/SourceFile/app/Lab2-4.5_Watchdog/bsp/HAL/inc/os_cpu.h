@@ -92,6 +92,7 @@ typedef unsigned int   OS_STK;                   /* Each stack entry is 32-bits
 
 #define  OS_STK_GROWTH        1        /* Stack grows from HIGH to LOW memory */
 #define  OS_TASK_SW           OSCtxSw  
+#define  OS_CPU_BARRIER()     __asm__ volatile ("" ::: "memory") /* Compiler barrier, one in-order core */
 
 /******************************************************************************************
  *                Disable and Enable Interrupts - 2 methods
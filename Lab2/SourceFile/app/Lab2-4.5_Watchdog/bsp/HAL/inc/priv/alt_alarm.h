@@ -66,8 +66,9 @@ struct alt_alarm_s
                           * zero indicates that the alarm should be removed 
                           * from the list. 
                           */
-  alt_u8 rollover;       /* set when desired alarm time + current time causes
-                            overflow, to prevent premature alarm */
+  alt_u8 rollover;       /* unused, kept for the layout of the structure: the
+                            alarm times are compared by their signed
+                            difference, which is safe across an overflow */
   void* context;         /* Argument for the callback */
 };
 
@@ -90,10 +91,14 @@ extern alt_u32 _alt_tick_rate;
 
 extern volatile alt_u32 _alt_nticks;
 
-/* The list of registered alarms. */
+/* The list of registered alarms, sorted by the time they expire. */
 
 extern alt_llist alt_alarm_list;
 
+/* Adds an alarm to alt_alarm_list, in order. Interrupts must be disabled. */
+
+extern void alt_alarm_insert (struct alt_alarm_s* alarm);
+
 #ifdef __cplusplus
 }
 #endif
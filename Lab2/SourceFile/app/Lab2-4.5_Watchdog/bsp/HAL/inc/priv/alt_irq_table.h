@@ -56,4 +56,13 @@ extern struct ALT_IRQ_HANDLER
   void *context;
 } alt_irq[ALT_NIRQ];
 
+/*
+ * The priorities of the interrupts with ALT_IRQ_PRIORITY_REMAP, lowest first
+ * (see alt_irq_handler.c).
+ */
+
+#ifdef ALT_IRQ_PRIORITY_REMAP
+extern alt_u8 alt_irq_priority[ALT_NIRQ];
+#endif
+
 #endif
@@ -119,6 +119,16 @@ static ALT_INLINE alt_u32 ALT_ALWAYS_INLINE alt_nticks (void)
 
 extern void alt_tick (void);
 
+/*
+ * alt_tick_n() and alt_tick_next() are also only for the system clock
+ * driver, which uses them to stop the tick while the system is idle:
+ * alt_tick_next() returns the number of ticks until the first alarm expires,
+ * and alt_tick_n() makes up for the ticks that elapsed without an interrupt.
+ */
+
+extern void    alt_tick_n (alt_u32 ticks);
+extern alt_u32 alt_tick_next (void);
+
 #ifdef __cplusplus
 }
 #endif
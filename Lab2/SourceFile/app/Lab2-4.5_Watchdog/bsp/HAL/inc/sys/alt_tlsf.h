@@ -0,0 +1,136 @@
+#ifndef __ALT_TLSF_H__
+#define __ALT_TLSF_H__
+
+/******************************************************************************
+*                                                                             *
+* Two-level segregated fit (TLSF) heaps.                                      *
+*                                                                             *
+* A heap is made of one or more pools of memory handed to it by the caller.   *
+* The free blocks are kept in lists by size class: the first level splits     *
+* sizes by powers of two, the second splits each power of two into            *
+* ALT_TLSF_SL_COUNT classes. A bitmap of the non-empty lists at each level    *
+* lets alt_tlsf_malloc() and alt_tlsf_free() find a list with a few bit       *
+* scans, so both run in constant time whatever the number and the layout of   *
+* the blocks. Adjacent free blocks are merged at once.                        *
+*                                                                             *
+* The heap functions do no locking. alt_tlsf_heap.c serialises them for the   *
+* HAL heap behind malloc(), the way newlib does.                              *
+*                                                                             *
+******************************************************************************/
+
+#include <stddef.h>
+
+#include "alt_types.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+/*
+ * Sizes of the classes. The largest block of a heap is just under
+ * 2^ALT_TLSF_FL_MAX bytes.
+ */
+
+#ifndef ALT_TLSF_FL_MAX
+#define ALT_TLSF_FL_MAX   24
+#endif
+
+#define ALT_TLSF_SL_LOG2  4
+#define ALT_TLSF_SL_COUNT (1 << ALT_TLSF_SL_LOG2)
+#define ALT_TLSF_FL_SHIFT (ALT_TLSF_SL_LOG2 + 3)
+#define ALT_TLSF_FL_COUNT (ALT_TLSF_FL_MAX - ALT_TLSF_FL_SHIFT + 1)
+
+/*
+ * Blocks and their payloads are aligned on two words, 8 bytes on the
+ * Nios II, and each block has a header of two words.
+ */
+
+#define ALT_TLSF_ALIGN    (2 * sizeof (size_t))
+
+typedef struct alt_tlsf_block_s alt_tlsf_block;
+
+typedef struct alt_tlsf_s
+{
+  alt_u32         fl_map;
+  alt_u32         sl_map[ALT_TLSF_FL_COUNT];
+  alt_tlsf_block* free[ALT_TLSF_FL_COUNT][ALT_TLSF_SL_COUNT];
+  size_t          size;             /* bytes of all pools, headers included */
+  size_t          used;             /* bytes of the allocated payloads */
+  size_t          peak;             /* highest value of 'used' */
+  alt_u32         blocks;           /* allocated blocks */
+} alt_tlsf;
+
+/*
+ * Statistics of a heap, see alt_tlsf_get_stats(). The fragmentation is
+ * the share of the free memory, in permille, that lies outside of the
+ * largest free block and so can not serve a request of that size.
+ */
+
+typedef struct alt_tlsf_stats_s
+{
+  size_t  size;
+  size_t  used;
+  size_t  peak;
+  size_t  free;
+  size_t  largest_free;
+  alt_u32 blocks;
+  alt_u32 free_blocks;
+  alt_u32 fragmentation;            /* permille */
+} alt_tlsf_stats;
+
+/*
+ * alt_tlsf_create() makes an empty heap with its control block at 'heap'.
+ * Memory is added with alt_tlsf_add_pool(), which returns 0, or -1 if the
+ * pool is too small or too large.
+ */
+
+extern void alt_tlsf_create (alt_tlsf* heap);
+
+extern int alt_tlsf_add_pool (alt_tlsf* heap, void* mem, size_t bytes);
+
+extern void* alt_tlsf_malloc (alt_tlsf* heap, size_t size);
+
+extern void alt_tlsf_free (alt_tlsf* heap, void* ptr);
+
+extern void* alt_tlsf_realloc (alt_tlsf* heap, void* ptr, size_t size);
+
+/*
+ * alt_tlsf_block_size() returns the usable size of an allocated block.
+ */
+
+extern size_t alt_tlsf_block_size (void* ptr);
+
+/*
+ * alt_tlsf_memalign() returns a block aligned on 'align' bytes, a power of
+ * two.
+ */
+
+extern void* alt_tlsf_memalign (alt_tlsf* heap, size_t align, size_t size);
+
+/*
+ * alt_tlsf_get_stats() fills 'stats'. It walks the free lists, so it is
+ * meant for monitoring rather than for the control path.
+ */
+
+extern void alt_tlsf_get_stats (alt_tlsf* heap, alt_tlsf_stats* stats);
+
+/*
+ * The HAL heap, which malloc() and free() use when ALT_TLSF_HEAP is set
+ * (see alt_tlsf_heap.c), and the heap made of the part of onchip_memory
+ * the linker left unused, which is only used through alt_onchip_malloc()
+ * and alt_onchip_free() and needs ALT_TLSF_ONCHIP. Both are serialised by
+ * __malloc_lock(), so they must not be used from interrupt handlers.
+ */
+
+extern alt_tlsf alt_heap;
+extern alt_tlsf alt_onchip_heap;
+
+extern void* alt_onchip_malloc (size_t size);
+extern void  alt_onchip_free (void* ptr);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __ALT_TLSF_H__ */
@@ -82,20 +82,12 @@ int alt_alarm_start (alt_alarm* alarm, alt_u32 nticks,
       alarm->time = nticks + current_nticks + 1; 
       
       /* 
-       * If the desired alarm time causes a roll-over, set the rollover
-       * flag. This will prevent the subsequent tick event from causing
-       * an alarm too early.
+       * The list is sorted by the signed difference of the alarm times,
+       * which needs no roll-over flag.
        */
-      if(alarm->time < current_nticks)
-      {
-        alarm->rollover = 1;
-      }
-      else
-      {
-        alarm->rollover = 0;
-      }
+      alarm->rollover = 0;
     
-      alt_llist_insert (&alt_alarm_list, &alarm->llist);
+      alt_alarm_insert (alarm);
       alt_irq_enable_all (irq_context);
 
       return 0;
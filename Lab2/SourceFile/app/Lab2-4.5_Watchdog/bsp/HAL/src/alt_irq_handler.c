@@ -62,6 +62,47 @@ struct ALT_IRQ_HANDLER
   void *context;
 } alt_irq[ALT_NIRQ];
 
+/*
+ * Without the interrupt vector custom instruction, the highest priority
+ * pending interrupt, the lowest numbered one, is found by counting the
+ * trailing zeros of the list of pending interrupts (ALT_IRQ_BITSCAN) instead
+ * of testing each bit from IRQ 0 up. The count is the one the operating
+ * system uses for its ready lists, ALT_OS_CTZ() (see os/alt_hooks.h), so
+ * the bit scan is the default only with an operating system that provides
+ * it. Set ALT_IRQ_BITSCAN to 0 for the bit by bit search.
+ */
+
+#ifndef ALT_IRQ_BITSCAN
+#ifdef ALT_OS_CTZ
+#define ALT_IRQ_BITSCAN 1
+#else
+#define ALT_IRQ_BITSCAN 0
+#endif
+#endif
+
+/*
+ * With ALT_IRQ_PRIORITY_REMAP defined, the priorities of the interrupts are
+ * taken from "alt_irq_priority" instead of their numbers: of the pending
+ * interrupts, the one with the lowest entry is processed first, and of those
+ * with the same entry the lowest numbered one. All entries are zero at reset,
+ * which keeps the order of the numbers.
+ */
+
+#if ALT_IRQ_BITSCAN && defined(ALT_IRQ_PRIORITY_REMAP)
+alt_u8 alt_irq_priority[ALT_NIRQ];
+#endif
+
+/*
+ * alt_irq_ctz() returns the number of the lowest set bit of "active", which
+ * must not be zero. On the Nios II, which has no instruction for it,
+ * OS_PrioCtz() halves the list five times, which takes the same time for any
+ * interrupt.
+ */
+
+#if ALT_IRQ_BITSCAN && !defined(ALT_CI_INTERRUPT_VECTOR)
+#define alt_irq_ctz(active) ALT_OS_CTZ(active)
+#endif
+
 /*
  * alt_irq_handler() is called by the interrupt exception handler in order to 
  * process any outstanding interrupts. 
@@ -84,8 +125,12 @@ void alt_irq_handler (void)
   char*  alt_irq_base = (char*)alt_irq;
 #else
   alt_u32 active;
-  alt_u32 mask;
   alt_u32 i;
+#if !ALT_IRQ_BITSCAN
+  alt_u32 mask;
+#elif defined(ALT_IRQ_PRIORITY_REMAP)
+  alt_u32 j;
+#endif
 #endif /* ALT_CI_INTERRUPT_VECTOR */
   
   /*
@@ -129,6 +174,31 @@ void alt_irq_handler (void)
 
   do
   {
+#if ALT_IRQ_BITSCAN
+    i = alt_irq_ctz (active);
+
+#ifdef ALT_IRQ_PRIORITY_REMAP
+    /* 
+     * Look for a pending interrupt of higher priority among the others,
+     * taking them one lowest set bit at a time.
+     */
+
+    for (active &= active - 1; active; active &= active - 1)
+    {
+      j = alt_irq_ctz (active);
+      if (alt_irq_priority[j] < alt_irq_priority[i])
+      {
+        i = j;
+      }
+    }
+#endif
+
+#ifdef ALT_ENHANCED_INTERRUPT_API_PRESENT
+    alt_irq[i].handler(alt_irq[i].context); 
+#else
+    alt_irq[i].handler(alt_irq[i].context, i); 
+#endif
+#else /* ALT_IRQ_BITSCAN */
     i = 0;
     mask = 1;
 
@@ -153,6 +223,7 @@ void alt_irq_handler (void)
       i++;
 
     } while (1);
+#endif /* ALT_IRQ_BITSCAN */
 
     active = alt_irq_pending ();
     
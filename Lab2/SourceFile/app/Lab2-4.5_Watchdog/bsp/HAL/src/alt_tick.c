@@ -73,72 +73,93 @@ void alt_alarm_stop (alt_alarm* alarm)
 }
 
 /*
- * alt_tick() is periodically called by the system clock driver in order to
- * process the registered list of alarms. Each alarm is registed with a
- * callback interval, and a callback function, "callback". 
+ * alt_alarm_insert() adds an alarm to the list of registered alarms, which is
+ * kept in the order the alarms expire, after the alarms that expire at the
+ * same tick. Alarm times are compared by their signed difference, which
+ * stays right across a roll-over of the tick count as long as no alarm is
+ * more than 2^31 ticks away. The list is searched from its end, where a
+ * periodic alarm usually goes back to. Interrupts must be disabled.
+ */
+
+void alt_alarm_insert (alt_alarm* alarm)
+{
+  alt_llist* entry = alt_alarm_list.previous;
+
+  while ((entry != &alt_alarm_list) &&
+         ((alt_32) (((alt_alarm*) entry)->time - alarm->time) > 0))
+  {
+    entry = entry->previous;
+  }
+  alt_llist_insert (entry, &alarm->llist);
+}
+
+/*
+ * alt_tick_alarms() makes the callbacks of the alarms that have expired by
+ * the current tick count. Since the list is sorted, it stops at the first
+ * alarm that is not due, so the alarms that are not due cost nothing.
  *
- * The return value of the callback function indicates how many ticks are to
- * elapse until the next callback. A return value of zero indicates that the
- * alarm should be deactivated. 
- * 
- * alt_tick() is expected to run at interrupt level.
+ * The due alarms are first moved to a list of their own, so that each makes
+ * one callback even if it is due again right away, and its callback may
+ * stop or restart it, or any other alarm.
  */
 
-void alt_tick (void)
+static void alt_tick_alarms (void)
 {
-  alt_alarm* next;
+  alt_llist  due   = {&due, &due};
   alt_alarm* alarm = (alt_alarm*) alt_alarm_list.next;
 
   alt_u32    next_callback;
 
-  /* update the tick counter */
-
-  _alt_nticks++;
+  while ((alarm != (alt_alarm*) &alt_alarm_list) &&
+         ((alt_32) (alarm->time - _alt_nticks) <= 0))
+  {
+    alt_llist_remove (&alarm->llist);
+    alt_llist_insert (due.previous, &alarm->llist);
+    alarm = (alt_alarm*) alt_alarm_list.next;
+  }
 
-  /* process the registered callbacks */
+  /* process the callbacks in the order the alarms expired */
 
-  while (alarm != (alt_alarm*) &alt_alarm_list)
+  while (due.next != &due)
   {
-    next = (alt_alarm*) alarm->llist.next;
+    alarm         = (alt_alarm*) due.next;
+    next_callback = alarm->callback (alarm->context);
 
     /* 
-     * Upon the tick-counter rolling over it is safe to clear the 
-     * roll-over flag; once the flag is cleared this (or subsequnt)
-     * tick events are enabled to generate an alarm event. 
+     * Unless the callback stopped or restarted its alarm, deactivate it if
+     * the return value is zero, or else register it for its next time.
      */
-    if ((alarm->rollover) && (_alt_nticks == 0))
+    if (due.next == &alarm->llist)
     {
-      alarm->rollover = 0;
-    }
-    
-    /* if the alarm period has expired, make the callback */    
-    if ((alarm->time <= _alt_nticks) && (alarm->rollover == 0))
-    {
-      next_callback = alarm->callback (alarm->context);
-
-      /* deactivate the alarm if the return value is zero */
-
-      if (next_callback == 0)
-      {
-        alt_alarm_stop (alarm);
-      }
-      else
+      alt_llist_remove (&alarm->llist);
+      if (next_callback != 0)
       {
         alarm->time += next_callback;
-        
-        /* 
-         * If the desired alarm time causes a roll-over, set the rollover
-         * flag. This will prevent the subsequent tick event from causing
-         * an alarm too early.
-         */
-        if(alarm->time < _alt_nticks)
-        {
-          alarm->rollover = 1;
-        }
+        alt_alarm_insert (alarm);
       }
     }
-    alarm = next;
   }
+}
+
+/*
+ * alt_tick() is periodically called by the system clock driver in order to
+ * process the registered list of alarms. Each alarm is registed with a
+ * callback interval, and a callback function, "callback". 
+ *
+ * The return value of the callback function indicates how many ticks are to
+ * elapse until the next callback. A return value of zero indicates that the
+ * alarm should be deactivated. 
+ * 
+ * alt_tick() is expected to run at interrupt level.
+ */
+
+void alt_tick (void)
+{
+  /* update the tick counter */
+
+  _alt_nticks++;
+
+  alt_tick_alarms ();
 
   /* 
    * Update the operating system specific timer facilities.
@@ -147,3 +168,55 @@ void alt_tick (void)
   ALT_OS_TIME_TICK();
 }
 
+/*
+ * alt_tick_n() is called by the system clock driver instead of alt_tick()
+ * when "ticks" ticks elapsed without an interrupt, because the driver had
+ * stopped the tick while the system was idle (see alt_tick_next()). The
+ * alarms due meanwhile are processed once, late, and the operating system is
+ * told about all the ticks at once if it can be.
+ *
+ * alt_tick_n() is expected to run at interrupt level.
+ */
+
+void alt_tick_n (alt_u32 ticks)
+{
+  if (ticks == 0)
+  {
+    return;
+  }
+  _alt_nticks += ticks;
+
+  alt_tick_alarms ();
+
+#ifdef ALT_OS_TIME_TICK_N
+  ALT_OS_TIME_TICK_N (ticks);
+#else
+  while (ticks-- > 0)
+  {
+    ALT_OS_TIME_TICK();
+  }
+#endif
+}
+
+/*
+ * alt_tick_next() returns the number of ticks until the first alarm expires,
+ * 1 meaning at the next tick, or 0xffffffff if there is no alarm. It is used
+ * by the system clock driver to find for how long it may stop the tick.
+ * Interrupts must be disabled.
+ */
+
+alt_u32 alt_tick_next (void)
+{
+  alt_alarm* alarm = (alt_alarm*) alt_alarm_list.next;
+  alt_u32    ticks;
+
+  if (alarm == (alt_alarm*) &alt_alarm_list)
+  {
+    return 0xffffffff;
+  }
+
+  /* the first alarm of the sorted list expires first */
+
+  ticks = alarm->time - _alt_nticks;
+  return ((alt_32) ticks > 0) ? ticks : 1;
+}
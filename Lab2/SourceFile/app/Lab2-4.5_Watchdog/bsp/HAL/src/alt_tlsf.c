@@ -0,0 +1,438 @@
+/******************************************************************************
+*                                                                             *
+* Two-level segregated fit heaps, see sys/alt_tlsf.h.                         *
+*                                                                             *
+* Every block starts with a header of two words: the address of the block     *
+* before it in memory and the size of its payload, with the low bit set       *
+* while the block is free. The payload of a free block holds the links of     *
+* its free list. A pool ends with a used block of size 0, so that the merge   *
+* of a freed block with the block after it needs no bounds check.             *
+*                                                                             *
+******************************************************************************/
+
+#include <string.h>
+
+#include "sys/alt_tlsf.h"
+
+struct alt_tlsf_block_s
+{
+  alt_tlsf_block* prev_phys;        /* block before this one in memory */
+  size_t          size;             /* payload bytes | ALT_TLSF_FREE */
+  alt_tlsf_block* next_free;        /* only valid while free */
+  alt_tlsf_block* prev_free;
+};
+
+#define ALT_TLSF_FREE      ((size_t) 1)
+#define ALT_TLSF_HDR       ALT_TLSF_ALIGN
+#define ALT_TLSF_MIN       (2 * sizeof (alt_tlsf_block*))
+#define ALT_TLSF_SMALL     ((size_t) 1 << ALT_TLSF_FL_SHIFT)
+#define ALT_TLSF_MAX       (((size_t) 1 << ALT_TLSF_FL_MAX) - ALT_TLSF_ALIGN)
+
+#define ALT_TLSF_ALIGN_UP(x, a) (((x) + ((a) - 1)) & ~((a) - 1))
+
+static int alt_tlsf_fls (size_t x)
+{
+  return 31 - __builtin_clz ((alt_u32) x);
+}
+
+static size_t alt_tlsf_size (const alt_tlsf_block* block)
+{
+  return block->size & ~ALT_TLSF_FREE;
+}
+
+static void* alt_tlsf_payload (alt_tlsf_block* block)
+{
+  return (char*) block + ALT_TLSF_HDR;
+}
+
+static alt_tlsf_block* alt_tlsf_from_payload (void* ptr)
+{
+  return (alt_tlsf_block*) ((char*) ptr - ALT_TLSF_HDR);
+}
+
+static alt_tlsf_block* alt_tlsf_next (alt_tlsf_block* block)
+{
+  return (alt_tlsf_block*) ((char*) block + ALT_TLSF_HDR +
+                            alt_tlsf_size (block));
+}
+
+/*
+ * Maps a size to its free list. Sizes below ALT_TLSF_SMALL share the
+ * first level, in ALT_TLSF_SL_COUNT steps of equal width.
+ */
+
+static void alt_tlsf_mapping (size_t size, int* fl, int* sl)
+{
+  int msb;
+
+  if (size < ALT_TLSF_SMALL)
+  {
+    *fl = 0;
+    *sl = (int) (size / (ALT_TLSF_SMALL / ALT_TLSF_SL_COUNT));
+  }
+  else
+  {
+    msb = alt_tlsf_fls (size);
+    *fl = msb - ALT_TLSF_FL_SHIFT + 1;
+    *sl = (int) (size >> (msb - ALT_TLSF_SL_LOG2)) ^ ALT_TLSF_SL_COUNT;
+  }
+}
+
+static void alt_tlsf_insert (alt_tlsf* heap, alt_tlsf_block* block)
+{
+  int fl, sl;
+  alt_tlsf_block* head;
+
+  alt_tlsf_mapping (alt_tlsf_size (block), &fl, &sl);
+  head = heap->free[fl][sl];
+
+  block->size     |= ALT_TLSF_FREE;
+  block->next_free = head;
+  block->prev_free = NULL;
+  if (head)
+  {
+    head->prev_free = block;
+  }
+  heap->free[fl][sl] = block;
+  heap->fl_map      |= 1u << fl;
+  heap->sl_map[fl]  |= 1u << sl;
+}
+
+static void alt_tlsf_remove (alt_tlsf* heap, alt_tlsf_block* block)
+{
+  int fl, sl;
+
+  alt_tlsf_mapping (alt_tlsf_size (block), &fl, &sl);
+
+  if (block->prev_free)
+  {
+    block->prev_free->next_free = block->next_free;
+  }
+  else
+  {
+    heap->free[fl][sl] = block->next_free;
+    if (!block->next_free)
+    {
+      heap->sl_map[fl] &= ~(1u << sl);
+      if (!heap->sl_map[fl])
+      {
+        heap->fl_map &= ~(1u << fl);
+      }
+    }
+  }
+  if (block->next_free)
+  {
+    block->next_free->prev_free = block->prev_free;
+  }
+  block->size &= ~ALT_TLSF_FREE;
+}
+
+/*
+ * Takes a free block of at least 'size' bytes off its list, or returns
+ * NULL. The size is rounded up to the start of the next class, so that
+ * any block of the list found is large enough: this is a good fit rather
+ * than a best fit, in exchange for a search without loops.
+ */
+
+static alt_tlsf_block* alt_tlsf_find (alt_tlsf* heap, size_t size)
+{
+  int fl, sl;
+  alt_u32 map;
+  alt_tlsf_block* block;
+
+  if (size >= ALT_TLSF_SMALL)
+  {
+    size += ((size_t) 1 << (alt_tlsf_fls (size) - ALT_TLSF_SL_LOG2)) - 1;
+  }
+  if (size > ALT_TLSF_MAX)
+  {
+    return NULL;
+  }
+  alt_tlsf_mapping (size, &fl, &sl);
+
+  map = heap->sl_map[fl] & (~0u << sl);
+  if (!map)
+  {
+    map = heap->fl_map & (~0u << (fl + 1));
+    if (!map)
+    {
+      return NULL;
+    }
+    fl  = __builtin_ctz (map);
+    map = heap->sl_map[fl];
+  }
+  sl = __builtin_ctz (map);
+
+  block = heap->free[fl][sl];
+  alt_tlsf_remove (heap, block);
+  return block;
+}
+
+static void alt_tlsf_merge_next (alt_tlsf* heap, alt_tlsf_block* block)
+{
+  alt_tlsf_block* next = alt_tlsf_next (block);
+
+  alt_tlsf_remove (heap, next);
+  block->size += ALT_TLSF_HDR + next->size;
+  alt_tlsf_next (block)->prev_phys = block;
+}
+
+/*
+ * Splits the tail off a block if it can hold a block of its own, and puts
+ * the tail back on a free list. The tail is merged with the block after it
+ * if that one is free, which happens when realloc() shrinks a block.
+ */
+
+static void alt_tlsf_trim (alt_tlsf* heap, alt_tlsf_block* block, size_t size)
+{
+  size_t total = alt_tlsf_size (block);
+  alt_tlsf_block* rest;
+
+  if (total >= size + ALT_TLSF_HDR + ALT_TLSF_MIN)
+  {
+    block->size = size;
+    rest = alt_tlsf_next (block);
+    rest->prev_phys = block;
+    rest->size      = total - size - ALT_TLSF_HDR;
+    alt_tlsf_next (rest)->prev_phys = rest;
+    if (alt_tlsf_next (rest)->size & ALT_TLSF_FREE)
+    {
+      alt_tlsf_merge_next (heap, rest);
+    }
+    alt_tlsf_insert (heap, rest);
+  }
+}
+
+static void* alt_tlsf_use (alt_tlsf* heap, alt_tlsf_block* block, size_t size)
+{
+  alt_tlsf_trim (heap, block, size);
+
+  heap->used += alt_tlsf_size (block);
+  heap->blocks++;
+  if (heap->used > heap->peak)
+  {
+    heap->peak = heap->used;
+  }
+  return alt_tlsf_payload (block);
+}
+
+static size_t alt_tlsf_adjust (size_t size)
+{
+  size = ALT_TLSF_ALIGN_UP (size, ALT_TLSF_ALIGN);
+  return (size < ALT_TLSF_MIN) ? ALT_TLSF_MIN : size;
+}
+
+void alt_tlsf_create (alt_tlsf* heap)
+{
+  memset (heap, 0, sizeof (*heap));
+}
+
+int alt_tlsf_add_pool (alt_tlsf* heap, void* mem, size_t bytes)
+{
+  char* start = (char*) ALT_TLSF_ALIGN_UP ((size_t) mem, ALT_TLSF_ALIGN);
+  char* end   = (char*) (((size_t) mem + bytes) & ~(ALT_TLSF_ALIGN - 1));
+  alt_tlsf_block* block = (alt_tlsf_block*) start;
+  alt_tlsf_block* last;
+
+  if (end <= start ||
+      (size_t) (end - start) < 2 * ALT_TLSF_HDR + ALT_TLSF_MIN ||
+      (size_t) (end - start) - 2 * ALT_TLSF_HDR > ALT_TLSF_MAX)
+  {
+    return -1;
+  }
+
+  block->prev_phys = NULL;
+  block->size      = (size_t) (end - start) - 2 * ALT_TLSF_HDR;
+
+  last = alt_tlsf_next (block);
+  last->prev_phys = block;
+  last->size      = 0;
+
+  alt_tlsf_insert (heap, block);
+  heap->size += (size_t) (end - start);
+  return 0;
+}
+
+void* alt_tlsf_malloc (alt_tlsf* heap, size_t size)
+{
+  alt_tlsf_block* block;
+
+  if (size > ALT_TLSF_MAX)
+  {
+    return NULL;
+  }
+  size  = alt_tlsf_adjust (size);
+  block = alt_tlsf_find (heap, size);
+
+  return block ? alt_tlsf_use (heap, block, size) : NULL;
+}
+
+void alt_tlsf_free (alt_tlsf* heap, void* ptr)
+{
+  alt_tlsf_block* block;
+  alt_tlsf_block* prev;
+
+  if (!ptr)
+  {
+    return;
+  }
+  block = alt_tlsf_from_payload (ptr);
+  heap->used -= alt_tlsf_size (block);
+  heap->blocks--;
+
+  if (alt_tlsf_next (block)->size & ALT_TLSF_FREE)
+  {
+    alt_tlsf_merge_next (heap, block);
+  }
+  prev = block->prev_phys;
+  if (prev && (prev->size & ALT_TLSF_FREE))
+  {
+    alt_tlsf_remove (heap, prev);
+    prev->size += ALT_TLSF_HDR + block->size;
+    alt_tlsf_next (prev)->prev_phys = prev;
+    block = prev;
+  }
+  alt_tlsf_insert (heap, block);
+}
+
+void* alt_tlsf_realloc (alt_tlsf* heap, void* ptr, size_t size)
+{
+  alt_tlsf_block* block;
+  alt_tlsf_block* next;
+  size_t old;
+  void* p;
+
+  if (!ptr)
+  {
+    return alt_tlsf_malloc (heap, size);
+  }
+  if (!size)
+  {
+    alt_tlsf_free (heap, ptr);
+    return NULL;
+  }
+  if (size > ALT_TLSF_MAX)
+  {
+    return NULL;
+  }
+
+  block = alt_tlsf_from_payload (ptr);
+  old   = alt_tlsf_size (block);
+  size  = alt_tlsf_adjust (size);
+  next  = alt_tlsf_next (block);
+
+  /*
+   * Grow or shrink in place when the block, or the free block after it, has
+   * room.
+   */
+
+  if (size > old && (next->size & ALT_TLSF_FREE) &&
+      old + ALT_TLSF_HDR + alt_tlsf_size (next) >= size)
+  {
+    alt_tlsf_merge_next (heap, block);
+  }
+  if (alt_tlsf_size (block) >= size)
+  {
+    heap->used -= old;
+    heap->blocks--;
+    return alt_tlsf_use (heap, block, size);
+  }
+
+  p = alt_tlsf_malloc (heap, size);
+  if (p)
+  {
+    memcpy (p, ptr, old);
+    alt_tlsf_free (heap, ptr);
+  }
+  return p;
+}
+
+void* alt_tlsf_memalign (alt_tlsf* heap, size_t align, size_t size)
+{
+  alt_tlsf_block* block;
+  alt_tlsf_block* aligned;
+  size_t gap;
+  char* p;
+
+  if (align <= ALT_TLSF_ALIGN)
+  {
+    return alt_tlsf_malloc (heap, size);
+  }
+  if (size > ALT_TLSF_MAX || align > ALT_TLSF_MAX / 2)
+  {
+    return NULL;
+  }
+
+  /*
+   * Take a block with room for the gap in front of the aligned payload,
+   * which must hold a free block of its own if it is not empty.
+   */
+
+  size  = alt_tlsf_adjust (size);
+  block = alt_tlsf_find (heap, size + align + ALT_TLSF_HDR + ALT_TLSF_MIN);
+  if (!block)
+  {
+    return NULL;
+  }
+
+  p   = alt_tlsf_payload (block);
+  gap = ALT_TLSF_ALIGN_UP ((size_t) p, align) - (size_t) p;
+  if (gap && gap < ALT_TLSF_HDR + ALT_TLSF_MIN)
+  {
+    gap = ALT_TLSF_ALIGN_UP ((size_t) p + ALT_TLSF_HDR + ALT_TLSF_MIN, align) -
+          (size_t) p;
+  }
+
+  if (gap)
+  {
+    aligned = (alt_tlsf_block*) (p + gap - ALT_TLSF_HDR);
+    aligned->prev_phys = block;
+    aligned->size      = alt_tlsf_size (block) - gap;
+    alt_tlsf_next (aligned)->prev_phys = aligned;
+    block->size = gap - ALT_TLSF_HDR;
+    alt_tlsf_insert (heap, block);
+    block = aligned;
+  }
+  return alt_tlsf_use (heap, block, size);
+}
+
+size_t alt_tlsf_block_size (void* ptr)
+{
+  return alt_tlsf_size (alt_tlsf_from_payload (ptr));
+}
+
+void alt_tlsf_get_stats (alt_tlsf* heap, alt_tlsf_stats* stats)
+{
+  alt_tlsf_block* block;
+  alt_u32 map;
+  int fl, sl;
+
+  memset (stats, 0, sizeof (*stats));
+  stats->size   = heap->size;
+  stats->used   = heap->used;
+  stats->peak   = heap->peak;
+  stats->blocks = heap->blocks;
+
+  for (map = heap->fl_map; map; map &= map - 1)
+  {
+    fl = __builtin_ctz (map);
+    for (sl = 0; sl < ALT_TLSF_SL_COUNT; sl++)
+    {
+      for (block = heap->free[fl][sl]; block; block = block->next_free)
+      {
+        stats->free += alt_tlsf_size (block);
+        stats->free_blocks++;
+        if (alt_tlsf_size (block) > stats->largest_free)
+        {
+          stats->largest_free = alt_tlsf_size (block);
+        }
+      }
+    }
+  }
+
+  if (stats->free)
+  {
+    stats->fragmentation = (alt_u32) (1000 -
+      (alt_u64) stats->largest_free * 1000 / stats->free);
+  }
+}
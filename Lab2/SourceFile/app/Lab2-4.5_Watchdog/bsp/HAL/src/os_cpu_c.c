@@ -20,6 +20,11 @@
 
 #include "system.h"
 
+#if (OS_TASK_PROFILE_EN > 0) || (OS_TICKLESS_EN > 0)
+#include "sys/alt_timestamp.h"
+#include "altera_avalon_timer.h"
+#endif
+
 extern void OSStartTsk;                 /* The entry point for all tasks. */
 
 #if OS_TMR_EN > 0
@@ -155,6 +160,10 @@ void OSTaskDelHook (OS_TCB *ptcb)
 */
 void OSTaskSwHook (void)
 {
+#if OS_TASK_PROFILE_EN > 0
+    OS_TaskProfileSw();
+#endif
+    OS_TRACE(OS_TRACE_SW, OSPrioHighRdy);
 }
 
 /*
@@ -195,7 +204,7 @@ void OSTimeTickHook (void)
 {
 #if OS_TMR_EN > 0
     OSTmrCtr++;
-    if (OSTmrCtr >= (OS_TICKS_PER_SEC / OS_TMR_CFG_TICKS_PER_SEC)) {
+    if (OSTmrCtr >= OS_TICKS_PER_TMR) {
         OSTmrCtr = 0;
         OSTmrSignal();
     }
@@ -207,11 +216,50 @@ void OSTimeTickHook (void)
 #endif
 }
 
+/*
+*********************************************************************************************************
+*                                         TICK HOOK FOR SEVERAL TICKS
+*
+* Description: This function is called by OSTimeTickN() for the 'ticks' ticks that elapsed while the
+*              idle task had stopped the tick, instead of OSTimeTickHook() for each.  It signals the
+*              timer task as many times as OSTimeTickHook() would have, in one call.
+*
+* Arguments  : ticks     is the number of ticks that elapsed.
+*
+* Note(s)    : 1) Interrupts are disabled during this call.
+*              2) The Interniche timer has no such entry point and still gets one call per tick.
+*********************************************************************************************************
+*/
+#if OS_TICKLESS_EN > 0
+void OSTimeTickNHook (INT32U ticks)
+{
+#if OS_TMR_EN > 0
+    INT32U  ctr;
+
+
+    ctr      = OSTmrCtr + ticks;
+    OSTmrCtr = (INT16U)(ctr % OS_TICKS_PER_TMR);
+    OSTmrSignalN(ctr / OS_TICKS_PER_TMR);
+#else
+    ticks = ticks;                     /* Prevent compiler warning */
+#endif
+
+#ifdef ALT_INICHE
+    while (ticks-- > 0) {
+        cticks_hook();
+    }
+#endif
+}
+#endif
+
 void OSInitHookBegin(void)
 {
 #if OS_TMR_EN > 0
     OSTmrCtr = 0;
 #endif
+#if (OS_TASK_PROFILE_EN > 0) && (ALT_TIMESTAMP_CLK_BASE != none_BASE)
+    alt_timestamp_start();
+#endif
 }
 
 void OSInitHookEnd(void)
@@ -227,3 +275,78 @@ void OSTCBInitHook(OS_TCB *ptcb)
 }
 
 #endif
+
+#if OS_TASK_PROFILE_EN > 0
+/*
+*********************************************************************************************************
+*                                             CYCLE COUNTER
+*
+* Description: This function returns a free running count of CPU clock cycles, for the task profiling
+*              of the kernel (see OS_TaskProfileSw()).  The timestamp timer is used if the BSP has one.
+*              Otherwise the count is derived from the system clock timer by its driver: the ticks since
+*              reset times the tick period, plus the cycles elapsed since the last tick, read from the
+*              snapshot registers of the timer.  This stays right while the tick is stopped.
+*
+* Arguments  : none
+*
+* Note(s)    : 1) Interrupts are disabled during this call.
+*              2) The count wraps around every 2^32 cycles, i.e. every 86 s at 50 MHz.
+*              3) The system clock timer is assumed to run at the CPU clock, which it does in this
+*                 system (TIMER_0_FREQ == ALT_CPU_FREQ).
+*********************************************************************************************************
+*/
+INT32U OSCPUCyclesGet (void)
+{
+#if ALT_TIMESTAMP_CLK_BASE != none_BASE
+    return ((INT32U)alt_timestamp());
+#else
+    return ((INT32U)alt_avalon_timer_sc_cycles());
+#endif
+}
+#endif
+
+#if OS_TICKLESS_EN > 0
+/*
+*********************************************************************************************************
+*                                           STOP AND RESTART THE TICK
+*
+* Description: OSTickSuppressHook() is called by the idle task to stop the tick for up to 'ticks' ticks.
+*              The tick hook signals the timer task every OS_TICKS_PER_TMR ticks, so the time is first
+*              shortened to the signal at which the first running OS_TMR expires.  The system clock
+*              driver shortens it further to the first alarm of the HAL, and stretches the period of
+*              the timer.
+*
+*              OSTickResumeHook() is called by OSIntEnter() on the first interrupt afterwards.  The
+*              driver restarts the tick and announces the ticks that elapsed with OSTimeTickN(), which
+*              calls OSTimeTickNHook() once for all of them.
+*
+* Arguments  : ticks     is the number of ticks until the first delay expires, 0xFFFFFFFF if none.
+*
+* Returns    : OS_TRUE if the tick was stopped, OS_FALSE if it keeps running.
+*
+* Note(s)    : 1) Interrupts are disabled during these calls.
+*********************************************************************************************************
+*/
+BOOLEAN OSTickSuppressHook (INT32U ticks)
+{
+#if OS_TMR_EN > 0
+    INT32U  signals;
+    INT32U  tmr;
+
+
+    signals = OSTmrNextGet();
+    if ((signals != 0) && (signals - 1 < ticks / OS_TICKS_PER_TMR)) {
+        tmr = OS_TICKS_PER_TMR - OSTmrCtr + (signals - 1) * OS_TICKS_PER_TMR;
+        if (tmr < ticks) {
+            ticks = tmr;
+        }
+    }
+#endif
+    return ((alt_avalon_timer_sc_suppress(ticks) != 0) ? OS_TRUE : OS_FALSE);
+}
+
+void OSTickResumeHook (void)
+{
+    alt_avalon_timer_sc_resume();
+}
+#endif
@@ -53,6 +53,9 @@ extern OS_EVENT *alt_heapsem;
  */
 
 #define ALT_OS_TIME_TICK OSTimeTick
+#if OS_TICKLESS_EN > 0
+#define ALT_OS_TIME_TICK_N OSTimeTickN
+#endif
 #define ALT_OS_INIT()    OSInit();                     \
                          alt_envsem  = OSSemCreate(1); \
                          alt_heapsem = OSSemCreate(1)
@@ -60,6 +63,18 @@ extern OS_EVENT *alt_heapsem;
 #define ALT_OS_INT_ENTER OSIntEnter
 #define ALT_OS_INT_EXIT  OSIntExit
 
+/*
+ * The lowest set bit of a word, found the way the kernel finds the highest
+ * priority of a ready list word: with the instruction of the CPU port, or
+ * else with OS_PrioCtz().
+ */
+
+#ifdef OS_CPU_CTZ
+#define ALT_OS_CTZ(word) OS_CPU_CTZ(word)
+#else
+#define ALT_OS_CTZ(word) OS_PrioCtz(word)
+#endif
+
 #endif /* ALT_ASM_SRC */
 
 /* These macros are used by the VIC funnel assembly code */
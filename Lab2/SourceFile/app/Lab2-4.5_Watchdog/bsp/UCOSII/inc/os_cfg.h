@@ -45,6 +45,14 @@ extern "C"
                                        /* ---------------------- MISCELLANEOUS ----------------------- */
 #define OS_APP_HOOKS_EN           1    /* Application-defined hooks are called from the uC/OS-II hooks */
 #define OS_EVENT_MULTI_EN         1    /* Include code for OSEventPendMulti()                          */
+                                       /* OS_PRIO_BITSCAN_EN keeps the ready and wait lists in 32-bit  */
+                                       /* ... words and finds the highest priority by counting the     */
+                                       /* ... trailing zeros.  Unless set here, ucos_ii.h sets it once */
+                                       /* ... the port is known: 1 with a CTZ instruction (OS_CPU_CTZ) */
+                                       /* ... or with OS_LOWEST_PRIO > 63, else 0                      */
+#ifndef OS_MEM_WORD_EN
+#define OS_MEM_WORD_EN            1    /* Clear and copy kernel tables and task stacks a word at a     */
+#endif                                 /* ... time instead of a byte or an entry at a time             */
 
                                        /* -------------------- MESSAGE MAILBOXES --------------------- */
 #define OS_MBOX_PEND_ABORT_EN     1    /*     Include code for OSMboxPendAbort()                       */
@@ -52,12 +60,141 @@ extern "C"
                                        /* ---------------------- MESSAGE QUEUES ---------------------- */
 #define OS_Q_PEND_ABORT_EN        1    /*     Include code for OSQPendAbort()                          */
 
+                                       /* ---------------------- STATE CHANNELS ---------------------- */
+#ifndef OS_CHAN_EN
+#define OS_CHAN_EN                1    /* Enable (1) or Disable (0) code generation for STATE CHANNELS */
+#endif
+#ifndef OS_MAX_CHANS
+#define OS_MAX_CHANS              8    /*     Max. number of state channels in your application        */
+#endif
+
+                                       /* --------------------- DEFERRED LOGGING --------------------- */
+#ifndef OS_LOG_EN
+#define OS_LOG_EN                 1    /* Enable (1) or Disable (0) code generation for DEFERRED LOGS  */
+#endif
+#ifndef OS_MAX_LOGS
+#define OS_MAX_LOGS               8    /*     Max. number of logs (one per logging task)               */
+#endif
+
+                                       /* ------------------ SINGLE-PRODUCER RINGS ------------------- */
+#ifndef OS_RING_EN
+#define OS_RING_EN                1    /* Enable (1) or Disable (0) code generation for RINGS          */
+#endif
+#ifndef OS_MAX_RINGS
+#define OS_MAX_RINGS              4    /*     Max. number of rings in your application                 */
+#endif
+
+                                       /* --------------------- MEMORY MANAGEMENT -------------------- */
+#ifndef OS_MEM_CLASS_EN
+#define OS_MEM_CLASS_EN           1    /* Include code for OSMemAlloc()/OSMemFree() over size classes  */
+#endif
+#ifndef OS_MEM_CLASS_MAX
+#define OS_MEM_CLASS_MAX          8    /*     Max. number of size classes                              */
+#endif
+#ifndef OS_MEM_MAG_SIZE
+#define OS_MEM_MAG_SIZE           4    /*     Free blocks per size class a task caches in its ...      */
+#endif                                 /*     ... magazine, see OSMemMagSet()                          */
+
                                        /* ------------------------ SEMAPHORES ------------------------ */
 #define OS_SEM_PEND_ABORT_EN      1    /*    Include code for OSSemPendAbort()                         */
 
+                                       /* --------------------- TASK MANAGEMENT ---------------------- */
+#ifndef OS_TASK_PERIODIC_EN
+#define OS_TASK_PERIODIC_EN       1    /*     Include code for OSTaskCreatePeriodic() and ...          */
+#endif                                 /*     ... OSTaskWaitNextPeriod()                               */
+#ifndef OS_EDF_EN
+#define OS_EDF_EN                 1    /*     Schedule the periodic tasks in a band of priorities by   */
+#endif                                 /*     ... earliest deadline instead of by priority             */
+#ifndef OS_EDF_PRIO_HI
+#define OS_EDF_PRIO_HI           10    /*     Highest priority (lowest number) of the EDF band         */
+#endif
+#ifndef OS_EDF_PRIO_LO
+#define OS_EDF_PRIO_LO           14    /*     Lowest  priority (highest number) of the EDF band        */
+#endif
+#ifndef OS_RR_EN
+#define OS_RR_EN                  1    /*     Share the CPU in time slices between the tasks of a band */
+#endif                                 /*     ... of priorities, as if they had the same priority      */
+#ifndef OS_RR_PRIO_HI
+#define OS_RR_PRIO_HI            15    /*     Highest priority (lowest number) of the round-robin band */
+#endif
+#ifndef OS_RR_PRIO_LO
+#define OS_RR_PRIO_LO            18    /*     Lowest  priority of the round-robin band                 */
+#endif
+#ifndef OS_RR_QUANTUM
+#define OS_RR_QUANTUM            10    /*     Time slice of a task of the round-robin band, in ticks   */
+#endif
+#ifndef OS_TASK_NOTIFY_EN
+#define OS_TASK_NOTIFY_EN         1    /*     Include code for OSTaskNotifyPend/Post()                 */
+#endif
+#ifndef OS_TASK_STAT_CYCLES_EN
+#define OS_TASK_STAT_CYCLES_EN    1    /*     CPU usage from the cycles of the idle task, without ...  */
+#endif                                 /*     ... calibrating the idle counter (OS_TASK_PROFILE_EN)    */
+
+                                       /* --------------------- TIME MANAGEMENT ---------------------- */
+#ifndef OS_TICK_LIST_EN
+#define OS_TICK_LIST_EN           1    /* Keep delayed tasks in a delta list instead of scanning all   */
+#endif                                 /* ... TCBs in OSTimeTick()                                     */
+#ifndef OS_TICKLESS_EN
+#define OS_TICKLESS_EN            1    /* Stop the tick while the idle task runs, until the next delay */
+#endif                                 /* ... or timer expires (OSTickSuppressHook())                  */
+
+                                       /* --------------------- TIMER MANAGEMENT --------------------- */
+#ifndef OS_TMR_CFG_STAT_EN
+#define OS_TMR_CFG_STAT_EN        1    /*     Count the timers visited by OSTmr_Task() on each tick    */
+#endif
+#ifndef OS_TMR_CFG_WHEEL_AUTO
+#define OS_TMR_CFG_WHEEL_AUTO     0    /*     Size the timer wheel from OS_TMR_CFG_MAX (see below)     */
+#endif
+
+                                       /* ------------------------ EVENT TRACE ----------------------- */
+#ifndef OS_TRACE_EN
+#define OS_TRACE_EN               1    /* Record context switches, ISRs, posts and pends in a ring     */
+#endif                                 /* ... of timestamped records (OS_TASK_PROFILE_EN)              */
+#ifndef OS_TRACE_SIZE
+#define OS_TRACE_SIZE          2048    /*     Number of records in the ring, a power of 2              */
+#endif
+
                                                                                                                      
 #include "system.h"
 
+/*
+ * Timer wheel sizing helper.  OS_TMR_WHEEL_SIZE_FOR(n) is the smallest prime
+ * in the table below that is >= n, which gives about one timer per spoke for
+ * n running timers.  A prime size keeps periodic timers spread over all the
+ * spokes unless their period is a multiple of the wheel size.  With
+ * OS_TMR_CFG_WHEEL_AUTO set, it replaces the OS_TMR_CFG_WHEEL_SIZE from
+ * system.h, based on OS_TMR_CFG_MAX.
+ */
+#define OS_TMR_WHEEL_SIZE_FOR(n)        (((n) <=    2) ?    2u : \
+                                         ((n) <=    3) ?    3u : \
+                                         ((n) <=    5) ?    5u : \
+                                         ((n) <=    7) ?    7u : \
+                                         ((n) <=   11) ?   11u : \
+                                         ((n) <=   13) ?   13u : \
+                                         ((n) <=   17) ?   17u : \
+                                         ((n) <=   23) ?   23u : \
+                                         ((n) <=   31) ?   31u : \
+                                         ((n) <=   37) ?   37u : \
+                                         ((n) <=   47) ?   47u : \
+                                         ((n) <=   61) ?   61u : \
+                                         ((n) <=   67) ?   67u : \
+                                         ((n) <=   89) ?   89u : \
+                                         ((n) <=  127) ?  127u : \
+                                         ((n) <=  131) ?  131u : \
+                                         ((n) <=  179) ?  179u : \
+                                         ((n) <=  251) ?  251u : \
+                                         ((n) <=  257) ?  257u : \
+                                         ((n) <=  359) ?  359u : \
+                                         ((n) <=  509) ?  509u : \
+                                         ((n) <=  521) ?  521u : \
+                                         ((n) <=  719) ?  719u : \
+                                                         1021u)
+
+#if OS_TMR_CFG_WHEEL_AUTO > 0
+#undef  OS_TMR_CFG_WHEEL_SIZE
+#define OS_TMR_CFG_WHEEL_SIZE           OS_TMR_WHEEL_SIZE_FOR(OS_TMR_CFG_MAX)
+#endif
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
@@ -45,6 +45,14 @@ extern "C" {
 #include <os_cfg.h>
 #include <os_cpu.h>
 
+#ifndef  OS_PRIO_BITSCAN_EN                             /* Default of OS_CFG.H, which needs the port:   */
+#if defined(OS_CPU_CTZ) || (OS_LOWEST_PRIO > 63)        /* ... the bit scan pays with a CTZ instruction */
+#define  OS_PRIO_BITSCAN_EN           1                 /* ... or beyond the 64 priorities that the     */
+#else                                                   /* ... 8-bit OSUnMapTbl[] lookup covers         */
+#define  OS_PRIO_BITSCAN_EN           0
+#endif
+#endif
+
 /*
 *********************************************************************************************************
 *                                             MISCELLANEOUS
@@ -78,13 +86,18 @@ extern "C" {
 #define  OS_TASK_STAT_PRIO  (OS_LOWEST_PRIO - 1)        /* Statistic task priority                     */
 #define  OS_TASK_IDLE_PRIO  (OS_LOWEST_PRIO)            /* IDLE      task priority                     */
 
-#if OS_LOWEST_PRIO <= 63
-#define  OS_EVENT_TBL_SIZE ((OS_LOWEST_PRIO) / 8 + 1)   /* Size of event table                         */
-#define  OS_RDY_TBL_SIZE   ((OS_LOWEST_PRIO) / 8 + 1)   /* Size of ready table                         */
+                                                        /* Words of the ready and event tables ...     */
+#if OS_PRIO_BITSCAN_EN > 0                              /* ... 32 priorities each, found by bit scan   */
+#define  OS_PRIO_MAP_SHIFT            5u
+#elif OS_LOWEST_PRIO <= 63                              /* ... else 8 or 16, found with OSUnMapTbl[]   */
+#define  OS_PRIO_MAP_SHIFT            3u
 #else
-#define  OS_EVENT_TBL_SIZE ((OS_LOWEST_PRIO) / 16 + 1)  /* Size of event table                         */
-#define  OS_RDY_TBL_SIZE   ((OS_LOWEST_PRIO) / 16 + 1)  /* Size of ready table                         */
+#define  OS_PRIO_MAP_SHIFT            4u
 #endif
+#define  OS_PRIO_MAP_MASK  ((1u << OS_PRIO_MAP_SHIFT) - 1u)   /* Bit of a priority in its word         */
+
+#define  OS_EVENT_TBL_SIZE ((OS_LOWEST_PRIO) / (1u << OS_PRIO_MAP_SHIFT) + 1)   /* Size of event table */
+#define  OS_RDY_TBL_SIZE   ((OS_LOWEST_PRIO) / (1u << OS_PRIO_MAP_SHIFT) + 1)   /* Size of ready table */
 
 #define  OS_TASK_IDLE_ID          65535u                /* ID numbers for Idle, Stat and Timer tasks   */
 #define  OS_TASK_STAT_ID          65534u
@@ -107,9 +120,11 @@ extern "C" {
 #define  OS_STAT_SUSPEND           0x08u    /* Task is suspended                                       */
 #define  OS_STAT_MUTEX             0x10u    /* Pending on mutual exclusion semaphore                   */
 #define  OS_STAT_FLAG              0x20u    /* Pending on event flag group                             */
+#define  OS_STAT_NOTIFY            0x40u    /* Pending on task notification                            */
 #define  OS_STAT_MULTI             0x80u    /* Pending on multiple events                              */
 
-#define  OS_STAT_PEND_ANY         (OS_STAT_SEM | OS_STAT_MBOX | OS_STAT_Q | OS_STAT_MUTEX | OS_STAT_FLAG)
+#define  OS_STAT_PEND_ANY         (OS_STAT_SEM | OS_STAT_MBOX | OS_STAT_Q | OS_STAT_MUTEX | OS_STAT_FLAG | \
+                                   OS_STAT_NOTIFY)
 
 /*
 *********************************************************************************************************
@@ -213,6 +228,42 @@ extern "C" {
 #define  OS_TASK_OPT_STK_CLR     0x0002u    /* Clear the stack when the task is create                 */
 #define  OS_TASK_OPT_SAVE_FP     0x0004u    /* Save the contents of any floating-point registers       */
 
+/*
+*********************************************************************************************************
+*                     TASK NOTIFICATION OPTIONS (see OSTaskNotifyPost() and OSTaskNotifyPend())
+*********************************************************************************************************
+*/
+#define  OS_NOTIFY_OPT_SET            0u    /* OSTaskNotifyPost(): OR 'val' into the notification word */
+#define  OS_NOTIFY_OPT_INC            1u    /* OSTaskNotifyPost(): Increment the notification count    */
+
+#define  OS_NOTIFY_OPT_CLR            0u    /* OSTaskNotifyPend(): Return the word and clear it        */
+#define  OS_NOTIFY_OPT_DEC            1u    /* OSTaskNotifyPend(): Return the count and decrement it   */
+
+/*
+*********************************************************************************************************
+*                                TASK PROFILE OPTIONS (see OSTaskProfileQuery())
+*********************************************************************************************************
+*/
+#define  OS_PROFILE_OPT_NONE          0u    /* Leave the profile of the task unchanged                 */
+#define  OS_PROFILE_OPT_CLR_MAX       1u    /* Clear the longest burst after reading it                */
+
+/*
+*********************************************************************************************************
+*                                   TRACE RECORD TYPES (see OS_TRACE_REC)
+*********************************************************************************************************
+*/
+#define  OS_TRACE_SW                  1u    /* Context switch,      'OSTraceArg' is the prio switched in */
+#define  OS_TRACE_INT_ENTER           2u    /* ISR entry,           'OSTraceArg' is the new nesting      */
+#define  OS_TRACE_INT_EXIT            3u    /* ISR exit,            'OSTraceArg' is the new nesting      */
+#define  OS_TRACE_SEM_POST            4u    /* OSSemPost(),         'OSTraceArg' is the event number     */
+#define  OS_TRACE_SEM_PEND            5u    /* OSSemPend() returned at once                              */
+#define  OS_TRACE_SEM_WAIT            6u    /* OSSemPend() blocked the task                              */
+#define  OS_TRACE_MBOX_POST           7u    /* OSMboxPost(), OSMboxPostOpt()                             */
+#define  OS_TRACE_MBOX_PEND           8u    /* OSMboxPend() returned at once                             */
+#define  OS_TRACE_MBOX_WAIT           9u    /* OSMboxPend() blocked the task                             */
+#define  OS_TRACE_NOTIFY_POST        10u    /* OSTaskNotifyPost(),  'OSTraceArg' is the prio notified    */
+#define  OS_TRACE_NOTIFY_WAIT        11u    /* OSTaskNotifyPend() blocked the task                       */
+
 /*
 *********************************************************************************************************
 *                            TIMER OPTIONS (see OSTmrStart() and OSTmrStop())
@@ -236,6 +287,16 @@ extern "C" {
 #define  OS_TMR_STATE_COMPLETED       2u
 #define  OS_TMR_STATE_RUNNING         3u
 
+/*
+*********************************************************************************************************
+*                                   TICKS PER SIGNAL OF THE TIMER TASK
+*
+* Note: OS_TICKS_PER_SEC is a double in system.h, so the quotient is taken once by the compiler and the
+*       tick hooks of the port only do integer arithmetic.
+*********************************************************************************************************
+*/
+#define  OS_TICKS_PER_TMR  ((INT32U)(OS_TICKS_PER_SEC / OS_TMR_CFG_TICKS_PER_SEC))
+
 /*
 *********************************************************************************************************
 *                                             ERROR CODES
@@ -287,6 +348,9 @@ extern "C" {
 #define OS_ERR_TASK_SUSPEND_IDLE     71u
 #define OS_ERR_TASK_SUSPEND_PRIO     72u
 #define OS_ERR_TASK_WAITING          73u
+#define OS_ERR_TASK_NOTIFY_OVF       74u
+#define OS_ERR_TASK_NOT_PERIODIC     75u
+#define OS_ERR_TASK_DEADLINE_MISS    76u
 
 #define OS_ERR_TIME_NOT_DLY          80u
 #define OS_ERR_TIME_INVALID_MINUTES  81u
@@ -332,6 +396,36 @@ extern "C" {
 #define OS_ERR_TMR_STOPPED          142u
 #define OS_ERR_TMR_NO_CALLBACK      143u
 
+#define OS_ERR_CHAN_INVALID_ADDR    150u
+#define OS_ERR_CHAN_INVALID_SIZE    151u
+#define OS_ERR_CHAN_DEPLETED        152u
+#define OS_ERR_CHAN_INVALID_PCHAN   153u
+#define OS_ERR_CHAN_INVALID_PDATA   154u
+#define OS_ERR_CHAN_EMPTY           155u
+
+#define OS_ERR_LOG_INVALID_ADDR     160u
+#define OS_ERR_LOG_INVALID_SIZE     161u
+#define OS_ERR_LOG_DEPLETED         162u
+#define OS_ERR_LOG_EXIST            163u
+#define OS_ERR_LOG_NONE             164u
+#define OS_ERR_LOG_FULL             165u
+#define OS_ERR_LOG_EMPTY            166u
+#define OS_ERR_LOG_INVALID_PREC     167u
+
+#define OS_ERR_TRACE_INVALID_PREC   170u
+#define OS_ERR_TRACE_RUNNING        171u
+
+#define OS_ERR_RING_INVALID_ADDR    180u
+#define OS_ERR_RING_INVALID_SIZE    181u
+#define OS_ERR_RING_DEPLETED        182u
+#define OS_ERR_RING_INVALID_PRING   183u
+#define OS_ERR_RING_INVALID_PDATA   184u
+#define OS_ERR_RING_FULL            185u
+
+#define OS_ERR_MEM_CLASS_DEPLETED   190u
+#define OS_ERR_MEM_INVALID_CLASS    191u
+#define OS_ERR_MEM_MAG_ISR          192u
+
 /*
 *********************************************************************************************************
 *                                    OLD ERROR CODE NAMES (< V2.84)
@@ -378,6 +472,25 @@ extern "C" {
 #define OS_FLAG_INVALID_OPT          OS_ERR_FLAG_INVALID_OPT
 #define OS_FLAG_GRP_DEPLETED         OS_ERR_FLAG_GRP_DEPLETED
 
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                       READY AND WAIT LIST WORDS
+*
+* Note: The ready list and the wait list of an event are tables of words with one bit per priority, and
+*       a group word with one bit per word of the table that has a bit set.  The priority of a bit is
+*       (word << OS_PRIO_MAP_SHIFT) + bit, so the lowest bit set is the highest priority.
+*********************************************************************************************************
+*/
+
+#if   OS_PRIO_MAP_SHIFT == 5
+typedef  INT32U  OS_PRIO_MAP;
+#elif OS_PRIO_MAP_SHIFT == 4
+typedef  INT16U  OS_PRIO_MAP;
+#else
+typedef  INT8U   OS_PRIO_MAP;
+#endif
+
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -390,13 +503,8 @@ typedef struct os_event {
     INT8U    OSEventType;                    /* Type of event control block (see OS_EVENT_TYPE_xxxx)    */
     void    *OSEventPtr;                     /* Pointer to message or queue structure                   */
     INT16U   OSEventCnt;                     /* Semaphore Count (not used if other EVENT type)          */
-#if OS_LOWEST_PRIO <= 63
-    INT8U    OSEventGrp;                     /* Group corresponding to tasks waiting for event to occur */
-    INT8U    OSEventTbl[OS_EVENT_TBL_SIZE];  /* List of tasks waiting for event to occur                */
-#else
-    INT16U   OSEventGrp;                     /* Group corresponding to tasks waiting for event to occur */
-    INT16U   OSEventTbl[OS_EVENT_TBL_SIZE];  /* List of tasks waiting for event to occur                */
-#endif
+    OS_PRIO_MAP OSEventGrp;                  /* Group corresponding to tasks waiting for event to occur */
+    OS_PRIO_MAP OSEventTbl[OS_EVENT_TBL_SIZE];  /* List of tasks waiting for event to occur             */
 
 #if OS_EVENT_NAME_SIZE > 1
     INT8U    OSEventName[OS_EVENT_NAME_SIZE];
@@ -461,16 +569,88 @@ typedef struct os_flag_node {               /* Event Flag Wait List Node
 #if OS_MBOX_EN > 0
 typedef struct os_mbox_data {
     void   *OSMsg;                         /* Pointer to message in mailbox                            */
-#if OS_LOWEST_PRIO <= 63
-    INT8U   OSEventTbl[OS_EVENT_TBL_SIZE]; /* List of tasks waiting for event to occur                 */
-    INT8U   OSEventGrp;                    /* Group corresponding to tasks waiting for event to occur  */
-#else
-    INT16U  OSEventTbl[OS_EVENT_TBL_SIZE]; /* List of tasks waiting for event to occur                 */
-    INT16U  OSEventGrp;                    /* Group corresponding to tasks waiting for event to occur  */
-#endif
+    OS_PRIO_MAP OSEventTbl[OS_EVENT_TBL_SIZE]; /* List of tasks waiting for event to occur             */
+    OS_PRIO_MAP OSEventGrp;                /* Group corresponding to tasks waiting for event to occur  */
 } OS_MBOX_DATA;
 #endif
 
+/*
+*********************************************************************************************************
+*                                       STATE CHANNEL DATA STRUCTURES
+*********************************************************************************************************
+*/
+
+#if (OS_CHAN_EN > 0) && (OS_MAX_CHANS > 0)
+typedef struct os_chan {                  /* STATE CHANNEL CONTROL BLOCK                               */
+    void            *OSChanBuf;           /* Pointer to the two copies of the record (or next free)   */
+    INT16U           OSChanSize;          /* Size (in bytes) of the record                             */
+    volatile INT32U  OSChanSeq;           /* Sequence counter, twice the number of records written     */
+} OS_CHAN;
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                         LOG DATA STRUCTURES
+*********************************************************************************************************
+*/
+
+#if (OS_LOG_EN > 0) && (OS_MAX_LOGS > 0)
+typedef struct os_log_rec {               /* LOG RECORD                                                */
+    char const      *OSLogFmt;            /* Pointer to the printf() format of the record              */
+    INT32U           OSLogArg[2];         /* Arguments of the format                                   */
+    INT32U           OSLogTime;           /* Value of OSTime when the record was posted                */
+    INT8U            OSLogPrio;           /* Priority of the posting task, set by OSLogAccept()        */
+} OS_LOG_REC;
+
+typedef struct os_log {                   /* LOG CONTROL BLOCK                                         */
+    OS_LOG_REC      *OSLogBuf;            /* Pointer to the ring of records                            */
+    struct os_log   *OSLogNext;           /* Pointer to next log in the list of logs (or next free)    */
+    INT32U           OSLogDropCtr;        /* Number of records dropped because the ring was full       */
+    volatile INT16U  OSLogIn;             /* Index of the next record to post, moved by the owner only */
+    volatile INT16U  OSLogOut;            /* Index of the next record to accept, moved by the drain    */
+    INT16U           OSLogSize;           /* Number of records in the ring                             */
+    INT8U            OSLogPrio;           /* Priority of the task owning the log                       */
+} OS_LOG;
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                   SINGLE-PRODUCER RING DATA STRUCTURES
+*********************************************************************************************************
+*/
+
+#if (OS_RING_EN > 0) && (OS_MAX_RINGS > 0)
+typedef struct os_ring {                  /* RING CONTROL BLOCK                                        */
+    INT8U           *OSRingBuf;           /* Pointer to the storage of the entries                     */
+    struct os_ring  *OSRingNext;          /* Pointer to next free ring                                 */
+    INT32U           OSRingDropCtr;       /* Number of entries dropped because the ring was full       */
+    volatile INT16U  OSRingIn;            /* Number of entries posted, moved by the producer only      */
+    volatile INT16U  OSRingOut;           /* Number of entries taken, moved by the consumer only       */
+    INT16U           OSRingMask;          /* Number of entries in the ring minus one                   */
+    INT16U           OSRingEntrySize;     /* Size of an entry, in bytes                                */
+    INT8U            OSRingPrio;          /* Priority of the consumer, notified of a non-empty ring    */
+} OS_RING;
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                        TRACE DATA STRUCTURES
+*********************************************************************************************************
+*/
+
+#if OS_TRACE_EN > 0
+typedef struct os_trace_rec {             /* TRACE RECORD                                              */
+    INT32U           OSTraceTime;         /* Value of OSCPUCyclesGet() when the record was made        */
+    INT16U           OSTraceArg;          /* Argument, depends on the type (see OS_TRACE_SW ...)       */
+    INT8U            OSTraceType;         /* Type of the record, OS_TRACE_SW ...                       */
+    INT8U            OSTracePrio;         /* Priority of the running task (switched out for a switch)  */
+} OS_TRACE_REC;
+#endif
+
+/*$PAGE*/
 /*
 *********************************************************************************************************
 *                                     MEMORY PARTITION DATA STRUCTURES
@@ -500,6 +680,32 @@ typedef struct os_mem_data {
 } OS_MEM_DATA;
 #endif
 
+#if (OS_MEM_EN > 0) && (OS_MAX_MEM_PART > 0) && (OS_MEM_CLASS_EN > 0)
+typedef struct os_mem_class {             /* SIZE CLASS OF OSMemAlloc()                                */
+    OS_MEM  *OSMemClassMem;               /* Pointer to the partition the blocks are taken from        */
+    INT32U   OSMemClassBlkSize;           /* Size (in bytes) of each block of the class                */
+    INT32U   OSMemClassNUsedMax;          /* Most blocks ever taken from the partition at once         */
+    INT32U   OSMemClassFallbackCtr;       /* Requests a larger class served, this one being empty      */
+    INT32U   OSMemClassFailCtr;           /* Requests that found no free block in any fitting class    */
+} OS_MEM_CLASS;
+
+
+typedef struct os_mem_mag {               /* FREE BLOCKS CACHED BY A TASK, see OSMemMagSet()           */
+    INT8U   OSMagCnt[OS_MEM_CLASS_MAX];   /* Number of blocks cached per class                         */
+    void   *OSMagBlk[OS_MEM_CLASS_MAX][OS_MEM_MAG_SIZE];
+} OS_MEM_MAG;
+
+
+typedef struct os_mem_class_data {
+    INT32U  OSBlkSize;                 /* Size (in bytes) of each memory block                         */
+    INT32U  OSNBlks;                   /* Total number of blocks in the partition                      */
+    INT32U  OSNFree;                   /* Number of blocks free in the partition, not in magazines     */
+    INT32U  OSNUsedMax;                /* Most blocks ever taken from the partition at once            */
+    INT32U  OSFallbackCtr;             /* Requests served by a larger class                            */
+    INT32U  OSFailCtr;                 /* Requests that found no free block                            */
+} OS_MEM_CLASS_DATA;
+#endif
+
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -509,13 +715,8 @@ typedef struct os_mem_data {
 
 #if OS_MUTEX_EN > 0
 typedef struct os_mutex_data {
-#if OS_LOWEST_PRIO <= 63
-    INT8U   OSEventTbl[OS_EVENT_TBL_SIZE];  /* List of tasks waiting for event to occur                */
-    INT8U   OSEventGrp;                     /* Group corresponding to tasks waiting for event to occur */
-#else
-    INT16U  OSEventTbl[OS_EVENT_TBL_SIZE];  /* List of tasks waiting for event to occur                */
-    INT16U  OSEventGrp;                     /* Group corresponding to tasks waiting for event to occur */
-#endif
+    OS_PRIO_MAP OSEventTbl[OS_EVENT_TBL_SIZE];  /* List of tasks waiting for event to occur            */
+    OS_PRIO_MAP OSEventGrp;                 /* Group corresponding to tasks waiting for event to occur */
     BOOLEAN OSValue;                        /* Mutex value (OS_FALSE = used, OS_TRUE = available)      */
     INT8U   OSOwnerPrio;                    /* Mutex owner's task priority or 0xFF if no owner         */
     INT8U   OSMutexPIP;                     /* Priority Inheritance Priority or 0xFF if no owner       */
@@ -544,13 +745,8 @@ typedef struct os_q_data {
     void          *OSMsg;               /* Pointer to next message to be extracted from queue          */
     INT16U         OSNMsgs;             /* Number of messages in message queue                         */
     INT16U         OSQSize;             /* Size of message queue                                       */
-#if OS_LOWEST_PRIO <= 63
-    INT8U          OSEventTbl[OS_EVENT_TBL_SIZE];  /* List of tasks waiting for event to occur         */
-    INT8U          OSEventGrp;          /* Group corresponding to tasks waiting for event to occur     */
-#else
-    INT16U         OSEventTbl[OS_EVENT_TBL_SIZE];  /* List of tasks waiting for event to occur         */
-    INT16U         OSEventGrp;          /* Group corresponding to tasks waiting for event to occur     */
-#endif
+    OS_PRIO_MAP    OSEventTbl[OS_EVENT_TBL_SIZE];  /* List of tasks waiting for event to occur         */
+    OS_PRIO_MAP    OSEventGrp;          /* Group corresponding to tasks waiting for event to occur     */
 } OS_Q_DATA;
 #endif
 
@@ -563,13 +759,8 @@ typedef struct os_q_data {
 #if OS_SEM_EN > 0
 typedef struct os_sem_data {
     INT16U  OSCnt;                          /* Semaphore count                                         */
-#if OS_LOWEST_PRIO <= 63
-    INT8U   OSEventTbl[OS_EVENT_TBL_SIZE];  /* List of tasks waiting for event to occur                */
-    INT8U   OSEventGrp;                     /* Group corresponding to tasks waiting for event to occur */
-#else
-    INT16U  OSEventTbl[OS_EVENT_TBL_SIZE];  /* List of tasks waiting for event to occur                */
-    INT16U  OSEventGrp;                     /* Group corresponding to tasks waiting for event to occur */
-#endif
+    OS_PRIO_MAP OSEventTbl[OS_EVENT_TBL_SIZE];  /* List of tasks waiting for event to occur            */
+    OS_PRIO_MAP OSEventGrp;                 /* Group corresponding to tasks waiting for event to occur */
 } OS_SEM_DATA;
 #endif
 
@@ -586,6 +777,21 @@ typedef struct os_stk_data {
 } OS_STK_DATA;
 #endif
 
+/*
+*********************************************************************************************************
+*                                           TASK PROFILE DATA
+*********************************************************************************************************
+*/
+
+#if OS_TASK_PROFILE_EN > 0
+typedef struct os_task_profile {
+    INT32U  OSCyclesTot;               /* Cycles the task has been running, wraps around               */
+    INT32U  OSCyclesMax;               /* Longest burst, i.e. cycles between switching in and out      */
+    INT32U  OSCtxSwCtr;                /* Number of times the task was switched in                     */
+    INT32U  OSPreemptCtr;              /* Number of times the task was switched out while still ready */
+} OS_TASK_PROFILE;
+#endif
+
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -627,19 +833,43 @@ typedef struct os_tcb {
 #endif
 
     INT16U           OSTCBDly;              /* Nbr ticks to delay task or, timeout waiting for event   */
+#if OS_TICK_LIST_EN > 0                     /* ... as requested: it does not count down in the tick    */
+                                            /* ... list, OSTaskQuery() returns the ticks left in it    */
+    struct os_tcb   *OSTCBTickNext;         /* Pointer to next     TCB in the tick list                */
+    struct os_tcb   *OSTCBTickPrev;         /* Pointer to previous TCB in the tick list                */
+    INT16U           OSTCBTickDelta;        /* Nbr ticks between previous TCB's timeout and this one   */
+#endif
+#if OS_TASK_PERIODIC_EN > 0
+    INT16U           OSTCBPeriod;           /* Period in ticks, 0 if the task is not periodic          */
+    INT32U           OSTCBRelease;          /* Value of OSTime when the current job was released       */
+    INT32U           OSTCBPeriodMissCtr;    /* Number of deadlines missed by the task                  */
+#endif
+#if OS_EDF_EN > 0
+    struct os_tcb   *OSTCBEDFNext;          /* Pointer to next     TCB in the EDF list                 */
+    struct os_tcb   *OSTCBEDFPrev;          /* Pointer to previous TCB in the EDF list                 */
+    INT32U           OSTCBDeadline;         /* Absolute deadline of the current job (OSTime)           */
+#endif
+#if OS_RR_EN > 0
+    struct os_tcb   *OSTCBRRNext;           /* Pointer to next     TCB in the round-robin FIFO         */
+    struct os_tcb   *OSTCBRRPrev;           /* Pointer to previous TCB in the round-robin FIFO         */
+#endif
+#if OS_TASK_NOTIFY_EN > 0
+    INT32U           OSTCBNotifyVal;        /* Notification word: bits or count, see OSTaskNotifyPost() */
+#endif
+#if (OS_LOG_EN > 0) && (OS_MAX_LOGS > 0)
+    OS_LOG          *OSTCBLog;              /* Pointer to the log the task posts to, see OSLogPost()   */
+#endif
+#if (OS_MEM_EN > 0) && (OS_MAX_MEM_PART > 0) && (OS_MEM_CLASS_EN > 0)
+    OS_MEM_MAG      *OSTCBMemMag;           /* Pointer to the task's cache of free blocks, or NULL     */
+#endif
     INT8U            OSTCBStat;             /* Task      status                                        */
     INT8U            OSTCBStatPend;         /* Task PEND status                                        */
     INT8U            OSTCBPrio;             /* Task priority (0 == highest)                            */
 
     INT8U            OSTCBX;                /* Bit position in group  corresponding to task priority   */
     INT8U            OSTCBY;                /* Index into ready table corresponding to task priority   */
-#if OS_LOWEST_PRIO <= 63
-    INT8U            OSTCBBitX;             /* Bit mask to access bit position in ready table          */
-    INT8U            OSTCBBitY;             /* Bit mask to access bit position in ready group          */
-#else
-    INT16U           OSTCBBitX;             /* Bit mask to access bit position in ready table          */
-    INT16U           OSTCBBitY;             /* Bit mask to access bit position in ready group          */
-#endif
+    OS_PRIO_MAP      OSTCBBitX;             /* Bit mask to access bit position in ready table          */
+    OS_PRIO_MAP      OSTCBBitY;             /* Bit mask to access bit position in ready group          */
 
 #if OS_TASK_DEL_EN > 0
     INT8U            OSTCBDelReq;           /* Indicates whether a task needs to delete itself         */
@@ -649,6 +879,8 @@ typedef struct os_tcb {
     INT32U           OSTCBCtxSwCtr;         /* Number of time the task was switched in                 */
     INT32U           OSTCBCyclesTot;        /* Total number of clock cycles the task has been running  */
     INT32U           OSTCBCyclesStart;      /* Snapshot of cycle counter at start of task resumption   */
+    INT32U           OSTCBCyclesMax;        /* Longest burst the task has been running                 */
+    INT32U           OSTCBPreemptCtr;       /* Number of times the task was switched out while ready   */
     OS_STK          *OSTCBStkBase;          /* Pointer to the beginning of the task stack              */
     INT32U           OSTCBStkUsed;          /* Number of bytes used from the stack                     */
 #endif
@@ -731,13 +963,8 @@ OS_EXT  INT8U             OSLockNesting;            /* Multitasking lock nesting
 OS_EXT  INT8U             OSPrioCur;                /* Priority of current task                        */
 OS_EXT  INT8U             OSPrioHighRdy;            /* Priority of highest priority task               */
 
-#if OS_LOWEST_PRIO <= 63
-OS_EXT  INT8U             OSRdyGrp;                        /* Ready list group                         */
-OS_EXT  INT8U             OSRdyTbl[OS_RDY_TBL_SIZE];       /* Table of tasks which are ready to run    */
-#else
-OS_EXT  INT16U            OSRdyGrp;                        /* Ready list group                         */
-OS_EXT  INT16U            OSRdyTbl[OS_RDY_TBL_SIZE];       /* Table of tasks which are ready to run    */
-#endif
+OS_EXT  OS_PRIO_MAP       OSRdyGrp;                        /* Ready list group                         */
+OS_EXT  OS_PRIO_MAP       OSRdyTbl[OS_RDY_TBL_SIZE];       /* Table of tasks which are ready to run    */
 
 OS_EXT  BOOLEAN           OSRunning;                       /* Flag indicating that kernel is running   */
 
@@ -755,15 +982,63 @@ OS_EXT  OS_TCB           *OSTCBList;                       /* Pointer to doubly
 OS_EXT  OS_TCB           *OSTCBPrioTbl[OS_LOWEST_PRIO + 1];/* Table of pointers to created TCBs        */
 OS_EXT  OS_TCB            OSTCBTbl[OS_MAX_TASKS + OS_N_SYS_TASKS];   /* Table of TCBs                  */
 
+#if OS_TICK_LIST_EN > 0
+OS_EXT  OS_TCB           *OSTickList;                      /* Delayed TCBs, sorted by timeout          */
+#endif
+
+#if OS_EDF_EN > 0
+OS_EXT  OS_TCB           *OSEDFList;                       /* EDF band TCBs, sorted by deadline        */
+#endif
+
+#if OS_RR_EN > 0
+OS_EXT  OS_TCB           *OSRRList;                        /* Round-robin band TCBs, in turn order     */
+OS_EXT  OS_TCB           *OSRRListLast;                    /* Last TCB of the round-robin FIFO         */
+OS_EXT  OS_TCB           *OSRRCur;                         /* TCB holding the current time slice       */
+OS_EXT  INT16U            OSRRTicks;                       /* Ticks left in the current time slice     */
+#endif
+
 #if OS_TICK_STEP_EN > 0
 OS_EXT  INT8U             OSTickStepState;          /* Indicates the state of the tick step feature    */
 #endif
 
+#if OS_TICKLESS_EN > 0
+OS_EXT  BOOLEAN           OSTickSuppressed;         /* The tick is stopped while the idle task runs    */
+OS_EXT  INT32U            OSTickCtr;                /* Number of ticks serviced by OSTimeTick()        */
+#endif
+
+#if (OS_CHAN_EN > 0) && (OS_MAX_CHANS > 0)
+OS_EXT  OS_CHAN          *OSChanFreeList;           /* Pointer to free list of state channels          */
+OS_EXT  OS_CHAN           OSChanTbl[OS_MAX_CHANS];  /* Table of state channels                         */
+#endif
+
+#if (OS_LOG_EN > 0) && (OS_MAX_LOGS > 0)
+OS_EXT  OS_LOG           *OSLogFreeList;            /* Pointer to free list of logs                    */
+OS_EXT  OS_LOG           *OSLogList;                /* Pointer to list of created logs                 */
+OS_EXT  INT8U             OSLogDrainPrio;           /* Priority of the drain, set by OSLogDrainSet()   */
+OS_EXT  OS_LOG            OSLogTbl[OS_MAX_LOGS];    /* Table of logs                                   */
+#endif
+
+#if (OS_RING_EN > 0) && (OS_MAX_RINGS > 0)
+OS_EXT  OS_RING          *OSRingFreeList;           /* Pointer to free list of rings                   */
+OS_EXT  OS_RING           OSRingTbl[OS_MAX_RINGS];  /* Table of rings                                  */
+#endif
+
+#if OS_TRACE_EN > 0
+OS_EXT  OS_TRACE_REC      OSTraceBuf[OS_TRACE_SIZE];/* Ring of trace records                           */
+OS_EXT  INT32U            OSTraceCtr;               /* Number of records made since OSTraceStart()     */
+OS_EXT  BOOLEAN           OSTraceOn;                /* Flag indicating that the trace is recording     */
+#endif
+
 #if (OS_MEM_EN > 0) && (OS_MAX_MEM_PART > 0)
 OS_EXT  OS_MEM           *OSMemFreeList;            /* Pointer to free list of memory partitions       */
 OS_EXT  OS_MEM            OSMemTbl[OS_MAX_MEM_PART];/* Storage for memory partition manager            */
 #endif
 
+#if (OS_MEM_EN > 0) && (OS_MAX_MEM_PART > 0) && (OS_MEM_CLASS_EN > 0)
+OS_EXT  OS_MEM_CLASS      OSMemClassTbl[OS_MEM_CLASS_MAX]; /* Size classes, in the order created       */
+OS_EXT  INT8U             OSMemClassCtr;            /* Number of size classes created                  */
+#endif
+
 #if (OS_Q_EN > 0) && (OS_MAX_QS > 0)
 OS_EXT  OS_Q             *OSQFreeList;              /* Pointer to list of free QUEUE control blocks    */
 OS_EXT  OS_Q              OSQTbl[OS_MAX_QS];        /* Table of QUEUE control blocks                   */
@@ -786,6 +1061,12 @@ OS_EXT  OS_TMR           *OSTmrFreeList;            /* Pointer to free list of t
 OS_EXT  OS_STK            OSTmrTaskStk[OS_TASK_TMR_STK_SIZE];
 
 OS_EXT  OS_TMR_WHEEL      OSTmrWheelTbl[OS_TMR_CFG_WHEEL_SIZE];
+
+#if OS_TMR_CFG_STAT_EN > 0
+OS_EXT  INT16U            OSTmrVisitCtr;            /* Timers visited on the last timer tick           */
+OS_EXT  INT16U            OSTmrVisitMax;            /* Max. number of timers visited on one tick       */
+OS_EXT  INT32U            OSTmrVisitTot;            /* Total number of timers visited                  */
+#endif
 #endif
 
 extern  INT8U   const     OSUnMapTbl[256];          /* Priority->Index    lookup table                 */
@@ -925,6 +1206,101 @@ INT8U         OSMboxQuery             (OS_EVENT        *pevent,
 #endif
 #endif
 
+/*
+*********************************************************************************************************
+*                                            STATE CHANNELS
+*********************************************************************************************************
+*/
+
+#if (OS_CHAN_EN > 0) && (OS_MAX_CHANS > 0)
+
+OS_CHAN      *OSChanCreate            (void            *pbuf,
+                                       INT16U           size,
+                                       INT8U           *perr);
+
+INT32U        OSChanRead              (OS_CHAN         *pchan,
+                                       void            *pdata,
+                                       INT8U           *perr);
+
+INT8U         OSChanWrite             (OS_CHAN         *pchan,
+                                       void            *pdata);
+
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                           DEFERRED LOGGING
+*********************************************************************************************************
+*/
+
+#if (OS_LOG_EN > 0) && (OS_MAX_LOGS > 0)
+
+INT8U         OSLogAccept             (OS_LOG_REC      *prec);
+
+OS_LOG       *OSLogCreate             (INT8U            prio,
+                                       OS_LOG_REC      *pbuf,
+                                       INT16U           nrecs,
+                                       INT8U           *perr);
+
+INT8U         OSLogDrainSet           (INT8U            prio);
+
+INT8U         OSLogPost               (char const      *pfmt,
+                                       INT32U           arg0,
+                                       INT32U           arg1);
+
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                         SINGLE-PRODUCER RINGS
+*********************************************************************************************************
+*/
+
+#if (OS_RING_EN > 0) && (OS_MAX_RINGS > 0)
+
+INT16U        OSRingAccept            (OS_RING         *pring,
+                                       void            *pdest,
+                                       INT16U           n);
+
+OS_RING      *OSRingCreate            (void            *pbuf,
+                                       INT16U           nentries,
+                                       INT16U           size,
+                                       INT8U            prio,
+                                       INT8U           *perr);
+
+INT16U        OSRingPend              (OS_RING         *pring,
+                                       void            *pdest,
+                                       INT16U           n,
+                                       INT16U           timeout,
+                                       INT8U           *perr);
+
+INT8U         OSRingPost              (OS_RING         *pring,
+                                       void            *pentry);
+
+#endif
+
+/*
+*********************************************************************************************************
+*                                             EVENT TRACE
+*********************************************************************************************************
+*/
+
+#if OS_TRACE_EN > 0
+
+INT16U        OSTraceRead             (INT32U           ix,
+                                       OS_TRACE_REC    *prec,
+                                       INT16U           nrecs,
+                                       INT8U           *perr);
+
+void          OSTraceStart            (void);
+
+INT32U        OSTraceStop             (void);
+
+#endif
+
+/*$PAGE*/
 /*
 *********************************************************************************************************
 *                                           MEMORY MANAGEMENT
@@ -957,6 +1333,25 @@ INT8U         OSMemQuery              (OS_MEM          *pmem,
                                        OS_MEM_DATA     *p_mem_data);
 #endif
 
+#if OS_MEM_CLASS_EN > 0
+void         *OSMemAlloc              (INT32U           size,
+                                       INT8U           *perr);
+
+OS_MEM       *OSMemClassCreate        (void            *addr,
+                                       INT32U           nblks,
+                                       INT32U           blksize,
+                                       INT8U           *perr);
+
+#if OS_MEM_QUERY_EN > 0
+INT8U         OSMemClassQuery         (INT8U            cls,
+                                       OS_MEM_CLASS_DATA *p_class_data);
+#endif
+
+INT8U         OSMemFree               (void            *pblk);
+
+INT8U         OSMemMagSet             (OS_MEM_MAG      *pmag);
+#endif
+
 #endif
 
 /*
@@ -1129,6 +1524,21 @@ INT8U         OSTaskCreateExt         (void           (*task)(void *p_arg),
                                        INT16U           opt);
 #endif
 
+#if OS_TASK_PERIODIC_EN > 0
+INT8U         OSTaskCreatePeriodic    (void           (*task)(void *p_arg),
+                                       void            *p_arg,
+                                       OS_STK          *ptos,
+                                       INT8U            prio,
+                                       INT16U           id,
+                                       OS_STK          *pbos,
+                                       INT32U           stk_size,
+                                       void            *pext,
+                                       INT16U           opt,
+                                       INT16U           period);
+
+INT8U         OSTaskWaitNextPeriod    (void);
+#endif
+
 #if OS_TASK_DEL_EN > 0
 INT8U         OSTaskDel               (INT8U            prio);
 INT8U         OSTaskDelReq            (INT8U            prio);
@@ -1144,6 +1554,22 @@ void          OSTaskNameSet           (INT8U            prio,
                                        INT8U           *perr);
 #endif
 
+#if OS_TASK_NOTIFY_EN > 0
+INT32U        OSTaskNotifyPend        (INT16U           timeout,
+                                       INT8U            opt,
+                                       INT8U           *perr);
+
+INT8U         OSTaskNotifyPost        (INT8U            prio,
+                                       INT32U           val,
+                                       INT8U            opt);
+#endif
+
+#if OS_TASK_PROFILE_EN > 0
+INT8U         OSTaskProfileQuery      (INT8U            prio,
+                                       OS_TASK_PROFILE *p_prof,
+                                       INT8U            opt);
+#endif
+
 #if OS_TASK_SUSPEND_EN > 0
 INT8U         OSTaskResume            (INT8U            prio);
 INT8U         OSTaskSuspend           (INT8U            prio);
@@ -1186,6 +1612,10 @@ void          OSTimeSet               (INT32U           ticks);
 
 void          OSTimeTick              (void);
 
+#if OS_TICKLESS_EN > 0
+void          OSTimeTickN             (INT32U           ticks);
+#endif
+
 /*
 *********************************************************************************************************
 *                                            TIMER MANAGEMENT
@@ -1224,6 +1654,11 @@ BOOLEAN      OSTmrStop                (OS_TMR          *ptmr,
                                        INT8U           *perr);
 
 INT8U        OSTmrSignal              (void);
+
+#if OS_TICKLESS_EN > 0
+INT32U       OSTmrNextGet             (void);
+INT8U        OSTmrSignalN             (INT32U           n);
+#endif
 #endif
 
 /*
@@ -1293,8 +1728,37 @@ void          OS_MemCopy              (INT8U           *pdest,
                                        INT8U           *psrc,
                                        INT16U           size);
 
+#ifndef OS_CPU_CTZ
+INT8U         OS_PrioCtz              (INT32U           word);
+#endif
+
 #if (OS_MEM_EN > 0) && (OS_MAX_MEM_PART > 0)
 void          OS_MemInit              (void);
+#if OS_MEM_CLASS_EN > 0
+void          OS_MemMagFlush          (OS_TCB          *ptcb);
+#endif
+#endif
+
+#if (OS_CHAN_EN > 0) && (OS_MAX_CHANS > 0)
+void          OS_ChanInit             (void);
+#endif
+
+#if (OS_LOG_EN > 0) && (OS_MAX_LOGS > 0)
+void          OS_LogInit              (void);
+#endif
+
+#if (OS_RING_EN > 0) && (OS_MAX_RINGS > 0)
+void          OS_RingInit             (void);
+#endif
+
+#if OS_TRACE_EN > 0
+void          OS_TraceInit            (void);
+void          OS_TraceRec             (INT8U            type,
+                                       INT16U           arg);
+#define       OS_TRACE(type, arg)      OS_TraceRec((type), (arg))
+#define       OS_TRACE_EVENT_ID(pevent) ((INT16U)((pevent) - &OSEventTbl[0]))
+#else
+#define       OS_TRACE(type, arg)
 #endif
 
 #if OS_Q_EN > 0
@@ -1316,6 +1780,10 @@ void          OS_TaskIdle             (void            *p_arg);
 void          OS_TaskStat             (void            *p_arg);
 #endif
 
+#if OS_TASK_PROFILE_EN > 0
+void          OS_TaskProfileSw        (void);
+#endif
+
 #if (OS_TASK_STAT_STK_CHK_EN > 0) && (OS_TASK_CREATE_EXT_EN > 0)
 void          OS_TaskStkClr           (OS_STK          *pbos,
                                        INT32U           size,
@@ -1334,6 +1802,27 @@ INT8U         OS_TCBInit              (INT8U            prio,
                                        void            *pext,
                                        INT16U           opt);
 
+void          OS_TickListInsert       (OS_TCB          *ptcb,
+                                       INT16U           ticks);
+
+void          OS_TickListRemove       (OS_TCB          *ptcb);
+
+#if OS_EDF_EN > 0
+void          OS_EDFInsert            (OS_TCB          *ptcb);
+
+void          OS_EDFRemove            (OS_TCB          *ptcb);
+#endif
+
+#if OS_RR_EN > 0
+void          OS_RRInsert             (OS_TCB          *ptcb);
+
+void          OS_RRRemove             (OS_TCB          *ptcb);
+#endif
+
+#if OS_TICKLESS_EN > 0
+INT16U        OS_TickListNext         (void);
+#endif
+
 #if OS_TMR_EN > 0
 void          OSTmr_Init              (void);
 #endif
@@ -1368,10 +1857,22 @@ OS_STK       *OSTaskStkInit           (void           (*task)(void *p_arg),
 void          OSTaskSwHook            (void);
 #endif
 
+#if OS_TASK_PROFILE_EN > 0
+INT32U        OSCPUCyclesGet          (void);
+#endif
+
 void          OSTCBInitHook           (OS_TCB          *ptcb);
 
 #if OS_TIME_TICK_HOOK_EN > 0
 void          OSTimeTickHook          (void);
+#if OS_TICKLESS_EN > 0
+void          OSTimeTickNHook         (INT32U           ticks);
+#endif
+#endif
+
+#if OS_TICKLESS_EN > 0
+BOOLEAN       OSTickSuppressHook      (INT32U           ticks);
+void          OSTickResumeHook        (void);
 #endif
 
 /*$PAGE*/
@@ -1527,6 +2028,106 @@ void          OSCtxSw                 (void);
     #ifndef OS_MEM_QUERY_EN
     #error  "OS_CFG.H, Missing OS_MEM_QUERY_EN: Include code for OSMemQuery()"
     #endif
+
+    #ifndef OS_MEM_CLASS_EN
+    #error  "OS_CFG.H, Missing OS_MEM_CLASS_EN: Include code for OSMemAlloc() and OSMemFree()"
+    #else
+        #ifndef OS_MEM_CLASS_MAX
+        #error  "OS_CFG.H, Missing OS_MEM_CLASS_MAX: Max. number of size classes"
+        #else
+            #if     (OS_MEM_CLASS_MAX < 1) || (OS_MEM_CLASS_MAX > 255)
+            #error  "OS_CFG.H, OS_MEM_CLASS_MAX must be between 1 and 255"
+            #endif
+        #endif
+        #ifndef OS_MEM_MAG_SIZE
+        #error  "OS_CFG.H, Missing OS_MEM_MAG_SIZE: Free blocks per size class in a task's magazine"
+        #else
+            #if     (OS_MEM_MAG_SIZE < 2) || (OS_MEM_MAG_SIZE > 255)
+            #error  "OS_CFG.H, OS_MEM_MAG_SIZE must be between 2 and 255"
+            #endif
+        #endif
+    #endif
+#endif
+
+/*
+*********************************************************************************************************
+*                                            STATE CHANNELS
+*********************************************************************************************************
+*/
+
+#ifndef OS_CHAN_EN
+#error  "OS_CFG.H, Missing OS_CHAN_EN: Enable (1) or Disable (0) code generation for STATE CHANNELS"
+#else
+    #ifndef OS_MAX_CHANS
+    #error  "OS_CFG.H, Missing OS_MAX_CHANS: Max. number of state channels"
+    #else
+        #if     OS_MAX_CHANS > 65500u
+        #error  "OS_CFG.H, OS_MAX_CHANS must be <= 65500"
+        #endif
+    #endif
+#endif
+
+/*
+*********************************************************************************************************
+*                                           DEFERRED LOGGING
+*********************************************************************************************************
+*/
+
+#ifndef OS_LOG_EN
+#error  "OS_CFG.H, Missing OS_LOG_EN: Enable (1) or Disable (0) code generation for DEFERRED LOGGING"
+#else
+    #ifndef OS_MAX_LOGS
+    #error  "OS_CFG.H, Missing OS_MAX_LOGS: Max. number of logs"
+    #else
+        #if     OS_MAX_LOGS > 65500u
+        #error  "OS_CFG.H, OS_MAX_LOGS must be <= 65500"
+        #endif
+    #endif
+#endif
+
+/*
+*********************************************************************************************************
+*                                         SINGLE-PRODUCER RINGS
+*********************************************************************************************************
+*/
+
+#ifndef OS_RING_EN
+#error  "OS_CFG.H, Missing OS_RING_EN: Enable (1) or Disable (0) code generation for SINGLE-PRODUCER RINGS"
+#else
+    #ifndef OS_MAX_RINGS
+    #error  "OS_CFG.H, Missing OS_MAX_RINGS: Max. number of rings"
+    #else
+        #if     OS_MAX_RINGS > 65500u
+        #error  "OS_CFG.H, OS_MAX_RINGS must be <= 65500"
+        #endif
+    #endif
+    #if     (OS_RING_EN > 0) && (OS_TASK_NOTIFY_EN == 0)
+    #error  "OS_CFG.H, OS_RING_EN requires OS_TASK_NOTIFY_EN to wake the consumer"
+    #endif
+#endif
+
+/*
+*********************************************************************************************************
+*                                             EVENT TRACE
+*********************************************************************************************************
+*/
+
+#ifndef OS_TRACE_EN
+#error  "OS_CFG.H, Missing OS_TRACE_EN: Enable (1) or Disable (0) code generation for the EVENT TRACE"
+#else
+    #if (OS_TRACE_EN > 0) && (OS_TASK_PROFILE_EN == 0)
+    #error  "OS_CFG.H, OS_TRACE_EN requires OS_TASK_PROFILE_EN for OSCPUCyclesGet()"
+    #endif
+    #ifndef OS_TRACE_SIZE
+    #error  "OS_CFG.H, Missing OS_TRACE_SIZE: Number of records in the trace ring"
+    #else
+        #if     (OS_TRACE_SIZE < 2) || ((OS_TRACE_SIZE & (OS_TRACE_SIZE - 1)) != 0)
+        #error  "OS_CFG.H, OS_TRACE_SIZE must be a power of 2"
+        #endif
+        #if     OS_TRACE_SIZE > 32768u
+        #error  "OS_CFG.H, OS_TRACE_SIZE must be <= 32768"
+        #endif
+    #endif
 #endif
 
 /*
@@ -1690,6 +2291,53 @@ void          OSCtxSw                 (void);
 #error  "OS_CFG.H, Missing OS_TASK_NAME_SIZE: Determine the size of task names"
 #endif
 
+#ifndef OS_TASK_NOTIFY_EN
+#error  "OS_CFG.H, Missing OS_TASK_NOTIFY_EN: Include code for OSTaskNotifyPend() and OSTaskNotifyPost()"
+#endif
+
+#ifndef OS_TASK_PERIODIC_EN
+#error  "OS_CFG.H, Missing OS_TASK_PERIODIC_EN: Include code for OSTaskCreatePeriodic() and OSTaskWaitNextPeriod()"
+#elif   OS_TASK_PERIODIC_EN > 0
+    #if     (OS_TASK_CREATE_EXT_EN == 0) || (OS_SCHED_LOCK_EN == 0)
+    #error  "OS_CFG.H, OS_TASK_CREATE_EXT_EN and OS_SCHED_LOCK_EN are required by OSTaskCreatePeriodic()"
+    #endif
+    #if     OS_TIME_GET_SET_EN == 0
+    #error  "OS_CFG.H, OS_TIME_GET_SET_EN is required by OSTaskWaitNextPeriod(), which reads OSTime"
+    #endif
+#endif
+
+#ifndef OS_EDF_EN
+#error  "OS_CFG.H, Missing OS_EDF_EN: Schedule the periodic tasks of a band of priorities by earliest deadline"
+#elif   OS_EDF_EN > 0
+    #if     OS_TASK_PERIODIC_EN == 0
+    #error  "OS_CFG.H, OS_EDF_EN requires OS_TASK_PERIODIC_EN for the deadlines of the tasks"
+    #endif
+    #if     !defined(OS_EDF_PRIO_HI) || !defined(OS_EDF_PRIO_LO)
+    #error  "OS_CFG.H, Missing OS_EDF_PRIO_HI or OS_EDF_PRIO_LO: Band of priorities scheduled by deadline"
+    #elif   (OS_EDF_PRIO_HI > OS_EDF_PRIO_LO) || (OS_EDF_PRIO_LO >= OS_LOWEST_PRIO)
+    #error  "OS_CFG.H, OS_EDF_PRIO_HI must be <= OS_EDF_PRIO_LO, which must be < OS_LOWEST_PRIO"
+    #endif
+#endif
+
+#ifndef OS_MEM_WORD_EN
+#error  "OS_CFG.H, Missing OS_MEM_WORD_EN: Clear and copy kernel memory a word at a time"
+#endif
+
+#ifndef OS_RR_EN
+#error  "OS_CFG.H, Missing OS_RR_EN: Share the CPU in time slices between the tasks of a band of priorities"
+#elif   OS_RR_EN > 0
+    #if     !defined(OS_RR_PRIO_HI) || !defined(OS_RR_PRIO_LO) || !defined(OS_RR_QUANTUM)
+    #error  "OS_CFG.H, Missing OS_RR_PRIO_HI, OS_RR_PRIO_LO or OS_RR_QUANTUM: Round-robin band and time slice"
+    #elif   (OS_RR_PRIO_HI > OS_RR_PRIO_LO) || (OS_RR_PRIO_LO >= OS_LOWEST_PRIO - 1)
+    #error  "OS_CFG.H, OS_RR_PRIO_HI must be <= OS_RR_PRIO_LO, which must be above the statistic task"
+    #elif   OS_RR_QUANTUM == 0
+    #error  "OS_CFG.H, OS_RR_QUANTUM must be > 0"
+    #endif
+    #if     (OS_EDF_EN > 0) && (OS_RR_PRIO_LO >= OS_EDF_PRIO_HI) && (OS_RR_PRIO_HI <= OS_EDF_PRIO_LO)
+    #error  "OS_CFG.H, The round-robin band must not overlap the EDF band"
+    #endif
+#endif
+
 #ifndef OS_TASK_SUSPEND_EN
 #error  "OS_CFG.H, Missing OS_TASK_SUSPEND_EN: Include code for OSTaskSuspend() and OSTaskResume()"
 #endif
@@ -1762,6 +2410,10 @@ void          OSCtxSw                 (void);
     #error  "OS_CFG.H, Missing OS_TMR_CFG_NAME_SIZE: Determines the number of characters used for Timer names"
     #endif
 
+    #ifndef OS_TMR_CFG_STAT_EN
+    #error  "OS_CFG.H, Missing OS_TMR_CFG_STAT_EN: When (1) counts the timers visited by the timer task on each tick"
+    #endif
+
     #ifndef OS_TMR_CFG_TICKS_PER_SEC
     #error  "OS_CFG.H, Missing OS_TMR_CFG_TICKS_PER_SEC: Determines the rate at which tiem timer management task will run (Hz)"
     #endif
@@ -1826,6 +2478,14 @@ void          OSCtxSw                 (void);
 #error  "OS_CFG.H, Missing OS_TASK_PROFILE_EN: Include data structure for run-time task profiling"
 #endif
 
+#ifndef OS_TASK_STAT_CYCLES_EN
+#error  "OS_CFG.H, Missing OS_TASK_STAT_CYCLES_EN: Compute the CPU usage from the cycles of the idle task"
+#else
+    #if (OS_TASK_STAT_CYCLES_EN > 0) && (OS_TASK_PROFILE_EN == 0)
+    #error  "OS_CFG.H, OS_TASK_STAT_CYCLES_EN requires OS_TASK_PROFILE_EN"
+    #endif
+#endif
+
 
 #ifndef OS_TASK_SW_HOOK_EN
 #error  "OS_CFG.H, Missing OS_TASK_SW_HOOK_EN: Allows you to include the code for OSTaskSwHook() or not"
@@ -1837,6 +2497,16 @@ void          OSCtxSw                 (void);
 #endif
 
 
+#ifndef OS_TICK_LIST_EN
+#error  "OS_CFG.H, Missing OS_TICK_LIST_EN: Keep delayed tasks in a delta list processed by OSTimeTick()"
+#endif
+
+
+#ifndef OS_TICKLESS_EN
+#error  "OS_CFG.H, Missing OS_TICKLESS_EN: Stop the tick while the idle task runs"
+#endif
+
+
 #ifndef OS_TIME_TICK_HOOK_EN
 #error  "OS_CFG.H, Missing OS_TIME_TICK_HOOK_EN: Allows you to include the code for OSTimeTickHook() or not"
 #endif
@@ -0,0 +1,250 @@
+/******************************************************************************
+*                                                                             *
+* The HAL heap on a TLSF allocator, see sys/alt_tlsf.h.                       *
+*                                                                             *
+* With ALT_TLSF_HEAP set (the default), malloc(), free() and the rest of the  *
+* allocation functions of newlib, including the reentrant versions the C      *
+* library calls itself, are replaced by a TLSF heap. It takes its memory      *
+* from sbrk() in chunks of at least ALT_TLSF_GROW_BYTES, each added as a      *
+* pool, so the time of an allocation is bounded except when the heap grows.   *
+* Tasks with deadlines should allocate once at start-up, or reserve the       *
+* memory they need up front with a malloc() and free() of its size.           *
+*                                                                             *
+* The calls are serialised with __malloc_lock() and __malloc_unlock() of      *
+* alt_malloc_lock.c, like those of newlib, so the heap must not be used from  *
+* interrupt handlers.                                                         *
+*                                                                             *
+* With ALT_TLSF_ONCHIP set, the part of onchip_memory behind the sections     *
+* the linker placed there is a second heap, used through alt_onchip_malloc()  *
+* and alt_onchip_free(), for data that benefits from single-cycle memory.     *
+*                                                                             *
+******************************************************************************/
+
+#include <errno.h>
+#include <reent.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "system.h"
+#include "sys/alt_tlsf.h"
+
+#ifndef ALT_TLSF_HEAP
+#define ALT_TLSF_HEAP 1
+#endif
+
+#ifndef ALT_TLSF_GROW_BYTES
+#define ALT_TLSF_GROW_BYTES 16384
+#endif
+
+#ifndef ALT_TLSF_ONCHIP
+#define ALT_TLSF_ONCHIP 0
+#endif
+
+extern void __malloc_lock (struct _reent* r);
+extern void __malloc_unlock (struct _reent* r);
+
+#if ALT_TLSF_HEAP
+
+alt_tlsf alt_heap;
+
+static int alt_heap_ready;
+
+/*
+ * Adds a chunk from sbrk() with room for a block of 'size' bytes. Called
+ * with the heap locked.
+ */
+
+static int alt_heap_grow (size_t size)
+{
+  size_t bytes = size + 4 * ALT_TLSF_ALIGN;
+  void* mem;
+
+  if (!alt_heap_ready)
+  {
+    alt_tlsf_create (&alt_heap);
+    alt_heap_ready = 1;
+  }
+
+  /* Requests of the larger classes are rounded up, see alt_tlsf_find(). */
+
+  bytes += bytes >> ALT_TLSF_SL_LOG2;
+  if (bytes < ALT_TLSF_GROW_BYTES)
+  {
+    bytes = ALT_TLSF_GROW_BYTES;
+  }
+
+  mem = sbrk ((int) bytes);
+  if (mem == (void*) -1)
+  {
+    return -1;
+  }
+  return alt_tlsf_add_pool (&alt_heap, mem, bytes);
+}
+
+void* _malloc_r (struct _reent* r, size_t size)
+{
+  void* p;
+
+  __malloc_lock (r);
+  p = alt_heap_ready ? alt_tlsf_malloc (&alt_heap, size) : NULL;
+  if (!p && alt_heap_grow (size) == 0)
+  {
+    p = alt_tlsf_malloc (&alt_heap, size);
+  }
+  __malloc_unlock (r);
+
+  if (!p)
+  {
+    r->_errno = ENOMEM;
+  }
+  return p;
+}
+
+void _free_r (struct _reent* r, void* ptr)
+{
+  if (ptr)
+  {
+    __malloc_lock (r);
+    alt_tlsf_free (&alt_heap, ptr);
+    __malloc_unlock (r);
+  }
+}
+
+void* _realloc_r (struct _reent* r, void* ptr, size_t size)
+{
+  void* p;
+
+  if (!ptr)
+  {
+    return _malloc_r (r, size);
+  }
+
+  __malloc_lock (r);
+  p = alt_tlsf_realloc (&alt_heap, ptr, size);
+  __malloc_unlock (r);
+
+  /* Out of room in the pools: grow the heap through a new block. */
+
+  if (!p && size)
+  {
+    p = _malloc_r (r, size);
+    if (p)
+    {
+      memcpy (p, ptr, alt_tlsf_block_size (ptr) < size ?
+                      alt_tlsf_block_size (ptr) : size);
+      _free_r (r, ptr);
+    }
+  }
+  return p;
+}
+
+void* _calloc_r (struct _reent* r, size_t n, size_t size)
+{
+  void* p;
+
+  if (size && n > (size_t) -1 / size)
+  {
+    r->_errno = ENOMEM;
+    return NULL;
+  }
+  p = _malloc_r (r, n * size);
+  if (p)
+  {
+    memset (p, 0, n * size);
+  }
+  return p;
+}
+
+void* _memalign_r (struct _reent* r, size_t align, size_t size)
+{
+  void* p;
+
+  __malloc_lock (r);
+  p = alt_heap_ready ? alt_tlsf_memalign (&alt_heap, align, size) : NULL;
+  if (!p && alt_heap_grow (size + align) == 0)
+  {
+    p = alt_tlsf_memalign (&alt_heap, align, size);
+  }
+  __malloc_unlock (r);
+
+  if (!p)
+  {
+    r->_errno = ENOMEM;
+  }
+  return p;
+}
+
+size_t _malloc_usable_size_r (struct _reent* r, void* ptr)
+{
+  return ptr ? alt_tlsf_block_size (ptr) : 0;
+}
+
+void* malloc (size_t size)
+{
+  return _malloc_r (_REENT, size);
+}
+
+void free (void* ptr)
+{
+  _free_r (_REENT, ptr);
+}
+
+void* realloc (void* ptr, size_t size)
+{
+  return _realloc_r (_REENT, ptr, size);
+}
+
+void* calloc (size_t n, size_t size)
+{
+  return _calloc_r (_REENT, n, size);
+}
+
+void* memalign (size_t align, size_t size)
+{
+  return _memalign_r (_REENT, align, size);
+}
+
+size_t malloc_usable_size (void* ptr)
+{
+  return _malloc_usable_size_r (_REENT, ptr);
+}
+
+#endif /* ALT_TLSF_HEAP */
+
+#if ALT_TLSF_ONCHIP
+
+alt_tlsf alt_onchip_heap;
+
+static int alt_onchip_ready;
+
+extern char _alt_partition_onchip_memory_end[]; /* set by linker */
+
+void* alt_onchip_malloc (size_t size)
+{
+  void* p;
+
+  __malloc_lock (_REENT);
+  if (!alt_onchip_ready)
+  {
+    alt_tlsf_create (&alt_onchip_heap);
+    alt_tlsf_add_pool (&alt_onchip_heap, _alt_partition_onchip_memory_end,
+                       (size_t) (ONCHIP_MEMORY_BASE + ONCHIP_MEMORY_SPAN) -
+                       (size_t) _alt_partition_onchip_memory_end);
+    alt_onchip_ready = 1;
+  }
+  p = alt_tlsf_malloc (&alt_onchip_heap, size);
+  __malloc_unlock (_REENT);
+  return p;
+}
+
+void alt_onchip_free (void* ptr)
+{
+  if (ptr)
+  {
+    __malloc_lock (_REENT);
+    alt_tlsf_free (&alt_onchip_heap, ptr);
+    __malloc_unlock (_REENT);
+  }
+}
+
+#endif /* ALT_TLSF_ONCHIP */
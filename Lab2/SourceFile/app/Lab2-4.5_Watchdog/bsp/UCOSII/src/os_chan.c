@@ -0,0 +1,230 @@
+/*
+*********************************************************************************************************
+*                                                uC/OS-II
+*                                          The Real-Time Kernel
+*                                             STATE CHANNELS
+*
+* File    : OS_CHAN.C
+* Version : V2.86
+*
+* A state channel holds the latest value of a fixed-size record that one task (or ISR) writes and any
+* number of tasks read.  Readers never block and the writer never allocates: the channel keeps two
+* copies of the record and a sequence counter, the 'latch' form of a sequence lock.  While the writer
+* updates one copy, readers take the other one, so a reader that preempts the writer still gets a
+* consistent record, and a reader only retries when the writer preempted it in the middle of a copy.
+*********************************************************************************************************
+*/
+
+#ifndef  OS_MASTER_FILE
+#include <ucos_ii.h>
+#endif
+
+#if (OS_CHAN_EN > 0) && (OS_MAX_CHANS > 0)
+/*
+*********************************************************************************************************
+*                                         CREATE A STATE CHANNEL
+*
+* Description : Create a state channel for records of 'size' bytes.
+*
+* Arguments   : pbuf     is a pointer to the storage of the channel, which must be 2 * 'size' bytes
+*                        large.  The storage must not be used by the application anymore.
+*
+*               size     is the size (in bytes) of the record carried by the channel.
+*
+*               perr     is a pointer to a variable containing an error message which will be set by
+*                        this function to either:
+*
+*                        OS_ERR_NONE                if the channel has been created correctly.
+*                        OS_ERR_CHAN_INVALID_ADDR   if 'pbuf' is a NULL pointer.
+*                        OS_ERR_CHAN_INVALID_SIZE   if 'size' is 0.
+*                        OS_ERR_CHAN_DEPLETED       if no more channel control blocks are available.
+*
+* Returns     : != (OS_CHAN *)0  is the channel was created
+*               == (OS_CHAN *)0  if the channel was not created because of invalid arguments or, no
+*                                free channel control block is available.
+*********************************************************************************************************
+*/
+
+OS_CHAN  *OSChanCreate (void *pbuf, INT16U size, INT8U *perr)
+{
+    OS_CHAN   *pchan;
+#if OS_CRITICAL_METHOD == 3                           /* Allocate storage for CPU status register      */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                         /* Validate 'perr'                               */
+        return ((OS_CHAN *)0);
+    }
+    if (pbuf == (void *)0) {                          /* Must pass a valid address for the storage     */
+        *perr = OS_ERR_CHAN_INVALID_ADDR;
+        return ((OS_CHAN *)0);
+    }
+    if (size == 0) {                                  /* Must carry at least one byte                  */
+        *perr = OS_ERR_CHAN_INVALID_SIZE;
+        return ((OS_CHAN *)0);
+    }
+#endif
+    OS_ENTER_CRITICAL();
+    pchan = OSChanFreeList;                           /* Get next free channel control block           */
+    if (OSChanFreeList != (OS_CHAN *)0) {             /* See if pool of free channels was empty        */
+        OSChanFreeList = (OS_CHAN *)OSChanFreeList->OSChanBuf;
+    }
+    OS_EXIT_CRITICAL();
+    if (pchan == (OS_CHAN *)0) {                      /* See if we have a channel control block        */
+        *perr = OS_ERR_CHAN_DEPLETED;
+        return ((OS_CHAN *)0);
+    }
+    pchan->OSChanBuf  = pbuf;                         /* Store address of the two copies               */
+    pchan->OSChanSize = size;
+    pchan->OSChanSeq  = 0;                            /* Nothing written yet                           */
+    *perr             = OS_ERR_NONE;
+    return (pchan);
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                       READ FROM A STATE CHANNEL
+*
+* Description : Copy the latest record written to a state channel.  This function never blocks and may
+*               be called from any task or ISR.
+*
+* Arguments   : pchan    is a pointer to the channel control block
+*
+*               pdata    is a pointer to where the record will be copied ('size' bytes).
+*
+*               perr     is a pointer to a variable containing an error message which will be set by
+*                        this function to either:
+*
+*                        OS_ERR_NONE                if the latest record was copied to 'pdata'.
+*                        OS_ERR_CHAN_EMPTY          if nothing was written to the channel yet, 'pdata'
+*                                                   is left unchanged.
+*                        OS_ERR_CHAN_INVALID_PCHAN  if you passed a NULL pointer for 'pchan'
+*                        OS_ERR_CHAN_INVALID_PDATA  if you passed a NULL pointer for 'pdata'
+*
+* Returns     : The number of records written to the channel when the copied record was the latest.
+*               Readers can compare it with the value of their previous read to find out whether the
+*               record is new.
+*
+* Note(s)     : 1) The copy is retried if the writer wrote to the channel while it was in progress.
+*********************************************************************************************************
+*/
+
+INT32U  OSChanRead (OS_CHAN *pchan, void *pdata, INT8U *perr)
+{
+    INT32U   seq;
+    INT8U   *psrc;
+    INT16U   size;
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                         /* Validate 'perr'                               */
+        return (0);
+    }
+    if (pchan == (OS_CHAN *)0) {                      /* Must point to a valid channel                 */
+        *perr = OS_ERR_CHAN_INVALID_PCHAN;
+        return (0);
+    }
+    if (pdata == (void *)0) {                         /* Must point to a valid destination             */
+        *perr = OS_ERR_CHAN_INVALID_PDATA;
+        return (0);
+    }
+#endif
+    size = pchan->OSChanSize;
+    do {
+        seq = pchan->OSChanSeq;
+        if (seq < 2) {                                /* First record not complete yet                 */
+            *perr = OS_ERR_CHAN_EMPTY;
+            return (0);
+        }
+        psrc = (INT8U *)pchan->OSChanBuf + (seq & 1) * size;   /* Take the copy not being written     */
+        OS_CPU_BARRIER();                             /* Copy after the read of the sequence ...       */
+        OS_MemCopy((INT8U *)pdata, psrc, size);
+        OS_CPU_BARRIER();                             /* ... and before it is read again               */
+    } while (pchan->OSChanSeq != seq);                /* Retry if the writer got in between            */
+    *perr = OS_ERR_NONE;
+    return (seq >> 1);
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                        WRITE TO A STATE CHANNEL
+*
+* Description : Make a record the latest value of a state channel.  Only one task or ISR may write to a
+*               channel.  This function never blocks and may be called from an ISR.
+*
+* Arguments   : pchan    is a pointer to the channel control block
+*
+*               pdata    is a pointer to the record to write ('size' bytes).
+*
+* Returns     : OS_ERR_NONE                if the record was written.
+*               OS_ERR_CHAN_INVALID_PCHAN  if you passed a NULL pointer for 'pchan'
+*               OS_ERR_CHAN_INVALID_PDATA  if you passed a NULL pointer for 'pdata'
+*
+* Note(s)     : 1) The record is copied twice.  An odd 'OSChanSeq' sends readers to the second copy while
+*                  the first one is written, an even one sends them to the first copy while the second one
+*                  is written.
+*               2) OS_CPU_BARRIER() keeps the compiler from moving a copy across the updates of
+*                  'OSChanSeq'.
+*********************************************************************************************************
+*/
+
+INT8U  OSChanWrite (OS_CHAN *pchan, void *pdata)
+{
+    INT8U   *pbuf;
+    INT16U   size;
+
+
+#if OS_ARG_CHK_EN > 0
+    if (pchan == (OS_CHAN *)0) {                      /* Must point to a valid channel                 */
+        return (OS_ERR_CHAN_INVALID_PCHAN);
+    }
+    if (pdata == (void *)0) {                         /* Must point to a valid record                  */
+        return (OS_ERR_CHAN_INVALID_PDATA);
+    }
+#endif
+    pbuf = (INT8U *)pchan->OSChanBuf;
+    size = pchan->OSChanSize;
+    pchan->OSChanSeq++;                               /* Readers take the second copy ...              */
+    OS_CPU_BARRIER();
+    OS_MemCopy(pbuf, (INT8U *)pdata, size);           /* ... while the first one is written            */
+    OS_CPU_BARRIER();
+    pchan->OSChanSeq++;                               /* Readers take the new first copy ...           */
+    OS_CPU_BARRIER();
+    OS_MemCopy(pbuf + size, (INT8U *)pdata, size);    /* ... while the second one is written           */
+    return (OS_ERR_NONE);
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                  INITIALIZE STATE CHANNEL MANAGER
+*
+* Description : This function is called by uC/OS-II to initialize the state channel manager.  Your
+*               application MUST NOT call this function.
+*
+* Arguments   : none
+*
+* Returns     : none
+*
+* Note(s)    : This function is INTERNAL to uC/OS-II and your application should not call it.
+*********************************************************************************************************
+*/
+
+void  OS_ChanInit (void)
+{
+    OS_CHAN  *pchan;
+    INT16U    i;
+
+
+    OS_MemClr((INT8U *)&OSChanTbl[0], sizeof(OSChanTbl)); /* Clear the channel table                  */
+    pchan = &OSChanTbl[0];
+    for (i = 0; i < (OS_MAX_CHANS - 1); i++) {             /* Init. list of free channels              */
+        pchan->OSChanBuf = (void *)&OSChanTbl[i+1];
+        pchan++;
+    }
+    pchan->OSChanBuf = (void *)0;                          /* Initialize last node                     */
+    OSChanFreeList   = &OSChanTbl[0];                      /* Point to beginning of free list          */
+}
+#endif                                                     /* OS_CHAN_EN                               */
@@ -77,6 +77,35 @@ static  void  OS_InitTCBList(void);
 
 static  void  OS_SchedNew(void);
 
+static  void  OS_TimeTickRdy(OS_TCB *ptcb);
+
+/*
+*********************************************************************************************************
+*                                    LOWEST BIT SET IN A READY LIST WORD
+*
+* Note: OS_PRIO_BIT() returns the position of the lowest bit set in a word of a ready or wait list, i.e.
+*       the highest priority of the word.  With OS_PRIO_BITSCAN_EN, it counts the trailing zeros, with the
+*       instruction the port provides through OS_CPU_CTZ() or else with OS_PrioCtz().
+*********************************************************************************************************
+*/
+
+#if OS_PRIO_BITSCAN_EN > 0
+#ifdef   OS_CPU_CTZ
+#define  OS_PRIO_BIT(map)  ((INT8U)OS_CPU_CTZ(map))
+#else
+#define  OS_PRIO_BIT(map)  OS_PrioCtz(map)
+#endif
+#elif OS_LOWEST_PRIO <= 63
+#define  OS_PRIO_BIT(map)  OSUnMapTbl[map]
+#else
+#define  OS_PRIO_BIT(map)  ((((map) & 0xFF) != 0) ? OSUnMapTbl[(map) & 0xFF]                         \
+                                                  : (INT8U)(OSUnMapTbl[((map) >> 8) & 0xFF] + 8))
+#endif
+
+#if OS_TICKLESS_EN > 0
+static  void  OS_TickSuppress(void);
+#endif
+
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -458,7 +487,7 @@ INT16U  OSEventPendMulti (OS_EVENT **pevents_pend, OS_EVENT **pevents_rdy, void
     OSTCBCur->OSTCBStat     |= events_stat  |           /* Resource not available, ...                 */
                                OS_STAT_MULTI;           /* ... pend on multiple events                 */
     OSTCBCur->OSTCBStatPend  = OS_STAT_PEND_OK;
-    OSTCBCur->OSTCBDly       = timeout;                 /* Store pend timeout in TCB                   */
+    OS_TickListInsert(OSTCBCur, timeout);               /* Store pend timeout in TCB                   */
     OS_EventTaskWaitMulti(pevents_pend);                /* Suspend task until events or timeout occurs */
 
     OS_EXIT_CRITICAL();
@@ -571,6 +600,22 @@ void  OSInit (void)
     OS_MemInit();                                                /* Initialize the memory manager            */
 #endif
 
+#if (OS_CHAN_EN > 0) && (OS_MAX_CHANS > 0)
+    OS_ChanInit();                                               /* Initialize the state channels            */
+#endif
+
+#if (OS_LOG_EN > 0) && (OS_MAX_LOGS > 0)
+    OS_LogInit();                                                /* Initialize the logs                      */
+#endif
+
+#if (OS_RING_EN > 0) && (OS_MAX_RINGS > 0)
+    OS_RingInit();                                               /* Initialize the single-producer rings     */
+#endif
+
+#if OS_TRACE_EN > 0
+    OS_TraceInit();                                              /* Initialize the event trace               */
+#endif
+
 #if (OS_Q_EN > 0) && (OS_MAX_QS > 0)
     OS_QInit();                                                  /* Initialize the message queue structures  */
 #endif
@@ -611,6 +656,8 @@ void  OSInit (void)
 *                 to OSIntEnter() at the beginning of the ISR you MUST have a call to OSIntExit() at the
 *                 end of the ISR.
 *              5) You are allowed to nest interrupts up to 255 levels deep.
+*              6) With OS_TICKLESS_EN, the first interrupt after the idle task stopped the tick restarts
+*                 it, and the ticks that elapsed meanwhile are processed before the ISR runs.
 *********************************************************************************************************
 */
 
@@ -625,6 +672,13 @@ void  OSIntEnter (void)
         if (OSIntNesting < 255u) {
             OSIntNesting++;                      /* Increment ISR nesting level                        */
         }
+#if OS_TICKLESS_EN > 0
+        if (OSTickSuppressed == OS_TRUE) {       /* Restart the tick stopped by the idle task          */
+            OSTickSuppressed = OS_FALSE;
+            OSTickResumeHook();
+        }
+#endif
+        OS_TRACE(OS_TRACE_INT_ENTER, OSIntNesting);
         OS_EXIT_CRITICAL();
     }
 }
@@ -661,6 +715,7 @@ void  OSIntExit (void)
         if (OSIntNesting > 0) {                            /* Prevent OSIntNesting from wrapping       */
             OSIntNesting--;
         }
+        OS_TRACE(OS_TRACE_INT_EXIT, OSIntNesting);
         if (OSIntNesting == 0) {                           /* Reschedule only if all ISRs complete ... */
             if (OSLockNesting == 0) {                      /* ... and not locked.                      */
                 OS_SchedNew();
@@ -807,6 +862,10 @@ void  OSStart (void)
 *                 CPU Usage (%) = 100 * (1 - ------------)
 *                                            OSIdleCtrMax
 *
+*              With OS_TASK_STAT_CYCLES_EN set, the CPU usage is computed from the cycles the idle task
+*              has been running instead (see OS_TaskProfileSw()), which needs no calibration, so this
+*              function only starts the statistics task and returns at once.
+*
 * Arguments  : none
 *
 * Returns    : none
@@ -822,11 +881,13 @@ void  OSStatInit (void)
 
 
 
+#if OS_TASK_STAT_CYCLES_EN == 0
     OSTimeDly(2);                                /* Synchronize with clock tick                        */
     OS_ENTER_CRITICAL();
     OSIdleCtr    = 0L;                           /* Clear idle counter                                 */
     OS_EXIT_CRITICAL();
     OSTimeDly(OS_TICKS_PER_SEC / 10);            /* Determine MAX. idle counter value for 1/10 second  */
+#endif
     OS_ENTER_CRITICAL();
     OSIdleCtrMax = OSIdleCtr;                    /* Store maximum idle counter count in 1/10 second    */
     OSStatRdy    = OS_TRUE;
@@ -867,6 +928,9 @@ void  OSTimeTick (void)
     OS_ENTER_CRITICAL();                                   /* Update the 32-bit tick counter               */
     OSTime++;
     OS_EXIT_CRITICAL();
+#endif
+#if OS_TICKLESS_EN > 0
+    OSTickCtr++;
 #endif
     if (OSRunning == OS_TRUE) {
 #if OS_TICK_STEP_EN > 0
@@ -893,28 +957,158 @@ void  OSTimeTick (void)
             return;
         }
 #endif
+#if OS_RR_EN > 0
+        OS_ENTER_CRITICAL();
+        if (OSRRCur == OSTCBCur) {                         /* Charge the slice of the interrupted task     */
+            if (--OSRRTicks == 0) {
+                OS_RRInsert(OSRRCur);                      /* Slice used up, next in turn at OSIntExit()   */
+            }
+        }
+        OS_EXIT_CRITICAL();
+#endif
+#if OS_TICK_LIST_EN > 0
+        OS_ENTER_CRITICAL();
+        ptcb = OSTickList;                                 /* Only the first delayed TCB counts down       */
+        if (ptcb != (OS_TCB *)0) {
+            ptcb->OSTCBTickDelta--;
+            while ((ptcb != (OS_TCB *)0) && (ptcb->OSTCBTickDelta == 0)) {
+                OS_TickListRemove(ptcb);                   /* Delay or timeout expired                     */
+                OS_TimeTickRdy(ptcb);
+                OS_EXIT_CRITICAL();                        /* Allow interrupts between expired tasks       */
+                OS_ENTER_CRITICAL();
+                ptcb = OSTickList;
+            }
+        }
+        OS_EXIT_CRITICAL();
+#else
         ptcb = OSTCBList;                                  /* Point at first TCB in TCB list               */
         while (ptcb->OSTCBPrio != OS_TASK_IDLE_PRIO) {     /* Go through all TCBs in TCB list              */
             OS_ENTER_CRITICAL();
             if (ptcb->OSTCBDly != 0) {                     /* No, Delayed or waiting for event with TO     */
                 if (--ptcb->OSTCBDly == 0) {               /* Decrement nbr of ticks to end of delay       */
-                                                           /* Check for timeout                            */
-                    if ((ptcb->OSTCBStat & OS_STAT_PEND_ANY) != OS_STAT_RDY) {
-                        ptcb->OSTCBStat  &= ~(INT8U)OS_STAT_PEND_ANY;          /* Yes, Clear status flag   */
-                        ptcb->OSTCBStatPend = OS_STAT_PEND_TO;                 /* Indicate PEND timeout    */
-                    } else {
-                        ptcb->OSTCBStatPend = OS_STAT_PEND_OK;
-                    }
-
-                    if ((ptcb->OSTCBStat & OS_STAT_SUSPEND) == OS_STAT_RDY) {  /* Is task suspended?       */
-                        OSRdyGrp               |= ptcb->OSTCBBitY;             /* No,  Make ready          */
-                        OSRdyTbl[ptcb->OSTCBY] |= ptcb->OSTCBBitX;
-                    }
+                    OS_TimeTickRdy(ptcb);
                 }
             }
             ptcb = ptcb->OSTCBNext;                        /* Point at next TCB in TCB list                */
             OS_EXIT_CRITICAL();
         }
+#endif
+    }
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                       PROCESS SEVERAL SYSTEM TICKS
+*
+* Description: This function is used to signal to uC/OS-II that 'ticks' system ticks elapsed at once,
+*              which is how the ticks skipped while the idle task had stopped the tick are made up for
+*              (see OSTickResumeHook()).  It has the same effect as calling OSTimeTick() 'ticks' times,
+*              but the tick list is advanced in a single pass.
+*
+* Arguments  : ticks     is the number of ticks that elapsed.
+*
+* Returns    : none
+*
+* Note(s)    : 1) OSTimeTickNHook() is called once with the number of ticks, instead of OSTimeTickHook()
+*                 for each: this function runs from OSIntEnter() with interrupts disabled, so its time must
+*                 not grow with the ticks.  The hook signalling the timer task in the port keeps its period.
+*              2) If uC/OS-View started stepping the tick meanwhile, the ticks are not processed, as in
+*                 OSTimeTick() while waiting for a step command.
+*********************************************************************************************************
+*/
+
+#if OS_TICKLESS_EN > 0
+void  OSTimeTickN (INT32U ticks)
+{
+    OS_TCB    *ptcb;
+#if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register     */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+    if (ticks == 0) {
+        return;
+    }
+#if OS_TIME_TICK_HOOK_EN > 0
+    OSTimeTickNHook(ticks);                                /* Call user definable hook for all the ticks   */
+#endif
+#if OS_TIME_GET_SET_EN > 0
+    OS_ENTER_CRITICAL();                                   /* Update the 32-bit tick counter               */
+    OSTime += ticks;
+    OS_EXIT_CRITICAL();
+#endif
+    if (OSRunning == OS_TRUE) {
+#if OS_TICK_STEP_EN > 0
+        if (OSTickStepState != OS_TICK_STEP_DIS) {         /* Return if stepping the tick                  */
+            return;
+        }
+#endif
+#if OS_TICK_LIST_EN > 0
+        OS_ENTER_CRITICAL();
+        ptcb = OSTickList;
+        while ((ptcb != (OS_TCB *)0) && (ptcb->OSTCBTickDelta <= ticks)) {
+            ticks                -= ptcb->OSTCBTickDelta;  /* Delay or timeout expired within the ticks    */
+            ptcb->OSTCBTickDelta  = 0;                     /* ... the next TCB counts from its timeout     */
+            OS_TickListRemove(ptcb);
+            OS_TimeTickRdy(ptcb);
+            OS_EXIT_CRITICAL();                            /* Allow interrupts between expired tasks       */
+            OS_ENTER_CRITICAL();
+            ptcb = OSTickList;
+        }
+        if (ptcb != (OS_TCB *)0) {
+            ptcb->OSTCBTickDelta -= (INT16U)ticks;         /* Only the first delayed TCB counts down       */
+        }
+        OS_EXIT_CRITICAL();
+#else
+        ptcb = OSTCBList;                                  /* Point at first TCB in TCB list               */
+        while (ptcb->OSTCBPrio != OS_TASK_IDLE_PRIO) {     /* Go through all TCBs in TCB list              */
+            OS_ENTER_CRITICAL();
+            if (ptcb->OSTCBDly != 0) {                     /* No, Delayed or waiting for event with TO     */
+                if (ptcb->OSTCBDly <= ticks) {             /* Delay expired within the ticks               */
+                    ptcb->OSTCBDly = 0;
+                    OS_TimeTickRdy(ptcb);
+                } else {
+                    ptcb->OSTCBDly -= (INT16U)ticks;
+                }
+            }
+            ptcb = ptcb->OSTCBNext;                        /* Point at next TCB in TCB list                */
+            OS_EXIT_CRITICAL();
+        }
+#endif
+    }
+}
+#endif
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                  MAKE TASK READY AFTER DELAY OR TIMEOUT
+*
+* Description: This function is called by OSTimeTick() when the delay or pend timeout of a task expires.
+*
+* Arguments  : ptcb      is a pointer to the TCB of the task whose delay has expired.
+*
+* Returns    : none
+*
+* Note       : This function assumes that interrupts are disabled.
+*********************************************************************************************************
+*/
+
+static  void  OS_TimeTickRdy (OS_TCB *ptcb)
+{
+                                                           /* Check for timeout                            */
+    if ((ptcb->OSTCBStat & OS_STAT_PEND_ANY) != OS_STAT_RDY) {
+        ptcb->OSTCBStat  &= ~(INT8U)OS_STAT_PEND_ANY;      /* Yes, Clear status flag                       */
+        ptcb->OSTCBStatPend = OS_STAT_PEND_TO;             /* Indicate PEND timeout                        */
+    } else {
+        ptcb->OSTCBStatPend = OS_STAT_PEND_OK;
+    }
+
+    if ((ptcb->OSTCBStat & OS_STAT_SUSPEND) == OS_STAT_RDY) {  /* Is task suspended?                       */
+        OSRdyGrp               |= ptcb->OSTCBBitY;             /* No,  Make ready                          */
+        OSRdyTbl[ptcb->OSTCBY] |= ptcb->OSTCBBitX;
     }
 }
 
@@ -992,32 +1186,14 @@ INT8U  OS_EventTaskRdy (OS_EVENT *pevent, void *pmsg, INT8U msk, INT8U pend_stat
     INT8U    y;
     INT8U    x;
     INT8U    prio;
-#if OS_LOWEST_PRIO > 63
-    INT16U  *ptbl;
-#endif
 
 
-#if OS_LOWEST_PRIO <= 63
-    y    = OSUnMapTbl[pevent->OSEventGrp];              /* Find HPT waiting for message                */
-    x    = OSUnMapTbl[pevent->OSEventTbl[y]];
-    prio = (INT8U)((y << 3) + x);                       /* Find priority of task getting the msg       */
-#else
-    if ((pevent->OSEventGrp & 0xFF) != 0) {             /* Find HPT waiting for message                */
-        y = OSUnMapTbl[ pevent->OSEventGrp & 0xFF];
-    } else {
-        y = OSUnMapTbl[(pevent->OSEventGrp >> 8) & 0xFF] + 8;
-    }
-    ptbl = &pevent->OSEventTbl[y];
-    if ((*ptbl & 0xFF) != 0) {
-        x = OSUnMapTbl[*ptbl & 0xFF];
-    } else {
-        x = OSUnMapTbl[(*ptbl >> 8) & 0xFF] + 8;
-    }
-    prio = (INT8U)((y << 4) + x);                       /* Find priority of task getting the msg       */
-#endif
+    y    = OS_PRIO_BIT(pevent->OSEventGrp);             /* Find HPT waiting for message                */
+    x    = OS_PRIO_BIT(pevent->OSEventTbl[y]);
+    prio = (INT8U)((y << OS_PRIO_MAP_SHIFT) + x);       /* Find priority of task getting the msg       */
 
     ptcb                  =  OSTCBPrioTbl[prio];        /* Point to this task's OS_TCB                 */
-    ptcb->OSTCBDly        =  0;                         /* Prevent OSTimeTick() from readying task     */
+    OS_TickListRemove(ptcb);                            /* Prevent OSTimeTick() from readying task     */
 #if ((OS_Q_EN > 0) && (OS_MAX_QS > 0)) || (OS_MBOX_EN > 0)
     ptcb->OSTCBMsg        =  pmsg;                      /* Send message directly to waiting task       */
 #else
@@ -1171,13 +1347,8 @@ void  OS_EventTaskRemoveMulti (OS_TCB    *ptcb,
     OS_EVENT **pevents;
     OS_EVENT  *pevent;
     INT8U      y;
-#if (OS_LOWEST_PRIO <= 63)
-    INT8U      bity;
-    INT8U      bitx;
-#else
-    INT16U     bity;
-    INT16U     bitx;
-#endif
+    OS_PRIO_MAP  bity;
+    OS_PRIO_MAP  bitx;
 
 
     y       =  ptcb->OSTCBY;
@@ -1212,12 +1383,8 @@ void  OS_EventTaskRemoveMulti (OS_TCB    *ptcb,
 #if (OS_EVENT_EN)
 void  OS_EventWaitListInit (OS_EVENT *pevent)
 {
-#if OS_LOWEST_PRIO <= 63
-    INT8U  *ptbl;
-#else
-    INT16U *ptbl;
-#endif
-    INT8U   i;
+    OS_PRIO_MAP  *ptbl;
+    INT8U         i;
 
 
     pevent->OSEventGrp = 0;                      /* No task waiting on event                           */
@@ -1312,6 +1479,11 @@ static  void  OS_InitMisc (void)
     OSCtxSwCtr    = 0;                                     /* Clear the context switch counter         */
     OSIdleCtr     = 0L;                                    /* Clear the 32-bit idle counter            */
 
+#if OS_TICKLESS_EN > 0
+    OSTickSuppressed = OS_FALSE;                           /* The tick runs                            */
+    OSTickCtr        = 0L;
+#endif
+
 #if OS_TASK_STAT_EN > 0
     OSIdleCtrRun  = 0L;
     OSIdleCtrMax  = 0L;
@@ -1334,12 +1506,8 @@ static  void  OS_InitMisc (void)
 
 static  void  OS_InitRdyList (void)
 {
-    INT8U    i;
-#if OS_LOWEST_PRIO <= 63
-    INT8U   *prdytbl;
-#else
-    INT16U  *prdytbl;
-#endif
+    INT8U         i;
+    OS_PRIO_MAP  *prdytbl;
 
 
     OSRdyGrp      = 0;                                     /* Clear the ready list                     */
@@ -1528,6 +1696,18 @@ static  void  OS_InitTCBList (void)
 #endif
     OSTCBList               = (OS_TCB *)0;                       /* TCB lists initializations          */
     OSTCBFreeList           = &OSTCBTbl[0];
+#if OS_TICK_LIST_EN > 0
+    OSTickList              = (OS_TCB *)0;                       /* No task is delayed                 */
+#endif
+#if OS_EDF_EN > 0
+    OSEDFList               = (OS_TCB *)0;                       /* No task is scheduled by deadline   */
+#endif
+#if OS_RR_EN > 0
+    OSRRList                = (OS_TCB *)0;                       /* No task shares the CPU in turns    */
+    OSRRListLast            = (OS_TCB *)0;
+    OSRRCur                 = (OS_TCB *)0;
+    OSRRTicks               = 0;
+#endif
 }
 /*$PAGE*/
 /*
@@ -1545,14 +1725,40 @@ static  void  OS_InitTCBList (void)
 * Notes      : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
 *              2) Note that we can only clear up to 64K bytes of RAM.  This is not an issue because none
 *                 of the uses of this function gets close to this limit.
-*              3) The clear is done one byte at a time since this will work on any processor irrespective
-*                 of the alignment of the destination.
+*              3) With OS_MEM_WORD_EN set, the bytes up to the first word boundary are cleared one at a
+*                 time, the words behind it four at a time, and the bytes past the last whole word one
+*                 at a time.  Otherwise the clear is done one byte at a time, which works on any
+*                 processor irrespective of the alignment of the destination.
 *********************************************************************************************************
 */
 
 void  OS_MemClr (INT8U *pdest, INT16U size)
 {
-    while (size > 0) {
+#if OS_MEM_WORD_EN > 0
+    INT32U  *pword;
+
+
+
+    while ((size > 0) && (((unsigned long)pdest & (sizeof(INT32U) - 1)) != 0)) {
+        *pdest++ = (INT8U)0;                           /* Clear the bytes up to a word boundary        */
+        size--;
+    }
+    pword = (INT32U *)pdest;
+    while (size >= 4 * sizeof(INT32U)) {               /* Clear four words at a time                   */
+        pword[0] = (INT32U)0;
+        pword[1] = (INT32U)0;
+        pword[2] = (INT32U)0;
+        pword[3] = (INT32U)0;
+        pword   += 4;
+        size    -= 4 * sizeof(INT32U);
+    }
+    while (size >= sizeof(INT32U)) {                   /* ... then the remaining words                 */
+        *pword++ = (INT32U)0;
+        size    -= sizeof(INT32U);
+    }
+    pdest = (INT8U *)pword;
+#endif
+    while (size > 0) {                                 /* ... and the remaining bytes                  */
         *pdest++ = (INT8U)0;
         size--;
     }
@@ -1577,14 +1783,47 @@ void  OS_MemClr (INT8U *pdest, INT16U size)
 *                 no provision to handle overlapping memory copy.  However, that's not a problem since this
 *                 is not a situation that will happen.
 *              2) Note that we can only copy up to 64K bytes of RAM
-*              3) The copy is done one byte at a time since this will work on any processor irrespective
-*                 of the alignment of the source and destination.
+*              3) With OS_MEM_WORD_EN set, and when the source and the destination are as far from a
+*                 word boundary, the bytes up to the boundary are copied one at a time, the words behind
+*                 it four at a time, and the bytes past the last whole word one at a time.  Otherwise
+*                 the copy is done one byte at a time, which works on any processor irrespective of the
+*                 alignment of the source and destination.
 *********************************************************************************************************
 */
 
 void  OS_MemCopy (INT8U *pdest, INT8U *psrc, INT16U size)
 {
-    while (size > 0) {
+#if OS_MEM_WORD_EN > 0
+    INT32U  *pdword;
+    INT32U  *psword;
+
+
+
+    if ((((unsigned long)pdest ^ (unsigned long)psrc) & (sizeof(INT32U) - 1)) == 0) {
+        while ((size > 0) && (((unsigned long)pdest & (sizeof(INT32U) - 1)) != 0)) {
+            *pdest++ = *psrc++;                        /* Copy the bytes up to a word boundary         */
+            size--;
+        }
+        pdword = (INT32U *)pdest;
+        psword = (INT32U *)psrc;
+        while (size >= 4 * sizeof(INT32U)) {           /* Copy four words at a time                    */
+            pdword[0] = psword[0];
+            pdword[1] = psword[1];
+            pdword[2] = psword[2];
+            pdword[3] = psword[3];
+            pdword   += 4;
+            psword   += 4;
+            size     -= 4 * sizeof(INT32U);
+        }
+        while (size >= sizeof(INT32U)) {               /* ... then the remaining words                 */
+            *pdword++ = *psword++;
+            size     -= sizeof(INT32U);
+        }
+        pdest = (INT8U *)pdword;
+        psrc  = (INT8U *)psword;
+    }
+#endif
+    while (size > 0) {                                 /* ... and the remaining bytes                  */
         *pdest++ = *psrc++;
         size--;
     }
@@ -1592,6 +1831,56 @@ void  OS_MemCopy (INT8U *pdest, INT8U *psrc, INT16U size)
 /*$PAGE*/
 /*
 *********************************************************************************************************
+*                                        COUNT TRAILING ZEROS
+*
+* Description: This function returns the number of zero bits below the lowest bit set in a 32-bit word:
+*              in a word of a ready or wait list, the highest priority of the word.  It is used when the
+*              port has no instruction for it (OS_CPU_CTZ()), as on the Nios II, and halves the word five
+*              times instead of looking the bytes up in OSUnMapTbl[], which takes the same time for any
+*              word.
+*
+* Arguments  : word     is the word, which must not be 0.
+*
+* Returns    : the position of the lowest bit set, 0 to 31.
+*
+* Note       : This function is INTERNAL to uC/OS-II and your application should not call it.  The HAL
+*              finds the pending interrupt with it too (ALT_OS_CTZ() in os/alt_hooks.h), so it is built
+*              even without OS_PRIO_BITSCAN_EN.
+*********************************************************************************************************
+*/
+
+#ifndef OS_CPU_CTZ
+INT8U  OS_PrioCtz (INT32U word)
+{
+    INT8U  n;
+
+
+    n = 0;
+    if ((word & 0x0000FFFFL) == 0) {
+        word >>= 16;
+        n     += 16;
+    }
+    if ((word & 0x000000FFL) == 0) {
+        word >>= 8;
+        n     += 8;
+    }
+    if ((word & 0x0000000FL) == 0) {
+        word >>= 4;
+        n     += 4;
+    }
+    if ((word & 0x00000003L) == 0) {
+        word >>= 2;
+        n     += 2;
+    }
+    if ((word & 0x00000001L) == 0) {
+        n     += 1;
+    }
+    return (n);
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
 *                                              SCHEDULER
 *
 * Description: This function is called by other uC/OS-II services to determine whether a new, high
@@ -1640,6 +1929,18 @@ void  OS_Sched (void)
 * Description: This function is called by other uC/OS-II services to determine the highest priority task
 *              that is ready to run.  The global variable 'OSPrioHighRdy' is changed accordingly.
 *
+*              With OS_EDF_EN, when the highest priority ready to run lies in the band OS_EDF_PRIO_HI to
+*              OS_EDF_PRIO_LO, the periodic task of the band with the earliest deadline that is ready to
+*              run is chosen instead.  Tasks above the band still preempt it and tasks below it only run
+*              when no task of the band is ready.  Tasks of the band that are not periodic have no
+*              deadline: they only run, by priority, when no periodic task of the band is ready.
+*
+*              With OS_RR_EN, the tasks of the band OS_RR_PRIO_HI to OS_RR_PRIO_LO share the CPU as if
+*              they had the same priority.  The task holding the time slice (OSRRCur) keeps running
+*              until it blocks or OSTimeTick() finds its slice used up, and is then put at the end of
+*              the FIFO of the band (OSRRList).  The first ready task of the FIFO gets the next slice.
+*              A task preempted by a task above the band keeps the rest of its slice.
+*
 * Arguments  : none
 *
 * Returns    : none
@@ -1651,27 +1952,43 @@ void  OS_Sched (void)
 
 static  void  OS_SchedNew (void)
 {
-#if OS_LOWEST_PRIO <= 63                         /* See if we support up to 64 tasks                   */
-    INT8U   y;
-
-
-    y             = OSUnMapTbl[OSRdyGrp];
-    OSPrioHighRdy = (INT8U)((y << 3) + OSUnMapTbl[OSRdyTbl[y]]);
-#else                                            /* We support up to 256 tasks                         */
+#if (OS_EDF_EN > 0) || (OS_RR_EN > 0)
+    OS_TCB *ptcb;
+#endif
     INT8U   y;
-    INT16U *ptbl;
 
 
-    if ((OSRdyGrp & 0xFF) != 0) {
-        y = OSUnMapTbl[OSRdyGrp & 0xFF];
-    } else {
-        y = OSUnMapTbl[(OSRdyGrp >> 8) & 0xFF] + 8;
+    y             = OS_PRIO_BIT(OSRdyGrp);       /* Word holding the highest priority ready task       */
+    OSPrioHighRdy = (INT8U)((y << OS_PRIO_MAP_SHIFT) + OS_PRIO_BIT(OSRdyTbl[y]));
+#if OS_EDF_EN > 0
+    if ((OSPrioHighRdy >= OS_EDF_PRIO_HI) && (OSPrioHighRdy <= OS_EDF_PRIO_LO)) {
+        ptcb = OSEDFList;                        /* Earliest deadline first, skip the blocked tasks    */
+        while (ptcb != (OS_TCB *)0) {
+            if ((OSRdyTbl[ptcb->OSTCBY] & ptcb->OSTCBBitX) != 0) {
+                OSPrioHighRdy = ptcb->OSTCBPrio;
+                break;
+            }
+            ptcb = ptcb->OSTCBEDFNext;
+        }
     }
-    ptbl = &OSRdyTbl[y];
-    if ((*ptbl & 0xFF) != 0) {
-        OSPrioHighRdy = (INT8U)((y << 4) + OSUnMapTbl[(*ptbl & 0xFF)]);
-    } else {
-        OSPrioHighRdy = (INT8U)((y << 4) + OSUnMapTbl[(*ptbl >> 8) & 0xFF] + 8);
+#endif
+#if OS_RR_EN > 0
+    if ((OSPrioHighRdy >= OS_RR_PRIO_HI) && (OSPrioHighRdy <= OS_RR_PRIO_LO)) {
+        ptcb = OSRRCur;                          /* The task holding the slice keeps running ...       */
+        if ((ptcb == (OS_TCB *)0) || ((OSRdyTbl[ptcb->OSTCBY] & ptcb->OSTCBBitX) == 0)) {
+            if (ptcb != (OS_TCB *)0) {           /* ... unless it blocked: it waits for its next turn  */
+                OS_RRInsert(ptcb);
+            }
+            ptcb = OSRRList;                     /* First ready task in turn gets a new slice          */
+            while ((ptcb != (OS_TCB *)0) && ((OSRdyTbl[ptcb->OSTCBY] & ptcb->OSTCBBitX) == 0)) {
+                ptcb = ptcb->OSTCBRRNext;
+            }
+            OSRRCur   = ptcb;
+            OSRRTicks = OS_RR_QUANTUM;
+        }
+        if (ptcb != (OS_TCB *)0) {               /* Not in the FIFO if raised into the band by a PIP   */
+            OSPrioHighRdy = ptcb->OSTCBPrio;
+        }
     }
 #endif
 }
@@ -1761,6 +2078,8 @@ INT8U  OS_StrLen (INT8U *psrc)
 *                 interrupts.
 *              2) This hook has been added to allow you to do such things as STOP the CPU to conserve
 *                 power.
+*              3) With OS_TICKLESS_EN, the tick is stopped until the next delay or timeout expires, so
+*                 that an idle CPU is not interrupted at OS_TICKS_PER_SEC (see OS_TickSuppress()).
 *********************************************************************************************************
 */
 
@@ -1776,10 +2095,54 @@ void  OS_TaskIdle (void *p_arg)
     for (;;) {
         OS_ENTER_CRITICAL();
         OSIdleCtr++;
+#if OS_TICKLESS_EN > 0
+        OS_TickSuppress();                       /* Stop the tick until there is work for it           */
+#endif
         OS_EXIT_CRITICAL();
         OSTaskIdleHook();                        /* Call user definable HOOK                           */
     }
 }
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                           STOP THE TICK
+*
+* Description: This function is called by the idle task to stop the tick until the first delay or pend
+*              timeout expires.  The port shortens the time to the next tick it has work for itself (the
+*              timer task, the alarms of the HAL) and programs the timer, or declines.  The next
+*              interrupt, be it that of the timer or any other, restarts the tick in OSIntEnter().
+*
+* Arguments  : none
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function assumes that interrupts are disabled.
+*              2) The tick is not stopped while uC/OS-View steps it.
+*********************************************************************************************************
+*/
+
+#if OS_TICKLESS_EN > 0
+static  void  OS_TickSuppress (void)
+{
+    INT16U  ticks;
+
+
+    if (OSTickSuppressed == OS_TRUE) {           /* Stopped already, until the next interrupt          */
+        return;
+    }
+#if OS_TICK_STEP_EN > 0
+    if (OSTickStepState != OS_TICK_STEP_DIS) {
+        return;
+    }
+#endif
+    ticks = OS_TickListNext();
+    if (ticks == 1) {                            /* A delay expires at the next tick anyway            */
+        return;
+    }
+    OSTickSuppressed = OSTickSuppressHook((ticks == 0) ? 0xFFFFFFFFL : (INT32U)ticks);
+}
+#endif
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -1793,6 +2156,13 @@ void  OS_TaskIdle (void *p_arg)
 *                 OSCPUUsage = 100 * (1 - ------------)     (units are in %)
 *                                         OSIdleCtrMax
 *
+*              or, with OS_TASK_STAT_CYCLES_EN set, from the cycles the idle task ran in the last period
+*              of the statistics task:
+*
+*                                         idle cycles
+*                 OSCPUUsage = 100 * (1 - ------------)     (units are in %)
+*                                         all cycles
+*
 * Arguments  : parg     this pointer is not used at this time.
 *
 * Returns    : none
@@ -1811,6 +2181,15 @@ void  OS_TaskStat (void *p_arg)
 #if OS_CRITICAL_METHOD == 3                      /* Allocate storage for CPU status register           */
     OS_CPU_SR  cpu_sr = 0;
 #endif
+#if OS_TASK_STAT_CYCLES_EN > 0
+    OS_TCB    *pidle;
+    INT32U     cycles;
+    INT32U     cycles_prev;
+    INT32U     idle;
+    INT32U     idle_prev;
+    INT32U     pct;
+    INT32U     idle_pct;
+#endif
 
 
 
@@ -1818,6 +2197,29 @@ void  OS_TaskStat (void *p_arg)
     while (OSStatRdy == OS_FALSE) {
         OSTimeDly(2 * OS_TICKS_PER_SEC / 10);    /* Wait until statistic task is ready                 */
     }
+#if OS_TASK_STAT_CYCLES_EN > 0
+    pidle       = OSTCBPrioTbl[OS_TASK_IDLE_PRIO];
+    OS_ENTER_CRITICAL();
+    cycles_prev = OSCPUCyclesGet();
+    idle_prev   = pidle->OSTCBCyclesTot;         /* The idle task is not running, its total is exact   */
+    OS_EXIT_CRITICAL();
+    for (;;) {
+        OSTimeDly(OS_TICKS_PER_SEC / 10);        /* Accumulate idle cycles for the next 1/10 second    */
+        OS_ENTER_CRITICAL();
+        cycles      = OSCPUCyclesGet();
+        idle        = pidle->OSTCBCyclesTot;
+        OS_EXIT_CRITICAL();
+        pct         = (cycles - cycles_prev) / 100L; /* Cycles per percent                             */
+        idle_pct    = (pct > 0L) ? (idle - idle_prev) / pct : 100L;
+        OSCPUUsage  = (INT8U)((idle_pct < 100L) ? (100L - idle_pct) : 0L);
+        cycles_prev = cycles;
+        idle_prev   = idle;
+        OSTaskStatHook();                        /* Invoke user definable hook                         */
+#if (OS_TASK_STAT_STK_CHK_EN > 0) && (OS_TASK_CREATE_EXT_EN > 0)
+        OS_TaskStatStkChk();                     /* Check the stacks for each task                     */
+#endif
+    }
+#else
     OSIdleCtrMax /= 100L;
     if (OSIdleCtrMax == 0L) {
         OSCPUUsage = 0;
@@ -1835,6 +2237,7 @@ void  OS_TaskStat (void *p_arg)
 #endif
         OSTimeDly(OS_TICKS_PER_SEC / 10);        /* Accumulate OSIdleCtr for the next 1/10 second      */
     }
+#endif
 }
 #endif
 /*$PAGE*/
@@ -1937,11 +2340,13 @@ INT8U  OS_TCBInit (INT8U prio, OS_STK *ptos, OS_STK *pbos, INT16U id, INT32U stk
     if (ptcb != (OS_TCB *)0) {
         OSTCBFreeList            = ptcb->OSTCBNext;        /* Update pointer to free TCB list          */
         OS_EXIT_CRITICAL();
+        OS_MemClr((INT8U *)ptcb, sizeof(OS_TCB));          /* Clear the TCB: the task is not delayed,  */
+                                                           /* ... not pending and in no list, and its  */
+                                                           /* ... counters and pointers are 0          */
         ptcb->OSTCBStkPtr        = ptos;                   /* Load Stack pointer in TCB                */
         ptcb->OSTCBPrio          = prio;                   /* Load task priority into TCB              */
         ptcb->OSTCBStat          = OS_STAT_RDY;            /* Task is ready to run                     */
         ptcb->OSTCBStatPend      = OS_STAT_PEND_OK;        /* Clear pend status                        */
-        ptcb->OSTCBDly           = 0;                      /* Task is not delayed                      */
 
 #if OS_TASK_CREATE_EXT_EN > 0
         ptcb->OSTCBExtPtr        = pext;                   /* Store pointer to TCB extension           */
@@ -1961,40 +2366,10 @@ INT8U  OS_TCBInit (INT8U prio, OS_STK *ptos, OS_STK *pbos, INT16U id, INT32U stk
         ptcb->OSTCBDelReq        = OS_ERR_NONE;
 #endif
 
-#if OS_LOWEST_PRIO <= 63
-        ptcb->OSTCBY             = (INT8U)(prio >> 3);          /* Pre-compute X, Y, BitX and BitY     */
-        ptcb->OSTCBX             = (INT8U)(prio & 0x07);
-        ptcb->OSTCBBitY          = (INT8U)(1 << ptcb->OSTCBY);
-        ptcb->OSTCBBitX          = (INT8U)(1 << ptcb->OSTCBX);
-#else
-        ptcb->OSTCBY             = (INT8U)((prio >> 4) & 0xFF); /* Pre-compute X, Y, BitX and BitY     */
-        ptcb->OSTCBX             = (INT8U) (prio & 0x0F);
-        ptcb->OSTCBBitY          = (INT16U)(1 << ptcb->OSTCBY);
-        ptcb->OSTCBBitX          = (INT16U)(1 << ptcb->OSTCBX);
-#endif
-
-#if (OS_EVENT_EN)
-        ptcb->OSTCBEventPtr      = (OS_EVENT  *)0;         /* Task is not pending on an  event         */
-#if (OS_EVENT_MULTI_EN > 0)
-        ptcb->OSTCBEventMultiPtr = (OS_EVENT **)0;         /* Task is not pending on any events        */
-#endif
-#endif
-
-#if (OS_FLAG_EN > 0) && (OS_MAX_FLAGS > 0) && (OS_TASK_DEL_EN > 0)
-        ptcb->OSTCBFlagNode  = (OS_FLAG_NODE *)0;          /* Task is not pending on an event flag     */
-#endif
-
-#if (OS_MBOX_EN > 0) || ((OS_Q_EN > 0) && (OS_MAX_QS > 0))
-        ptcb->OSTCBMsg       = (void *)0;                  /* No message received                      */
-#endif
-
-#if OS_TASK_PROFILE_EN > 0
-        ptcb->OSTCBCtxSwCtr    = 0L;                       /* Initialize profiling variables           */
-        ptcb->OSTCBCyclesStart = 0L;
-        ptcb->OSTCBCyclesTot   = 0L;
-        ptcb->OSTCBStkBase     = (OS_STK *)0;
-        ptcb->OSTCBStkUsed     = 0L;
-#endif
+        ptcb->OSTCBY             = (INT8U)(prio >> OS_PRIO_MAP_SHIFT);  /* Pre-compute X, Y, BitX ...  */
+        ptcb->OSTCBX             = (INT8U)(prio &  OS_PRIO_MAP_MASK);   /* ... and BitY                */
+        ptcb->OSTCBBitY          = (OS_PRIO_MAP)((OS_PRIO_MAP)1 << ptcb->OSTCBY);
+        ptcb->OSTCBBitX          = (OS_PRIO_MAP)((OS_PRIO_MAP)1 << ptcb->OSTCBX);
 
 #if OS_TASK_NAME_SIZE > 1
         ptcb->OSTCBTaskName[0] = '?';                      /* Unknown name at task creation            */
@@ -2015,6 +2390,9 @@ INT8U  OS_TCBInit (INT8U prio, OS_STK *ptos, OS_STK *pbos, INT16U id, INT32U stk
         OSTCBList               = ptcb;
         OSRdyGrp               |= ptcb->OSTCBBitY;         /* Make task ready to run                   */
         OSRdyTbl[ptcb->OSTCBY] |= ptcb->OSTCBBitX;
+#if OS_RR_EN > 0
+        OS_RRInsert(ptcb);                                 /* Last in turn if in the round-robin band  */
+#endif
         OSTaskCtr++;                                       /* Increment the #tasks counter             */
         OS_EXIT_CRITICAL();
         return (OS_ERR_NONE);
@@ -2022,3 +2400,333 @@ INT8U  OS_TCBInit (INT8U prio, OS_STK *ptos, OS_STK *pbos, INT16U id, INT32U stk
     OS_EXIT_CRITICAL();
     return (OS_ERR_TASK_NO_MORE_TCB);
 }
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                      INSERT A TASK IN THE TICK LIST
+*
+* Description: This function is called to delay a task, or to start its pend timeout, for 'ticks' clock
+*              ticks.  When OS_TICK_LIST_EN is enabled the TCB is linked into OSTickList, which is kept
+*              sorted by timeout.  Each TCB only holds the number of ticks between the timeout of the
+*              TCB before it and its own (OSTCBTickDelta), so OSTimeTick() only needs to decrement the
+*              first entry and to remove the entries that reach 0.
+*
+* Arguments  : ptcb      is a pointer to the TCB of the task to delay.  The task must not already be in
+*                        the tick list.
+*
+*              ticks     is the number of clock ticks to wait.  0 means that the task waits forever and
+*                        is not inserted.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function assumes that interrupts are disabled.
+*              2) OSTCBDly keeps the number of ticks that were requested; it is only non-zero while the
+*                 TCB is in the tick list.
+*              3) Tasks with the same timeout are kept in insertion order.
+*              4) This function is INTERNAL to uC/OS-II and your application should not call it.
+*********************************************************************************************************
+*/
+
+void  OS_TickListInsert (OS_TCB *ptcb, INT16U ticks)
+{
+#if OS_TICK_LIST_EN > 0
+    OS_TCB  *pprev;
+    OS_TCB  *pnext;
+
+
+    ptcb->OSTCBDly = ticks;
+    if (ticks == 0) {                                      /* Wait forever, no timeout to track            */
+        return;
+    }
+    pprev = (OS_TCB *)0;
+    pnext = OSTickList;
+    while ((pnext != (OS_TCB *)0) && (pnext->OSTCBTickDelta <= ticks)) {
+        ticks -= pnext->OSTCBTickDelta;                    /* Find first TCB that times out later          */
+        pprev  = pnext;
+        pnext  = pnext->OSTCBTickNext;
+    }
+    ptcb->OSTCBTickDelta = ticks;
+    ptcb->OSTCBTickPrev  = pprev;
+    ptcb->OSTCBTickNext  = pnext;
+    if (pnext != (OS_TCB *)0) {
+        pnext->OSTCBTickDelta -= ticks;                    /* Next TCB now counts from this one            */
+        pnext->OSTCBTickPrev   = ptcb;
+    }
+    if (pprev != (OS_TCB *)0) {
+        pprev->OSTCBTickNext = ptcb;
+    } else {
+        OSTickList           = ptcb;
+    }
+#else
+    ptcb->OSTCBDly = ticks;
+#endif
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                     REMOVE A TASK FROM THE TICK LIST
+*
+* Description: This function is called when a delayed task is readied before (or when) its delay or pend
+*              timeout expires, or when it is deleted.
+*
+* Arguments  : ptcb      is a pointer to the TCB of the task.  Nothing is done if the task is not delayed.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function assumes that interrupts are disabled.
+*              2) This function is INTERNAL to uC/OS-II and your application should not call it.
+*********************************************************************************************************
+*/
+
+void  OS_TickListRemove (OS_TCB *ptcb)
+{
+#if OS_TICK_LIST_EN > 0
+    OS_TCB  *pprev;
+    OS_TCB  *pnext;
+
+
+    if (ptcb->OSTCBDly == 0) {                             /* See if task is in the tick list              */
+        return;
+    }
+    pprev = ptcb->OSTCBTickPrev;
+    pnext = ptcb->OSTCBTickNext;
+    if (pnext != (OS_TCB *)0) {
+        pnext->OSTCBTickDelta += ptcb->OSTCBTickDelta;     /* Next TCB keeps the same timeout              */
+        pnext->OSTCBTickPrev   = pprev;
+    }
+    if (pprev != (OS_TCB *)0) {
+        pprev->OSTCBTickNext = pnext;
+    } else {
+        OSTickList           = pnext;
+    }
+    ptcb->OSTCBTickNext  = (OS_TCB *)0;
+    ptcb->OSTCBTickPrev  = (OS_TCB *)0;
+    ptcb->OSTCBTickDelta = 0;
+#endif
+    ptcb->OSTCBDly       = 0;
+}
+
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                  TICKS UNTIL THE FIRST DELAY EXPIRES
+*
+* Description: This function is called by the idle task to find for how long it can stop the tick.
+*
+* Arguments  : none
+*
+* Returns    : The number of ticks until the first delay or pend timeout expires, 1 meaning at the next
+*              tick, or 0 if no task is delayed.
+*
+* Note(s)    : 1) This function assumes that interrupts are disabled.
+*              2) This function is INTERNAL to uC/OS-II and your application should not call it.
+*********************************************************************************************************
+*/
+
+#if OS_TICKLESS_EN > 0
+INT16U  OS_TickListNext (void)
+{
+#if OS_TICK_LIST_EN > 0
+    if (OSTickList == (OS_TCB *)0) {
+        return (0);
+    }
+    return (OSTickList->OSTCBTickDelta);                   /* The first TCB counts from the current tick   */
+#else
+    OS_TCB  *ptcb;
+    INT16U   next;
+
+
+    next = 0;
+    ptcb = OSTCBList;
+    while (ptcb->OSTCBPrio != OS_TASK_IDLE_PRIO) {
+        if ((ptcb->OSTCBDly != 0) && ((next == 0) || (ptcb->OSTCBDly < next))) {
+            next = ptcb->OSTCBDly;
+        }
+        ptcb = ptcb->OSTCBNext;
+    }
+    return (next);
+#endif
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                  INSERT A TASK IN THE EDF LIST
+*
+* Description: This function is called when a periodic task is created or when its deadline changes.  If
+*              the priority of the task lies in the band OS_EDF_PRIO_HI to OS_EDF_PRIO_LO, the TCB is
+*              linked into OSEDFList, which OS_SchedNew() walks to find the task of the band with the
+*              earliest deadline.  The deadline of the current job is its release plus the period.
+*
+* Arguments  : ptcb      is a pointer to the TCB of the periodic task.  If it is already in the list, it is
+*                        moved to the place of its new deadline.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function assumes that interrupts are disabled.
+*              2) The list is sorted by deadline, then by priority.  Deadlines are compared by their
+*                 distance, so that they may wrap around with OSTime.
+*              3) This function is INTERNAL to uC/OS-II and your application should not call it.
+*********************************************************************************************************
+*/
+
+#if OS_EDF_EN > 0
+void  OS_EDFInsert (OS_TCB *ptcb)
+{
+    OS_TCB  *pprev;
+    OS_TCB  *pnext;
+    INT32S   diff;
+
+
+    OS_EDFRemove(ptcb);
+    if ((ptcb->OSTCBPrio < OS_EDF_PRIO_HI) || (ptcb->OSTCBPrio > OS_EDF_PRIO_LO)) {
+        return;                                            /* Scheduled by priority only               */
+    }
+    ptcb->OSTCBDeadline = ptcb->OSTCBRelease + ptcb->OSTCBPeriod;
+    pprev = (OS_TCB *)0;
+    pnext = OSEDFList;
+    while (pnext != (OS_TCB *)0) {                         /* Find first TCB with a later deadline     */
+        diff = (INT32S)(pnext->OSTCBDeadline - ptcb->OSTCBDeadline);
+        if ((diff > 0) || ((diff == 0) && (pnext->OSTCBPrio > ptcb->OSTCBPrio))) {
+            break;
+        }
+        pprev = pnext;
+        pnext = pnext->OSTCBEDFNext;
+    }
+    ptcb->OSTCBEDFPrev = pprev;
+    ptcb->OSTCBEDFNext = pnext;
+    if (pnext != (OS_TCB *)0) {
+        pnext->OSTCBEDFPrev = ptcb;
+    }
+    if (pprev != (OS_TCB *)0) {
+        pprev->OSTCBEDFNext = ptcb;
+    } else {
+        OSEDFList           = ptcb;
+    }
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                  REMOVE A TASK FROM THE EDF LIST
+*
+* Description: This function is called when a periodic task is deleted or changes priority.
+*
+* Arguments  : ptcb      is a pointer to the TCB of the task.  Nothing is done if the task is not in the
+*                        list.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function assumes that interrupts are disabled.
+*              2) This function is INTERNAL to uC/OS-II and your application should not call it.
+*********************************************************************************************************
+*/
+
+#if OS_EDF_EN > 0
+void  OS_EDFRemove (OS_TCB *ptcb)
+{
+    OS_TCB  *pprev;
+    OS_TCB  *pnext;
+
+
+    pprev = ptcb->OSTCBEDFPrev;
+    pnext = ptcb->OSTCBEDFNext;
+    if ((pprev == (OS_TCB *)0) && (OSEDFList != ptcb)) {   /* See if task is in the EDF list           */
+        return;
+    }
+    if (pnext != (OS_TCB *)0) {
+        pnext->OSTCBEDFPrev = pprev;
+    }
+    if (pprev != (OS_TCB *)0) {
+        pprev->OSTCBEDFNext = pnext;
+    } else {
+        OSEDFList           = pnext;
+    }
+    ptcb->OSTCBEDFNext = (OS_TCB *)0;
+    ptcb->OSTCBEDFPrev = (OS_TCB *)0;
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                              PUT A TASK AT THE END OF THE ROUND-ROBIN FIFO
+*
+* Description: This function is called when a task is created or changes priority, and when a task of
+*              the round-robin band has used up its time slice or has blocked.  If the priority of the
+*              task lies in the band OS_RR_PRIO_HI to OS_RR_PRIO_LO, the TCB is linked at the end of
+*              OSRRList, so that every other ready task of the band runs before it again.
+*
+* Arguments  : ptcb      is a pointer to the TCB of the task.  If it is already in the FIFO, it is moved to
+*                        the end and loses its time slice.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function assumes that interrupts are disabled.
+*              2) This function is INTERNAL to uC/OS-II and your application should not call it.
+*********************************************************************************************************
+*/
+
+#if OS_RR_EN > 0
+void  OS_RRInsert (OS_TCB *ptcb)
+{
+    OS_RRRemove(ptcb);
+    if ((ptcb->OSTCBPrio < OS_RR_PRIO_HI) || (ptcb->OSTCBPrio > OS_RR_PRIO_LO)) {
+        return;                                            /* Scheduled by priority only               */
+    }
+    ptcb->OSTCBRRPrev = OSRRListLast;
+    ptcb->OSTCBRRNext = (OS_TCB *)0;
+    if (OSRRListLast != (OS_TCB *)0) {
+        OSRRListLast->OSTCBRRNext = ptcb;
+    } else {
+        OSRRList                  = ptcb;
+    }
+    OSRRListLast = ptcb;
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                REMOVE A TASK FROM THE ROUND-ROBIN FIFO
+*
+* Description: This function is called when a task is deleted or changes priority.
+*
+* Arguments  : ptcb      is a pointer to the TCB of the task.  Nothing is done if the task is not in the
+*                        FIFO.  If it holds the time slice, the slice ends.
+*
+* Returns    : none
+*
+* Note(s)    : 1) This function assumes that interrupts are disabled.
+*              2) This function is INTERNAL to uC/OS-II and your application should not call it.
+*********************************************************************************************************
+*/
+
+#if OS_RR_EN > 0
+void  OS_RRRemove (OS_TCB *ptcb)
+{
+    OS_TCB  *pprev;
+    OS_TCB  *pnext;
+
+
+    if (OSRRCur == ptcb) {
+        OSRRCur = (OS_TCB *)0;
+    }
+    pprev = ptcb->OSTCBRRPrev;
+    pnext = ptcb->OSTCBRRNext;
+    if ((pprev == (OS_TCB *)0) && (OSRRList != ptcb)) {    /* See if task is in the FIFO               */
+        return;
+    }
+    if (pnext != (OS_TCB *)0) {
+        pnext->OSTCBRRPrev = pprev;
+    } else {
+        OSRRListLast       = pprev;
+    }
+    if (pprev != (OS_TCB *)0) {
+        pprev->OSTCBRRNext = pnext;
+    } else {
+        OSRRList           = pnext;
+    }
+    ptcb->OSTCBRRNext = (OS_TCB *)0;
+    ptcb->OSTCBRRPrev = (OS_TCB *)0;
+}
+#endif
@@ -35,6 +35,18 @@ INT16U  const  OSDebugEn           = OS_DEBUG_EN;               /* Debug constan
 
 INT32U  const  OSEndiannessTest    = 0x12345678L;               /* Variable to test CPU endianness     */
 
+INT16U  const  OSChanEn            = OS_CHAN_EN;
+INT16U  const  OSChanMax           = OS_MAX_CHANS;              /* Number of state channels            */
+#if (OS_CHAN_EN > 0) && (OS_MAX_CHANS > 0)
+INT16U  const  OSChanSize          = sizeof(OS_CHAN);           /* Size in Bytes of OS_CHAN            */
+INT16U  const  OSChanTblSize       = sizeof(OSChanTbl);
+#else
+INT16U  const  OSChanSize          = 0;
+INT16U  const  OSChanTblSize       = 0;
+#endif
+
+INT16U  const  OSEDFEn             = OS_EDF_EN;
+
 INT16U  const  OSEventEn           = OS_EVENT_EN;
 INT16U  const  OSEventMax          = OS_MAX_EVENTS;             /* Number of event control blocks      */
 INT16U  const  OSEventNameSize     = OS_EVENT_NAME_SIZE;        /* Size (in bytes) of event names      */
@@ -61,8 +73,28 @@ INT16U  const  OSFlagWidth         = 0;
 INT16U  const  OSFlagMax           = OS_MAX_FLAGS;
 INT16U  const  OSFlagNameSize      = OS_FLAG_NAME_SIZE;         /* Size (in bytes) of flag names       */
 
+INT16U  const  OSLogEn             = OS_LOG_EN;
+INT16U  const  OSLogMax            = OS_MAX_LOGS;               /* Number of logs                      */
+#if (OS_LOG_EN > 0) && (OS_MAX_LOGS > 0)
+INT16U  const  OSLogSize           = sizeof(OS_LOG);            /* Size in Bytes of OS_LOG             */
+INT16U  const  OSLogTblSize        = sizeof(OSLogTbl);
+#else
+INT16U  const  OSLogSize           = 0;
+INT16U  const  OSLogTblSize        = 0;
+#endif
+
 INT16U  const  OSLowestPrio        = OS_LOWEST_PRIO;
 
+INT16U  const  OSRingEn            = OS_RING_EN;
+INT16U  const  OSRingMax           = OS_MAX_RINGS;              /* Number of rings                     */
+#if (OS_RING_EN > 0) && (OS_MAX_RINGS > 0)
+INT16U  const  OSRingSize          = sizeof(OS_RING);           /* Size in Bytes of OS_RING            */
+INT16U  const  OSRingTblSize       = sizeof(OSRingTbl);
+#else
+INT16U  const  OSRingSize          = 0;
+INT16U  const  OSRingTblSize       = 0;
+#endif
+
 INT16U  const  OSMboxEn            = OS_MBOX_EN;
 
 INT16U  const  OSMemEn             = OS_MEM_EN;
@@ -75,6 +107,9 @@ INT16U  const  OSMemTblSize        = sizeof(OSMemTbl);
 INT16U  const  OSMemSize           = 0;
 INT16U  const  OSMemTblSize        = 0;
 #endif
+INT16U  const  OSMemClassEn        = OS_MEM_CLASS_EN;
+INT16U  const  OSMemClassMax       = OS_MEM_CLASS_MAX;          /* Number of size classes              */
+INT16U  const  OSMemMagSize        = OS_MEM_MAG_SIZE;           /* Blocks per class in a magazine      */
 INT16U  const  OSMutexEn           = OS_MUTEX_EN;
 
 INT16U  const  OSPtrSize           = sizeof(void *);            /* Size in Bytes of a pointer          */
@@ -87,7 +122,10 @@ INT16U  const  OSQSize             = sizeof(OS_Q);              /* Size in bytes
 INT16U  const  OSQSize             = 0;
 #endif
 
-INT16U  const  OSRdyTblSize        = OS_RDY_TBL_SIZE;           /* Number of bytes in the ready table  */
+INT16U  const  OSRREn              = OS_RR_EN;
+INT16U  const  OSRRQuantum         = OS_RR_QUANTUM;
+
+INT16U  const  OSRdyTblSize        = sizeof(OSRdyTbl);          /* Number of bytes in the ready table  */
 
 INT16U  const  OSSemEn             = OS_SEM_EN;
 
@@ -100,6 +138,8 @@ INT16U  const  OSTaskIdleStkSize   = OS_TASK_IDLE_STK_SIZE;
 INT16U  const  OSTaskProfileEn     = OS_TASK_PROFILE_EN;
 INT16U  const  OSTaskMax           = OS_MAX_TASKS + OS_N_SYS_TASKS; /* Total max. number of tasks      */
 INT16U  const  OSTaskNameSize      = OS_TASK_NAME_SIZE;             /* Size (in bytes) of task names   */
+INT16U  const  OSTaskNotifyEn      = OS_TASK_NOTIFY_EN;
+INT16U  const  OSTaskPeriodicEn    = OS_TASK_PERIODIC_EN;
 INT16U  const  OSTaskStatEn        = OS_TASK_STAT_EN;
 INT16U  const  OSTaskStatStkSize   = OS_TASK_STAT_STK_SIZE;
 INT16U  const  OSTaskStatStkChkEn  = OS_TASK_STAT_STK_CHK_EN;
@@ -115,6 +155,7 @@ INT16U  const  OSTmrEn             = OS_TMR_EN;
 INT16U  const  OSTmrCfgMax         = OS_TMR_CFG_MAX;
 INT16U  const  OSTmrCfgNameSize    = OS_TMR_CFG_NAME_SIZE;
 INT16U  const  OSTmrCfgWheelSize   = OS_TMR_CFG_WHEEL_SIZE;
+INT16U  const  OSTmrCfgStatEn      = OS_TMR_CFG_STAT_EN;
 INT16U  const  OSTmrCfgTicksPerSec = OS_TMR_CFG_TICKS_PER_SEC;
 
 #if (OS_TMR_EN > 0) && (OS_TMR_CFG_MAX > 0)
@@ -129,6 +170,14 @@ INT16U  const  OSTmrWheelSize      = 0;
 INT16U  const  OSTmrWheelTblSize   = 0;
 #endif
 
+INT16U  const  OSTraceEn           = OS_TRACE_EN;
+INT16U  const  OSTraceMax          = OS_TRACE_SIZE;             /* Number of records in the trace ring */
+#if OS_TRACE_EN > 0
+INT16U  const  OSTraceRecSize      = sizeof(OS_TRACE_REC);      /* Size in Bytes of OS_TRACE_REC       */
+#else
+INT16U  const  OSTraceRecSize      = 0;
+#endif
+
 #endif
 
 /*$PAGE*/
@@ -159,10 +208,28 @@ INT16U  const  OSDataSize = sizeof(OSCtxSwCtr)
 #if OS_TICK_STEP_EN > 0
                           + sizeof(OSTickStepState)
 #endif
+#if (OS_CHAN_EN > 0) && (OS_MAX_CHANS > 0)
+                          + sizeof(OSChanFreeList)
+                          + sizeof(OSChanTbl)
+#endif
+#if (OS_LOG_EN > 0) && (OS_MAX_LOGS > 0)
+                          + sizeof(OSLogFreeList)
+                          + sizeof(OSLogList)
+                          + sizeof(OSLogDrainPrio)
+                          + sizeof(OSLogTbl)
+#endif
+#if (OS_RING_EN > 0) && (OS_MAX_RINGS > 0)
+                          + sizeof(OSRingFreeList)
+                          + sizeof(OSRingTbl)
+#endif
 #if (OS_MEM_EN > 0) && (OS_MAX_MEM_PART > 0)
                           + sizeof(OSMemFreeList)
                           + sizeof(OSMemTbl)
 #endif
+#if (OS_MEM_EN > 0) && (OS_MAX_MEM_PART > 0) && (OS_MEM_CLASS_EN > 0)
+                          + sizeof(OSMemClassTbl)
+                          + sizeof(OSMemClassCtr)
+#endif
 #if (OS_Q_EN > 0) && (OS_MAX_QS > 0)
                           + sizeof(OSQFreeList)
                           + sizeof(OSQTbl)
@@ -180,6 +247,11 @@ INT16U  const  OSDataSize = sizeof(OSCtxSwCtr)
                           + sizeof(OSTmrFreeList)
                           + sizeof(OSTmrTaskStk)
                           + sizeof(OSTmrWheelTbl)
+#endif
+#if OS_TRACE_EN > 0
+                          + sizeof(OSTraceBuf)
+                          + sizeof(OSTraceCtr)
+                          + sizeof(OSTraceOn)
 #endif
                           + sizeof(OSIntNesting)
                           + sizeof(OSLockNesting)
@@ -231,6 +303,13 @@ void  OSDebugInit (void)
 
     ptemp = (void *)&OSEndiannessTest;
 
+    ptemp = (void *)&OSChanEn;
+    ptemp = (void *)&OSChanMax;
+    ptemp = (void *)&OSChanSize;
+    ptemp = (void *)&OSChanTblSize;
+
+    ptemp = (void *)&OSEDFEn;
+
     ptemp = (void *)&OSEventMax;
     ptemp = (void *)&OSEventNameSize;
     ptemp = (void *)&OSEventEn;
@@ -245,13 +324,26 @@ void  OSDebugInit (void)
     ptemp = (void *)&OSFlagMax;
     ptemp = (void *)&OSFlagNameSize;
 
+    ptemp = (void *)&OSLogEn;
+    ptemp = (void *)&OSLogMax;
+    ptemp = (void *)&OSLogSize;
+    ptemp = (void *)&OSLogTblSize;
+
     ptemp = (void *)&OSLowestPrio;
 
+    ptemp = (void *)&OSRingEn;
+    ptemp = (void *)&OSRingMax;
+    ptemp = (void *)&OSRingSize;
+    ptemp = (void *)&OSRingTblSize;
+
     ptemp = (void *)&OSMboxEn;
 
     ptemp = (void *)&OSMemEn;
     ptemp = (void *)&OSMemMax;
     ptemp = (void *)&OSMemNameSize;
+    ptemp = (void *)&OSMemClassEn;
+    ptemp = (void *)&OSMemClassMax;
+    ptemp = (void *)&OSMemMagSize;
     ptemp = (void *)&OSMemSize;
     ptemp = (void *)&OSMemTblSize;
 
@@ -263,6 +355,9 @@ void  OSDebugInit (void)
     ptemp = (void *)&OSQMax;
     ptemp = (void *)&OSQSize;
 
+    ptemp = (void *)&OSRREn;
+    ptemp = (void *)&OSRRQuantum;
+
     ptemp = (void *)&OSRdyTblSize;
 
     ptemp = (void *)&OSSemEn;
@@ -272,6 +367,8 @@ void  OSDebugInit (void)
     ptemp = (void *)&OSTaskCreateEn;
     ptemp = (void *)&OSTaskCreateExtEn;
     ptemp = (void *)&OSTaskDelEn;
+    ptemp = (void *)&OSTaskNotifyEn;
+    ptemp = (void *)&OSTaskPeriodicEn;
     ptemp = (void *)&OSTaskIdleStkSize;
     ptemp = (void *)&OSTaskProfileEn;
     ptemp = (void *)&OSTaskMax;
@@ -295,6 +392,7 @@ void  OSDebugInit (void)
     ptemp = (void *)&OSTmrCfgMax;
     ptemp = (void *)&OSTmrCfgNameSize;
     ptemp = (void *)&OSTmrCfgWheelSize;
+    ptemp = (void *)&OSTmrCfgStatEn;
     ptemp = (void *)&OSTmrCfgTicksPerSec;
     ptemp = (void *)&OSTmrSize;
     ptemp = (void *)&OSTmrTblSize;
@@ -303,6 +401,10 @@ void  OSDebugInit (void)
     ptemp = (void *)&OSTmrWheelTblSize;
 #endif
 
+    ptemp = (void *)&OSTraceEn;
+    ptemp = (void *)&OSTraceMax;
+    ptemp = (void *)&OSTraceRecSize;
+
     ptemp = (void *)&OSVersionNbr;
 
     ptemp = (void *)&OSDataSize;
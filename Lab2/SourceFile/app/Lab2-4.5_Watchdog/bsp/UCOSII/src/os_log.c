@@ -0,0 +1,346 @@
+/*
+*********************************************************************************************************
+*                                                uC/OS-II
+*                                          The Real-Time Kernel
+*                                             DEFERRED LOGGING
+*
+* File    : OS_LOG.C
+* Version : V2.86
+*
+* A log is a ring of binary records owned by one task.  The task posts a record (the address of a
+* printf() format and its arguments) without formatting it, without blocking and without any critical
+* section.  A single drain task, usually at a low priority, accepts the records of all logs in the order
+* they were posted and formats them.  Each ring has exactly one writer and one reader, so the owner only
+* moves 'OSLogIn' and the drain only moves 'OSLogOut'.  A record posted to a full ring is dropped and
+* counted.  A record posted to an empty ring notifies the drain, which names itself with OSLogDrainSet()
+* and waits with OSTaskNotifyPend() once it has taken every record.
+*********************************************************************************************************
+*/
+
+#ifndef  OS_MASTER_FILE
+#include <ucos_ii.h>
+#endif
+
+#if (OS_LOG_EN > 0) && (OS_MAX_LOGS > 0)
+/*
+*********************************************************************************************************
+*                                         CREATE A LOG FOR A TASK
+*
+* Description : Create the log of a task.  The records the task posts with OSLogPost() go to this log.
+*
+* Arguments   : prio     is the priority of the task owning the log.  If you specify OS_PRIO_SELF, the
+*                        log is created for the calling task.
+*
+*               pbuf     is a pointer to the storage of the ring, an array of 'nrecs' records.
+*
+*               nrecs    is the number of records in 'pbuf'.  The ring holds up to 'nrecs' - 1 records.
+*
+*               perr     is a pointer to a variable containing an error message which will be set by
+*                        this function to either:
+*
+*                        OS_ERR_NONE                if the log has been created correctly.
+*                        OS_ERR_CREATE_ISR          if you called this function from an ISR.
+*                        OS_ERR_PRIO_INVALID        if the priority you specify is higher that the
+*                                                   maximum allowed (i.e. >= OS_LOWEST_PRIO)
+*                        OS_ERR_LOG_INVALID_ADDR    if 'pbuf' is a NULL pointer.
+*                        OS_ERR_LOG_INVALID_SIZE    if 'nrecs' is less than 2.
+*                        OS_ERR_TASK_NOT_EXIST      if the task does not exist.
+*                        OS_ERR_LOG_EXIST           if the task already has a log.
+*                        OS_ERR_LOG_DEPLETED        if no more log control blocks are available.
+*
+* Returns     : != (OS_LOG *)0  is the log was created
+*               == (OS_LOG *)0  if the log was not created.
+*
+* Note(s)     : 1) A log can not be deleted.  When its task is deleted, the drain still accepts the records
+*                  left in it.
+*********************************************************************************************************
+*/
+
+OS_LOG  *OSLogCreate (INT8U prio, OS_LOG_REC *pbuf, INT16U nrecs, INT8U *perr)
+{
+    OS_LOG    *plog;
+    OS_TCB    *ptcb;
+#if OS_CRITICAL_METHOD == 3                           /* Allocate storage for CPU status register      */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                         /* Validate 'perr'                               */
+        return ((OS_LOG *)0);
+    }
+    if (prio >= OS_LOWEST_PRIO) {                     /* Make sure task priority is valid              */
+        if (prio != OS_PRIO_SELF) {
+            *perr = OS_ERR_PRIO_INVALID;
+            return ((OS_LOG *)0);
+        }
+    }
+    if (pbuf == (OS_LOG_REC *)0) {                    /* Must pass a valid address for the storage     */
+        *perr = OS_ERR_LOG_INVALID_ADDR;
+        return ((OS_LOG *)0);
+    }
+    if (nrecs < 2) {                                  /* Must hold at least one record                 */
+        *perr = OS_ERR_LOG_INVALID_SIZE;
+        return ((OS_LOG *)0);
+    }
+#endif
+    if (OSIntNesting > 0) {                           /* See if called from ISR ...                    */
+        *perr = OS_ERR_CREATE_ISR;                    /* ... can't create from an ISR                  */
+        return ((OS_LOG *)0);
+    }
+    OS_ENTER_CRITICAL();
+    if (prio == OS_PRIO_SELF) {                       /* See if creating the log of the calling task   */
+        ptcb = OSTCBCur;
+    } else {
+        ptcb = OSTCBPrioTbl[prio];
+    }
+    if ((ptcb == (OS_TCB *)0) || (ptcb == OS_TCB_RESERVED)) { /* Task must exist                       */
+        OS_EXIT_CRITICAL();
+        *perr = OS_ERR_TASK_NOT_EXIST;
+        return ((OS_LOG *)0);
+    }
+    if (ptcb->OSTCBLog != (OS_LOG *)0) {              /* Task can only have one log                    */
+        OS_EXIT_CRITICAL();
+        *perr = OS_ERR_LOG_EXIST;
+        return ((OS_LOG *)0);
+    }
+    plog = OSLogFreeList;                             /* Get next free log control block               */
+    if (plog == (OS_LOG *)0) {                        /* See if pool of free logs was empty            */
+        OS_EXIT_CRITICAL();
+        *perr = OS_ERR_LOG_DEPLETED;
+        return ((OS_LOG *)0);
+    }
+    OSLogFreeList      = plog->OSLogNext;
+    plog->OSLogBuf     = pbuf;                        /* Store the ring                                */
+    plog->OSLogSize    = nrecs;
+    plog->OSLogIn      = 0;                           /* Ring is empty                                 */
+    plog->OSLogOut     = 0;
+    plog->OSLogDropCtr = 0;
+    plog->OSLogPrio    = ptcb->OSTCBPrio;
+    plog->OSLogNext    = OSLogList;                   /* Make the log visible to the drain             */
+    OSLogList          = plog;
+    ptcb->OSTCBLog     = plog;                        /* Send the posts of the task to the log         */
+    OS_EXIT_CRITICAL();
+    *perr              = OS_ERR_NONE;
+    return (plog);
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                         NAME THE DRAIN OF THE LOGS
+*
+* Description : Name the task which accepts the records of all logs.  OSLogPost() notifies this task when
+*               it makes a log non-empty.
+*
+* Arguments   : prio     is the priority of the drain task.  If you specify OS_PRIO_SELF, the calling
+*                        task becomes the drain.
+*
+* Returns     : OS_ERR_NONE           if the drain was named.
+*               OS_ERR_PRIO_INVALID   if the priority you specify is higher that the maximum allowed
+*                                     (i.e. >= OS_LOWEST_PRIO)
+*
+* Note(s)     : 1) Call this function before the drain first waits with OSTaskNotifyPend(), e.g. when the
+*                  drain task starts.  Records posted before then notify nobody, but the drain finds them
+*                  with OSLogAccept() before it waits.
+*********************************************************************************************************
+*/
+
+INT8U  OSLogDrainSet (INT8U prio)
+{
+#if OS_CRITICAL_METHOD == 3                           /* Allocate storage for CPU status register      */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (prio >= OS_LOWEST_PRIO) {                     /* Make sure task priority is valid              */
+        if (prio != OS_PRIO_SELF) {
+            return (OS_ERR_PRIO_INVALID);
+        }
+    }
+#endif
+    OS_ENTER_CRITICAL();
+    if (prio == OS_PRIO_SELF) {                       /* See if the calling task is the drain          */
+        prio = OSTCBCur->OSTCBPrio;
+    }
+    OSLogDrainPrio = prio;
+    OS_EXIT_CRITICAL();
+    return (OS_ERR_NONE);
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                          POST A RECORD TO A LOG
+*
+* Description : Append a record to the log of the calling task.  The record is formatted later, by the
+*               drain, so posting only costs a few stores.  This function never blocks.  When the record
+*               makes the log non-empty, the drain is notified.
+*
+* Arguments   : pfmt     is a pointer to the printf() format of the record.  It is stored, not copied,
+*                        so it must point to a string constant.
+*
+*               arg0     is the argument for the first conversion in 'pfmt', if any.
+*
+*               arg1     is the argument for the second conversion in 'pfmt', if any.
+*
+* Returns     : OS_ERR_NONE         if the record was posted.
+*               OS_ERR_LOG_NONE     if the calling task has no log, or this function was called from an
+*                                   ISR.
+*               OS_ERR_LOG_FULL     if the log is full, the record is dropped and counted in
+*                                   'OSLogDropCtr'.
+*
+* Note(s)     : 1) The arguments are stored as INT32U, so 'pfmt' may only contain conversions of an 'int'
+*                  or smaller (%d, %u, %x, %c).
+*               2) No critical section is needed since the calling task is the only one moving 'OSLogIn'.
+*                  The record is written through a volatile pointer so that it is complete before
+*                  'OSLogIn' makes it visible to the drain.
+*               3) The drain is notified when it had taken every record before this one, which is when
+*                  it may be waiting.  The check is made after the record is visible, so a drain that
+*                  finds every log empty and waits is always notified.  No drain is notified before
+*                  OSLogDrainSet() named it.
+*********************************************************************************************************
+*/
+
+INT8U  OSLogPost (char const *pfmt, INT32U arg0, INT32U arg1)
+{
+    OS_LOG               *plog;
+    volatile OS_LOG_REC  *prec;
+    INT16U                in;
+    INT16U                next;
+
+
+    if (OSIntNesting > 0) {                           /* ISRs have no log                              */
+        return (OS_ERR_LOG_NONE);
+    }
+    plog = OSTCBCur->OSTCBLog;
+    if (plog == (OS_LOG *)0) {                        /* Calling task must have a log                  */
+        return (OS_ERR_LOG_NONE);
+    }
+    in   = plog->OSLogIn;
+    next = in + 1;
+    if (next == plog->OSLogSize) {                    /* Wrap around the ring                          */
+        next = 0;
+    }
+    if (next == plog->OSLogOut) {                     /* Ring is full, drop the record                 */
+        plog->OSLogDropCtr++;
+        return (OS_ERR_LOG_FULL);
+    }
+    prec              = &plog->OSLogBuf[in];
+    prec->OSLogFmt    = pfmt;
+    prec->OSLogArg[0] = arg0;
+    prec->OSLogArg[1] = arg1;
+    prec->OSLogTime   = OSTime;
+    plog->OSLogIn     = next;                         /* Hand the record over to the drain             */
+    if ((plog->OSLogOut == in) &&                     /* Wake the drain if the log was empty           */
+        (OSLogDrainPrio != OS_PRIO_SELF)) {
+        (void)OSTaskNotifyPost(OSLogDrainPrio, 1, OS_NOTIFY_OPT_SET);
+    }
+    return (OS_ERR_NONE);
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                      ACCEPT A RECORD FROM THE LOGS
+*
+* Description : Take the oldest record posted to any log.  This function is called by the drain task
+*               and never blocks.  Only one task may call it.
+*
+* Arguments   : prec     is a pointer to where the record will be copied.  'OSLogPrio' is set to the
+*                        priority of the task which posted it.
+*
+* Returns     : OS_ERR_NONE               if a record was copied to 'prec'.
+*               OS_ERR_LOG_EMPTY          if no log holds a record.
+*               OS_ERR_LOG_INVALID_PREC   if you passed a NULL pointer for 'prec'.
+*
+* Note(s)     : 1) Records are ordered by the value of OSTime when they were posted.  Records of the same
+*                  tick are taken from the log created last first.
+*               2) The drain waits for the next record with OSTaskNotifyPend() after this function
+*                  returned OS_ERR_LOG_EMPTY.  A notification left from records already taken can end
+*                  the wait early, so it calls this function again until it returns OS_ERR_LOG_EMPTY.
+*********************************************************************************************************
+*/
+
+INT8U  OSLogAccept (OS_LOG_REC *prec)
+{
+    OS_LOG               *plog;
+    OS_LOG               *poldest;
+    volatile OS_LOG_REC  *psrc;
+    INT32U                time;
+    INT32U                oldest;
+    INT16U                out;
+
+
+#if OS_ARG_CHK_EN > 0
+    if (prec == (OS_LOG_REC *)0) {                    /* Must point to a valid destination             */
+        return (OS_ERR_LOG_INVALID_PREC);
+    }
+#endif
+    poldest = (OS_LOG *)0;
+    oldest  = 0;
+    plog    = OSLogList;                              /* Logs are only added at the head of the list   */
+    while (plog != (OS_LOG *)0) {
+        out = plog->OSLogOut;
+        if (out != plog->OSLogIn) {                   /* See if the log holds a record                 */
+            psrc = &plog->OSLogBuf[out];
+            time = psrc->OSLogTime;
+            if ((poldest == (OS_LOG *)0) ||           /* Keep the oldest one, wrap of OSTime included  */
+                ((INT32S)(time - oldest) < 0)) {
+                poldest = plog;
+                oldest  = time;
+            }
+        }
+        plog = plog->OSLogNext;
+    }
+    if (poldest == (OS_LOG *)0) {
+        return (OS_ERR_LOG_EMPTY);
+    }
+    out               = poldest->OSLogOut;
+    psrc              = &poldest->OSLogBuf[out];
+    prec->OSLogFmt    = psrc->OSLogFmt;
+    prec->OSLogArg[0] = psrc->OSLogArg[0];
+    prec->OSLogArg[1] = psrc->OSLogArg[1];
+    prec->OSLogTime   = psrc->OSLogTime;
+    prec->OSLogPrio   = poldest->OSLogPrio;
+    out++;
+    if (out == poldest->OSLogSize) {                  /* Wrap around the ring                          */
+        out = 0;
+    }
+    poldest->OSLogOut = out;                          /* Hand the slot back to the owner               */
+    return (OS_ERR_NONE);
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                     INITIALIZE DEFERRED LOGGING
+*
+* Description : This function is called by uC/OS-II to initialize the logs.  Your application MUST NOT
+*               call this function.
+*
+* Arguments   : none
+*
+* Returns     : none
+*
+* Note(s)    : This function is INTERNAL to uC/OS-II and your application should not call it.
+*********************************************************************************************************
+*/
+
+void  OS_LogInit (void)
+{
+    OS_LOG  *plog;
+    INT16U   i;
+
+
+    OS_MemClr((INT8U *)&OSLogTbl[0], sizeof(OSLogTbl));  /* Clear the log table                       */
+    plog = &OSLogTbl[0];
+    for (i = 0; i < (OS_MAX_LOGS - 1); i++) {             /* Init. list of free logs                   */
+        plog->OSLogNext = &OSLogTbl[i+1];
+        plog++;
+    }
+    plog->OSLogNext = (OS_LOG *)0;                        /* Initialize last node                      */
+    OSLogFreeList   = &OSLogTbl[0];                       /* Point to beginning of free list           */
+    OSLogList       = (OS_LOG *)0;                        /* No log created yet                        */
+    OSLogDrainPrio  = OS_PRIO_SELF;                       /* No drain to notify until OSLogDrainSet()  */
+}
+#endif                                                    /* OS_LOG_EN                                 */
@@ -305,13 +305,15 @@ void  *OSMboxPend (OS_EVENT *pevent, INT16U timeout, INT8U *perr)
     pmsg = pevent->OSEventPtr;
     if (pmsg != (void *)0) {                          /* See if there is already a message             */
         pevent->OSEventPtr = (void *)0;               /* Clear the mailbox                             */
+        OS_TRACE(OS_TRACE_MBOX_PEND, OS_TRACE_EVENT_ID(pevent));
         OS_EXIT_CRITICAL();
         *perr = OS_ERR_NONE;
         return (pmsg);                                /* Return the message received (or NULL)         */
     }
+    OS_TRACE(OS_TRACE_MBOX_WAIT, OS_TRACE_EVENT_ID(pevent));
     OSTCBCur->OSTCBStat     |= OS_STAT_MBOX;          /* Message not available, task will pend         */
     OSTCBCur->OSTCBStatPend  = OS_STAT_PEND_OK;
-    OSTCBCur->OSTCBDly       = timeout;               /* Load timeout in TCB                           */
+    OS_TickListInsert(OSTCBCur, timeout);             /* Load timeout in TCB                           */
     OS_EventTaskWait(pevent);                         /* Suspend task until event or timeout occurs    */
     OS_EXIT_CRITICAL();
     OS_Sched();                                       /* Find next highest priority task ready to run  */
@@ -472,6 +474,7 @@ INT8U  OSMboxPost (OS_EVENT *pevent, void *pmsg)
         return (OS_ERR_EVENT_TYPE);
     }
     OS_ENTER_CRITICAL();
+    OS_TRACE(OS_TRACE_MBOX_POST, OS_TRACE_EVENT_ID(pevent));
     if (pevent->OSEventGrp != 0) {                    /* See if any task pending on mailbox            */
                                                       /* Ready HPT waiting on event                    */
         (void)OS_EventTaskRdy(pevent, pmsg, OS_STAT_MBOX, OS_STAT_PEND_OK);
@@ -543,6 +546,7 @@ INT8U  OSMboxPostOpt (OS_EVENT *pevent, void *pmsg, INT8U opt)
         return (OS_ERR_EVENT_TYPE);
     }
     OS_ENTER_CRITICAL();
+    OS_TRACE(OS_TRACE_MBOX_POST, OS_TRACE_EVENT_ID(pevent));
     if (pevent->OSEventGrp != 0) {                    /* See if any task pending on mailbox            */
         if ((opt & OS_POST_OPT_BROADCAST) != 0x00) {  /* Do we need to post msg to ALL waiting tasks ? */
             while (pevent->OSEventGrp != 0) {         /* Yes, Post to ALL tasks waiting on mailbox     */
@@ -590,13 +594,8 @@ INT8U  OSMboxPostOpt (OS_EVENT *pevent, void *pmsg, INT8U opt)
 INT8U  OSMboxQuery (OS_EVENT *pevent, OS_MBOX_DATA *p_mbox_data)
 {
     INT8U      i;
-#if OS_LOWEST_PRIO <= 63
-    INT8U     *psrc;
-    INT8U     *pdest;
-#else
-    INT16U    *psrc;
-    INT16U    *pdest;
-#endif
+    OS_PRIO_MAP *psrc;
+    OS_PRIO_MAP *pdest;
 #if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register */
     OS_CPU_SR  cpu_sr = 0;
 #endif
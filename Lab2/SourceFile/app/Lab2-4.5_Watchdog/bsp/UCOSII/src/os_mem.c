@@ -76,7 +76,7 @@ OS_MEM  *OSMemCreate (void *addr, INT32U nblks, INT32U blksize, INT8U *perr)
         *perr = OS_ERR_MEM_INVALID_ADDR;
         return ((OS_MEM *)0);
     }
-    if (((INT32U)addr & (sizeof(void *) - 1)) != 0){  /* Must be pointer size aligned                  */
+    if (((unsigned long)addr & (sizeof(void *) - 1)) != 0) { /* Must be pointer size aligned           */
         *perr = OS_ERR_MEM_INVALID_ADDR;
         return ((OS_MEM *)0);
     }
@@ -100,11 +100,11 @@ OS_MEM  *OSMemCreate (void *addr, INT32U nblks, INT32U blksize, INT8U *perr)
         return ((OS_MEM *)0);
     }
     plink = (void **)addr;                            /* Create linked list of free memory blocks      */
-    pblk  = (INT8U *)((INT32U)addr + blksize);
+    pblk  = (INT8U *)addr + blksize;
     for (i = 0; i < (nblks - 1); i++) {
        *plink = (void *)pblk;                         /* Save pointer to NEXT block in CURRENT block   */
         plink = (void **)pblk;                        /* Position to  NEXT      block                  */
-        pblk  = (INT8U *)((INT32U)pblk + blksize);    /* Point to the FOLLOWING block                  */
+        pblk += blksize;                              /* Point to the FOLLOWING block                  */
     }
     *plink              = (void *)0;                  /* Last memory block points to NULL              */
     pmem->OSMemAddr     = addr;                       /* Store start address of memory partition       */
@@ -383,6 +383,361 @@ INT8U  OSMemQuery (OS_MEM *pmem, OS_MEM_DATA *p_mem_data)
 /*$PAGE*/
 /*
 *********************************************************************************************************
+*                                             SIZE CLASSES
+*
+* Description : OSMemAlloc() and OSMemFree() serve blocks by size from the partitions made with
+*               OSMemClassCreate(), the size classes.  A request is served from the class with the
+*               smallest blocks that fit, or from the next larger class with a free block if that one is
+*               empty.  A task that has attached a magazine with OSMemMagSet() caches up to
+*               OS_MEM_MAG_SIZE free blocks of each class in it, so that most of its requests take or
+*               return a block without disabling interrupts: only the task itself uses its magazine.  An
+*               empty magazine is refilled, and a full one drained, by half its size in one critical
+*               section.
+*
+*               The classes are never deleted, and are only read outside of critical sections once
+*               OSMemClassCtr counts them, so they can be created while other tasks allocate.
+*********************************************************************************************************
+*/
+
+#if OS_MEM_CLASS_EN > 0
+static  INT8U  OS_MemClassFit (INT32U size, BOOLEAN free);
+static  INT8U  OS_MemClassOf  (void *pblk);
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                      ALLOCATE A BLOCK BY SIZE
+*
+* Description : Get a block of at least 'size' bytes from the best fitting size class.
+*
+* Arguments   : size    is the number of bytes needed.
+*
+*               perr    is a pointer to a variable containing an error message which will be set by this
+*                       function to either:
+*
+*                       OS_ERR_NONE             if a block was allocated.
+*                       OS_ERR_MEM_INVALID_SIZE if no size class has blocks of 'size' bytes
+*                       OS_ERR_MEM_NO_FREE_BLKS if no class with blocks that fit has a free block left
+*
+* Returns     : A pointer to a memory block if no error is detected
+*               A pointer to NULL if an error is detected
+*
+* Note(s)     : 1) May be called from an ISR, which always takes the block from a partition.
+*********************************************************************************************************
+*/
+
+#if OS_MEM_CLASS_EN > 0
+void  *OSMemAlloc (INT32U size, INT8U *perr)
+{
+    OS_MEM_CLASS  *pclass;
+    OS_MEM_MAG    *pmag;
+    OS_MEM        *pmem;
+    void          *pblk;
+    INT32U         nused;
+    INT8U          cls;
+    INT8U          fit;
+    INT8U          n;
+#if OS_CRITICAL_METHOD == 3                           /* Allocate storage for CPU status register      */
+    OS_CPU_SR      cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                         /* Validate 'perr'                               */
+        return ((void *)0);
+    }
+#endif
+    cls = OS_MemClassFit(size, OS_FALSE);             /* Find the best fitting class                   */
+    if (cls == OS_MEM_CLASS_MAX) {
+        *perr = OS_ERR_MEM_INVALID_SIZE;
+        return ((void *)0);
+    }
+    pmag = (OS_MEM_MAG *)0;
+    if ((OSIntNesting == 0) && (OSRunning == OS_TRUE)) {
+        pmag = OSTCBCur->OSTCBMemMag;
+    }
+    if (pmag != (OS_MEM_MAG *)0) {                    /* Take the block from the magazine if it has one*/
+        n = pmag->OSMagCnt[cls];
+        if (n > 0) {
+            n--;
+            pblk                = pmag->OSMagBlk[cls][n];
+            pmag->OSMagCnt[cls] = n;
+            *perr               = OS_ERR_NONE;
+            return (pblk);
+        }
+    }
+    OS_ENTER_CRITICAL();
+    fit = OS_MemClassFit(size, OS_TRUE);              /* Best fitting class that has a free block      */
+    if (fit == OS_MEM_CLASS_MAX) {
+        OSMemClassTbl[cls].OSMemClassFailCtr++;
+        OS_EXIT_CRITICAL();
+        *perr = OS_ERR_MEM_NO_FREE_BLKS;
+        return ((void *)0);
+    }
+    if (fit != cls) {
+        OSMemClassTbl[cls].OSMemClassFallbackCtr++;
+    }
+    pclass              = &OSMemClassTbl[fit];
+    pmem                = pclass->OSMemClassMem;
+    pblk                = pmem->OSMemFreeList;        /* Take the block from the partition             */
+    pmem->OSMemFreeList = *(void **)pblk;
+    pmem->OSMemNFree--;
+    if ((pmag != (OS_MEM_MAG *)0) && (fit == cls)) {  /* Refill half of the magazine                   */
+        n = 0;
+        while ((n < (OS_MEM_MAG_SIZE / 2)) && (pmem->OSMemNFree > 0)) {
+            pmag->OSMagBlk[cls][n] = pmem->OSMemFreeList;
+            pmem->OSMemFreeList    = *(void **)pmem->OSMemFreeList;
+            pmem->OSMemNFree--;
+            n++;
+        }
+        pmag->OSMagCnt[cls] = n;
+    }
+    nused = pmem->OSMemNBlks - pmem->OSMemNFree;
+    if (nused > pclass->OSMemClassNUsedMax) {         /* Track the high-water mark of the partition    */
+        pclass->OSMemClassNUsedMax = nused;
+    }
+    OS_EXIT_CRITICAL();
+    *perr = OS_ERR_NONE;
+    return (pblk);
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                         CREATE A SIZE CLASS
+*
+* Description : Create a memory partition, as OSMemCreate() does, and make it a size class of
+*               OSMemAlloc().
+*
+* Arguments   : addr     is the starting address of the memory partition
+*
+*               nblks    is the number of memory blocks to create from the partition.
+*
+*               blksize  is the size (in bytes) of each block in the memory partition.
+*
+*               perr     is a pointer to a variable containing an error message which will be set by
+*                        this function to either:
+*
+*                        OS_ERR_NONE                if the size class has been created.
+*                        OS_ERR_MEM_CLASS_DEPLETED  if OS_MEM_CLASS_MAX classes exist already
+*                        or one of the errors of OSMemCreate().
+*
+* Returns    : != (OS_MEM *)0  is the partition of the class, which may be queried with OSMemQuery() but
+*                              must not be passed to OSMemGet() or OSMemPut().
+*              == (OS_MEM *)0  if the class was not created.
+*********************************************************************************************************
+*/
+
+#if OS_MEM_CLASS_EN > 0
+OS_MEM  *OSMemClassCreate (void *addr, INT32U nblks, INT32U blksize, INT8U *perr)
+{
+    OS_MEM        *pmem;
+    OS_MEM_CLASS  *pclass;
+#if OS_CRITICAL_METHOD == 3                           /* Allocate storage for CPU status register      */
+    OS_CPU_SR      cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                         /* Validate 'perr'                               */
+        return ((OS_MEM *)0);
+    }
+#endif
+    if (OSMemClassCtr >= OS_MEM_CLASS_MAX) {          /* Fail before a partition is taken for nothing  */
+        *perr = OS_ERR_MEM_CLASS_DEPLETED;
+        return ((OS_MEM *)0);
+    }
+    pmem = OSMemCreate(addr, nblks, blksize, perr);
+    if (pmem == (OS_MEM *)0) {
+        return ((OS_MEM *)0);
+    }
+    OS_ENTER_CRITICAL();
+    if (OSMemClassCtr >= OS_MEM_CLASS_MAX) {          /* Another task took the last class meanwhile    */
+        OS_EXIT_CRITICAL();
+        *perr = OS_ERR_MEM_CLASS_DEPLETED;
+        return ((OS_MEM *)0);
+    }
+    pclass                        = &OSMemClassTbl[OSMemClassCtr];
+    pclass->OSMemClassMem         = pmem;
+    pclass->OSMemClassBlkSize     = blksize;
+    pclass->OSMemClassNUsedMax    = 0;
+    pclass->OSMemClassFallbackCtr = 0;
+    pclass->OSMemClassFailCtr     = 0;
+    OSMemClassCtr++;                                  /* Publish the class once it is complete         */
+    OS_EXIT_CRITICAL();
+    *perr = OS_ERR_NONE;
+    return (pmem);
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                          QUERY A SIZE CLASS
+*
+* Description : This function is used to obtain the usage of a size class, to size its partition.
+*
+* Arguments   : cls           is the number of the class, 0 for the first one created.
+*
+*               p_class_data  is a pointer to a structure that will receive the block size and count of
+*                             the class, the blocks free in its partition, the most blocks ever taken
+*                             from it at once (blocks cached in magazines count as taken), and the
+*                             number of requests that had to fall back to a larger class or failed.
+*
+* Returns     : OS_ERR_NONE               if no errors were found.
+*               OS_ERR_MEM_INVALID_CLASS  if no class 'cls' exists.
+*               OS_ERR_MEM_INVALID_PDATA  if you passed a NULL pointer to the data recipient.
+*********************************************************************************************************
+*/
+
+#if (OS_MEM_CLASS_EN > 0) && (OS_MEM_QUERY_EN > 0)
+INT8U  OSMemClassQuery (INT8U cls, OS_MEM_CLASS_DATA *p_class_data)
+{
+    OS_MEM_CLASS  *pclass;
+#if OS_CRITICAL_METHOD == 3                      /* Allocate storage for CPU status register           */
+    OS_CPU_SR      cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (p_class_data == (OS_MEM_CLASS_DATA *)0) {/* Must release a valid storage area for the data     */
+        return (OS_ERR_MEM_INVALID_PDATA);
+    }
+#endif
+    if (cls >= OSMemClassCtr) {
+        return (OS_ERR_MEM_INVALID_CLASS);
+    }
+    pclass = &OSMemClassTbl[cls];
+    OS_ENTER_CRITICAL();
+    p_class_data->OSBlkSize     = pclass->OSMemClassBlkSize;
+    p_class_data->OSNBlks       = pclass->OSMemClassMem->OSMemNBlks;
+    p_class_data->OSNFree       = pclass->OSMemClassMem->OSMemNFree;
+    p_class_data->OSNUsedMax    = pclass->OSMemClassNUsedMax;
+    p_class_data->OSFallbackCtr = pclass->OSMemClassFallbackCtr;
+    p_class_data->OSFailCtr     = pclass->OSMemClassFailCtr;
+    OS_EXIT_CRITICAL();
+    return (OS_ERR_NONE);
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                       RELEASE A BLOCK BY ADDRESS
+*
+* Description : Returns a block obtained from OSMemAlloc() to its size class.
+*
+* Arguments   : pblk    is a pointer to the memory block being released.
+*
+* Returns     : OS_ERR_NONE              if the memory block was released
+*               OS_ERR_MEM_FULL          if the partition of the block has all its blocks already
+*               OS_ERR_MEM_INVALID_PBLK  if 'pblk' is not in the partition of any size class
+*
+* Note(s)     : 1) May be called from an ISR, which always returns the block to its partition.
+*********************************************************************************************************
+*/
+
+#if OS_MEM_CLASS_EN > 0
+INT8U  OSMemFree (void *pblk)
+{
+    OS_MEM_MAG  *pmag;
+    OS_MEM      *pmem;
+    void        *pfree;
+    INT8U        cls;
+    INT8U        n;
+#if OS_CRITICAL_METHOD == 3                      /* Allocate storage for CPU status register           */
+    OS_CPU_SR    cpu_sr = 0;
+#endif
+
+
+
+    cls = OS_MemClassOf(pblk);                   /* Find the class from the address of the block       */
+    if (cls == OS_MEM_CLASS_MAX) {
+        return (OS_ERR_MEM_INVALID_PBLK);
+    }
+    pmag = (OS_MEM_MAG *)0;
+    if ((OSIntNesting == 0) && (OSRunning == OS_TRUE)) {
+        pmag = OSTCBCur->OSTCBMemMag;
+    }
+    if (pmag != (OS_MEM_MAG *)0) {               /* Keep the block in the magazine if it has room      */
+        n = pmag->OSMagCnt[cls];
+        if (n < OS_MEM_MAG_SIZE) {
+            pmag->OSMagBlk[cls][n] = pblk;
+            pmag->OSMagCnt[cls]    = n + 1;
+            return (OS_ERR_NONE);
+        }
+    }
+    pmem = OSMemClassTbl[cls].OSMemClassMem;
+    OS_ENTER_CRITICAL();
+    if (pmem->OSMemNFree >= pmem->OSMemNBlks) {  /* Make sure all blocks not already returned          */
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_MEM_FULL);
+    }
+    *(void **)pblk      = pmem->OSMemFreeList;   /* Insert released block into free block list         */
+    pmem->OSMemFreeList = pblk;
+    pmem->OSMemNFree++;
+    if (pmag != (OS_MEM_MAG *)0) {               /* Drain half of the full magazine                    */
+        n = OS_MEM_MAG_SIZE;
+        while (n > (OS_MEM_MAG_SIZE / 2)) {
+            n--;
+            pfree               = pmag->OSMagBlk[cls][n];
+            *(void **)pfree     = pmem->OSMemFreeList;
+            pmem->OSMemFreeList = pfree;
+            pmem->OSMemNFree++;
+        }
+        pmag->OSMagCnt[cls] = n;
+    }
+    OS_EXIT_CRITICAL();
+    return (OS_ERR_NONE);
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                    ATTACH A MAGAZINE TO THE TASK
+*
+* Description : This function gives the calling task a magazine, a cache of free blocks for OSMemAlloc()
+*               and OSMemFree() that they use without disabling interrupts.  The blocks of the magazine
+*               the task had before are returned to their partitions.  OSTaskDel() returns those of the
+*               magazine of the task it deletes.
+*
+* Arguments   : pmag    is a pointer to the magazine, which must stay valid as long as it is attached,
+*                       or NULL to detach the magazine of the task.
+*
+* Returns     : OS_ERR_NONE         if the magazine was attached.
+*               OS_ERR_MEM_MAG_ISR  if you called this function from an ISR.
+*********************************************************************************************************
+*/
+
+#if OS_MEM_CLASS_EN > 0
+INT8U  OSMemMagSet (OS_MEM_MAG *pmag)
+{
+    INT8U      cls;
+#if OS_CRITICAL_METHOD == 3                      /* Allocate storage for CPU status register           */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+    if (OSIntNesting > 0) {                      /* See if trying to call from an ISR                  */
+        return (OS_ERR_MEM_MAG_ISR);
+    }
+    if (pmag != (OS_MEM_MAG *)0) {
+        for (cls = 0; cls < OS_MEM_CLASS_MAX; cls++) {
+            pmag->OSMagCnt[cls] = 0;             /* The new magazine starts empty                      */
+        }
+    }
+    OS_ENTER_CRITICAL();
+    OS_MemMagFlush(OSTCBCur);                    /* Return the blocks of the previous magazine         */
+    OSTCBCur->OSTCBMemMag = pmag;
+    OS_EXIT_CRITICAL();
+    return (OS_ERR_NONE);
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
 *                                    INITIALIZE MEMORY PARTITION MANAGER
 *
 * Description : This function is called by uC/OS-II to initialize the memory partition manager.  Your
@@ -430,5 +785,134 @@ void  OS_MemInit (void)
 
     OSMemFreeList       = &OSMemTbl[0];                   /* Point to beginning of free list           */
 #endif
+
+#if OS_MEM_CLASS_EN > 0
+    OS_MemClr((INT8U *)&OSMemClassTbl[0], sizeof(OSMemClassTbl));
+    OSMemClassCtr       = 0;                              /* No size classes yet                       */
+#endif
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                     FIND THE SIZE CLASS OF A REQUEST
+*
+* Description : This function returns the class with the smallest blocks of at least 'size' bytes, among
+*               all classes or, if 'free' is OS_TRUE, among those whose partition has a free block.
+*
+* Arguments   : size    is the number of bytes requested.
+*
+*               free    selects the classes with a free block only.
+*
+* Returns     : The number of the class, or OS_MEM_CLASS_MAX if no class fits.
+*
+* Note(s)     : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*               2) With 'free' set, it must be called with interrupts disabled.
+*********************************************************************************************************
+*/
+
+#if OS_MEM_CLASS_EN > 0
+static  INT8U  OS_MemClassFit (INT32U size, BOOLEAN free)
+{
+    OS_MEM_CLASS  *pclass;
+    INT32U         best;
+    INT8U          fit;
+    INT8U          cls;
+    INT8U          n;
+
+
+    n    = OSMemClassCtr;
+    fit  = OS_MEM_CLASS_MAX;
+    best = 0xFFFFFFFFL;
+    for (cls = 0; cls < n; cls++) {
+        pclass = &OSMemClassTbl[cls];
+        if ((pclass->OSMemClassBlkSize >= size) && (pclass->OSMemClassBlkSize < best)) {
+            if ((free == OS_FALSE) || (pclass->OSMemClassMem->OSMemNFree > 0)) {
+                best = pclass->OSMemClassBlkSize;
+                fit  = cls;
+            }
+        }
+    }
+    return (fit);
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                     FIND THE SIZE CLASS OF A BLOCK
+*
+* Description : This function returns the class whose partition holds the block at 'pblk'.
+*
+* Arguments   : pblk    is a pointer to the block.
+*
+* Returns     : The number of the class, or OS_MEM_CLASS_MAX if the block is in no class.
+*
+* Note(s)     : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*********************************************************************************************************
+*/
+
+#if OS_MEM_CLASS_EN > 0
+static  INT8U  OS_MemClassOf (void *pblk)
+{
+    OS_MEM  *pmem;
+    INT8U   *paddr;
+    INT8U    cls;
+    INT8U    n;
+
+
+    n = OSMemClassCtr;
+    for (cls = 0; cls < n; cls++) {
+        pmem  = OSMemClassTbl[cls].OSMemClassMem;
+        paddr = (INT8U *)pmem->OSMemAddr;
+        if (((INT8U *)pblk >= paddr) &&
+            ((INT8U *)pblk <  paddr + pmem->OSMemNBlks * pmem->OSMemBlkSize)) {
+            return (cls);
+        }
+    }
+    return (OS_MEM_CLASS_MAX);
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                    RETURN THE BLOCKS OF A MAGAZINE
+*
+* Description : This function returns the blocks cached in the magazine of a task to their partitions.
+*
+* Arguments   : ptcb    is a pointer to the TCB of the task.
+*
+* Returns     : none
+*
+* Note(s)     : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*               2) It must be called with interrupts disabled.
+*********************************************************************************************************
+*/
+
+#if OS_MEM_CLASS_EN > 0
+void  OS_MemMagFlush (OS_TCB *ptcb)
+{
+    OS_MEM_MAG  *pmag;
+    OS_MEM      *pmem;
+    void        *pblk;
+    INT8U        cls;
+    INT8U        n;
+
+
+    pmag = ptcb->OSTCBMemMag;
+    if (pmag == (OS_MEM_MAG *)0) {
+        return;
+    }
+    for (cls = 0; cls < OSMemClassCtr; cls++) {
+        pmem = OSMemClassTbl[cls].OSMemClassMem;
+        n    = pmag->OSMagCnt[cls];
+        while (n > 0) {
+            n--;
+            pblk                = pmag->OSMagBlk[cls][n];
+            *(void **)pblk      = pmem->OSMemFreeList;
+            pmem->OSMemFreeList = pblk;
+            pmem->OSMemNFree++;
+        }
+        pmag->OSMagCnt[cls] = 0;
+    }
 }
+#endif
 #endif                                                    /* OS_MEM_EN                                 */
@@ -468,17 +468,10 @@ void  OSMutexPend (OS_EVENT *pevent, INT16U timeout, INT8U *perr)
                 rdy = OS_FALSE;                            /* No                                       */
             }
             ptcb->OSTCBPrio = pip;                         /* Change owner task prio to PIP            */
-#if OS_LOWEST_PRIO <= 63
-            ptcb->OSTCBY    = (INT8U)( ptcb->OSTCBPrio >> 3);
-            ptcb->OSTCBX    = (INT8U)( ptcb->OSTCBPrio & 0x07);
-            ptcb->OSTCBBitY = (INT8U)(1 << ptcb->OSTCBY);
-            ptcb->OSTCBBitX = (INT8U)(1 << ptcb->OSTCBX);
-#else
-            ptcb->OSTCBY    = (INT8U)((ptcb->OSTCBPrio >> 4) & 0xFF);
-            ptcb->OSTCBX    = (INT8U)( ptcb->OSTCBPrio & 0x0F);
-            ptcb->OSTCBBitY = (INT16U)(1 << ptcb->OSTCBY);
-            ptcb->OSTCBBitX = (INT16U)(1 << ptcb->OSTCBX);
-#endif
+            ptcb->OSTCBY    = (INT8U)(ptcb->OSTCBPrio >> OS_PRIO_MAP_SHIFT);
+            ptcb->OSTCBX    = (INT8U)(ptcb->OSTCBPrio &  OS_PRIO_MAP_MASK);
+            ptcb->OSTCBBitY = (OS_PRIO_MAP)((OS_PRIO_MAP)1 << ptcb->OSTCBY);
+            ptcb->OSTCBBitX = (OS_PRIO_MAP)((OS_PRIO_MAP)1 << ptcb->OSTCBX);
             if (rdy == OS_TRUE) {                          /* If task was ready at owner's priority ...*/
                 OSRdyGrp               |= ptcb->OSTCBBitY; /* ... make it ready at new priority.       */
                 OSRdyTbl[ptcb->OSTCBY] |= ptcb->OSTCBBitX;
@@ -494,7 +487,7 @@ void  OSMutexPend (OS_EVENT *pevent, INT16U timeout, INT8U *perr)
     }
     OSTCBCur->OSTCBStat     |= OS_STAT_MUTEX;         /* Mutex not available, pend current task        */
     OSTCBCur->OSTCBStatPend  = OS_STAT_PEND_OK;
-    OSTCBCur->OSTCBDly       = timeout;               /* Store timeout in current task's TCB           */
+    OS_TickListInsert(OSTCBCur, timeout);             /* Store timeout in current task's TCB           */
     OS_EventTaskWait(pevent);                         /* Suspend task until event or timeout occurs    */
     OS_EXIT_CRITICAL();
     OS_Sched();                                       /* Find next highest priority task ready         */
@@ -623,13 +616,8 @@ INT8U  OSMutexPost (OS_EVENT *pevent)
 INT8U  OSMutexQuery (OS_EVENT *pevent, OS_MUTEX_DATA *p_mutex_data)
 {
     INT8U      i;
-#if OS_LOWEST_PRIO <= 63
-    INT8U     *psrc;
-    INT8U     *pdest;
-#else
-    INT16U    *psrc;
-    INT16U    *pdest;
-#endif
+    OS_PRIO_MAP *psrc;
+    OS_PRIO_MAP *pdest;
 #if OS_CRITICAL_METHOD == 3                      /* Allocate storage for CPU status register           */
     OS_CPU_SR  cpu_sr = 0;
 #endif
@@ -695,17 +683,10 @@ static  void  OSMutex_RdyAtPrio (OS_TCB *ptcb, INT8U prio)
         OSRdyGrp &= ~ptcb->OSTCBBitY;
     }
     ptcb->OSTCBPrio         = prio;
-#if OS_LOWEST_PRIO <= 63
-    ptcb->OSTCBY            = (INT8U)((prio >> (INT8U)3) & (INT8U)0x07);
-    ptcb->OSTCBX            = (INT8U) (prio & (INT8U)0x07);
-    ptcb->OSTCBBitY         = (INT8U)(1 << ptcb->OSTCBY);
-    ptcb->OSTCBBitX         = (INT8U)(1 << ptcb->OSTCBX);
-#else
-    ptcb->OSTCBY            = (INT8U)((prio >> (INT8U)4) & (INT8U)0x0F);
-    ptcb->OSTCBX            = (INT8U) (prio & (INT8U)0x0F);
-    ptcb->OSTCBBitY         = (INT16U)(1 << ptcb->OSTCBY);
-    ptcb->OSTCBBitX         = (INT16U)(1 << ptcb->OSTCBX);
-#endif
+    ptcb->OSTCBY            = (INT8U)(prio >> OS_PRIO_MAP_SHIFT);
+    ptcb->OSTCBX            = (INT8U)(prio &  OS_PRIO_MAP_MASK);
+    ptcb->OSTCBBitY         = (OS_PRIO_MAP)((OS_PRIO_MAP)1 << ptcb->OSTCBY);
+    ptcb->OSTCBBitX         = (OS_PRIO_MAP)((OS_PRIO_MAP)1 << ptcb->OSTCBX);
     OSRdyGrp               |= ptcb->OSTCBBitY;             /* Make task ready at original priority     */
     OSRdyTbl[ptcb->OSTCBY] |= ptcb->OSTCBBitX;
     OSTCBPrioTbl[prio]      = ptcb;
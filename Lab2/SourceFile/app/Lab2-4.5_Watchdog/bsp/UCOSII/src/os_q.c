@@ -430,7 +430,7 @@ void  *OSQPend (OS_EVENT *pevent, INT16U timeout, INT8U *perr)
     }
     OSTCBCur->OSTCBStat     |= OS_STAT_Q;        /* Task will have to pend for a message to be posted  */
     OSTCBCur->OSTCBStatPend  = OS_STAT_PEND_OK;
-    OSTCBCur->OSTCBDly       = timeout;          /* Load timeout into TCB                              */
+    OS_TickListInsert(OSTCBCur, timeout);        /* Load timeout into TCB                              */
     OS_EventTaskWait(pevent);                    /* Suspend task until event or timeout occurs         */
     OS_EXIT_CRITICAL();
     OS_Sched();                                  /* Find next highest priority task ready to run       */
@@ -779,13 +779,8 @@ INT8U  OSQQuery (OS_EVENT *pevent, OS_Q_DATA *p_q_data)
 {
     OS_Q      *pq;
     INT8U      i;
-#if OS_LOWEST_PRIO <= 63
-    INT8U     *psrc;
-    INT8U     *pdest;
-#else
-    INT16U    *psrc;
-    INT16U    *pdest;
-#endif
+    OS_PRIO_MAP *psrc;
+    OS_PRIO_MAP *pdest;
 #if OS_CRITICAL_METHOD == 3                            /* Allocate storage for CPU status register     */
     OS_CPU_SR  cpu_sr = 0;
 #endif
@@ -0,0 +1,340 @@
+/*
+*********************************************************************************************************
+*                                                uC/OS-II
+*                                          The Real-Time Kernel
+*                                           SINGLE-PRODUCER RINGS
+*
+* File    : OS_RING.C
+* Version : V2.86
+*
+* A ring is a FIFO of fixed size entries with exactly one producer, an ISR or a task, and one consumer
+* task.  The producer only moves 'OSRingIn' and the consumer only moves 'OSRingOut', so neither needs a
+* critical section to post or to take entries.  Both indices run freely and are masked into the ring,
+* whose number of entries is a power of two.  The consumer takes the entries in batches, and is notified
+* through its task notification word when a post makes the ring non-empty, which is the only post that
+* enters a critical section.
+*********************************************************************************************************
+*/
+
+#ifndef  OS_MASTER_FILE
+#include <ucos_ii.h>
+#endif
+
+#if (OS_RING_EN > 0) && (OS_MAX_RINGS > 0)
+/*
+*********************************************************************************************************
+*                                             CREATE A RING
+*
+* Description : Create a ring for a consumer task.
+*
+* Arguments   : pbuf     is a pointer to the storage of the ring, an array of 'nentries' entries of
+*                        'size' bytes each.
+*
+*               nentries is the number of entries in 'pbuf', a power of two.  The ring holds up to
+*                        'nentries' entries.
+*
+*               size     is the size of an entry, in bytes.
+*
+*               prio     is the priority of the consumer task.  If you specify OS_PRIO_SELF, the calling
+*                        task is the consumer.
+*
+*               perr     is a pointer to a variable containing an error message which will be set by
+*                        this function to either:
+*
+*                        OS_ERR_NONE                if the ring has been created correctly.
+*                        OS_ERR_CREATE_ISR          if you called this function from an ISR.
+*                        OS_ERR_PRIO_INVALID        if the priority you specify is higher that the
+*                                                   maximum allowed (i.e. >= OS_LOWEST_PRIO)
+*                        OS_ERR_RING_INVALID_ADDR   if 'pbuf' is a NULL pointer.
+*                        OS_ERR_RING_INVALID_SIZE   if 'nentries' is not a power of two of at least 2,
+*                                                   if 'size' is 0 or if the storage is larger than
+*                                                   65535 bytes.
+*                        OS_ERR_RING_DEPLETED       if no more ring control blocks are available.
+*
+* Returns     : != (OS_RING *)0  is the ring was created
+*               == (OS_RING *)0  if the ring was not created.
+*
+* Note(s)     : 1) A ring can not be deleted.
+*               2) The consumer does not have to exist yet, but it must be the only task taking entries
+*                  from the ring.
+*********************************************************************************************************
+*/
+
+OS_RING  *OSRingCreate (void *pbuf, INT16U nentries, INT16U size, INT8U prio, INT8U *perr)
+{
+    OS_RING   *pring;
+#if OS_CRITICAL_METHOD == 3                           /* Allocate storage for CPU status register      */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                         /* Validate 'perr'                               */
+        return ((OS_RING *)0);
+    }
+    if (prio >= OS_LOWEST_PRIO) {                     /* Make sure task priority is valid              */
+        if (prio != OS_PRIO_SELF) {
+            *perr = OS_ERR_PRIO_INVALID;
+            return ((OS_RING *)0);
+        }
+    }
+    if (pbuf == (void *)0) {                          /* Must pass a valid address for the storage     */
+        *perr = OS_ERR_RING_INVALID_ADDR;
+        return ((OS_RING *)0);
+    }
+    if ((nentries < 2) ||                             /* Must hold a power of two of entries ...       */
+        ((nentries & (nentries - 1)) != 0) ||
+        (size == 0) ||                                /* ... of at least one byte ...                  */
+        ((INT32U)nentries * size > 65535uL)) {        /* ... within the reach of OS_MemCopy()          */
+        *perr = OS_ERR_RING_INVALID_SIZE;
+        return ((OS_RING *)0);
+    }
+#endif
+    if (OSIntNesting > 0) {                           /* See if called from ISR ...                    */
+        *perr = OS_ERR_CREATE_ISR;                    /* ... can't create from an ISR                  */
+        return ((OS_RING *)0);
+    }
+    OS_ENTER_CRITICAL();
+    if (prio == OS_PRIO_SELF) {                       /* See if the calling task is the consumer       */
+        prio = OSTCBCur->OSTCBPrio;
+    }
+    pring = OSRingFreeList;                           /* Get next free ring control block              */
+    if (pring == (OS_RING *)0) {                      /* See if pool of free rings was empty           */
+        OS_EXIT_CRITICAL();
+        *perr = OS_ERR_RING_DEPLETED;
+        return ((OS_RING *)0);
+    }
+    OSRingFreeList         = pring->OSRingNext;
+    OS_EXIT_CRITICAL();
+    pring->OSRingNext      = (OS_RING *)0;
+    pring->OSRingBuf       = (INT8U *)pbuf;           /* Store the ring                                */
+    pring->OSRingMask      = nentries - 1;
+    pring->OSRingEntrySize = size;
+    pring->OSRingIn        = 0;                       /* Ring is empty                                 */
+    pring->OSRingOut       = 0;
+    pring->OSRingDropCtr   = 0;
+    pring->OSRingPrio      = prio;
+    *perr                  = OS_ERR_NONE;
+    return (pring);
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                         POST AN ENTRY TO A RING
+*
+* Description : Append an entry to a ring.  This function never blocks and may be called from an ISR.
+*               When the entry makes the ring non-empty, the consumer is notified.
+*
+* Arguments   : pring    is a pointer to the ring.
+*
+*               pentry   is a pointer to the entry, which is copied into the ring.
+*
+* Returns     : OS_ERR_NONE                 if the entry was posted.
+*               OS_ERR_RING_FULL            if the ring is full, the entry is dropped and counted in
+*                                           'OSRingDropCtr'.
+*               OS_ERR_RING_INVALID_PRING   if 'pring' is a NULL pointer.
+*               OS_ERR_RING_INVALID_PDATA   if 'pentry' is a NULL pointer.
+*
+* Note(s)     : 1) Only one ISR or task may post to a ring.  No critical section is needed since it is
+*                  the only one moving 'OSRingIn'.  OS_CPU_BARRIER() keeps the compiler from moving the
+*                  copy of the entry after the store to 'OSRingIn', which hands it over to the consumer.
+*               2) The consumer is notified when it had taken every entry before this one, which is
+*                  when it may be waiting in OSRingPend().  The check is made after the entry is
+*                  visible, so a consumer that finds the ring empty and waits is always notified.
+*********************************************************************************************************
+*/
+
+INT8U  OSRingPost (OS_RING *pring, void *pentry)
+{
+    INT16U  in;
+    INT16U  size;
+
+
+#if OS_ARG_CHK_EN > 0
+    if (pring == (OS_RING *)0) {                      /* Validate 'pring'                              */
+        return (OS_ERR_RING_INVALID_PRING);
+    }
+    if (pentry == (void *)0) {                        /* Validate 'pentry'                             */
+        return (OS_ERR_RING_INVALID_PDATA);
+    }
+#endif
+    in = pring->OSRingIn;
+    if ((INT16U)(in - pring->OSRingOut) > pring->OSRingMask) {  /* Ring is full, drop the entry        */
+        pring->OSRingDropCtr++;
+        return (OS_ERR_RING_FULL);
+    }
+    size = pring->OSRingEntrySize;
+    OS_MemCopy(&pring->OSRingBuf[(in & pring->OSRingMask) * size], (INT8U *)pentry, size);
+    OS_CPU_BARRIER();                                 /* Entry is stored before it is handed over      */
+    pring->OSRingIn = in + 1;                         /* Hand the entry over to the consumer           */
+    if (pring->OSRingOut == in) {                     /* Wake the consumer if the ring was empty       */
+        (void)OSTaskNotifyPost(pring->OSRingPrio, 1, OS_NOTIFY_OPT_SET);
+    }
+    return (OS_ERR_NONE);
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                      ACCEPT ENTRIES FROM A RING
+*
+* Description : Take up to 'n' of the oldest entries of a ring at once.  This function is called by the
+*               consumer and never blocks.
+*
+* Arguments   : pring    is a pointer to the ring.
+*
+*               pdest    is a pointer to where the entries will be copied, an array of at least 'n'
+*                        entries.
+*
+*               n        is the largest number of entries to take.
+*
+* Returns     : The number of entries copied to 'pdest', 0 if the ring is empty or an argument is
+*               invalid.
+*
+* Note(s)     : 1) No critical section is needed since the consumer is the only one moving 'OSRingOut'.
+*                  OS_CPU_BARRIER() keeps the copy of the entries before the store to 'OSRingOut' which
+*                  hands their slots back to the producer.
+*********************************************************************************************************
+*/
+
+INT16U  OSRingAccept (OS_RING *pring, void *pdest, INT16U n)
+{
+    INT16U  out;
+    INT16U  cnt;
+    INT16U  first;
+    INT16U  size;
+    INT8U  *pdst;
+
+
+#if OS_ARG_CHK_EN > 0
+    if ((pring == (OS_RING *)0) || (pdest == (void *)0)) {
+        return (0);
+    }
+#endif
+    out = pring->OSRingOut;
+    cnt = pring->OSRingIn - out;                      /* Number of entries in the ring                 */
+    if (cnt > n) {
+        cnt = n;
+    }
+    if (cnt == 0) {
+        return (0);
+    }
+    size  = pring->OSRingEntrySize;
+    pdst  = (INT8U *)pdest;
+    first = pring->OSRingMask + 1 - (out & pring->OSRingMask);   /* Entries up to the end of storage   */
+    if (first > cnt) {
+        first = cnt;
+    }
+    OS_MemCopy(pdst, &pring->OSRingBuf[(out & pring->OSRingMask) * size], first * size);
+    if (first < cnt) {                                /* Rest of the entries from the start of storage */
+        OS_MemCopy(pdst + first * size, &pring->OSRingBuf[0], (cnt - first) * size);
+    }
+    OS_CPU_BARRIER();                                 /* Entries are read before the slots are freed   */
+    pring->OSRingOut = out + cnt;                     /* Hand the slots back to the producer           */
+    return (cnt);
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                      WAIT FOR ENTRIES OF A RING
+*
+* Description : Take up to 'n' of the oldest entries of a ring at once, and wait for a post if the ring is
+*               empty.  This function is called by the consumer.
+*
+* Arguments   : pring    is a pointer to the ring.
+*
+*               pdest    is a pointer to where the entries will be copied, an array of at least 'n'
+*                        entries.
+*
+*               n        is the largest number of entries to take.
+*
+*               timeout  is an optional timeout period (in clock ticks).  If non-zero, your task will
+*                        wait for an entry up to the amount of time specified by this argument.  If you
+*                        specify 0, however, your task will wait forever.
+*
+*               perr     is a pointer to where an error message will be deposited.  Possible error
+*                        messages are:
+*
+*                        OS_ERR_NONE                 at least one entry was copied to 'pdest'.
+*                        OS_ERR_TIMEOUT              no entry was posted within 'timeout'.
+*                        OS_ERR_PEND_ISR             if you called this function from an ISR.
+*                        OS_ERR_PEND_LOCKED          if you called this function when the scheduler is
+*                                                    locked.
+*                        OS_ERR_RING_INVALID_PRING   if 'pring' is a NULL pointer.
+*                        OS_ERR_RING_INVALID_PDATA   if 'pdest' is a NULL pointer or 'n' is 0.
+*
+* Returns     : The number of entries copied to 'pdest'.
+*
+* Note(s)     : 1) The consumer waits on its task notification word (see OSTaskNotifyPend()), which it
+*                  should not use for anything else.  A task consuming several rings waits with
+*                  OSTaskNotifyPend() itself and takes the entries of each with OSRingAccept().
+*               2) A notification left from entries already taken can end a wait early; the wait then
+*                  starts again with the full 'timeout'.
+*********************************************************************************************************
+*/
+
+INT16U  OSRingPend (OS_RING *pring, void *pdest, INT16U n, INT16U timeout, INT8U *perr)
+{
+    INT16U  cnt;
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                         /* Validate 'perr'                               */
+        return (0);
+    }
+    if (pring == (OS_RING *)0) {                      /* Validate 'pring'                              */
+        *perr = OS_ERR_RING_INVALID_PRING;
+        return (0);
+    }
+    if ((pdest == (void *)0) || (n == 0)) {           /* Validate 'pdest' and 'n'                      */
+        *perr = OS_ERR_RING_INVALID_PDATA;
+        return (0);
+    }
+#endif
+    if (OSIntNesting > 0) {                           /* See if called from ISR ...                    */
+        *perr = OS_ERR_PEND_ISR;                      /* ... can't PEND from an ISR                    */
+        return (0);
+    }
+    cnt = OSRingAccept(pring, pdest, n);
+    while (cnt == 0) {                                /* Wait until a post makes the ring non-empty    */
+        (void)OSTaskNotifyPend(timeout, OS_NOTIFY_OPT_CLR, perr);
+        if (*perr != OS_ERR_NONE) {                   /* Timed out, or not allowed to wait             */
+            return (0);
+        }
+        cnt = OSRingAccept(pring, pdest, n);
+    }
+    *perr = OS_ERR_NONE;
+    return (cnt);
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                       INITIALIZE SINGLE-PRODUCER RINGS
+*
+* Description : This function is called by uC/OS-II to initialize the rings.  Your application MUST NOT
+*               call this function.
+*
+* Arguments   : none
+*
+* Returns     : none
+*
+* Note(s)    : This function is INTERNAL to uC/OS-II and your application should not call it.
+*********************************************************************************************************
+*/
+
+void  OS_RingInit (void)
+{
+    OS_RING  *pring;
+    INT16U    i;
+
+
+    OS_MemClr((INT8U *)&OSRingTbl[0], sizeof(OSRingTbl)); /* Clear the ring table                      */
+    pring = &OSRingTbl[0];
+    for (i = 0; i < (OS_MAX_RINGS - 1); i++) {            /* Init. list of free rings                  */
+        pring->OSRingNext = &OSRingTbl[i+1];
+        pring++;
+    }
+    pring->OSRingNext = (OS_RING *)0;                     /* Initialize last node                      */
+    OSRingFreeList    = &OSRingTbl[0];                    /* Point to beginning of free list           */
+}
+#endif                                                    /* OS_RING_EN                                */
@@ -310,14 +310,16 @@ void  OSSemPend (OS_EVENT *pevent, INT16U timeout, INT8U *perr)
     OS_ENTER_CRITICAL();
     if (pevent->OSEventCnt > 0) {                     /* If sem. is positive, resource available ...   */
         pevent->OSEventCnt--;                         /* ... decrement semaphore only if positive.     */
+        OS_TRACE(OS_TRACE_SEM_PEND, OS_TRACE_EVENT_ID(pevent));
         OS_EXIT_CRITICAL();
         *perr = OS_ERR_NONE;
         return;
     }
                                                       /* Otherwise, must wait until event occurs       */
+    OS_TRACE(OS_TRACE_SEM_WAIT, OS_TRACE_EVENT_ID(pevent));
     OSTCBCur->OSTCBStat     |= OS_STAT_SEM;           /* Resource not available, pend on semaphore     */
     OSTCBCur->OSTCBStatPend  = OS_STAT_PEND_OK;
-    OSTCBCur->OSTCBDly       = timeout;               /* Store pend timeout in TCB                     */
+    OS_TickListInsert(OSTCBCur, timeout);             /* Store pend timeout in TCB                     */
     OS_EventTaskWait(pevent);                         /* Suspend task until event or timeout occurs    */
     OS_EXIT_CRITICAL();
     OS_Sched();                                       /* Find next highest priority task ready         */
@@ -467,6 +469,7 @@ INT8U  OSSemPost (OS_EVENT *pevent)
         return (OS_ERR_EVENT_TYPE);
     }
     OS_ENTER_CRITICAL();
+    OS_TRACE(OS_TRACE_SEM_POST, OS_TRACE_EVENT_ID(pevent));
     if (pevent->OSEventGrp != 0) {                    /* See if any task waiting for semaphore         */
                                                       /* Ready HPT waiting on event                    */
         (void)OS_EventTaskRdy(pevent, (void *)0, OS_STAT_SEM, OS_STAT_PEND_OK);
@@ -506,13 +509,8 @@ INT8U  OSSemPost (OS_EVENT *pevent)
 #if OS_SEM_QUERY_EN > 0
 INT8U  OSSemQuery (OS_EVENT *pevent, OS_SEM_DATA *p_sem_data)
 {
-#if OS_LOWEST_PRIO <= 63
-    INT8U     *psrc;
-    INT8U     *pdest;
-#else
-    INT16U    *psrc;
-    INT16U    *pdest;
-#endif
+    OS_PRIO_MAP *psrc;
+    OS_PRIO_MAP *pdest;
     INT8U      i;
 #if OS_CRITICAL_METHOD == 3                                /* Allocate storage for CPU status register */
     OS_CPU_SR  cpu_sr = 0;
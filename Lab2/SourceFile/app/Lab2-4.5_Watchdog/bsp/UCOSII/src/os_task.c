@@ -60,17 +60,10 @@ INT8U  OSTaskChangePrio (INT8U oldprio, INT8U newprio)
     INT8U      y_new;
     INT8U      x_new;
     INT8U      y_old;
-#if OS_LOWEST_PRIO <= 63
-    INT8U      bity_new;
-    INT8U      bitx_new;
-    INT8U      bity_old;
-    INT8U      bitx_old;
-#else
-    INT16U     bity_new;
-    INT16U     bitx_new;
-    INT16U     bity_old;
-    INT16U     bitx_old;
-#endif
+    OS_PRIO_MAP  bity_new;
+    OS_PRIO_MAP  bitx_new;
+    OS_PRIO_MAP  bity_old;
+    OS_PRIO_MAP  bitx_old;
 #if OS_CRITICAL_METHOD == 3
     OS_CPU_SR  cpu_sr = 0;                                  /* Storage for CPU status register         */
 #endif
@@ -104,17 +97,10 @@ INT8U  OSTaskChangePrio (INT8U oldprio, INT8U newprio)
         OS_EXIT_CRITICAL();                                 /* No, can't change its priority!          */
         return (OS_ERR_TASK_NOT_EXIST);
     }
-#if OS_LOWEST_PRIO <= 63
-    y_new                 = (INT8U)(newprio >> 3);          /* Yes, compute new TCB fields             */
-    x_new                 = (INT8U)(newprio & 0x07);
-    bity_new              = (INT8U)(1 << y_new);
-    bitx_new              = (INT8U)(1 << x_new);
-#else
-    y_new                 = (INT8U)((newprio >> 4) & 0x0F);
-    x_new                 = (INT8U)( newprio & 0x0F);
-    bity_new              = (INT16U)(1 << y_new);
-    bitx_new              = (INT16U)(1 << x_new);
-#endif
+    y_new                 = (INT8U)(newprio >> OS_PRIO_MAP_SHIFT);  /* Yes, compute new TCB fields     */
+    x_new                 = (INT8U)(newprio &  OS_PRIO_MAP_MASK);
+    bity_new              = (OS_PRIO_MAP)((OS_PRIO_MAP)1 << y_new);
+    bitx_new              = (OS_PRIO_MAP)((OS_PRIO_MAP)1 << x_new);
 
     OSTCBPrioTbl[oldprio] = (OS_TCB *)0;                    /* Remove TCB from old priority            */
     OSTCBPrioTbl[newprio] =  ptcb;                          /* Place pointer to TCB @ new priority     */
@@ -163,6 +149,14 @@ INT8U  OSTaskChangePrio (INT8U oldprio, INT8U newprio)
     ptcb->OSTCBX    = x_new;
     ptcb->OSTCBBitY = bity_new;
     ptcb->OSTCBBitX = bitx_new;
+#if OS_EDF_EN > 0
+    if (ptcb->OSTCBPeriod != 0) {                           /* Periodic task may enter or leave EDF    */
+        OS_EDFInsert(ptcb);
+    }
+#endif
+#if OS_RR_EN > 0
+    OS_RRInsert(ptcb);                                      /* May enter or leave round-robin band     */
+#endif
     OS_EXIT_CRITICAL();
     if (OSRunning == OS_TRUE) {
         OS_Sched();                                         /* Find new highest priority task          */
@@ -382,6 +376,70 @@ INT8U  OSTaskCreateExt (void   (*task)(void *p_arg),
 /*$PAGE*/
 /*
 *********************************************************************************************************
+*                                        CREATE A PERIODIC TASK
+*
+* Description: This function creates a task with OSTaskCreateExt() and makes it periodic.  The task is
+*              released for the first time when it is created and then every 'period' clock ticks.  The
+*              release times are absolute, so the task does not drift however long each job runs.  The
+*              task must end every job with OSTaskWaitNextPeriod().
+*
+* Arguments  : task, p_arg, ptos, prio, id, pbos, stk_size, pext, opt
+*                          are passed to OSTaskCreateExt(), see there.
+*
+*              period      is the period of the task in clock ticks.  The relative deadline of every job
+*                          is the next release, i.e. 'period' ticks after its own release.
+*
+* Returns    : OS_ERR_NONE               if the function was successful.
+*              OS_ERR_TASK_NOT_PERIODIC  if you specified a period of 0.
+*              Any other error code that OSTaskCreateExt() returns.
+*
+* Note(s)    : 1) The scheduler is locked while the task is created, so that the task cannot run before
+*                 its period is set.
+*********************************************************************************************************
+*/
+
+#if OS_TASK_PERIODIC_EN > 0
+INT8U  OSTaskCreatePeriodic (void   (*task)(void *p_arg),
+                             void    *p_arg,
+                             OS_STK  *ptos,
+                             INT8U    prio,
+                             INT16U   id,
+                             OS_STK  *pbos,
+                             INT32U   stk_size,
+                             void    *pext,
+                             INT16U   opt,
+                             INT16U   period)
+{
+    OS_TCB    *ptcb;
+    INT8U      err;
+#if OS_CRITICAL_METHOD == 3                  /* Allocate storage for CPU status register               */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+    if (period == 0) {                       /* A periodic task needs a period                         */
+        return (OS_ERR_TASK_NOT_PERIODIC);
+    }
+    OSSchedLock();                           /* Keep the new task from running before it is periodic   */
+    err = OSTaskCreateExt(task, p_arg, ptos, prio, id, pbos, stk_size, pext, opt);
+    if (err == OS_ERR_NONE) {
+        OS_ENTER_CRITICAL();
+        ptcb                = OSTCBPrioTbl[prio];
+        ptcb->OSTCBPeriod   = period;
+        ptcb->OSTCBRelease  = OSTime;        /* First job is released now                              */
+#if OS_EDF_EN > 0
+        OS_EDFInsert(ptcb);                  /* Scheduled by deadline if in the EDF band               */
+#endif
+        OS_EXIT_CRITICAL();
+    }
+    OSSchedUnlock();
+    return (err);
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
 *                                            DELETE A TASK
 *
 * Description: This function allows you to delete a task.  The calling task can delete itself by
@@ -481,7 +539,17 @@ INT8U  OSTaskDel (INT8U prio)
     }
 #endif
 
-    ptcb->OSTCBDly      = 0;                            /* Prevent OSTimeTick() from updating          */
+    OS_TickListRemove(ptcb);                            /* Prevent OSTimeTick() from updating          */
+#if OS_EDF_EN > 0
+    OS_EDFRemove(ptcb);                                 /* Prevent OS_SchedNew() from choosing it      */
+#endif
+#if OS_RR_EN > 0
+    OS_RRRemove(ptcb);
+#endif
+#if (OS_MEM_EN > 0) && (OS_MAX_MEM_PART > 0) && (OS_MEM_CLASS_EN > 0)
+    OS_MemMagFlush(ptcb);                               /* Return the blocks cached in its magazine    */
+    ptcb->OSTCBMemMag   = (OS_MEM_MAG *)0;
+#endif
     ptcb->OSTCBStat     = OS_STAT_RDY;                  /* Prevent task from being resumed             */
     ptcb->OSTCBStatPend = OS_STAT_PEND_OK;
     if (OSLockNesting < 255u) {                         /* Make sure we don't context switch           */
@@ -767,6 +835,186 @@ void  OSTaskNameSet (INT8U prio, INT8U *pname, INT8U *perr)
 }
 #endif
 
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                    WAIT FOR A TASK NOTIFICATION
+*
+* Description: This function waits until the notification word of the calling task is non-zero.  The
+*              notification word is a light-weight alternative to a semaphore or event flag group that is
+*              dedicated to one task: it needs no event control block and OSTaskNotifyPost() readies the
+*              task without going through an event wait list.
+*
+* Arguments  : timeout   is an optional timeout period (in clock ticks).  If non-zero, your task will
+*                        wait for a notification up to the amount of time specified by this argument.
+*                        If you specify 0, however, your task will wait forever.
+*
+*              opt       determines what happens to the notification word when it is returned:
+*                        OS_NOTIFY_OPT_CLR     the word is cleared, use this when the word holds bits
+*                                              set with OS_NOTIFY_OPT_SET.
+*                        OS_NOTIFY_OPT_DEC     the word is decremented by one, use this when the word
+*                                              counts posts made with OS_NOTIFY_OPT_INC.
+*
+*              perr      is a pointer to where an error message will be deposited.  Possible error
+*                        messages are:
+*
+*                        OS_ERR_NONE         The call was successful and your task received a notification.
+*                        OS_ERR_TIMEOUT      A notification was not received within the specified 'timeout'.
+*                        OS_ERR_INVALID_OPT  You specified an invalid option.
+*                        OS_ERR_PEND_ISR     If you called this function from an ISR.
+*                        OS_ERR_PEND_LOCKED  If you called this function when the scheduler is locked.
+*
+* Returns    : The notification word as it was before 'opt' was applied, or 0 if no notification was
+*              received.
+*********************************************************************************************************
+*/
+
+#if OS_TASK_NOTIFY_EN > 0
+INT32U  OSTaskNotifyPend (INT16U timeout, INT8U opt, INT8U *perr)
+{
+    INT32U     val;
+    INT8U      y;
+#if OS_CRITICAL_METHOD == 3                           /* Allocate storage for CPU status register      */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                         /* Validate 'perr'                               */
+        return (0);
+    }
+    if (opt > OS_NOTIFY_OPT_DEC) {                    /* Validate 'opt'                                */
+        *perr = OS_ERR_INVALID_OPT;
+        return (0);
+    }
+#endif
+    if (OSIntNesting > 0) {                           /* See if called from ISR ...                    */
+        *perr = OS_ERR_PEND_ISR;                      /* ... can't PEND from an ISR                    */
+        return (0);
+    }
+    if (OSLockNesting > 0) {                          /* See if called with scheduler locked ...       */
+        *perr = OS_ERR_PEND_LOCKED;                   /* ... can't PEND when locked                    */
+        return (0);
+    }
+    OS_ENTER_CRITICAL();
+    if (OSTCBCur->OSTCBNotifyVal == 0) {              /* Must wait until a notification is posted      */
+        OS_TRACE(OS_TRACE_NOTIFY_WAIT, 0);
+        OSTCBCur->OSTCBStat     |= OS_STAT_NOTIFY;
+        OSTCBCur->OSTCBStatPend  = OS_STAT_PEND_OK;
+        OS_TickListInsert(OSTCBCur, timeout);         /* Store pend timeout in TCB                     */
+        y             =  OSTCBCur->OSTCBY;            /* Task no longer ready                          */
+        OSRdyTbl[y]  &= ~OSTCBCur->OSTCBBitX;
+        if (OSRdyTbl[y] == 0) {
+            OSRdyGrp &= ~OSTCBCur->OSTCBBitY;
+        }
+        OS_EXIT_CRITICAL();
+        OS_Sched();                                   /* Find next highest priority task ready         */
+        OS_ENTER_CRITICAL();
+        if (OSTCBCur->OSTCBStatPend != OS_STAT_PEND_OK) {
+            OSTCBCur->OSTCBStat     = OS_STAT_RDY;    /* Timed out, or resumed by OSTimeDlyResume()    */
+            OSTCBCur->OSTCBStatPend = OS_STAT_PEND_OK;
+            OS_EXIT_CRITICAL();
+            *perr = OS_ERR_TIMEOUT;
+            return (0);
+        }
+    }
+    val = OSTCBCur->OSTCBNotifyVal;                   /* Consume the notification                      */
+    if (opt == OS_NOTIFY_OPT_DEC) {
+        OSTCBCur->OSTCBNotifyVal--;
+    } else {
+        OSTCBCur->OSTCBNotifyVal = 0;
+    }
+    OS_EXIT_CRITICAL();
+    *perr = OS_ERR_NONE;
+    return (val);
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                        POST A TASK NOTIFICATION
+*
+* Description: This function updates the notification word of a task and, if the task is waiting in
+*              OSTaskNotifyPend(), makes it ready to run.  It can be called from a task, an ISR or a timer
+*              callback and is the cheapest way to release a task from any of them.
+*
+* Arguments  : prio     is the priority of the task to notify.  If you specify OS_PRIO_SELF, the calling
+*                       task is notified.
+*
+*              val      is the value to OR into the notification word with OS_NOTIFY_OPT_SET.  It is not
+*                       used with OS_NOTIFY_OPT_INC.
+*
+*              opt      determines how the notification word is updated:
+*                       OS_NOTIFY_OPT_SET     OR 'val' into the word
+*                       OS_NOTIFY_OPT_INC     increment the word by one
+*
+* Returns    : OS_ERR_NONE              The call was successful and the notification was posted.
+*              OS_ERR_PRIO_INVALID      If the priority you specify is higher that the maximum allowed
+*                                       (i.e. >= OS_LOWEST_PRIO) or, you have not specified OS_PRIO_SELF.
+*              OS_ERR_INVALID_OPT       You specified an invalid option.
+*              OS_ERR_TASK_NOT_EXIST    If the task does not exist or is assigned to a Mutex PIP.
+*              OS_ERR_TASK_NOTIFY_OVF   If the notification count would overflow.
+*********************************************************************************************************
+*/
+
+#if OS_TASK_NOTIFY_EN > 0
+INT8U  OSTaskNotifyPost (INT8U prio, INT32U val, INT8U opt)
+{
+    OS_TCB    *ptcb;
+#if OS_CRITICAL_METHOD == 3                                   /* Storage for CPU status register       */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (prio >= OS_LOWEST_PRIO) {                             /* Make sure task priority is valid      */
+        if (prio != OS_PRIO_SELF) {
+            return (OS_ERR_PRIO_INVALID);
+        }
+    }
+    if (opt > OS_NOTIFY_OPT_INC) {                            /* Validate 'opt'                        */
+        return (OS_ERR_INVALID_OPT);
+    }
+#endif
+    OS_ENTER_CRITICAL();
+    if (prio == OS_PRIO_SELF) {                               /* See if notifying self                 */
+        ptcb = OSTCBCur;
+    } else {
+        ptcb = OSTCBPrioTbl[prio];
+    }
+    if ((ptcb == (OS_TCB *)0) || (ptcb == OS_TCB_RESERVED)) { /* Task to notify must exist             */
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_TASK_NOT_EXIST);
+    }
+    OS_TRACE(OS_TRACE_NOTIFY_POST, ptcb->OSTCBPrio);
+    if (opt == OS_NOTIFY_OPT_INC) {                           /* Update the notification word          */
+        if (ptcb->OSTCBNotifyVal == 0xFFFFFFFFL) {
+            OS_EXIT_CRITICAL();
+            return (OS_ERR_TASK_NOTIFY_OVF);
+        }
+        ptcb->OSTCBNotifyVal++;
+    } else {
+        ptcb->OSTCBNotifyVal |= val;
+    }
+    if (((ptcb->OSTCBStat & OS_STAT_NOTIFY) != OS_STAT_RDY) &&/* Ready the task if it is waiting ...    */
+        (ptcb->OSTCBNotifyVal != 0)) {                        /* ... and the word is now non-zero      */
+        OS_TickListRemove(ptcb);                              /* Prevent OSTimeTick() from readying it */
+        ptcb->OSTCBStat     &= ~(INT8U)OS_STAT_NOTIFY;
+        ptcb->OSTCBStatPend  =  OS_STAT_PEND_OK;
+        if ((ptcb->OSTCBStat & OS_STAT_SUSPEND) == OS_STAT_RDY) {
+            OSRdyGrp               |= ptcb->OSTCBBitY;        /* Put task in the ready to run list     */
+            OSRdyTbl[ptcb->OSTCBY] |= ptcb->OSTCBBitX;
+        }
+        OS_EXIT_CRITICAL();
+        OS_Sched();                                           /* Find highest priority task ready      */
+        return (OS_ERR_NONE);
+    }
+    OS_EXIT_CRITICAL();
+    return (OS_ERR_NONE);
+}
+#endif
 /*$PAGE*/
 /*
 *********************************************************************************************************
@@ -900,10 +1148,24 @@ INT8U  OSTaskStkChk (INT8U prio, OS_STK_DATA *p_stk_data)
     pchk  = ptcb->OSTCBStkBottom;
     OS_EXIT_CRITICAL();
 #if OS_STK_GROWTH == 1
+#if OS_MEM_WORD_EN > 0
+    while ((size - nfree >= 4) &&                     /* Skip four zero entries at a time ...          */
+           ((pchk[0] | pchk[1] | pchk[2] | pchk[3]) == (OS_STK)0)) {
+        pchk  += 4;
+        nfree += 4;
+    }
+#endif
     while (*pchk++ == (OS_STK)0) {                    /* Compute the number of zero entries on the stk */
         nfree++;
     }
 #else
+#if OS_MEM_WORD_EN > 0
+    while ((size - nfree >= 4) &&
+           ((pchk[0] | pchk[-1] | pchk[-2] | pchk[-3]) == (OS_STK)0)) {
+        pchk  -= 4;
+        nfree += 4;
+    }
+#endif
     while (*pchk-- == (OS_STK)0) {
         nfree++;
     }
@@ -1007,6 +1269,10 @@ INT8U  OSTaskSuspend (INT8U prio)
 *              OS_ERR_PRIO            if the desired task has not been created
 *              OS_ERR_TASK_NOT_EXIST  if the task is assigned to a Mutex PIP
 *              OS_ERR_PDATA_NULL      if 'p_task_data' is a NULL pointer
+*
+* Note(s)    : With OS_TICK_LIST_EN set, OSTCBDly in the TCB keeps the number of ticks that were requested,
+*              as only the deltas of the tick list count down.  The copy gets the number of ticks left
+*              instead, the sum of the deltas up to the task in the tick list, as without the list.
 *********************************************************************************************************
 */
 
@@ -1014,6 +1280,10 @@ INT8U  OSTaskSuspend (INT8U prio)
 INT8U  OSTaskQuery (INT8U prio, OS_TCB *p_task_data)
 {
     OS_TCB    *ptcb;
+#if OS_TICK_LIST_EN > 0
+    OS_TCB    *ptick;
+    INT16U     dly;
+#endif
 #if OS_CRITICAL_METHOD == 3                      /* Allocate storage for CPU status register           */
     OS_CPU_SR  cpu_sr = 0;
 #endif
@@ -1045,6 +1315,17 @@ INT8U  OSTaskQuery (INT8U prio, OS_TCB *p_task_data)
     }
                                                  /* Copy TCB into user storage area                    */
     OS_MemCopy((INT8U *)p_task_data, (INT8U *)ptcb, sizeof(OS_TCB));
+#if OS_TICK_LIST_EN > 0
+    if (ptcb->OSTCBDly != 0) {                   /* See if task is in the tick list                    */
+        dly   = 0;
+        ptick = OSTickList;
+        while (ptick != ptcb) {                  /* Add up the deltas up to the task ...               */
+            dly  += ptick->OSTCBTickDelta;
+            ptick = ptick->OSTCBTickNext;
+        }
+        p_task_data->OSTCBDly = dly + ptcb->OSTCBTickDelta;  /* ... to get the ticks left              */
+    }
+#endif
     OS_EXIT_CRITICAL();
     return (OS_ERR_NONE);
 }
@@ -1052,6 +1333,220 @@ INT8U  OSTaskQuery (INT8U prio, OS_TCB *p_task_data)
 /*$PAGE*/
 /*
 *********************************************************************************************************
+*                                       QUERY THE PROFILE OF A TASK
+*
+* Description: This function is called to obtain the execution profile of a task: the CPU cycles it has
+*              been running, its longest burst, the number of times it was switched in and the number of
+*              times it was preempted.  The counters are kept by OS_TaskProfileSw() on every context
+*              switch.  The cycles of the burst in progress of the calling task are included in the
+*              total.
+*
+* Arguments  : prio         is the priority of the task to obtain the profile of, or OS_PRIO_SELF.
+*
+*              p_prof       is a pointer to where the profile will be stored.
+*
+*              opt          is one of the following options:
+*
+*                           OS_PROFILE_OPT_NONE       leave the profile of the task unchanged
+*                           OS_PROFILE_OPT_CLR_MAX    clear the longest burst, so that the next query
+*                                                     returns the longest burst since this one
+*
+* Returns    : OS_ERR_NONE            if the profile was stored in 'p_prof'
+*              OS_ERR_PRIO_INVALID    if the priority you specify is higher that the maximum allowed
+*                                     (i.e. > OS_LOWEST_PRIO) or, you have not specified OS_PRIO_SELF.
+*              OS_ERR_PRIO            if the desired task has not been created
+*              OS_ERR_TASK_NOT_EXIST  if the task is assigned to a Mutex PIP
+*              OS_ERR_PDATA_NULL      if 'p_prof' is a NULL pointer
+*
+* Note(s)    : 1) The cycle counts wrap around every 2^32 cycles.  Differences between two queries are
+*                 valid as long as they are less than 2^32 cycles apart.
+*********************************************************************************************************
+*/
+
+#if OS_TASK_PROFILE_EN > 0
+INT8U  OSTaskProfileQuery (INT8U prio, OS_TASK_PROFILE *p_prof, INT8U opt)
+{
+    OS_TCB    *ptcb;
+#if OS_CRITICAL_METHOD == 3                      /* Allocate storage for CPU status register           */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+#if OS_ARG_CHK_EN > 0
+    if (prio > OS_LOWEST_PRIO) {                 /* Task priority valid ?                              */
+        if (prio != OS_PRIO_SELF) {
+            return (OS_ERR_PRIO_INVALID);
+        }
+    }
+    if (p_prof == (OS_TASK_PROFILE *)0) {        /* Validate 'p_prof'                                  */
+        return (OS_ERR_PDATA_NULL);
+    }
+#endif
+    OS_ENTER_CRITICAL();
+    if (prio == OS_PRIO_SELF) {
+        prio = OSTCBCur->OSTCBPrio;
+    }
+    ptcb = OSTCBPrioTbl[prio];
+    if (ptcb == (OS_TCB *)0) {                   /* Task to query must exist                           */
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_PRIO);
+    }
+    if (ptcb == OS_TCB_RESERVED) {               /* Task to query must not be assigned to a Mutex      */
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_TASK_NOT_EXIST);
+    }
+    p_prof->OSCyclesTot  = ptcb->OSTCBCyclesTot;
+    if (ptcb == OSTCBCur) {                      /* Add the burst in progress of the caller            */
+        p_prof->OSCyclesTot += OSCPUCyclesGet() - ptcb->OSTCBCyclesStart;
+    }
+    p_prof->OSCyclesMax  = ptcb->OSTCBCyclesMax;
+    p_prof->OSCtxSwCtr   = ptcb->OSTCBCtxSwCtr;
+    p_prof->OSPreemptCtr = ptcb->OSTCBPreemptCtr;
+    if (opt == OS_PROFILE_OPT_CLR_MAX) {
+        ptcb->OSTCBCyclesMax = 0L;
+    }
+    OS_EXIT_CRITICAL();
+    return (OS_ERR_NONE);
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                     ACCOUNT FOR A CONTEXT SWITCH
+*
+* Description: This function is called by the port's OSTaskSwHook() on every context switch, from
+*              OSTCBCur to OSTCBHighRdy.  It adds the cycles OSTCBCur has been running since it was
+*              switched in to its total, keeps its longest burst, and counts a preemption if OSTCBCur
+*              is still ready to run.  It then notes the time OSTCBHighRdy is switched in.
+*
+* Arguments  : none
+*
+* Returns    : none
+*
+* Notes      : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts are disabled during this call.
+*              3) Time spent in interrupt service routines is accounted to the interrupted task.
+*********************************************************************************************************
+*/
+
+#if OS_TASK_PROFILE_EN > 0
+void  OS_TaskProfileSw (void)
+{
+    OS_TCB  *ptcb;
+    INT32U   now;
+    INT32U   burst;
+
+
+    now = OSCPUCyclesGet();
+    if (OSRunning == OS_TRUE) {                  /* OSStartHighRdy() has no task to switch out         */
+        ptcb                  = OSTCBCur;
+        burst                 = now - ptcb->OSTCBCyclesStart;
+        ptcb->OSTCBCyclesTot += burst;
+        if (burst > ptcb->OSTCBCyclesMax) {
+            ptcb->OSTCBCyclesMax = burst;
+        }
+        if ((OSRdyTbl[ptcb->OSTCBY] & ptcb->OSTCBBitX) != 0) {
+            ptcb->OSTCBPreemptCtr++;             /* Switched out while still ready: preempted          */
+        }
+    }
+    OSTCBHighRdy->OSTCBCyclesStart = now;
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                 WAIT FOR THE NEXT RELEASE OF A PERIODIC TASK
+*
+* Description: This function is called by a task created with OSTaskCreatePeriodic() when it has
+*              finished its current job.  The task is delayed until its next release, which is exactly one
+*              period after the release of the current job, and is made ready to run by OSTimeTick().
+*
+*              If the next release is the current tick, the job finished in time and the next one starts
+*              at once.  If the next release has already passed, the job has missed its deadline.  The
+*              task is not delayed in either case.  Releases that passed while the job was still running are skipped, so
+*              that the task stays on its original release times, and every deadline that has passed is
+*              counted in OSTCBPeriodMissCtr.
+*
+* Arguments  : none
+*
+* Returns    : OS_ERR_NONE                the task was delayed until its next release, or its next release
+*                                         is the current tick and the next job starts at once.
+*              OS_ERR_TASK_DEADLINE_MISS  the current job missed its deadline, the next job starts at once.
+*              OS_ERR_TASK_NOT_PERIODIC   the calling task was not created with OSTaskCreatePeriodic().
+*              OS_ERR_TIME_DLY_ISR        if you called this function from an ISR.
+*              OS_ERR_PEND_LOCKED         if you called this function when the scheduler is locked.
+*********************************************************************************************************
+*/
+
+#if OS_TASK_PERIODIC_EN > 0
+INT8U  OSTaskWaitNextPeriod (void)
+{
+    INT32U     next;
+    INT32U     late;
+    INT32U     skipped;
+    INT8U      y;
+#if OS_CRITICAL_METHOD == 3                      /* Allocate storage for CPU status register           */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+    if (OSIntNesting > 0) {                      /* See if trying to call from an ISR                  */
+        return (OS_ERR_TIME_DLY_ISR);
+    }
+    if (OSLockNesting > 0) {                     /* See if called with scheduler locked ...            */
+        return (OS_ERR_PEND_LOCKED);
+    }
+    OS_ENTER_CRITICAL();
+    if (OSTCBCur->OSTCBPeriod == 0) {
+        OS_EXIT_CRITICAL();
+        return (OS_ERR_TASK_NOT_PERIODIC);
+    }
+    next = OSTCBCur->OSTCBRelease + OSTCBCur->OSTCBPeriod;
+    late = OSTime - next;                        /* Ticks since the next release, if it has passed     */
+    if ((INT32S)late < 0) {                      /* Next release is still ahead: wait for it           */
+        OSTCBCur->OSTCBRelease = next;
+        y            =  OSTCBCur->OSTCBY;        /* Delay current task                                 */
+        OSRdyTbl[y] &= ~OSTCBCur->OSTCBBitX;
+        if (OSRdyTbl[y] == 0) {
+            OSRdyGrp &= ~OSTCBCur->OSTCBBitY;
+        }
+        OS_TickListInsert(OSTCBCur, (INT16U)(next - OSTime));
+#if OS_EDF_EN > 0
+        OS_EDFInsert(OSTCBCur);                  /* Deadline of the next job                           */
+#endif
+        OS_EXIT_CRITICAL();
+        OS_Sched();                              /* Find next task to run!                             */
+        return (OS_ERR_NONE);
+    }
+    if (late == 0) {                             /* Next release is now: on time, start the next job   */
+        OSTCBCur->OSTCBRelease = next;
+#if OS_EDF_EN > 0
+        OS_EDFInsert(OSTCBCur);                  /* Deadline of the next job                           */
+        OS_EXIT_CRITICAL();
+        OS_Sched();
+#else
+        OS_EXIT_CRITICAL();
+#endif
+        return (OS_ERR_NONE);
+    }
+    skipped                       = late / OSTCBCur->OSTCBPeriod; /* Releases passed while running  */
+    OSTCBCur->OSTCBRelease        = next + skipped * OSTCBCur->OSTCBPeriod;
+    OSTCBCur->OSTCBPeriodMissCtr += skipped + 1;                   /* Deadlines missed               */
+#if OS_EDF_EN > 0
+    OS_EDFInsert(OSTCBCur);                      /* Later deadline, another job may come first now     */
+    OS_EXIT_CRITICAL();
+    OS_Sched();
+#else
+    OS_EXIT_CRITICAL();
+#endif
+    return (OS_ERR_TASK_DEADLINE_MISS);
+}
+#endif
+/*$PAGE*/
+/*
+*********************************************************************************************************
 *                                        CLEAR TASK STACK
 *
 * Description: This function is used to clear the stack of a task (i.e. write all zeros)
@@ -1070,6 +1565,9 @@ INT8U  OSTaskQuery (INT8U prio, OS_TCB *p_task_data)
 *                       specific.  See OS_TASK_OPT_??? in uCOS-II.H.
 *
 * Returns    : none
+*
+* Note       : With OS_MEM_WORD_EN set, the stack is cleared eight entries at a time and the entries
+*              past the last group of eight one at a time.
 *********************************************************************************************************
 */
 #if (OS_TASK_STAT_STK_CHK_EN > 0) && (OS_TASK_CREATE_EXT_EN > 0)
@@ -1078,11 +1576,39 @@ void  OS_TaskStkClr (OS_STK *pbos, INT32U size, INT16U opt)
     if ((opt & OS_TASK_OPT_STK_CHK) != 0x0000) {       /* See if stack checking has been enabled       */
         if ((opt & OS_TASK_OPT_STK_CLR) != 0x0000) {   /* See if stack needs to be cleared             */
 #if OS_STK_GROWTH == 1
+#if OS_MEM_WORD_EN > 0
+            while (size >= 8) {                        /* Clear eight entries at a time                */
+                pbos[0] = (OS_STK)0;
+                pbos[1] = (OS_STK)0;
+                pbos[2] = (OS_STK)0;
+                pbos[3] = (OS_STK)0;
+                pbos[4] = (OS_STK)0;
+                pbos[5] = (OS_STK)0;
+                pbos[6] = (OS_STK)0;
+                pbos[7] = (OS_STK)0;
+                pbos   += 8;
+                size   -= 8;
+            }
+#endif
             while (size > 0) {                         /* Stack grows from HIGH to LOW memory          */
                 size--;
                 *pbos++ = (OS_STK)0;                   /* Clear from bottom of stack and up!           */
             }
 #else
+#if OS_MEM_WORD_EN > 0
+            while (size >= 8) {
+                pbos[ 0] = (OS_STK)0;
+                pbos[-1] = (OS_STK)0;
+                pbos[-2] = (OS_STK)0;
+                pbos[-3] = (OS_STK)0;
+                pbos[-4] = (OS_STK)0;
+                pbos[-5] = (OS_STK)0;
+                pbos[-6] = (OS_STK)0;
+                pbos[-7] = (OS_STK)0;
+                pbos    -= 8;
+                size    -= 8;
+            }
+#endif
             while (size > 0) {                         /* Stack grows from LOW to HIGH memory          */
                 size--;
                 *pbos-- = (OS_STK)0;                   /* Clear from bottom of stack and down          */
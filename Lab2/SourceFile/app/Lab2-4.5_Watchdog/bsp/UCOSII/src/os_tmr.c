@@ -718,6 +718,96 @@ INT8U  OSTmrSignal (void)
 }
 #endif
 
+/*$PAGE*/
+/*
+************************************************************************************************************************
+*                                        SIGNAL SEVERAL TIMER UPDATES AT ONCE
+*
+* Description: This function is called by the port, with the tick stopped by the idle task (OS_TICKLESS_EN), for the
+*              signals due in the ticks that elapsed meanwhile.  It has the same effect as calling OSTmrSignal() 'n'
+*              times, but takes the same time whatever 'n' is: the first signal readies OSTmr_Task(), and the others
+*              are added to the count of the semaphore at once.
+*
+* Arguments  : n       is the number of signals.
+*
+* Returns    : OS_ERR_NONE         The call was successful and the timer task was signaled.
+*              OS_ERR_SEM_OVF      If the count of the semaphore would overflow.  The signals that fit are counted.
+*              OS_ERR_EVENT_TYPE   See OSTmrSignal().
+*              OS_ERR_PEVENT_NULL  See OSTmrSignal().
+************************************************************************************************************************
+*/
+
+#if (OS_TMR_EN > 0) && (OS_TICKLESS_EN > 0)
+INT8U  OSTmrSignalN (INT32U n)
+{
+    INT8U      err;
+#if OS_CRITICAL_METHOD == 3                                     /* Allocate storage for CPU status register            */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+    if (n == 0) {
+        return (OS_ERR_NONE);
+    }
+    err = OSSemPost(OSTmrSemSignal);                            /* Ready the timer task, or count the first signal     */
+    if (err != OS_ERR_NONE) {
+        return (err);
+    }
+    OS_ENTER_CRITICAL();
+    if (n - 1 > (INT32U)(65535u - OSTmrSemSignal->OSEventCnt)) {
+        OSTmrSemSignal->OSEventCnt = 65535u;                    /* Count the signals that fit                          */
+        err                        = OS_ERR_SEM_OVF;
+    } else {
+        OSTmrSemSignal->OSEventCnt += (INT16U)(n - 1);
+    }
+    OS_EXIT_CRITICAL();
+    return (err);
+}
+#endif
+
+/*$PAGE*/
+/*
+************************************************************************************************************************
+*                                        SIGNALS UNTIL THE FIRST TIMER EXPIRES
+*
+* Description: This function is called by the port, with the tick stopped by the idle task (OS_TICKLESS_EN), to find how
+*              many more times OSTmrSignal() must be called before a timer expires.  A spoke is sorted by expiry, so only
+*              the first timer of every spoke is looked at.
+*
+* Arguments  : none
+*
+* Returns    : The number of signals until the first running timer expires, 1 meaning at the next one, or 0 if no timer
+*              is running.
+*
+* Note(s)    : 1) This function assumes that interrupts are disabled.  The wheel is not locked: the idle task only runs
+*                 while OSTmr_Task() and every task that could hold the lock are blocked.
+************************************************************************************************************************
+*/
+
+#if (OS_TMR_EN > 0) && (OS_TICKLESS_EN > 0)
+INT32U  OSTmrNextGet (void)
+{
+    OS_TMR  *ptmr;
+    INT32U   remain;
+    INT32U   next;
+    INT16U   spoke;
+
+
+    next = 0;
+    for (spoke = 0; spoke < OS_TMR_CFG_WHEEL_SIZE; spoke++) {
+        ptmr = OSTmrWheelTbl[spoke].OSTmrFirst;
+        if (ptmr != (OS_TMR *)0) {
+            remain = ptmr->OSTmrMatch - OSTmrTime;                 /* Correct across OSTmrTime wrap-around            */
+            if ((next == 0) || (remain < next)) {
+                next = remain;
+            }
+        }
+    }
+    return (next);
+}
+#endif
+
 /*$PAGE*/
 /*
 ************************************************************************************************************************
@@ -836,6 +926,11 @@ void  OSTmr_Init (void)
 #endif
     OSTmrTime           = 0;
     OSTmrUsed           = 0;
+#if OS_TMR_CFG_STAT_EN > 0
+    OSTmrVisitCtr       = 0;
+    OSTmrVisitMax       = 0;
+    OSTmrVisitTot       = 0;
+#endif
     OSTmrFree           = OS_TMR_CFG_MAX;
     OSTmrFreeList       = &OSTmrTbl[0];
     OSTmrSem            = OSSemCreate(1);
@@ -933,8 +1028,9 @@ static  void  OSTmr_InitTask (void)
 ************************************************************************************************************************
 *                                         INSERT A TIMER INTO THE TIMER WHEEL
 *
-* Description: This function is called to insert the timer into the timer wheel.  The timer is always inserted at the
-*              beginning of the list.
+* Description: This function is called to insert the timer into the timer wheel.  Each spoke is kept sorted by the
+*              number of timer ticks left until the timer expires, so OSTmr_Task() only has to look at the timers
+*              at the beginning of the spoke.  A timer is inserted after the timers that expire at the same time.
 *
 * Arguments  : ptmr          Is a pointer to the timer to insert.
 *
@@ -950,8 +1046,10 @@ static  void  OSTmr_InitTask (void)
 static  void  OSTmr_Link (OS_TMR *ptmr, INT8U type)
 {
     OS_TMR       *ptmr1;
+    OS_TMR       *ptmr2;
     OS_TMR_WHEEL *pspoke;
     INT16U        spoke;
+    INT32U        remain;
 
 
     ptmr->OSTmrState = OS_TMR_STATE_RUNNING;
@@ -967,18 +1065,27 @@ static  void  OSTmr_Link (OS_TMR *ptmr, INT8U type)
     spoke  = (INT16U)(ptmr->OSTmrMatch % OS_TMR_CFG_WHEEL_SIZE);
     pspoke = &OSTmrWheelTbl[spoke];
 
-    if (pspoke->OSTmrFirst == (OS_TMR *)0) {                       /* Link into timer wheel                           */
-        pspoke->OSTmrFirst   = ptmr;
-        ptmr->OSTmrNext      = (OS_TMR *)0;
-        pspoke->OSTmrEntries = 1;
+    remain = ptmr->OSTmrMatch - OSTmrTime;                         /* Ticks left, correct across OSTmrTime wrap-around */
+    ptmr1  = (OS_TMR *)0;                                          /* Find the timer to insert after                  */
+    ptmr2  = pspoke->OSTmrFirst;
+    while (ptmr2 != (OS_TMR *)0) {
+        if ((ptmr2->OSTmrMatch - OSTmrTime) > remain) {
+            break;
+        }
+        ptmr1 = ptmr2;
+        ptmr2 = (OS_TMR *)ptmr2->OSTmrNext;
+    }
+    ptmr->OSTmrPrev = (void *)ptmr1;                               /* Link into timer wheel                           */
+    ptmr->OSTmrNext = (void *)ptmr2;
+    if (ptmr1 == (OS_TMR *)0) {
+        pspoke->OSTmrFirst = ptmr;
     } else {
-        ptmr1                = pspoke->OSTmrFirst;                 /* Point to first timer in the spoke               */
-        pspoke->OSTmrFirst   = ptmr;
-        ptmr->OSTmrNext      = (void *)ptmr1;
-        ptmr1->OSTmrPrev     = (void *)ptmr;
-        pspoke->OSTmrEntries++;
+        ptmr1->OSTmrNext   = (void *)ptmr;
     }
-    ptmr->OSTmrPrev = (void *)0;                                   /* Timer always inserted as first node in list     */
+    if (ptmr2 != (OS_TMR *)0) {
+        ptmr2->OSTmrPrev   = (void *)ptmr;
+    }
+    pspoke->OSTmrEntries++;
 }
 #endif
 
@@ -1079,10 +1186,12 @@ static  void  OSTmr_Task (void *p_arg)
 {
     INT8U            err;
     OS_TMR          *ptmr;
-    OS_TMR          *ptmr_next;
     OS_TMR_CALLBACK  pfnct;
     OS_TMR_WHEEL    *pspoke;
     INT16U           spoke;
+#if OS_TMR_CFG_STAT_EN > 0
+    INT16U           visited;
+#endif
 
 
     (void)p_arg;                                                 /* Not using 'p_arg', prevent compiler warning       */
@@ -1092,24 +1201,38 @@ static  void  OSTmr_Task (void *p_arg)
         OSTmrTime++;                                             /* Increment the current time                        */
         spoke  = (INT16U)(OSTmrTime % OS_TMR_CFG_WHEEL_SIZE);    /* Position on current timer wheel entry             */
         pspoke = &OSTmrWheelTbl[spoke];
-        ptmr   = pspoke->OSTmrFirst;
-        while (ptmr != (OS_TMR *)0) {
-            ptmr_next = (OS_TMR *)ptmr->OSTmrNext;               /* Point to next timer to update because current ... */
-                                                                 /* ... timer could get unlinked from the wheel.      */
-            if (OSTmrTime == ptmr->OSTmrMatch) {                 /* Process each timer that expires                   */
-                pfnct = ptmr->OSTmrCallback;                     /* Execute callback function if available            */
-                if (pfnct != (OS_TMR_CALLBACK)0) {
-                    (*pfnct)((void *)ptmr, ptmr->OSTmrCallbackArg);
-                }
-                OSTmr_Unlink(ptmr);                              /* Remove from current wheel spoke                   */
-                if (ptmr->OSTmrOpt == OS_TMR_OPT_PERIODIC) {
-                    OSTmr_Link(ptmr, OS_TMR_LINK_PERIODIC);      /* Recalculate new position of timer in wheel        */
-                } else {
-                    ptmr->OSTmrState = OS_TMR_STATE_COMPLETED;   /* Indicate that the timer has completed             */
-                }
+#if OS_TMR_CFG_STAT_EN > 0
+        visited = 0;
+#endif
+        for (;;) {                                               /* Spoke is sorted: expired timers are at the front  */
+            ptmr = pspoke->OSTmrFirst;                           /* ... and a re-linked timer goes behind them        */
+            if (ptmr == (OS_TMR *)0) {
+                break;
             }
-            ptmr = ptmr_next;
+#if OS_TMR_CFG_STAT_EN > 0
+            visited++;
+#endif
+            if (OSTmrTime != ptmr->OSTmrMatch) {                 /* Stop at the first timer that has not expired      */
+                break;
+            }
+            pfnct = ptmr->OSTmrCallback;                         /* Execute callback function if available            */
+            if (pfnct != (OS_TMR_CALLBACK)0) {
+                (*pfnct)((void *)ptmr, ptmr->OSTmrCallbackArg);
+            }
+            OSTmr_Unlink(ptmr);                                  /* Remove from current wheel spoke                   */
+            if (ptmr->OSTmrOpt == OS_TMR_OPT_PERIODIC) {
+                OSTmr_Link(ptmr, OS_TMR_LINK_PERIODIC);          /* Recalculate new position of timer in wheel        */
+            } else {
+                ptmr->OSTmrState = OS_TMR_STATE_COMPLETED;       /* Indicate that the timer has completed             */
+            }
+        }
+#if OS_TMR_CFG_STAT_EN > 0
+        OSTmrVisitCtr  = visited;                                /* Update the timer wheel statistics                 */
+        OSTmrVisitTot += visited;
+        if (visited > OSTmrVisitMax) {
+            OSTmrVisitMax = visited;
         }
+#endif
         OSTmr_Unlock();
     }
 }
@@ -0,0 +1,194 @@
+/*
+*********************************************************************************************************
+*                                                uC/OS-II
+*                                          The Real-Time Kernel
+*                                              EVENT TRACE
+*
+* File    : OS_TRACE.C
+* Version : V2.86
+*
+* The trace is a ring of 8 byte records, each stamped with OSCPUCyclesGet().  The kernel makes a record
+* on every context switch, ISR entry and exit, semaphore, mailbox and notification post, and on every
+* pend, telling whether the pend blocked.  Making a record is a few stores with interrupts already
+* disabled, so the trace can stay on in the field.  Once stopped, the application reads the ring out,
+* oldest record first, and dumps it in whatever way suits it; host/tools/trace2json turns the dump of
+* the Watchdog application into a Chrome trace.
+*********************************************************************************************************
+*/
+
+#ifndef  OS_MASTER_FILE
+#include <ucos_ii.h>
+#endif
+
+#if OS_TRACE_EN > 0
+/*
+*********************************************************************************************************
+*                                         READ RECORDS OF THE TRACE
+*
+* Description : Copy records out of a stopped trace, oldest first.  The ring holds the last
+*               OS_TRACE_SIZE records made before OSTraceStop(), which can be read in several calls.
+*
+* Arguments   : ix       is the number of the first record to copy, 0 being the oldest one in the ring.
+*
+*               prec     is a pointer to where the records will be copied.
+*
+*               nrecs    is the maximum number of records to copy.
+*
+*               perr     is a pointer to a variable containing an error message which will be set by
+*                        this function to either:
+*
+*                        OS_ERR_NONE                  if the records have been copied.
+*                        OS_ERR_TRACE_INVALID_PREC    if 'prec' is a NULL pointer.
+*                        OS_ERR_TRACE_RUNNING         if the trace has not been stopped.
+*
+* Returns     : The number of records copied, 0 once 'ix' is past the newest record.
+*********************************************************************************************************
+*/
+
+INT16U  OSTraceRead (INT32U ix, OS_TRACE_REC *prec, INT16U nrecs, INT8U *perr)
+{
+    INT32U  held;
+    INT32U  first;
+    INT16U  n;
+
+
+#if OS_ARG_CHK_EN > 0
+    if (perr == (INT8U *)0) {                         /* Validate 'perr'                               */
+        return (0);
+    }
+    if (prec == (OS_TRACE_REC *)0) {                  /* Must point to a valid destination             */
+        *perr = OS_ERR_TRACE_INVALID_PREC;
+        return (0);
+    }
+#endif
+    if (OSTraceOn == OS_TRUE) {                       /* The ring would change under our feet          */
+        *perr = OS_ERR_TRACE_RUNNING;
+        return (0);
+    }
+    held = OSTraceCtr;                                /* Older records have been overwritten           */
+    if (held > OS_TRACE_SIZE) {
+        held = OS_TRACE_SIZE;
+    }
+    first = OSTraceCtr - held;
+    n     = 0;
+    while ((ix < held) && (n < nrecs)) {
+        *prec++ = OSTraceBuf[(first + ix) & (OS_TRACE_SIZE - 1)];
+        ix++;
+        n++;
+    }
+    *perr = OS_ERR_NONE;
+    return (n);
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                             START THE TRACE
+*
+* Description : Empty the ring and start recording.  The trace is started by OSInit().
+*
+* Arguments   : none
+*
+* Returns     : none
+*********************************************************************************************************
+*/
+
+void  OSTraceStart (void)
+{
+#if OS_CRITICAL_METHOD == 3                           /* Allocate storage for CPU status register      */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+    OS_ENTER_CRITICAL();
+    OSTraceCtr = 0L;
+    OSTraceOn  = OS_TRUE;
+    OS_EXIT_CRITICAL();
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                             STOP THE TRACE
+*
+* Description : Stop recording, so that the ring can be read with OSTraceRead().
+*
+* Arguments   : none
+*
+* Returns     : The number of records made since the trace was started.  When it is larger than
+*               OS_TRACE_SIZE, the older records have been overwritten.
+*********************************************************************************************************
+*/
+
+INT32U  OSTraceStop (void)
+{
+    INT32U     ctr;
+#if OS_CRITICAL_METHOD == 3                           /* Allocate storage for CPU status register      */
+    OS_CPU_SR  cpu_sr = 0;
+#endif
+
+
+
+    OS_ENTER_CRITICAL();
+    OSTraceOn = OS_FALSE;
+    ctr       = OSTraceCtr;
+    OS_EXIT_CRITICAL();
+    return (ctr);
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                             MAKE A RECORD
+*
+* Description : Append a record to the ring, overwriting the oldest one when the ring is full.  This
+*               function is called through the OS_TRACE() macro, which compiles to nothing when
+*               OS_TRACE_EN is 0.
+*
+* Arguments   : type     is the type of the record (OS_TRACE_SW ...).
+*
+*               arg      is the argument of the record, see the record types in ucos_ii.h.
+*
+* Returns     : none
+*
+* Note(s)    : 1) This function is INTERNAL to uC/OS-II and your application should not call it.
+*              2) Interrupts must be disabled when calling this function.
+*              3) On a context switch, OSPrioCur is still the priority of the task switched out.
+*********************************************************************************************************
+*/
+
+void  OS_TraceRec (INT8U type, INT16U arg)
+{
+    OS_TRACE_REC  *prec;
+
+
+    if (OSTraceOn == OS_FALSE) {
+        return;
+    }
+    prec              = &OSTraceBuf[OSTraceCtr & (OS_TRACE_SIZE - 1)];
+    prec->OSTraceTime = OSCPUCyclesGet();
+    prec->OSTraceArg  = arg;
+    prec->OSTraceType = type;
+    prec->OSTracePrio = OSPrioCur;
+    OSTraceCtr++;
+}
+/*$PAGE*/
+/*
+*********************************************************************************************************
+*                                          INITIALIZE THE TRACE
+*
+* Description : This function is called by uC/OS-II to initialize the trace.  Your application MUST NOT
+*               call this function.
+*
+* Arguments   : none
+*
+* Returns     : none
+*
+* Note(s)    : This function is INTERNAL to uC/OS-II and your application should not call it.
+*********************************************************************************************************
+*/
+
+void  OS_TraceInit (void)
+{
+    OSTraceCtr = 0L;                                  /* Record from the first context switch on       */
+    OSTraceOn  = OS_TRUE;
+}
+#endif                                                /* OS_TRACE_EN                                   */
@@ -72,6 +72,23 @@ extern "C"
 extern void alt_avalon_timer_sc_init (void* base, alt_u32 irq_controller_id, 
                                       alt_u32 irq, alt_u32 freq);
 
+/*
+ * Tickless idle: the operating system stops the system clock tick while it
+ * is idle with alt_avalon_timer_sc_suppress(), and restarts it with
+ * alt_avalon_timer_sc_resume() on the next interrupt. See
+ * altera_avalon_timer_sc.c.
+ */
+
+extern int     alt_avalon_timer_sc_suppress (alt_u32 ticks);
+extern void    alt_avalon_timer_sc_resume (void);
+
+/*
+ * alt_avalon_timer_sc_cycles() is a free running count of the cycles of the
+ * system clock timer, which stays right while the tick is stopped.
+ */
+
+extern alt_u32 alt_avalon_timer_sc_cycles (void);
+
 /*
  * Variables used to store the timestamp parameters, when the device is to be
  * accessed using the high resolution timestamp driver.
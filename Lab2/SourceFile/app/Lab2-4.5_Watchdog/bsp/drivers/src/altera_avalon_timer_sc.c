@@ -41,6 +41,76 @@
 #include "alt_types.h"
 #include "sys/alt_log_printf.h"
 
+/*
+ * Tickless idle. When the system is idle, the operating system stops the
+ * tick by calling alt_avalon_timer_sc_suppress(), which stretches the timer
+ * period up to the first tick that has work to do, for the operating system
+ * or for an alarm. The first interrupt taken afterwards, of the timer or of
+ * any other device, calls alt_avalon_timer_sc_resume() before its ISR runs,
+ * which makes up for the ticks that were skipped with alt_tick_n() and
+ * returns to one interrupt per tick.
+ *
+ * The tick boundaries stay where the running tick would have put them: on
+ * resuming, the timer is first programmed for the rest of the current tick,
+ * and for the tick period once that expires. The interrupt latency by which
+ * the timer is restarted late then is kept in alt_sc_debt and taken off the
+ * next stretched period, so that the tick does not drift. Only the few
+ * cycles it takes to reprogram the timer are lost at each suppression.
+ */
+
+#define ALT_SC_RUN     0 /* the timer interrupts at every tick */
+#define ALT_SC_SLEEP   1 /* the period is stretched over several ticks */
+#define ALT_SC_EXPIRED 2 /* the stretched period expired, the ISR is due */
+#define ALT_SC_ALIGN   3 /* the period is the rest of the current tick */
+
+static void*   alt_sc_base;        /* the system clock timer */
+static alt_u32 alt_sc_period;      /* cycles of a tick */
+static alt_u32 alt_sc_load;        /* cycles of the period programmed */
+static alt_u32 alt_sc_first;       /* cycles from the suppression to the
+                                      first tick boundary */
+static alt_u32 alt_sc_ticks;       /* ticks the stretched period spans */
+static alt_u32 alt_sc_debt;        /* cycles the tick boundaries lag by */
+static alt_u8  alt_sc_state = ALT_SC_RUN;
+
+/*
+ * alt_sc_program() restarts the timer with a period of "cycles" clock
+ * cycles. Writing the period registers stops the timer.
+ */
+
+static void alt_sc_program (void* base, alt_u32 cycles)
+{
+  IOWR_ALTERA_AVALON_TIMER_PERIODL (base, (cycles - 1) & 0xFFFF);
+  IOWR_ALTERA_AVALON_TIMER_PERIODH (base, (cycles - 1) >> 16);
+  IOWR_ALTERA_AVALON_TIMER_CONTROL (base, 
+            ALTERA_AVALON_TIMER_CONTROL_ITO_MSK  |
+            ALTERA_AVALON_TIMER_CONTROL_CONT_MSK |
+            ALTERA_AVALON_TIMER_CONTROL_START_MSK);
+  alt_sc_load = cycles;
+}
+
+/*
+ * alt_sc_count() returns the counter of the timer, and in "to" whether a
+ * time-out is pending, read consistently.
+ */
+
+static alt_u32 alt_sc_count (void* base, alt_u32* to)
+{
+  alt_u32 count;
+
+  do
+  {
+    *to = IORD_ALTERA_AVALON_TIMER_STATUS (base) & 
+          ALTERA_AVALON_TIMER_STATUS_TO_MSK;
+    IOWR_ALTERA_AVALON_TIMER_SNAPL (base, 0);
+    count = ((IORD_ALTERA_AVALON_TIMER_SNAPH (base) & 
+              ALTERA_AVALON_TIMER_SNAPH_MSK) << 16) |
+             (IORD_ALTERA_AVALON_TIMER_SNAPL (base) & 
+              ALTERA_AVALON_TIMER_SNAPL_MSK);
+  } while ((IORD_ALTERA_AVALON_TIMER_STATUS (base) & 
+            ALTERA_AVALON_TIMER_STATUS_TO_MSK) != *to);
+  return count;
+}
+
 /* 
  * alt_avalon_timer_sc_irq() is the interrupt handler used for the system 
  * clock. This is called periodically when a timer interrupt occurs. The 
@@ -71,6 +141,33 @@ static void alt_avalon_timer_sc_irq (void* base, alt_u32 id)
   /* ALT_LOG - see altera_hal/HAL/inc/sys/alt_log_printf.h */
   ALT_LOG_SYS_CLK_HEARTBEAT();
 
+  /* 
+   * After a suppression, complete the tick the stretched period ended in,
+   * then return to the tick period. 
+   */
+  if (alt_sc_state != ALT_SC_RUN)
+  {
+    alt_u32 to;
+    alt_u32 since = alt_sc_load - 1 - alt_sc_count (base, &to);
+
+    if (since >= alt_sc_period)
+    {
+      alt_sc_debt += since - (alt_sc_period - 1);
+      since        = alt_sc_period - 1;
+    }
+    if (alt_sc_state == ALT_SC_EXPIRED)
+    {
+      alt_sc_program (base, alt_sc_period - since);
+      alt_sc_state = ALT_SC_ALIGN;
+    }
+    else
+    {
+      alt_sc_program (base, alt_sc_period);
+      alt_sc_debt += since;
+      alt_sc_state = ALT_SC_RUN;
+    }
+  }
+
   /* 
    * Notify the system of a clock tick. disable interrupts 
    * during this time to safely support ISR preemption
@@ -92,6 +189,15 @@ void alt_avalon_timer_sc_init (void* base, alt_u32 irq_controller_id,
   /* set the system clock frequency */
   
   alt_sysclk_init (freq);
+
+  /* remember the tick period, for stopping the tick */
+
+  alt_sc_base   = base;
+  alt_sc_period = (((IORD_ALTERA_AVALON_TIMER_PERIODH (base) & 
+                     ALTERA_AVALON_TIMER_PERIODH_MSK) << 16) |
+                    (IORD_ALTERA_AVALON_TIMER_PERIODL (base) & 
+                     ALTERA_AVALON_TIMER_PERIODL_MSK)) + 1;
+  alt_sc_load   = alt_sc_period;
   
   /* set to free running mode */
   
@@ -108,3 +214,125 @@ void alt_avalon_timer_sc_init (void* base, alt_u32 irq_controller_id,
   alt_irq_register (irq, base, alt_avalon_timer_sc_irq);
 #endif  
 }
+
+/*
+ * alt_avalon_timer_sc_suppress() stops the tick for up to "ticks" ticks:
+ * the next timer interrupt comes at the tick "ticks" ticks from now, or
+ * earlier if an alarm expires before. It is called by the operating system,
+ * with interrupts disabled, when it is idle. It returns non-zero if the tick
+ * was stopped, and zero if the next tick is due anyway.
+ */
+
+int alt_avalon_timer_sc_suppress (alt_u32 ticks)
+{
+  void*   base = alt_sc_base;
+  alt_u32 next = alt_tick_next ();
+  alt_u32 count;
+  alt_u32 debt;
+  alt_u32 to;
+  alt_u32 max;
+
+  if (next < ticks)
+  {
+    ticks = next;
+  }
+  if ((alt_sc_state != ALT_SC_RUN) || (ticks < 2))
+  {
+    return 0;
+  }
+  count = alt_sc_count (base, &to);
+  if (to)
+  {
+    return 0;                   /* a tick is pending */
+  }
+
+  /* the stretched period must fit in the 32 bit counter */
+
+  max = 1 + (0xFFFFFFFF - (count + 1)) / alt_sc_period;
+  if (ticks > max)
+  {
+    ticks = max;
+  }
+
+  /* catch up with the boundaries the tick would have had */
+
+  debt         = (alt_sc_debt <= count) ? alt_sc_debt : count;
+  alt_sc_debt -= debt;
+  alt_sc_first = count + 1 - debt;
+  alt_sc_ticks = ticks;
+  alt_sc_program (base, alt_sc_first + (ticks - 1) * alt_sc_period);
+  alt_sc_state = ALT_SC_SLEEP;
+  return 1;
+}
+
+/*
+ * alt_avalon_timer_sc_resume() restarts the tick after a suppression. It is
+ * called by the operating system, with interrupts disabled, when it enters
+ * the first ISR after alt_avalon_timer_sc_suppress(). The ticks that elapsed
+ * are announced with alt_tick_n(), except for the last tick of the stretched
+ * period if it expired: the timer ISR, which is due, announces that one.
+ */
+
+void alt_avalon_timer_sc_resume (void)
+{
+  void*   base = alt_sc_base;
+  alt_u32 elapsed;
+  alt_u32 ticks;
+  alt_u32 count;
+  alt_u32 to;
+
+  if (alt_sc_state != ALT_SC_SLEEP)
+  {
+    return;
+  }
+  count = alt_sc_count (base, &to);
+  if (to)
+  {
+    ticks        = alt_sc_ticks - 1;
+    alt_sc_state = ALT_SC_EXPIRED;
+  }
+  else
+  {
+    elapsed = alt_sc_load - 1 - count;
+    ticks   = (elapsed >= alt_sc_first) ? 
+              1 + (elapsed - alt_sc_first) / alt_sc_period : 0;
+    alt_sc_program (base, alt_sc_first + ticks * alt_sc_period - elapsed);
+    alt_sc_state = ALT_SC_ALIGN;
+  }
+  alt_tick_n (ticks);
+}
+
+/*
+ * alt_avalon_timer_sc_cycles() returns a free running count of the timer
+ * clock cycles: the ticks counted by alt_nticks() times the tick period,
+ * plus the cycles elapsed since the last of them, read from the counter. It
+ * is meant for a system without a timestamp timer, and wraps around every
+ * 2^32 cycles. Interrupts must be disabled.
+ */
+
+alt_u32 alt_avalon_timer_sc_cycles (void)
+{
+  alt_u32 count;
+  alt_u32 since;
+  alt_u32 to;
+
+  count = alt_sc_count (alt_sc_base, &to);
+  if (alt_sc_state == ALT_SC_SLEEP)
+  {
+    /* the last tick counted ended before the suppression */
+
+    since = alt_sc_period - alt_sc_first + (alt_sc_load - 1 - count) + 
+            (to ? alt_sc_load : 0);
+  }
+  else if (to)
+  {
+    /* a pending time-out is a tick the ISR did not count yet */
+
+    since = alt_sc_period + (alt_sc_load - 1 - count);
+  }
+  else
+  {
+    since = alt_sc_period - 1 - count;
+  }
+  return alt_nticks () * alt_sc_period + since + alt_sc_debt;
+}
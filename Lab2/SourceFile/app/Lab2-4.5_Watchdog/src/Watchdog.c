@@ -17,6 +17,34 @@
  *   be exchanged for alt_printf where hexadecimals are supported and also
  *   quite readable. This modification is easily motivated and accepted by the course
  *   staff.
+ *
+ *   The periodic tasks do not print themselves. They post their messages to
+ *   their own log with OSLogPost(), and the LogDrain task, which has the
+ *   lowest priority, formats and prints them.
+ *
+ *   The kernel profiles the tasks in the context switch hook. Every
+ *   PROFILE_PERIODS watchdog periods, and at an overload, the Watchdog task
+ *   takes a snapshot of the profiles with OSTaskProfileQuery(), which
+ *   LogDrain prints as a table: the share of the CPU, the longest burst and
+ *   the number of preemptions of each task since the previous snapshot.
+ *
+ *   The kernel also keeps a trace of the last context switches, ISRs,
+ *   posts and pends. When an overload begins, the Watchdog task stops the
+ *   trace, and LogDrain dumps it and starts it again. host/tools/trace2json
+ *   turns the dump into a timeline.
+ *
+ *   After PLACE_PERIODS watchdog periods LogDrain prints the usage of the
+ *   stacks, the switches into every task and the sizes of the hot kernel
+ *   tables. host/tools/memplace turns them into a linker script that moves
+ *   the tables and the busiest stacks, sized after the bytes used found by
+ *   a full scan of each stack, to onchip_memory. The tasks clear their
+ *   stacks when they are created, as the stacks placed there are not
+ *   cleared at reset.
+ *
+ *   ButtonIO and SwitchIO do not poll the buttons and switches. The edge
+ *   capture interrupts of their PIOs start a debounce alarm, and the tasks
+ *   only run when the debounced state of their input changed, so a press
+ *   reaches ControlTask in its next period.
  */
 #include <stdio.h>
 #include "system.h"
@@ -25,6 +53,7 @@
 #include "sys/alt_irq.h"
 #include "sys/alt_alarm.h"
 #include "altera_avalon_performance_counter.h"
+#include "cruise.h"
 
 #define DEBUG 1
 
@@ -62,14 +91,45 @@
 
 #define TASK_STACKSIZE 2048
 
+/*
+ * Stack sizes of the tasks, in OS_STK entries. host/tools/memplace
+ * defines them for the stacks it moves to onchip_memory, sized after their
+ * high-water marks.
+ */
+#ifndef CONTROLTASK_STACKSIZE
+#define CONTROLTASK_STACKSIZE TASK_STACKSIZE
+#endif
+#ifndef VEHICLETASK_STACKSIZE
+#define VEHICLETASK_STACKSIZE TASK_STACKSIZE
+#endif
+#ifndef BUTTONIO_STACKSIZE
+#define BUTTONIO_STACKSIZE TASK_STACKSIZE
+#endif
+#ifndef SWITCHIO_STACKSIZE
+#define SWITCHIO_STACKSIZE TASK_STACKSIZE
+#endif
+#ifndef DETECTION_STACKSIZE
+#define DETECTION_STACKSIZE TASK_STACKSIZE
+#endif
+#ifndef WATCHDOG_STACKSIZE
+#define WATCHDOG_STACKSIZE TASK_STACKSIZE
+#endif
+#ifndef EXTRALOAD_STACKSIZE
+#define EXTRALOAD_STACKSIZE TASK_STACKSIZE
+#endif
+#ifndef LOGDRAIN_STACKSIZE
+#define LOGDRAIN_STACKSIZE TASK_STACKSIZE
+#endif
+
 OS_STK StartTask_Stack[TASK_STACKSIZE]; 
-OS_STK ControlTask_Stack[TASK_STACKSIZE]; 
-OS_STK VehicleTask_Stack[TASK_STACKSIZE];
-OS_STK ButtonIO_Stack[TASK_STACKSIZE];
-OS_STK SwitchIO_Stack[TASK_STACKSIZE];
-OS_STK Detection_Stack[TASK_STACKSIZE];
-OS_STK Watchdog_Stack[TASK_STACKSIZE];
-OS_STK Extraload_Stack[TASK_STACKSIZE];
+OS_STK ControlTask_Stack[CONTROLTASK_STACKSIZE];
+OS_STK VehicleTask_Stack[VEHICLETASK_STACKSIZE];
+OS_STK ButtonIO_Stack[BUTTONIO_STACKSIZE];
+OS_STK SwitchIO_Stack[SWITCHIO_STACKSIZE];
+OS_STK Detection_Stack[DETECTION_STACKSIZE];
+OS_STK Watchdog_Stack[WATCHDOG_STACKSIZE];
+OS_STK Extraload_Stack[EXTRALOAD_STACKSIZE];
+OS_STK LogDrain_Stack[LOGDRAIN_STACKSIZE];
 
 // Task Priorities
 
@@ -81,74 +141,150 @@ OS_STK Extraload_Stack[TASK_STACKSIZE];
 #define DETECTION_PRIO    14  // lowest priority.
 #define WATCHDOG_PRIO      7
 #define EXTRALOAD_PRIO    13      
+#define LOGDRAIN_PRIO     16  // below Detection, prints only in idle time
 
-// Task Periods
+// Task Periods (ms). Vehicle and Control are periodic tasks released by the
+// kernel, ButtonIO and SwitchIO are released by their input (see below) and
+// the others by SW timers.
 
 #define CONTROL_PERIOD   300
 #define VEHICLE_PERIOD   300
-#define BUTTONIO_PERIOD  300
-#define SWITCHIO_PERIOD  300
 #define DETECTION_PERIOD 300
 #define WATCHDOG_PERIOD  300
 #define EXTRALOAD_PERIOD 300
 
+#define MS_TO_TICKS(ms) ((ms) * OS_TICKS_PER_SEC / 1000)
+
 /*
  * Definition of Kernel Objects 
  */
 
-// Mailboxes
-OS_EVENT *Mbox_Throttle;
-OS_EVENT *Mbox_Velocity;
-OS_EVENT *Mbox_Brake;
-OS_EVENT *Mbox_BrakeButton;
-OS_EVENT *Mbox_Engine;
-OS_EVENT *Mbox_EngineSwitch;
-OS_EVENT *Mbox_Gas;
-OS_EVENT *Mbox_Gear;
-OS_EVENT *Mbox_Cruise;
-
-// Semaphores
-OS_EVENT *VehicleSem;
-OS_EVENT *ControlSem;
-OS_EVENT *ButtonIOSem;
-OS_EVENT *SwitchIOSem;
-OS_EVENT *DetectionSem;
-OS_EVENT *WatchdogSem;
-OS_EVENT *ExtraloadSem;
-
-// Callbackfunctions
-void VehicleCallback(void *ptmr, void *callback_arg) {
-  OSSemPost(VehicleSem);
-}
-void ControlCallback(void *ptmr, void *callback_arg) {
-  OSSemPost(ControlSem);
-}
-void ButtonIOCallback(void *ptmr, void *callback_arg) {
-  OSSemPost(ButtonIOSem);
-}
-void SwitchIOCallback(void *ptmr, void *callback_arg) {
-  OSSemPost(SwitchIOSem);
-}
+// Callbackfunctions, they release the watchdog tasks by a task notification
 void WatchdogCallback(void *ptmr, void *callback_arg) {
-    OSSemPost(WatchdogSem);
+    OSTaskNotifyPost(WATCHDOG_PRIO, 0, OS_NOTIFY_OPT_INC);
 }
 void ExtraloadCallback(void *ptmr, void *callback_arg) {
-    OSSemPost(ExtraloadSem);
+    OSTaskNotifyPost(EXTRALOAD_PRIO, 0, OS_NOTIFY_OPT_INC);
 }
 
 // SW-Timer
-OS_TMR *VehicleTmr;
-OS_TMR *ControlTmr;
-OS_TMR *ButtonIOTmr;
-OS_TMR *SwitchIOTmr;
 OS_TMR *WatchdogTmr;
 OS_TMR *ExtraloadTmr;
 
 /*
  * Types
  */
-enum active {on = 2, off = 1};
+// enum active and the records carried by the state channels are
+// declared in cruise.h
+
+/*
+ * State channels, each holding the latest record of its writer. Readers
+ * keep their own copy and keep it unchanged as long as nothing was written.
+ */
+OS_CHAN *Chan_Vehicle;   // Written by VehicleTask
+OS_CHAN *Chan_Actuators;
+OS_CHAN *Chan_Buttons;
+OS_CHAN *Chan_Switches;
+
+struct vehicle Chan_Vehicle_Buf[2];
+struct actuators Chan_Actuators_Buf[2];
+struct buttons Chan_Buttons_Buf[2];
+struct switches Chan_Switches_Buf[2];
+
+/*
+ * Logs of the tasks that print, one ring of LOG_RECORDS records each
+ */
+#define LOG_RECORDS 16
+
+static const INT8U log_prio[] = {VEHICLETASK_PRIO, CONTROLTASK_PRIO,
+  BUTTONIO_PRIO, SWITCHIO_PRIO, WATCHDOG_PRIO, EXTRALOAD_PRIO};
+
+#define LOGS (sizeof(log_prio) / sizeof(log_prio[0]))
+
+OS_LOG_REC Log_Buf[LOGS][LOG_RECORDS];
+
+/*
+ * Task profile since the previous snapshot, written by the Watchdog task
+ * while Profile_Ready is 0 and printed by LogDrain while it is 1
+ */
+#define PROFILE_PERIODS 10 /* 3 s */
+
+struct profile_entry {
+  INT8U prio;
+  INT32U cycles;        // run in the window
+  INT32U max;           // longest burst
+  INT32U preempts;
+};
+
+struct profile {
+  struct profile_entry task[OS_LOWEST_PRIO + 1];
+  int tasks;
+  INT32U window;        // cycles since the previous snapshot
+  int overload;
+};
+
+static struct profile Profile;
+static volatile int Profile_Ready = 0;
+
+/*
+ * Number of records made in the trace, set by the Watchdog task when it
+ * stops the trace and cleared by LogDrain once it has dumped it
+ */
+static volatile INT32U Trace_Stopped = 0;
+
+/*
+ * Names of the tasks, shown in the trace
+ */
+static const struct {
+  INT8U prio;
+  char* name;
+} task_names[] = {
+  {VEHICLETASK_PRIO, "VehicleTask"}, {CONTROLTASK_PRIO, "ControlTask"},
+  {BUTTONIO_PRIO, "ButtonIO"}, {SWITCHIO_PRIO, "SwitchIO"},
+  {DETECTION_PRIO, "Detection"}, {WATCHDOG_PRIO, "Watchdog"},
+  {EXTRALOAD_PRIO, "Extraload"}, {LOGDRAIN_PRIO, "LogDrain"}};
+
+#define TASK_NAMES (sizeof(task_names) / sizeof(task_names[0]))
+
+/*
+ * Set by the Watchdog task after PLACE_PERIODS periods, when LogDrain
+ * prints the usage of the stacks once for host/tools/memplace. The cycle
+ * counts of the profiles wrap after 86 s.
+ */
+#define PLACE_PERIODS 100 /* 30 s */
+
+static volatile int Place_Ready = 0;
+
+/*
+ * Stacks of the tasks that keep running, with the macros of their sizes
+ * ("-" for the stacks of the kernel, sized by the BSP)
+ */
+#define STACK(prio, stk, size) {prio, #stk, #size, sizeof(stk)}
+
+static const struct {
+  INT8U prio;
+  char* name;
+  char* size;
+  INT32U bytes;
+} task_stacks[] = {
+  STACK(VEHICLETASK_PRIO, VehicleTask_Stack, VEHICLETASK_STACKSIZE),
+  STACK(CONTROLTASK_PRIO, ControlTask_Stack, CONTROLTASK_STACKSIZE),
+  STACK(BUTTONIO_PRIO, ButtonIO_Stack, BUTTONIO_STACKSIZE),
+  STACK(SWITCHIO_PRIO, SwitchIO_Stack, SWITCHIO_STACKSIZE),
+  STACK(DETECTION_PRIO, Detection_Stack, DETECTION_STACKSIZE),
+  STACK(WATCHDOG_PRIO, Watchdog_Stack, WATCHDOG_STACKSIZE),
+  STACK(EXTRALOAD_PRIO, Extraload_Stack, EXTRALOAD_STACKSIZE),
+  STACK(LOGDRAIN_PRIO, LogDrain_Stack, LOGDRAIN_STACKSIZE),
+  STACK(OS_TASK_IDLE_PRIO, OSTaskIdleStk, -),
+#if OS_TASK_STAT_EN > 0
+  STACK(OS_TASK_STAT_PRIO, OSTaskStatStk, -),
+#endif
+#if OS_TMR_EN > 0
+  STACK(OS_TASK_TMR_PRIO, OSTmrTaskStk, -),
+#endif
+};
 
+#define TASK_STACKS (sizeof(task_stacks) / sizeof(task_stacks[0]))
 
 /*
  * Global variables
@@ -160,14 +296,109 @@ int OKSignal = 0;
 
 
 /*
- * Helper functions
+ * Inputs of the buttons and switches. The edge capture interrupt of a PIO
+ * is masked and starts the debounce alarm of the input, which samples the
+ * pins every DEBOUNCE_MS. The same value read twice in a row is the new
+ * state of the input, which the IO task of the input is notified of. Once
+ * the pins are stable the interrupt is unmasked again, except while a
+ * button is held: the PIO only captures the press of the buttons, so the
+ * alarm samples them until they are all released.
+ */
+#define DEBOUNCE_MS 10
+
+struct input {
+  alt_u32 base;
+  alt_u32 ic_id;
+  alt_u32 irq;
+  alt_u32 pins;             // Pins of the input
+  alt_u32 invert;           // Active low pins
+  alt_u32 held;             // Pins whose release is not captured
+  INT8U prio;               // IO task notified of a new state
+  alt_alarm alarm;
+  alt_u32 sample;           // Last sample of the pins
+  volatile alt_u32 state;   // Debounced state, 1 for active pins
+};
+
+static struct input Keys = {D2_PIO_KEYS4_BASE,
+  D2_PIO_KEYS4_IRQ_INTERRUPT_CONTROLLER_ID, D2_PIO_KEYS4_IRQ,
+  GAS_PEDAL_FLAG | BRAKE_PEDAL_FLAG | CRUISE_CONTROL_FLAG,
+  GAS_PEDAL_FLAG | BRAKE_PEDAL_FLAG | CRUISE_CONTROL_FLAG,
+  GAS_PEDAL_FLAG | BRAKE_PEDAL_FLAG | CRUISE_CONTROL_FLAG, BUTTONIO_PRIO};
+
+// The other switches set the Extraload, which reads them itself
+static struct input Switches = {DE2_PIO_TOGGLES18_BASE,
+  DE2_PIO_TOGGLES18_IRQ_INTERRUPT_CONTROLLER_ID, DE2_PIO_TOGGLES18_IRQ,
+  TOP_GEAR_FLAG | ENGINE_FLAG, 0, 0, SWITCHIO_PRIO};
+
+static alt_u32 debounce; // DEBOUNCE_MS in alarm ticks
+
+static alt_u32 input_read(struct input* in)
+{
+  return (IORD_ALTERA_AVALON_PIO_DATA(in->base) ^ in->invert) & in->pins;
+}
+
+/*
+ * Debounce alarm of an input
+ */
+static alt_u32 input_debounce(void* context)
+{
+  struct input* in = context;
+  alt_u32 value = input_read(in);
+
+  if (value != in->sample) {
+    in->sample = value;
+    return debounce;
+  }
+  if (value != in->state) {
+    in->state = value;
+    OSTaskNotifyPost(in->prio, 1, OS_NOTIFY_OPT_SET);
+  }
+  if (value & in->held) {
+    return debounce;
+  }
+  // Wait for the next edge, unless the pins changed since the sample
+  IOWR_ALTERA_AVALON_PIO_EDGE_CAP(in->base, in->pins);
+  if (input_read(in) != value) {
+    return debounce;
+  }
+  IOWR_ALTERA_AVALON_PIO_IRQ_MASK(in->base, in->pins);
+  return 0;
+}
+
+/*
+ * ISR for the edge capture of an input
  */
+static void input_isr(void* context)
+{
+  struct input* in = context;
 
-int buttons_pressed(void)
+  IOWR_ALTERA_AVALON_PIO_IRQ_MASK(in->base, 0);
+  IOWR_ALTERA_AVALON_PIO_EDGE_CAP(in->base, in->pins);
+  alt_alarm_start(&in->alarm, debounce, input_debounce, in);
+}
+
+/*
+ * Takes the current pins of an input as its state and starts listening to
+ * its edges
+ */
+static void input_init(struct input* in)
 {
-  return ~IORD_ALTERA_AVALON_PIO_DATA(D2_PIO_KEYS4_BASE);    
+  in->state = in->sample = input_read(in);
+  IOWR_ALTERA_AVALON_PIO_IRQ_MASK(in->base, 0);
+  IOWR_ALTERA_AVALON_PIO_EDGE_CAP(in->base, in->pins);
+  alt_ic_isr_register(in->ic_id, in->irq, input_isr, in, NULL);
+  if (in->state & in->held) {
+    alt_alarm_start(&in->alarm, debounce, input_debounce, in);
+  }
+  else {
+    IOWR_ALTERA_AVALON_PIO_IRQ_MASK(in->base, in->pins);
+  }
 }
 
+/*
+ * Helper functions
+ */
+
 int switches_pressed(void)
 {
   return IORD_ALTERA_AVALON_PIO_DATA(DE2_PIO_TOGGLES18_BASE);    
@@ -293,266 +524,127 @@ void show_position(INT16U position)
 
 /*
  * The task 'VehicleTask' is the model of the vehicle being simulated. It updates variables like
- * acceleration and velocity based on the input given to the model.
- * 
- * The car model is equivalent to moving mass with linear resistances acting upon it.
- * Therefore, if left one, it will stably stop as the velocity converges to zero on a flat surface.
- * You can prove that easily via basic LTI systems methods.
+ * acceleration and velocity based on the input given to the model (see vehicle.c).
  */
 void VehicleTask(void* pdata)
 { 
-  // constants that should not be modified
-  const unsigned int wind_factor = 1;
-  const unsigned int brake_factor = 4;
-  const unsigned int gravity_factor = 2;
-  // variables relevant to the model and its simulation on top of the RTOS
   INT8U err;  
-  void* msg;
-  INT8U* throttle; 
-  INT16S acceleration;  
-  INT16U position = 0; 
-  INT16S velocity = 0; 
-  enum active* brake_pedal = off;
-  enum active* engine = off;
+  // Used until ControlTask writes the actuators for the first time
+  struct actuators act = {0, off, off};
+  struct vehicle v;
+  INT16U position;
+  INT16S velocity;
 
-  printf("Vehicle task created!\n");
+  vehicle_init(&v);
+  OSLogPost("Vehicle task created!\n", 0, 0);
 
   while(1)
   {
-    err = OSMboxPost(Mbox_Velocity, (void *) &velocity);
-
-    //OSTimeDlyHMSM(0,0,0,VEHICLE_PERIOD); 
-    OSSemPend(VehicleSem, 0, &err);
-
-    /* Non-blocking read of mailbox: 
-       - message in mailbox: update throttle
-       - no message:         use old throttle
-       */
-    msg = OSMboxPend(Mbox_Throttle, 1, &err); 
-    if (err == OS_NO_ERR) 
-      throttle = (INT8U*) msg;
-    /* Same for the brake signal that bypass the control law */
-    msg = OSMboxPend(Mbox_Brake, 1, &err); 
-    if (err == OS_NO_ERR) 
-      brake_pedal = (enum active*) msg;
-    /* Same for the engine signal that bypass the control law */
-    msg = OSMboxPend(Mbox_Engine, 1, &err); 
-    if (err == OS_NO_ERR) 
-      engine = (enum active*) msg;
-
-
-    // vehichle cannot effort more than 80 units of throttle
-    if (*throttle > 80) *throttle = 80;
-
-    // brakes + wind
-    if (*brake_pedal == off)
-    {
-      // wind resistance
-      acceleration = - wind_factor*velocity;
-      // actuate with engines
-      if (*engine == on) { 
-        acceleration += (*throttle);
-      }
+    OSChanWrite(Chan_Vehicle, &v);
 
-      // gravity effects
-      if (400 <= position && position < 800)
-        acceleration -= gravity_factor; // traveling uphill
-      else if (800 <= position && position < 1200)
-        acceleration -= 2*gravity_factor; // traveling steep uphill
-      else if (1600 <= position && position < 2000)
-        acceleration += 2*gravity_factor; //traveling downhill
-      else if (2000 <= position)
-        acceleration += gravity_factor; // traveling steep downhill
-    }
-    // if the engine and the brakes are activated at the same time,
-    // we assume that the brake dynamics dominates, so both cases fall
-    // here.
-    else 
-      acceleration = - brake_factor*velocity;
-
-    printf("Position: %d m\n", position);
-    printf("Velocity: %d m/s\n", velocity);
-    printf("Accell: %d m/s2\n", acceleration);
-    printf("Throttle: %d V\n", *throttle);
-
-    position = position + velocity * VEHICLE_PERIOD / 1000;
-    velocity = velocity  + acceleration * VEHICLE_PERIOD / 1000.0;
-    // reset the position to the beginning of the track
-    if(position > 2400)
-      position = 0;
-
-    show_velocity_on_sevenseg((INT8S) velocity);
-    show_position(position);
+    OSTaskWaitNextPeriod();
+
+    /* Non-blocking read of the latest throttle, brake and engine signals
+       (the brake and engine signals bypass the control law); the
+       previous values are kept if ControlTask did not write yet */
+    OSChanRead(Chan_Actuators, &act, &err);
+
+    position = v.position;
+    velocity = v.velocity;
+    vehicle_step(&v, &act, VEHICLE_PERIOD);
+
+    OSLogPost("Position: %d m\n", position, 0);
+    OSLogPost("Velocity: %d m/s\n", velocity, 0);
+    OSLogPost("Accell: %d m/s2\n", v.acceleration, 0);
+    OSLogPost("Throttle: %d V\n", act.throttle > 80 ? 80 : act.throttle, 0);
+
+    show_velocity_on_sevenseg((INT8S) v.velocity);
+    show_position(v.position);
   }
 } 
 
 /*
  * The task 'ControlTask' is the main task of the application. It reacts
- * on sensors and generates responses.
+ * on sensors and generates responses with the control law in control.c.
  */
 
 void ControlTask(void* pdata)
 {
   INT8U err;
-  INT8U throttle = 40; /* Value between 0 and 80, which is interpreted as between 0.0V and 8.0V */
-  void* msg;
-  INT16S* current_velocity;
-  INT16S  target_velocity;
-
-  enum active *gas_pedal = off;
-  enum active *top_gear = off;
-  enum active *cruise_button = off;
-  enum active *engine = off;
-  enum active enginestate = off;
-  enum active *brake = off;
-  enum active brakestate = off;
-  enum active cruise_activated = off;
-
-  printf("Control Task created!\n");
+  INT8U events;
+  struct vehicle current = {0, 0, 0};
+
+  struct buttons btn = {off, off, off};
+  struct switches sw = {off, off};
+  /* Throttle: value between 0 and 80, which is interpreted as between 0.0V and 8.0V */
+  struct actuators act = {40, off, off};
+  struct control ctrl;
+
+  control_init(&ctrl, &control_default_params, CONTROL_PERIOD);
+  OSLogPost("Control Task created!\n", 0, 0);
 
   while(1)
   {
-    msg = OSMboxPend(Mbox_Velocity, 0, &err);
-    current_velocity = (INT16S*) msg;
-
-    // Here you can use whatever technique or algorithm that you prefer to control
-    // the velocity via the throttle. There are no right and wrong answer to this controller, so
-    // be free to use anything that is able to maintain the cruise working properly. You are also
-    // allowed to store more than one sample of the velocity. For instance, you could define
-    //
-    // INT16S previous_vel;
-    // INT16S pre_previous_vel;
-    // ...
-    //
-    // If your control algorithm/technique needs them in order to function. 
-    msg = OSMboxPend(Mbox_Gas, 1, &err); 
-    if (err == OS_NO_ERR) 
-        gas_pedal = (enum active*) msg;
-
-    msg = OSMboxPend(Mbox_Gear, 1, &err); 
-    if (err == OS_NO_ERR) 
-        top_gear = (enum active*) msg;
-
-    msg = OSMboxPend(Mbox_Cruise, 1, &err); 
-    if (err == OS_NO_ERR) 
-        cruise_button = (enum active*) msg;
-
-    msg = OSMboxPend(Mbox_EngineSwitch, 1, &err);
-    if (err == OS_NO_ERR)
-        engine = (enum active*) msg;
-
-    msg = OSMboxPend(Mbox_BrakeButton, 1, &err);
-    if (err == OS_NO_ERR) {
-        brake = (enum active*) msg;
-        brakestate = *brake;
-    }
+    OSChanRead(Chan_Vehicle, &current, &err);
+    OSChanRead(Chan_Buttons, &btn, &err);
+    OSChanRead(Chan_Switches, &sw, &err);
 
-    if (*engine == on) {
-        enginestate = on;
-    }
-    else {
-        if (*current_velocity == 0) {
-            led_red = led_red & ~LED_RED_0;
-            printf("Engine is off!\n");
-            enginestate = off;
-        }
-        else {
-            printf("Engine is till on! Velocity > 0!\n");
-            enginestate = on;
-        }
-    }
+    events = control_step(&ctrl, current.position, current.velocity,
+                          &btn, &sw, &act);
 
-    if (*cruise_button == on) { // if cruise is pressed
-        if (*top_gear == on && *gas_pedal == off && *brake == off && *current_velocity >= 20) { // check activation
-            printf("Cruise control is activated!\n");
-            led_green = led_green | LED_GREEN_0;
-            cruise_activated = on;
-            target_velocity = *current_velocity;
-            if (target_velocity < 25) {
-              target_velocity = 25;
-            }
-        }
+    if (events & CONTROL_ENGINE_OFF) {
+        led_red = led_red & ~LED_RED_0;
+        OSLogPost("Engine is off!\n", 0, 0);
     }
-    
-    if (*top_gear == off || *gas_pedal == on || *brake == on) {
-        cruise_activated = off;
-        led_green = led_green & ~LED_GREEN_0;
+    if (events & CONTROL_ENGINE_STILL_ON) {
+        OSLogPost("Engine is till on! Velocity > 0!\n", 0, 0);
+    }
+    if (events & CONTROL_CRUISE_ON) {
+        OSLogPost("Cruise control is activated!\n", 0, 0);
     }
 
-    if (cruise_activated == on) {
-        if (target_velocity + 2 <= *current_velocity && *current_velocity < target_velocity + 4) {
-            throttle = 15;
-        }
-        else if (*current_velocity >= target_velocity + 4) {
-            throttle = 5;
-        }
-        else if (target_velocity - 4 < *current_velocity && *current_velocity <= target_velocity - 2) {
-            throttle = 50;
-        }
-        else if (*current_velocity <= target_velocity - 4) {
-            throttle = 60;
-        }
-        else {
-            throttle = 40;
-        }
-        show_target_velocity(target_velocity);
+    if (ctrl.cruise_activated == on) {
+        led_green = led_green | LED_GREEN_0;
+        show_target_velocity(ctrl.target_velocity);
     }
     else {
-        if (enginestate == on) {
-            if (*gas_pedal == on) {
-                throttle = 80;
-            }
-            else if (*brake == on) {
-                throttle = 0;
-            }
-            else {
-                throttle = 0;
-            }
-        }
-        else {
-            throttle = 0;
-        }
+        led_green = led_green & ~LED_GREEN_0;
         show_target_velocity(0);
     }
 
-    err = OSMboxPost(Mbox_Throttle, (void *) &throttle);
-    err = OSMboxPost(Mbox_Engine, (void *) &enginestate);
-    err = OSMboxPost(Mbox_Brake, (void *) &brakestate);
+    OSChanWrite(Chan_Actuators, &act);
 
-    //OSTimeDlyHMSM(0,0,0, CONTROL_PERIOD);
     IOWR_ALTERA_AVALON_PIO_DATA(DE2_PIO_GREENLED9_BASE, led_green);
     IOWR_ALTERA_AVALON_PIO_DATA(DE2_PIO_REDLED18_BASE, led_red);
-    OSSemPend(ControlSem, 0, &err);
+    OSTaskWaitNextPeriod();
   }
 }
 
 void ButtonIO(void* pdata) {
   INT8U err;
-  INT16S* current_velocity;
-  void* msg;
   int state;
 
   enum active cruise_button = off;
   enum active gas_pedal = off;
   enum active brake_pedal = off;
+  struct buttons btn;
 
-  printf("ButtonIO created!\n");
+  OSLogPost("ButtonIO created!\n", 0, 0);
 
   while(1) {
-    state = buttons_pressed();
-    OSSemPend(ButtonIOSem, 0, &err);
+    state = Keys.state;
     if (state & CRUISE_CONTROL_FLAG) { // button(key) 1 curise_control
-      printf("Cruise control is pressed!\n");
+      OSLogPost("Cruise control is pressed!\n", 0, 0);
       led_green = led_green | LED_GREEN_2;
       cruise_button = on;
     }
     else if (state & BRAKE_PEDAL_FLAG) { // button(key) 2 brake_pedal
-      printf("Brake is on!\n");
+      OSLogPost("Brake is on!\n", 0, 0);
       brake_pedal = on;
       led_green = led_green | LED_GREEN_4;
     }
     else if (state & GAS_PEDAL_FLAG) { // button(key) 3 gas_pedal
-      printf("Gas pedal is on!\n");
+      OSLogPost("Gas pedal is on!\n", 0, 0);
       gas_pedal = on;
       led_green = led_green | LED_GREEN_6;
     }
@@ -564,37 +656,36 @@ void ButtonIO(void* pdata) {
       led_green = led_green & ~LED_GREEN_4;
       led_green = led_green & ~LED_GREEN_6;
     }
-    err = OSMboxPost(Mbox_Cruise, (void*)&cruise_button);
-    err = OSMboxPost(Mbox_Gas, (void*)&gas_pedal);
-    err = OSMboxPost(Mbox_BrakeButton, (void*)&brake_pedal);
+    btn.cruise = cruise_button;
+    btn.gas = gas_pedal;
+    btn.brake = brake_pedal;
+    OSChanWrite(Chan_Buttons, &btn);
     IOWR_ALTERA_AVALON_PIO_DATA(DE2_PIO_GREENLED9_BASE, led_green);
+    OSTaskNotifyPend(0, OS_NOTIFY_OPT_CLR, &err);
   }
 }
 
 void SwitchIO(void* pdata) {
   INT8U err;
-  INT16S* current_velocity;
-  void* msg;
   int state;
 
   enum active engine = off;
   enum active top_gear = off;
+  struct switches sw;
 
-  printf("SwitchIO Created!\n");
+  OSLogPost("SwitchIO Created!\n", 0, 0);
 
   while (1) {
-    state = switches_pressed();
-    state = state & 0x3;  // To get only last two switches
-    OSSemPend(SwitchIOSem, 0, &err);
+    state = Switches.state;
     if (state == (ENGINE_FLAG | TOP_GEAR_FLAG)) {
-      printf("Engine and Gear are on!\n");
+      OSLogPost("Engine and Gear are on!\n", 0, 0);
       engine = on;
       top_gear = on;
       led_red = led_red | LED_RED_0;
       led_red = led_red | LED_RED_1;
     }
     else if (state == ENGINE_FLAG) {
-      printf("Only Engine is on!\n");
+      OSLogPost("Only Engine is on!\n", 0, 0);
       engine = on;
       top_gear = off;
       led_red = led_red | LED_RED_0;
@@ -604,42 +695,222 @@ void SwitchIO(void* pdata) {
       top_gear = on;
       engine = off;
       led_red = led_red | LED_RED_1;
-      printf("Gear is on!\n");
+      OSLogPost("Gear is on!\n", 0, 0);
     }
     else {
       top_gear = off;
       engine = off;
       led_red = led_red & ~LED_RED_1;
-      printf("Gear is off!\n");
+      OSLogPost("Gear is off!\n", 0, 0);
     }
-    err = OSMboxPost(Mbox_EngineSwitch, (void*)&engine);
-    err = OSMboxPost(Mbox_Gear, (void*)&top_gear);
+    sw.engine = engine;
+    sw.top_gear = top_gear;
+    OSChanWrite(Chan_Switches, &sw);
     IOWR_ALTERA_AVALON_PIO_DATA(DE2_PIO_REDLED18_BASE, led_red);
+    OSTaskNotifyPend(0, OS_NOTIFY_OPT_CLR, &err);
+  }
+}
+
+/*
+ * Takes a snapshot of the profiles of all tasks into Profile
+ */
+static void profile_take(int overload)
+{
+  static INT32U last_cycles[OS_LOWEST_PRIO + 1];
+  static INT32U last_preempts[OS_LOWEST_PRIO + 1];
+  static INT32U last_time;
+  struct profile_entry* e;
+  OS_TASK_PROFILE p;
+  INT8U prio;
+
+  Profile.tasks = 0;
+  Profile.overload = overload;
+  for (prio = 0; prio <= OS_LOWEST_PRIO; prio++) {
+    if (OSTaskProfileQuery(prio, &p, OS_PROFILE_OPT_CLR_MAX) != OS_ERR_NONE) {
+      continue;
+    }
+    e = &Profile.task[Profile.tasks++];
+    e->prio = prio;
+    e->cycles = p.OSCyclesTot - last_cycles[prio];
+    e->max = p.OSCyclesMax;
+    e->preempts = p.OSPreemptCtr - last_preempts[prio];
+    last_cycles[prio] = p.OSCyclesTot;
+    last_preempts[prio] = p.OSPreemptCtr;
+  }
+  // Tasks deleted since the previous snapshot are missing from the table
+  Profile.window = OSCPUCyclesGet() - last_time;
+  last_time += Profile.window;
+  Profile_Ready = 1;
+}
+
+/*
+ * Prints Profile, the CPU share in tenths of a percent and the longest
+ * burst in microseconds
+ */
+static void profile_print(void)
+{
+  unsigned long per_ms = alt_get_cpu_freq() / 1000;
+  unsigned long per_permille = Profile.window / 1000;
+  unsigned long permille;
+  struct profile_entry* e;
+  int i;
+
+  printf("Profile of %lu ms%s\n", (unsigned long) Profile.window / per_ms,
+         Profile.overload ? ", overload" : "");
+  printf("prio   cpu  max burst preempts\n");
+  for (i = 0; i < Profile.tasks; i++) {
+    e = &Profile.task[i];
+    permille = (per_permille > 0) ? e->cycles / per_permille : 0;
+    printf("%4u %3lu.%lu%% %7lu us %8lu\n", e->prio, permille / 10,
+           permille % 10, (unsigned long) e->max / (per_ms / 1000),
+           (unsigned long) e->preempts);
+  }
+}
+
+/*
+ * Prints the stopped trace, one line per record between a header line and
+ * an end line, with the names of the tasks (see host/tools/trace2json.c)
+ */
+static void trace_dump(INT32U ctr)
+{
+  OS_TRACE_REC rec[16];
+  INT8U name[OS_TASK_NAME_SIZE];
+  INT32U ix = 0;
+  INT16U n;
+  INT16U i;
+  INT8U err;
+  INT8U prio;
+
+  printf("@trace %lu %lu\n", (unsigned long) alt_get_cpu_freq(),
+         (unsigned long) ctr);
+  for (prio = 0; prio <= OS_LOWEST_PRIO; prio++) {
+    if (OSTaskNameGet(prio, name, &err) > 0) {
+      printf("@task %u %s\n", prio, name);
+    }
+  }
+  while ((n = OSTraceRead(ix, rec, 16, &err)) > 0) {
+    for (i = 0; i < n; i++) {
+      printf("@r %08lx %u %u %u\n", (unsigned long) rec[i].OSTraceTime,
+             rec[i].OSTraceType, rec[i].OSTracePrio, rec[i].OSTraceArg);
+    }
+    ix += n;
+  }
+  printf("@end\n");
+}
+
+/*
+ * Prints the sizes of the kernel tables and, for every stack, its size,
+ * the bytes used and the switches into its task and the cycles it ran,
+ * between a header line and an end line (see host/tools/memplace.c).
+ * OSTaskStkChk() finds the bytes used by a full scan of the stack, from
+ * its bottom to the first entry that is not 0.
+ */
+static void place_dump(void)
+{
+  OS_TASK_PROFILE p;
+  OS_STK_DATA stk;
+  unsigned i;
+
+  printf("@place %lu %lu\n", (unsigned long) OSCtxSwCtr,
+         (unsigned long) OSTimeGet());
+  printf("@data OSTCBTbl %u\n", (unsigned) sizeof(OSTCBTbl));
+  printf("@data OSTCBPrioTbl %u\n", (unsigned) sizeof(OSTCBPrioTbl));
+  printf("@data OSRdyTbl %u\n", (unsigned) sizeof(OSRdyTbl));
+  printf("@data OSEventTbl %u\n", (unsigned) sizeof(OSEventTbl));
+  for (i = 0; i < TASK_STACKS; i++) {
+    if (OSTaskStkChk(task_stacks[i].prio, &stk) != OS_ERR_NONE ||
+        OSTaskProfileQuery(task_stacks[i].prio, &p, OS_PROFILE_OPT_NONE) !=
+        OS_ERR_NONE) {
+      continue;
+    }
+    printf("@stack %s %s %lu %lu %lu %lu\n", task_stacks[i].name,
+           task_stacks[i].size, (unsigned long) task_stacks[i].bytes,
+           (unsigned long) stk.OSUsed,
+           (unsigned long) p.OSCtxSwCtr,
+           (unsigned long) p.OSCyclesTot);
   }
+  printf("@end\n");
+}
+
+/*
+ * The task 'LogDrain' prints the messages posted to the logs, oldest
+ * first, the profile snapshots, the trace and the usage of the stacks,
+ * whenever no other task is ready.  It names itself the drain of the logs
+ * with OSLogDrainSet() and waits for its notification, which
+ * OSLogPost() sends when a log gets a message while it is empty and the
+ * Watchdog task sends when it has something else to print, so the tick
+ * can stay stopped while it waits.
+ */
+void LogDrain(void* pdata) {
+    OS_LOG_REC rec;
+    INT8U err;
+
+    OSLogDrainSet(OS_PRIO_SELF);
+    while (1) {
+        while (OSLogAccept(&rec) == OS_ERR_NONE) {
+            printf(rec.OSLogFmt, rec.OSLogArg[0], rec.OSLogArg[1]);
+        }
+        if (Profile_Ready) {
+            profile_print();
+            Profile_Ready = 0;
+        }
+        if (Trace_Stopped) {
+            trace_dump(Trace_Stopped);
+            Trace_Stopped = 0;
+            OSTraceStart();
+        }
+        if (Place_Ready == 1) {
+            place_dump();
+            Place_Ready = 2;
+        }
+        OSTaskNotifyPend(0, OS_NOTIFY_OPT_CLR, &err);
+    }
 }
 
 void Detection(void* pdata) {
     INT8U err;
     
     while (1) {
-        OSSemPend(DetectionSem, 0, &err);
+        OSTaskNotifyPend(0, OS_NOTIFY_OPT_DEC, &err);
         OKSignal = 1;
     }
 }
 
 void Watchdog(void* pdata) {
     INT8U err;
+    int periods = 0;
+    int place_periods = 0;
+    int overload = 0;
+    int first = 1;    // Detection does not run before the first period
 
     while (1) {
-        OSSemPend(WatchdogSem, 0, &err);
+        OSTaskNotifyPend(0, OS_NOTIFY_OPT_DEC, &err);
+        periods++;
+        if (++place_periods == PLACE_PERIODS) {
+            Place_Ready = 1;
+            OSTaskNotifyPost(LOGDRAIN_PRIO, 1, OS_NOTIFY_OPT_SET);
+        }
+        // A snapshot not printed yet is kept, the next one covers both
+        if ((OKSignal == 0 || periods >= PROFILE_PERIODS) && !Profile_Ready) {
+            profile_take(OKSignal == 0);
+            periods = 0;
+            OSTaskNotifyPost(LOGDRAIN_PRIO, 1, OS_NOTIFY_OPT_SET);
+        }
+        // Keep the trace of the periods leading to the overload
+        if (OKSignal == 0 && !first && !overload && !Trace_Stopped) {
+            Trace_Stopped = OSTraceStop();
+            OSTaskNotifyPost(LOGDRAIN_PRIO, 1, OS_NOTIFY_OPT_SET);
+        }
+        overload = (OKSignal == 0 && !first);
+        first = 0;
         if (OKSignal == 0) {
-            printf("Warning!!! Overload!!!\n");
+            OSLogPost("Warning!!! Overload!!!\n", 0, 0);
         }
         else {
-            printf("No Overload.\n");
+            OSLogPost("No Overload.\n", 0, 0);
         }
         OKSignal = 0;
-        OSSemPost(DetectionSem);
+        OSTaskNotifyPost(DETECTION_PRIO, 0, OS_NOTIFY_OPT_INC);
     }
 }
 
@@ -649,12 +920,11 @@ void Extraload(void* pdata) {
     int extraload;
     int twopercent = EXTRALOAD_PERIOD / 100 * 2;  // 6ms
     int delaytime;
-    float runtime = 0;
-    alt_u64 t;
-    float milliseconds = 0;
+    alt_u64 cycles;
+    alt_u64 limit;
 
     while (1) {
-      OSSemPend(ExtraloadSem, 0, &err);
+      OSTaskNotifyPend(0, OS_NOTIFY_OPT_DEC, &err);
       state = switches_pressed();
       led_red = (led_red & ~0x3F0) | (state & 0x3F0);
       IOWR_ALTERA_AVALON_PIO_DATA(DE2_PIO_REDLED18_BASE, led_red);
@@ -663,22 +933,22 @@ void Extraload(void* pdata) {
         extraload = 50;
       }
       delaytime = twopercent * extraload;
-      printf("Expected Extraload Time: %d ms\n", delaytime);
+      OSLogPost("Expected Extraload Time: %d ms\n", delaytime, 0);
 
+      // The busy time is counted in cycles, the tiny core has no FPU
+      limit = (alt_u64) delaytime * (alt_get_cpu_freq() / 1000);
       PERF_RESET(PERFORMANCE_COUNTER_BASE);
-      t = perf_get_total_time((void*)PERFORMANCE_COUNTER_BASE);
+      cycles = perf_get_total_time((void*)PERFORMANCE_COUNTER_BASE);
       PERF_START_MEASURING(PERFORMANCE_COUNTER_BASE);
-      milliseconds = 1000 * (float)t / (float)alt_get_cpu_freq();
-      while (milliseconds < delaytime) {
+      while (cycles < limit) {
         int i = 0;
         int j = 0;
         for (i = 0; i < 10; ++i) {
           j++;
         }
-        t = perf_get_total_time((void*)PERFORMANCE_COUNTER_BASE);
+        cycles += perf_get_total_time((void*)PERFORMANCE_COUNTER_BASE);
         PERF_RESET(PERFORMANCE_COUNTER_BASE);
         PERF_START_MEASURING(PERFORMANCE_COUNTER_BASE);
-        milliseconds += 1000 * (float)t / (float)alt_get_cpu_freq();
       }
       PERF_STOP_MEASURING(PERFORMANCE_COUNTER_BASE);
     }
@@ -692,6 +962,7 @@ void Extraload(void* pdata) {
 void StartTask(void* pdata)
 {
   INT8U err;
+  int i;
   void* context;
 
   static alt_alarm alarm;     /* Is needed for timer ISR function */
@@ -715,38 +986,6 @@ void StartTask(void* pdata)
    * Create and start Software Timer 
    */
 
-  VehicleTmr = OSTmrCreate(0, // delay
-                           VEHICLE_PERIOD/100, //period
-                           OS_TMR_OPT_PERIODIC, //timer to automatically reload itself
-                           VehicleCallback, //callback function
-                           (void*) 0,
-                           "VehicleTmr",
-                           &err);
-
-  ControlTmr = OSTmrCreate(0, // delay
-                           CONTROL_PERIOD/100, //period-------------------------------------------------------------------------------
-                           OS_TMR_OPT_PERIODIC, //timer to automatically reload itself
-                           ControlCallback, //callback function
-                           (void*) 0,
-                           "ControlTmr",
-                           &err);
-                           
-  ButtonIOTmr = OSTmrCreate(0,
-                            BUTTONIO_PERIOD/100,
-                            OS_TMR_OPT_PERIODIC,
-                            ButtonIOCallback,
-                            (void*) 0,
-                            "ButtonIOTmr",
-                            &err);
-
-  SwitchIOTmr = OSTmrCreate(0,
-                            SWITCHIO_PERIOD/100,
-                            OS_TMR_OPT_PERIODIC,
-                            SwitchIOCallback,
-                            (void*) 0,
-                            "SwitchIOTmr",
-                            &err);
-
   WatchdogTmr = OSTmrCreate(0,
                             WATCHDOG_PERIOD/100,
                             OS_TMR_OPT_PERIODIC,
@@ -764,36 +1003,18 @@ void StartTask(void* pdata)
                              &err);
 
   // Start timer
-  OSTmrStart(VehicleTmr, &err);
-  OSTmrStart(ControlTmr, &err); 
-  OSTmrStart(ButtonIOTmr, &err);
-  OSTmrStart(SwitchIOTmr, &err);
   OSTmrStart(WatchdogTmr, &err);
   OSTmrStart(ExtraloadTmr, &err);
   
-  // Create Semaphores
-  VehicleSem = OSSemCreate(1);
-  ControlSem = OSSemCreate(1);
-  ButtonIOSem = OSSemCreate(1);
-  SwitchIOSem = OSSemCreate(1);
-  DetectionSem = OSSemCreate(1);
-  WatchdogSem = OSSemCreate(1);
-  ExtraloadSem = OSSemCreate(1);
-
   /*
    * Creation of Kernel Objects
    */
 
-  // Mailboxes
-  Mbox_Throttle = OSMboxCreate((void*) 0); /* Empty Mailbox - Throttle */
-  Mbox_Velocity = OSMboxCreate((void*) 0); /* Empty Mailbox - Velocity */
-  Mbox_Brake = OSMboxCreate((void*) 1); /* Empty Mailbox - Velocity */
-  Mbox_BrakeButton = OSMboxCreate((void*) 1);
-  Mbox_Engine = OSMboxCreate((void*) 1); /* Empty Mailbox - Engine */
-  Mbox_EngineSwitch = OSMboxCreate((void*) 1);
-  Mbox_Gas = OSMboxCreate((void*) 1);
-  Mbox_Gear = OSMboxCreate((void*) 1);
-  Mbox_Cruise = OSMboxCreate((void*) 1);
+  // State channels
+  Chan_Vehicle = OSChanCreate(Chan_Vehicle_Buf, sizeof(struct vehicle), &err);
+  Chan_Actuators = OSChanCreate(Chan_Actuators_Buf, sizeof(struct actuators), &err);
+  Chan_Buttons = OSChanCreate(Chan_Buttons_Buf, sizeof(struct buttons), &err);
+  Chan_Switches = OSChanCreate(Chan_Switches_Buf, sizeof(struct switches), &err);
 
   /*
    * Create statistics task
@@ -806,96 +1027,133 @@ void StartTask(void* pdata)
    */
 
 
-  err = OSTaskCreateExt(
+  err = OSTaskCreatePeriodic(
       ControlTask, // Pointer to task code
       NULL,        // Pointer to argument that is
       // passed to task
-      &ControlTask_Stack[TASK_STACKSIZE-1], // Pointer to top
+      &ControlTask_Stack[CONTROLTASK_STACKSIZE-1], // Pointer to top
       // of task stack
       CONTROLTASK_PRIO,
       CONTROLTASK_PRIO,
       (void *)&ControlTask_Stack[0],
-      TASK_STACKSIZE,
+      CONTROLTASK_STACKSIZE,
       (void *) 0,
-      OS_TASK_OPT_STK_CHK);
+      OS_TASK_OPT_STK_CHK | OS_TASK_OPT_STK_CLR,
+      MS_TO_TICKS(CONTROL_PERIOD));
 
-  err = OSTaskCreateExt(
+  err = OSTaskCreatePeriodic(
       VehicleTask, // Pointer to task code
       NULL,        // Pointer to argument that is
       // passed to task
-      &VehicleTask_Stack[TASK_STACKSIZE-1], // Pointer to top
+      &VehicleTask_Stack[VEHICLETASK_STACKSIZE-1], // Pointer to top
       // of task stack
       VEHICLETASK_PRIO,
       VEHICLETASK_PRIO,
       (void *)&VehicleTask_Stack[0],
-      TASK_STACKSIZE,
+      VEHICLETASK_STACKSIZE,
       (void *) 0,
-      OS_TASK_OPT_STK_CHK);
+      OS_TASK_OPT_STK_CHK | OS_TASK_OPT_STK_CLR,
+      MS_TO_TICKS(VEHICLE_PERIOD));
 
   err = OSTaskCreateExt(
       ButtonIO, // Pointer to task code
       NULL,        // Pointer to argument that is
       // passed to task
-      &ButtonIO_Stack[TASK_STACKSIZE-1], // Pointer to top
+      &ButtonIO_Stack[BUTTONIO_STACKSIZE-1], // Pointer to top
       // of task stack
       BUTTONIO_PRIO,
       BUTTONIO_PRIO,
       (void *)&ButtonIO_Stack[0],
-      TASK_STACKSIZE,
+      BUTTONIO_STACKSIZE,
       (void *) 0,
-      OS_TASK_OPT_STK_CHK);
+      OS_TASK_OPT_STK_CHK | OS_TASK_OPT_STK_CLR);
 
   err = OSTaskCreateExt(
       SwitchIO, // Pointer to task code
       NULL,        // Pointer to argument that is
       // passed to task
-      &SwitchIO_Stack[TASK_STACKSIZE-1], // Pointer to top
+      &SwitchIO_Stack[SWITCHIO_STACKSIZE-1], // Pointer to top
       // of task stack
       SWITCHIO_PRIO,
       SWITCHIO_PRIO,
       (void *)&SwitchIO_Stack[0],
-      TASK_STACKSIZE,
+      SWITCHIO_STACKSIZE,
       (void *) 0,
-      OS_TASK_OPT_STK_CHK);
+      OS_TASK_OPT_STK_CHK | OS_TASK_OPT_STK_CLR);
 
   err = OSTaskCreateExt(
       Detection, // Pointer to task code
       NULL,        // Pointer to argument that is
       // passed to task
-      &Detection_Stack[TASK_STACKSIZE-1], // Pointer to top
+      &Detection_Stack[DETECTION_STACKSIZE-1], // Pointer to top
       // of task stack
       DETECTION_PRIO,
       DETECTION_PRIO,
       (void *)&Detection_Stack[0],
-      TASK_STACKSIZE,
+      DETECTION_STACKSIZE,
       (void *) 0,
-      OS_TASK_OPT_STK_CHK);
+      OS_TASK_OPT_STK_CHK | OS_TASK_OPT_STK_CLR);
 
   err = OSTaskCreateExt(
       Watchdog, // Pointer to task code
       NULL,        // Pointer to argument that is
       // passed to task
-      &Watchdog_Stack[TASK_STACKSIZE-1], // Pointer to top
+      &Watchdog_Stack[WATCHDOG_STACKSIZE-1], // Pointer to top
       // of task stack
       WATCHDOG_PRIO,
       WATCHDOG_PRIO,
       (void *)&Watchdog_Stack[0],
-      TASK_STACKSIZE,
+      WATCHDOG_STACKSIZE,
       (void *) 0,
-      OS_TASK_OPT_STK_CHK);
+      OS_TASK_OPT_STK_CHK | OS_TASK_OPT_STK_CLR);
 
   err = OSTaskCreateExt(
       Extraload, // Pointer to task code
       NULL,        // Pointer to argument that is
       // passed to task
-      &Extraload_Stack[TASK_STACKSIZE-1], // Pointer to top
+      &Extraload_Stack[EXTRALOAD_STACKSIZE-1], // Pointer to top
       // of task stack
       EXTRALOAD_PRIO,
       EXTRALOAD_PRIO,
       (void *)&Extraload_Stack[0],
-      TASK_STACKSIZE,
+      EXTRALOAD_STACKSIZE,
+      (void *) 0,
+      OS_TASK_OPT_STK_CHK | OS_TASK_OPT_STK_CLR);
+
+  err = OSTaskCreateExt(
+      LogDrain, // Pointer to task code
+      NULL,        // Pointer to argument that is
+      // passed to task
+      &LogDrain_Stack[LOGDRAIN_STACKSIZE-1], // Pointer to top
+      // of task stack
+      LOGDRAIN_PRIO,
+      LOGDRAIN_PRIO,
+      (void *)&LogDrain_Stack[0],
+      LOGDRAIN_STACKSIZE,
       (void *) 0,
-      OS_TASK_OPT_STK_CHK);
+      OS_TASK_OPT_STK_CHK | OS_TASK_OPT_STK_CLR);
+
+  for (i = 0; i < TASK_NAMES; i++) {
+    OSTaskNameSet(task_names[i].prio, (INT8U*) task_names[i].name, &err);
+  }
+
+  // Logs, created before any of their tasks runs
+  for (i = 0; i < LOGS; i++) {
+    OSLogCreate(log_prio[i], Log_Buf[i], LOG_RECORDS, &err);
+  }
+
+  // Inputs, which release ButtonIO and SwitchIO from now on
+  debounce = alt_ticks_per_second() * DEBOUNCE_MS / 1000;
+  if (debounce == 0) {
+    debounce = 1;
+  }
+  input_init(&Keys);
+  input_init(&Switches);
+
+  // Release the timer driven tasks once, the timers release them from now on
+  OSTaskNotifyPost(DETECTION_PRIO, 0, OS_NOTIFY_OPT_INC);
+  OSTaskNotifyPost(WATCHDOG_PRIO, 0, OS_NOTIFY_OPT_INC);
+  OSTaskNotifyPost(EXTRALOAD_PRIO, 0, OS_NOTIFY_OPT_INC);
 
   printf("All Tasks and Kernel Objects generated!\n");
 
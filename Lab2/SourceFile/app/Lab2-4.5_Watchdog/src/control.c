@@ -0,0 +1,188 @@
+/* Cruise control law
+ *
+ * Description:
+ *
+ *   Without cruise control the throttle follows the gas pedal. The cruise
+ *   control is activated with the cruise button, in top gear, without gas
+ *   or brake pedal and at min_activation m/s or more, and holds the
+ *   velocity it was activated at (at least min_target m/s). Gas, brake or
+ *   leaving top gear deactivate it.
+ *
+ *   While active, a PID controller sets the throttle:
+ *
+ *     throttle = target + bias + kp * e + ki * sum(e * T) + kd * de / T
+ *
+ *   with the error e = target - velocity and the period T.  The vehicle
+ *   needs a throttle equal to its velocity on the flat, so the target is
+ *   the feed-forward term, and the bias adds the throttle the grade of the
+ *   segment takes.  The gains and the bias are looked up by the segment of
+ *   the track the vehicle is on.  The integral term is bounded and is not
+ *   accumulated while the throttle saturates in the direction of the error
+ *   (anti-windup).
+ *
+ *   The arithmetic is Q16.16 fixed point (fixed.h).  control_init() scales
+ *   the gains to the period once, so control_step() has no loops and no
+ *   divisions by variables.
+ */
+#include "cruise.h"
+
+const struct control_params control_default_params = {
+  { //  kp   ki   kd  bias
+    { 100,  50,   0,   0 },  // [0 m, 400 m)     flat
+    { 100,  50,   0,   2 },  // [400 m, 800 m)   uphill
+    { 100,  50,   0,   4 },  // [800 m, 1200 m)  steep uphill
+    { 100,  50,   0,   0 },  // [1200 m, 1600 m) flat
+    { 100,  50,   0,  -4 },  // [1600 m, 2000 m) steep downhill
+    { 100,  50,   0,  -2 },  // [2000 m, 2400 m] downhill
+  },
+  20,   // integral_limit
+  25,   // min_target
+  20,   // min_activation
+};
+
+void control_init(struct control* c, const struct control_params* params,
+                  int period_ms)
+{
+  const struct control_gains* g;
+  struct control_coeffs* k;
+  int i;
+
+  c->params = params;
+  for (i = 0; i < CONTROL_SEGMENTS; i++) {
+    g = &params->gains[i];
+    k = &c->coeffs[i];
+    k->kp = FIX_FROM_RATIO(g->kp, 100);
+    k->ki = FIX_FROM_RATIO((INT32S) g->ki * period_ms, 100000);
+    k->kd = FIX_FROM_RATIO((INT32S) g->kd * 10, period_ms);
+    k->bias = FIX_FROM_INT(g->bias);
+  }
+  c->integral = 0;
+  c->last_error = 0;
+  c->target_velocity = 0;
+  c->cruise_activated = off;
+}
+
+/*
+ * Returns the throttle of the PID controller for 'velocity' at 'position'
+ * and updates its state.
+ */
+static INT8U control_pid(struct control* c, INT16U position, INT16S velocity)
+{
+  const struct control_coeffs* k;
+  INT32S segment;
+  INT32S error;
+  fix_t limit = FIX_FROM_INT(c->params->integral_limit);
+  fix_t integral;
+  fix_t u;
+  fix_t pd;
+
+  segment = FIX_DIV_CONST(position, CONTROL_SEGMENT_LENGTH);
+  if (segment >= CONTROL_SEGMENTS) {
+    segment = CONTROL_SEGMENTS - 1;
+  }
+  k = &c->coeffs[segment];
+
+  error = c->target_velocity - velocity;
+  if (error > CONTROL_ERROR_MAX) {
+    error = CONTROL_ERROR_MAX;
+  }
+  else if (error < -CONTROL_ERROR_MAX) {
+    error = -CONTROL_ERROR_MAX;
+  }
+
+  pd = fix_add_sat(FIX_FROM_INT(c->target_velocity) + k->bias,
+                   fix_mul(k->kp, FIX_FROM_INT(error)));
+  pd = fix_add_sat(pd, fix_mul(k->kd, FIX_FROM_INT(error - c->last_error)));
+  c->last_error = error;
+
+  integral = fix_add_sat(c->integral, fix_mul(k->ki, FIX_FROM_INT(error)));
+  if (integral > limit) {
+    integral = limit;
+  }
+  else if (integral < -limit) {
+    integral = -limit;
+  }
+
+  u = fix_add_sat(pd, integral);
+  if ((u > FIX_FROM_INT(CONTROL_THROTTLE_MAX) && error > 0) ||
+      (u < 0 && error < 0)) {
+    u = fix_add_sat(pd, c->integral);   // anti-windup
+  }
+  else {
+    c->integral = integral;
+  }
+
+  if (u <= 0) {
+    return 0;
+  }
+  if (u >= FIX_FROM_INT(CONTROL_THROTTLE_MAX)) {
+    return CONTROL_THROTTLE_MAX;
+  }
+  return (INT8U) ((u + FIX_ONE / 2) >> FIX_Q);
+}
+
+/*
+ * Computes the actuator signals 'act' for one control period from the
+ * current position, velocity and inputs. 'act' keeps the signals of the
+ * previous period. Returns the CONTROL_* events of the step.
+ *
+ * Here you can use whatever technique or algorithm that you prefer to control
+ * the velocity via the throttle. There are no right and wrong answer to this controller, so
+ * be free to use anything that is able to maintain the cruise working properly. State that
+ * your algorithm needs across periods, such as previous velocities, goes into struct control.
+ */
+INT8U control_step(struct control* c, INT16U position, INT16S velocity,
+                   const struct buttons* btn, const struct switches* sw,
+                   struct actuators* act)
+{
+  const struct control_params* p = c->params;
+  INT16S target = c->target_velocity;
+  INT8U events = 0;
+
+  act->brake = btn->brake;
+
+  if (sw->engine == on) {
+    act->engine = on;
+  }
+  else {
+    if (velocity == 0) {
+      events |= CONTROL_ENGINE_OFF;
+      act->engine = off;
+    }
+    else {
+      events |= CONTROL_ENGINE_STILL_ON;
+      act->engine = on;
+    }
+  }
+
+  if (btn->cruise == on) { // if cruise is pressed
+    if (sw->top_gear == on && btn->gas == off && btn->brake == off && velocity >= p->min_activation) { // check activation
+      events |= CONTROL_CRUISE_ON;
+      c->cruise_activated = on;
+      target = velocity;
+      if (target < p->min_target) {
+        target = p->min_target;
+      }
+      c->target_velocity = target;
+      c->integral = 0;
+      c->last_error = 0;
+    }
+  }
+
+  if (sw->top_gear == off || btn->gas == on || btn->brake == on) {
+    c->cruise_activated = off;
+  }
+
+  if (c->cruise_activated == on) {
+    act->throttle = control_pid(c, position, velocity);
+  }
+  else {
+    if (act->engine == on && btn->gas == on) {
+      act->throttle = 80; // full throttle
+    }
+    else {
+      act->throttle = 0;
+    }
+  }
+  return events;
+}
@@ -0,0 +1,111 @@
+/* Vehicle model and control law of the cruise control
+ *
+ * Description:
+ *
+ *   The vehicle model of VehicleTask and the control law of ControlTask,
+ *   as plain functions that advance the model or the controller by one
+ *   period.  They do not call the kernel or the HAL, so the tasks in
+ *   Watchdog.c and the batch simulator of the host port (host/sim) run
+ *   exactly the same code.  Printing and the LEDs are left to the caller.
+ */
+#ifndef __CRUISE_H__
+#define __CRUISE_H__
+
+#include "os_cpu.h"
+#include "fixed.h"
+
+enum active {on = 2, off = 1};
+
+// Records exchanged by the tasks
+struct actuators {      // Written by ControlTask
+  INT8U throttle;
+  enum active engine;
+  enum active brake;
+};
+
+struct buttons {        // Written by ButtonIO
+  enum active cruise;
+  enum active gas;
+  enum active brake;
+};
+
+struct switches {       // Written by SwitchIO
+  enum active engine;
+  enum active top_gear;
+};
+
+/*
+ * Vehicle model
+ */
+
+#define TRACK_LENGTH 2400 /* m, the position wraps to 0 beyond it */
+
+struct vehicle {
+  INT16U position;      // m
+  INT16S velocity;      // m/s
+  INT16S acceleration;  // m/s2, of the last step
+};
+
+void vehicle_init(struct vehicle* v);
+void vehicle_step(struct vehicle* v, const struct actuators* act,
+                  int period_ms);
+
+/*
+ * Control law
+ */
+
+// The gains are scheduled by the segments of the track that the LEDs of
+// show_position() indicate
+#define CONTROL_SEGMENT_LENGTH 400  /* m */
+#define CONTROL_SEGMENTS       6    /* the last one ends at TRACK_LENGTH */
+
+#define CONTROL_THROTTLE_MAX   80   /* throttle the vehicle can use */
+#define CONTROL_ERROR_MAX      255  /* m/s, larger errors are clipped */
+
+// PID gains of a track segment, in hundredths (100 is a gain of 1)
+struct control_gains {
+  INT16U kp;                 // throttle per m/s of error
+  INT16U ki;                 // throttle per m/s of error and second
+  INT16U kd;                 // throttle per m/s2 of change of the error
+  INT8S bias;                // throttle added to the target velocity,
+                             // compensates the grade of the segment
+};
+
+struct control_params {
+  struct control_gains gains[CONTROL_SEGMENTS];
+  INT8U integral_limit;      // bound of the integral term, in throttle
+  INT8U min_target;          // lowest target velocity
+  INT8U min_activation;      // lowest velocity at which cruise activates
+};
+
+extern const struct control_params control_default_params;
+
+// Gains of a segment scaled to the control period, in Q16.16
+struct control_coeffs {
+  fix_t kp;
+  fix_t ki;                  // per period
+  fix_t kd;                  // per period
+  fix_t bias;
+};
+
+struct control {
+  const struct control_params* params;
+  struct control_coeffs coeffs[CONTROL_SEGMENTS];
+  fix_t integral;            // integral term, in throttle
+  INT16S last_error;
+  INT16S target_velocity;
+  enum active cruise_activated;
+};
+
+// Events of a control step, for the caller to report
+#define CONTROL_ENGINE_OFF      0x01 // engine switched off at standstill
+#define CONTROL_ENGINE_STILL_ON 0x02 // engine switched off, still moving
+#define CONTROL_CRUISE_ON       0x04 // cruise control (re)activated
+
+void control_init(struct control* c, const struct control_params* params,
+                  int period_ms);
+INT8U control_step(struct control* c, INT16U position, INT16S velocity,
+                   const struct buttons* btn, const struct switches* sw,
+                   struct actuators* act);
+
+#endif /* __CRUISE_H__ */
@@ -0,0 +1,120 @@
+/* Q-format fixed-point arithmetic
+ *
+ * Description:
+ *
+ *   The DE2 system has a "tiny" Nios II core without FPU, multiplier or
+ *   divider (see ALT_CPU_CPU_IMPLEMENTATION in system.h), so every float or
+ *   double operation is a call into the software floating point library.
+ *   The vehicle model and the control law use these helpers instead:
+ *
+ *     fix_t            Q16.16 number, 16 integer and 16 fraction bits.
+ *     fix_mul()        Q16.16 product, rounded towards minus infinity.
+ *     FIX_DIV_CONST()  division by a constant, truncated towards zero like
+ *                      the '/' operator, so results are bit-exact with it.
+ *     fix_sat16(), fix_add_sat(), fix_sub_sat()
+ *                      saturate instead of wrapping around.
+ *
+ *   FIX_DIV_CONST() multiplies by a reciprocal computed at compile time
+ *   where the CPU can multiply in hardware.  On the tiny core a software
+ *   multiplication costs more than the division, so it falls back to '/'.
+ */
+#ifndef __FIXED_H__
+#define __FIXED_H__
+
+#include "system.h"
+#include "alt_types.h"
+#include "os_cpu.h"
+
+typedef INT32S fix_t;
+
+#define FIX_Q          16
+#define FIX_ONE        ((fix_t) 1 << FIX_Q)
+#define FIX_MAX        ((fix_t) 0x7FFFFFFF)
+#define FIX_MIN        (-FIX_MAX - 1)
+
+#define FIX_FROM_INT(i)   ((fix_t) (i) * FIX_ONE)
+#define FIX_FROM_RATIO(n, d) ((fix_t) (((alt_64) (n) << FIX_Q) / (d)))
+
+/*
+ * Integer part of 'x', truncated towards zero.
+ */
+static inline INT32S fix_to_int(fix_t x)
+{
+  return (x >= 0) ? (x >> FIX_Q) : -((-x) >> FIX_Q);
+}
+
+static inline fix_t fix_mul(fix_t a, fix_t b)
+{
+  return (fix_t) (((alt_64) a * b) >> FIX_Q);
+}
+
+/*
+ * Saturates 'x' to the range of INT16S.
+ */
+static inline INT16S fix_sat16(INT32S x)
+{
+  if (x > 32767) {
+    return 32767;
+  }
+  if (x < -32768) {
+    return -32768;
+  }
+  return (INT16S) x;
+}
+
+static inline fix_t fix_add_sat(fix_t a, fix_t b)
+{
+  fix_t sum = (fix_t) ((INT32U) a + (INT32U) b);
+
+  // Overflow if both operands have the same sign and the sum another one
+  if (((a ^ sum) & (b ^ sum)) < 0) {
+    return (a < 0) ? FIX_MIN : FIX_MAX;
+  }
+  return sum;
+}
+
+static inline fix_t fix_sub_sat(fix_t a, fix_t b)
+{
+  fix_t diff = (fix_t) ((INT32U) a - (INT32U) b);
+
+  // Overflow if the operands have different signs and the difference
+  // the sign of 'b'
+  if (((a ^ b) & (a ^ diff)) < 0) {
+    return (a < 0) ? FIX_MIN : FIX_MAX;
+  }
+  return diff;
+}
+
+/*
+ * Division by a constant 'd' (2 <= d <= 65536) of 'x' (|x| < 2^31).
+ *
+ * With l = ceil(log2(d)) and m = floor(2^(31+l) / d) + 1, the quotient of
+ * 0 <= x < 2^31 is (x * m) >> (31 + l) (Granlund and Montgomery, "Division
+ * by invariant integers using multiplication", 1994).  The sign is handled
+ * separately, which truncates towards zero.
+ */
+#define FIX_CLOG2(d)                                                      \
+  ((d) <= 2 ? 1 : (d) <= 4 ? 2 : (d) <= 8 ? 3 : (d) <= 16 ? 4 :           \
+   (d) <= 32 ? 5 : (d) <= 64 ? 6 : (d) <= 128 ? 7 : (d) <= 256 ? 8 :      \
+   (d) <= 512 ? 9 : (d) <= 1024 ? 10 : (d) <= 2048 ? 11 :                 \
+   (d) <= 4096 ? 12 : (d) <= 8192 ? 13 : (d) <= 16384 ? 14 :              \
+   (d) <= 32768 ? 15 : 16)
+
+#define FIX_DIV_SHIFT(d)  (31 + FIX_CLOG2(d))
+#define FIX_DIV_MAGIC(d)  ((alt_u64) (((alt_u64) 1 << FIX_DIV_SHIFT(d)) / (d) + 1))
+
+static inline INT32S fix_div_magic(INT32S x, alt_u64 magic, int shift)
+{
+  if (x >= 0) {
+    return (INT32S) (((alt_u64) x * magic) >> shift);
+  }
+  return -(INT32S) (((alt_u64) -x * magic) >> shift);
+}
+
+#if defined(ALT_CPU_HARDWARE_MULX_PRESENT) && (ALT_CPU_HARDWARE_MULX_PRESENT == 0)
+#define FIX_DIV_CONST(x, d)  ((INT32S) (x) / (d))
+#else
+#define FIX_DIV_CONST(x, d)  fix_div_magic((x), FIX_DIV_MAGIC(d), FIX_DIV_SHIFT(d))
+#endif
+
+#endif /* __FIXED_H__ */
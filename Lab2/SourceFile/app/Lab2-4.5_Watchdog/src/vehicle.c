@@ -0,0 +1,82 @@
+/* Vehicle model
+ *
+ * Description:
+ *
+ *   The car model is equivalent to moving mass with linear resistances acting upon it.
+ *   Therefore, if left one, it will stably stop as the velocity converges to zero on a flat surface.
+ *   You can prove that easily via basic LTI systems methods.
+ *
+ *   The track is TRACK_LENGTH meters long, with uphill and downhill segments
+ *   between 400 m and 1200 m and from 1600 m on.
+ */
+#include "cruise.h"
+#include "fixed.h"
+
+// constants that should not be modified
+static const unsigned int wind_factor = 1;
+static const unsigned int brake_factor = 4;
+static const unsigned int gravity_factor = 2;
+
+void vehicle_init(struct vehicle* v)
+{
+  v->position = 0;
+  v->velocity = 0;
+  v->acceleration = 0;
+}
+
+/*
+ * Advances the model by 'period_ms' with the actuator signals 'act'. The
+ * brake and engine signals bypass the control law.
+ *
+ * The arithmetic is integer only.  The new velocity is the truncated
+ * velocity + acceleration * period_ms / 1000, computed on millimeters per
+ * second, which gives the same result as the floating point expression it
+ * replaces (host/sim/vehicle_check.c verifies it).
+ */
+void vehicle_step(struct vehicle* v, const struct actuators* act,
+                  int period_ms)
+{
+  INT8U throttle = act->throttle;
+  INT16U position = v->position;
+  INT16S velocity = v->velocity;
+  INT16S acceleration;
+
+  // vehichle cannot effort more than 80 units of throttle
+  if (throttle > 80) throttle = 80;
+
+  // brakes + wind
+  if (act->brake == off)
+  {
+    // wind resistance
+    acceleration = - wind_factor*velocity;
+    // actuate with engines
+    if (act->engine == on) {
+      acceleration += throttle;
+    }
+
+    // gravity effects
+    if (400 <= position && position < 800)
+      acceleration -= gravity_factor; // traveling uphill
+    else if (800 <= position && position < 1200)
+      acceleration -= 2*gravity_factor; // traveling steep uphill
+    else if (1600 <= position && position < 2000)
+      acceleration += 2*gravity_factor; //traveling downhill
+    else if (2000 <= position)
+      acceleration += gravity_factor; // traveling steep downhill
+  }
+  // if the engine and the brakes are activated at the same time,
+  // we assume that the brake dynamics dominates, so both cases fall
+  // here.
+  else
+    acceleration = - brake_factor*velocity;
+
+  position = position + FIX_DIV_CONST(velocity * period_ms, 1000);
+  velocity = fix_sat16(FIX_DIV_CONST(velocity * 1000 + acceleration * period_ms, 1000));
+  // reset the position to the beginning of the track
+  if(position > TRACK_LENGTH)
+    position = 0;
+
+  v->position = position;
+  v->velocity = velocity;
+  v->acceleration = acceleration;
+}
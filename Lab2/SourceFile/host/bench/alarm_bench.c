@@ -0,0 +1,164 @@
+/* Alarm processing benchmark
+ *
+ * Description:
+ *
+ *   Measures the number of cycles spent in alt_tick() with 1 to 64
+ *   registered alt_alarms, using section 1 of the performance counter.  The
+ *   tick is called from the benchmark task with interrupts disabled and
+ *   OSIntNesting raised, which is the state the timer ISR calls it in, so the
+ *   cycles include OSTimeTick() with the few tasks of the benchmark.
+ *
+ *   Two loads are measured for every alarm count:
+ *
+ *     idle      every alarm expires far beyond the end of the run, like the
+ *               1 s clock of Lab 1 seen from the ticks in between.
+ *     periodic  every alarm has a period of 2..8 ticks, so a measured tick
+ *               also makes some of their callbacks.
+ *
+ *   alt_alarm_start() keeps the alarms sorted by expiry, so alt_tick() stops
+ *   at the first alarm that is not due, and the idle load costs the same for
+ *   any number of alarms.  The "walk" column is the number of alarms an
+ *   unsorted list would visit on every tick, and "due" the callbacks made per
+ *   tick on average.  The cost of an empty measurement section is
+ *   subtracted from every sample.  The host adds much noise to the average,
+ *   which the minimum is freer of.  Run with ALT_HOST_SPEEDUP=20.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "system.h"
+#include "includes.h"
+#include "sys/alt_alarm.h"
+#include "altera_avalon_performance_counter.h"
+
+#define TASK_STACKSIZE 2048
+
+#define BENCH_PRIO     1
+#define ALARM_MAX      64
+
+#define SAMPLES        2000
+#define IDLE_PERIOD    600000
+
+static const int alarm_counts[] = {1, 8, 16, 32, 64};
+
+OS_STK Bench_Stack[TASK_STACKSIZE];
+
+static alt_alarm bench_alarms[ALARM_MAX];
+
+static volatile alt_u32 callbacks;
+
+/*
+ * Alarm callback: counts the call and registers the alarm again after the
+ * period given by its context.
+ */
+static alt_u32 alarm_handler(void* context)
+{
+  callbacks++;
+  return (alt_u32) (long) context;
+}
+
+/*
+ * Returns the cycles spent in one call to alt_tick() in interrupt context.
+ */
+static alt_u32 measure_tick(void)
+{
+#if OS_CRITICAL_METHOD == 3
+  OS_CPU_SR cpu_sr = 0;
+#endif
+
+  OS_ENTER_CRITICAL();
+  OSIntNesting++;
+  PERF_RESET(PERFORMANCE_COUNTER_BASE);
+  PERF_START_MEASURING(PERFORMANCE_COUNTER_BASE);
+  PERF_BEGIN(PERFORMANCE_COUNTER_BASE, 1);
+  alt_tick();
+  PERF_END(PERFORMANCE_COUNTER_BASE, 1);
+  PERF_STOP_MEASURING(PERFORMANCE_COUNTER_BASE);
+  OSIntNesting--;
+  OS_EXIT_CRITICAL();
+  return (alt_u32) perf_get_section_time((void*) PERFORMANCE_COUNTER_BASE, 1);
+}
+
+/*
+ * Returns the cycles of an empty measurement section.
+ */
+static alt_u32 measure_overhead(void)
+{
+  alt_u32 min = 0xFFFFFFFF;
+  alt_u32 t;
+  int i;
+
+  for (i = 0; i < SAMPLES; i++) {
+    PERF_RESET(PERFORMANCE_COUNTER_BASE);
+    PERF_START_MEASURING(PERFORMANCE_COUNTER_BASE);
+    PERF_BEGIN(PERFORMANCE_COUNTER_BASE, 1);
+    PERF_END(PERFORMANCE_COUNTER_BASE, 1);
+    PERF_STOP_MEASURING(PERFORMANCE_COUNTER_BASE);
+    t = (alt_u32) perf_get_section_time((void*) PERFORMANCE_COUNTER_BASE, 1);
+    if (t < min) {
+      min = t;
+    }
+  }
+  return min;
+}
+
+/*
+ * Starts 'n' alarms, measures SAMPLES ticks and stops the alarms again.
+ */
+static void run(int n, int periodic, alt_u32 overhead)
+{
+  alt_u32 sum = 0;
+  alt_u32 min = 0xFFFFFFFF;
+  alt_u32 period;
+  alt_u32 t;
+  int i;
+
+  for (i = 0; i < n; i++) {
+    period = periodic ? 2 + (i % 7) : IDLE_PERIOD + i;
+    alt_alarm_start(&bench_alarms[i], period, alarm_handler,
+                    (void*) (long) period);
+  }
+  callbacks = 0;
+
+  for (i = 0; i < SAMPLES; i++) {
+    t = measure_tick();
+    t = (t > overhead) ? t - overhead : 0;
+    sum += t;
+    if (t < min) {
+      min = t;
+    }
+  }
+
+  for (i = 0; i < n; i++) {
+    alt_alarm_stop(&bench_alarms[i]);
+  }
+  printf("%-9s %6d %6d %4u.%02u %10u %10u\n", periodic ? "periodic" : "idle",
+         n, n, (unsigned) (callbacks / SAMPLES),
+         (unsigned) (callbacks * 100 / SAMPLES % 100),
+         (unsigned) (sum / SAMPLES), (unsigned) min);
+}
+
+void BenchTask(void* pdata)
+{
+  alt_u32 overhead;
+  unsigned i;
+
+  overhead = measure_overhead();
+  printf("alt_tick() with sorted alarms\n");
+  printf("Measurement overhead: %u cycles\n", (unsigned) overhead);
+  printf("%-9s %6s %6s %7s %10s %10s\n", "load", "alarms", "walk", "due",
+         "avg", "min");
+  for (i = 0; i < sizeof(alarm_counts) / sizeof(alarm_counts[0]); i++) {
+    run(alarm_counts[i], 0, overhead);
+  }
+  for (i = 0; i < sizeof(alarm_counts) / sizeof(alarm_counts[0]); i++) {
+    run(alarm_counts[i], 1, overhead);
+  }
+  exit(0);
+}
+
+int main(void)
+{
+  OSTaskCreate(BenchTask, NULL, &Bench_Stack[TASK_STACKSIZE-1], BENCH_PRIO);
+  OSStart();
+  return 0;
+}
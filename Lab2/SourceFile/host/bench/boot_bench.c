@@ -0,0 +1,190 @@
+/* Boot benchmark
+ *
+ * Description:
+ *
+ *   Measures the cycles from reset to the first task, and the bulk memory
+ *   primitives of the kernel that make up most of them:
+ *
+ *     OS_MemClr    clears the kernel tables in OSInit() and every TCB in
+ *                  OS_TCBInit(), here on a buffer the size of OSTCBTbl[].
+ *     OS_MemCopy   copies a TCB in OSTaskQuery().
+ *     OS_TaskStkClr
+ *                  clears the stack of a task created with
+ *                  OS_TASK_OPT_STK_CLR, TASK_STACKSIZE entries.
+ *     OSTaskStkChk scans the stack of a task that has not run yet.  On
+ *                  the host the tasks run on host stacks, which the port
+ *                  gives the TCB, so this is a host stack of
+ *                  OS_CPU_HOST_STK_SIZE bytes.
+ *
+ *   Like the Watchdog application, main() creates seven tasks with
+ *   OSTaskCreateExt(), OS_TASK_OPT_STK_CHK and OS_TASK_OPT_STK_CLR and
+ *   stacks of TASK_STACKSIZE entries before it starts the kernel.  The
+ *   first of them reads the cycles since reset, split into the part before
+ *   main(), which is OSInit() and the device drivers, and the part from
+ *   main() to the first task.  Reset is the start of the host process,
+ *   where the cycle count of alt_host.h begins, and there is one sample
+ *   per run, so run it a few times.  The primitives are measured with
+ *   section 1 of the performance counter and their median is printed.
+ *
+ *   The host Makefile builds the benchmark twice: boot_bench with the word
+ *   at a time primitives (OS_MEM_WORD_EN) and boot_bench_byte with the
+ *   byte and entry at a time loops they replaced.  Run with
+ *   ALT_HOST_SPEEDUP=20.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "system.h"
+#include "includes.h"
+#include "alt_host.h"
+#include "altera_avalon_performance_counter.h"
+
+#define TASK_STACKSIZE 2048
+
+#define BENCH_PRIO     1
+#define WORKER_PRIO    2
+#define WORKERS        6
+
+#define SAMPLES        2000
+
+OS_STK Bench_Stack[TASK_STACKSIZE];
+OS_STK Worker_Stack[WORKERS][TASK_STACKSIZE];
+
+static OS_STK  Scratch_Stack[TASK_STACKSIZE];
+/* Words for the size of OSTCBTbl[] plus one byte, for the misaligned clear */
+static INT32U  Scratch_Tbl[(sizeof(OSTCBTbl) + sizeof(INT32U)) / sizeof(INT32U)];
+static OS_TCB  Scratch_TCB;
+
+static alt_u64 main_cycles;             /* alt_host_cycles() at main() */
+
+static alt_u32 samples[SAMPLES];
+
+static alt_u32 overhead;        /* Cycles of an empty measurement section */
+
+static void perf_begin(void)
+{
+  PERF_RESET(PERFORMANCE_COUNTER_BASE);
+  PERF_START_MEASURING(PERFORMANCE_COUNTER_BASE);
+  PERF_BEGIN(PERFORMANCE_COUNTER_BASE, 1);
+}
+
+static alt_u32 perf_end(void)
+{
+  alt_u32 t;
+
+  PERF_END(PERFORMANCE_COUNTER_BASE, 1);
+  PERF_STOP_MEASURING(PERFORMANCE_COUNTER_BASE);
+  t = (alt_u32) perf_get_section_time((void*) PERFORMANCE_COUNTER_BASE, 1);
+  return (t > overhead) ? t - overhead : 0;
+}
+
+/*
+ * Returns the cycles of an empty measurement section.
+ */
+static alt_u32 measure_overhead(void)
+{
+  alt_u32 min = 0xFFFFFFFF;
+  alt_u32 t;
+  int i;
+
+  for (i = 0; i < SAMPLES; i++) {
+    perf_begin();
+    t = perf_end();
+    if (t < min) {
+      min = t;
+    }
+  }
+  return min;
+}
+
+static int compare(const void* a, const void* b)
+{
+  alt_u32 x = *(const alt_u32*) a;
+  alt_u32 y = *(const alt_u32*) b;
+
+  return (x > y) - (x < y);
+}
+
+static void report(const char* name, unsigned bytes)
+{
+  qsort(samples, SAMPLES, sizeof(samples[0]), compare);
+  printf("%-14s %6u %8u\n", name, bytes, (unsigned) samples[SAMPLES / 2]);
+}
+
+static void WorkerTask(void* pdata)
+{
+  for (;;) {
+    OSTaskSuspend(OS_PRIO_SELF);
+  }
+}
+
+void BenchTask(void* pdata)
+{
+  alt_u64 first = alt_host_cycles();
+  OS_STK_DATA stk;
+  INT8U* tbl = (INT8U*) Scratch_Tbl;
+  int i;
+
+  printf("%-20s %10s\n", "boot", "cycles");
+  printf("%-20s %10u\n", "reset to main", (unsigned) main_cycles);
+  printf("%-20s %10u\n", "main to first task",
+         (unsigned) (first - main_cycles));
+  printf("%-20s %10u\n\n", "reset to first task", (unsigned) first);
+
+  overhead = measure_overhead();
+  printf("%-14s %6s %8s\n", "primitive", "bytes", "median");
+
+  for (i = 0; i < SAMPLES; i++) {
+    perf_begin();
+    OS_MemClr(tbl, sizeof(OSTCBTbl));
+    samples[i] = perf_end();
+  }
+  report("OS_MemClr", sizeof(OSTCBTbl));
+
+  for (i = 0; i < SAMPLES; i++) {
+    perf_begin();
+    OS_MemClr(tbl + 1, sizeof(OSTCBTbl));
+    samples[i] = perf_end();
+  }
+  report("  unaligned", sizeof(OSTCBTbl));
+
+  for (i = 0; i < SAMPLES; i++) {
+    perf_begin();
+    OS_MemCopy((INT8U*) &Scratch_TCB, (INT8U*) OSTCBCur, sizeof(OS_TCB));
+    samples[i] = perf_end();
+  }
+  report("OS_MemCopy", sizeof(OS_TCB));
+
+  for (i = 0; i < SAMPLES; i++) {
+    perf_begin();
+    OS_TaskStkClr(Scratch_Stack, TASK_STACKSIZE,
+                  OS_TASK_OPT_STK_CHK | OS_TASK_OPT_STK_CLR);
+    samples[i] = perf_end();
+  }
+  report("OS_TaskStkClr", sizeof(Scratch_Stack));
+
+  for (i = 0; i < SAMPLES; i++) {
+    perf_begin();
+    OSTaskStkChk(WORKER_PRIO, &stk);
+    samples[i] = perf_end();
+  }
+  report("OSTaskStkChk", (unsigned) (stk.OSFree + stk.OSUsed));
+  exit(0);
+}
+
+int main(void)
+{
+  int i;
+
+  main_cycles = alt_host_cycles();
+  for (i = 0; i < WORKERS; i++) {
+    OSTaskCreateExt(WorkerTask, NULL, &Worker_Stack[i][TASK_STACKSIZE-1],
+                    WORKER_PRIO + i, WORKER_PRIO + i, &Worker_Stack[i][0],
+                    TASK_STACKSIZE, NULL,
+                    OS_TASK_OPT_STK_CHK | OS_TASK_OPT_STK_CLR);
+  }
+  OSTaskCreateExt(BenchTask, NULL, &Bench_Stack[TASK_STACKSIZE-1], BENCH_PRIO,
+                  BENCH_PRIO, &Bench_Stack[0], TASK_STACKSIZE, NULL,
+                  OS_TASK_OPT_STK_CHK | OS_TASK_OPT_STK_CLR);
+  OSStart();
+  return 0;
+}
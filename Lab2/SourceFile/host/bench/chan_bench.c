@@ -0,0 +1,185 @@
+/* State channel benchmark
+ *
+ * Description:
+ *
+ *   Compares the two ways ControlTask can pick up the driver inputs once per
+ *   control period: polling the five mailboxes Gas, Gear, Cruise,
+ *   EngineSwitch and BrakeButton with OSMboxPend() and a timeout of one tick,
+ *   as the mailbox version of ControlTask does, and one OSChanRead() of a
+ *   state channel holding all five signals.  Section 1 of the performance
+ *   counter measures, for each of them:
+ *
+ *     mbox full   five polls, every mailbox holds a message, which is what
+ *                 ControlTask sees when the IO tasks posted in its period.
+ *     mbox empty  five polls of empty mailboxes; every poll waits for its
+ *                 timeout of one tick, so only a few samples are taken.
+ *     chan        one read of the channel.
+ *
+ *   The inputs are posted or written before each sample, outside the
+ *   measurement.  The cost of an empty measurement section is subtracted
+ *   from every sample.  On the host, cycles are derived from the host clock,
+ *   so run with ALT_HOST_SPEEDUP=20 to get a resolution of one host
+ *   nanosecond.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "system.h"
+#include "includes.h"
+#include "altera_avalon_performance_counter.h"
+
+#define TASK_STACKSIZE 2048
+
+#define BENCH_PRIO     1
+
+#define SAMPLES        2000
+#define SAMPLES_EMPTY  10
+
+#define INPUTS         5
+
+enum active {on = 2, off = 1};
+
+struct inputs {
+  enum active gas;
+  enum active top_gear;
+  enum active cruise;
+  enum active engine;
+  enum active brake;
+};
+
+OS_STK Bench_Stack[TASK_STACKSIZE];
+
+OS_EVENT *Mbox[INPUTS];
+OS_CHAN *Chan_Inputs;
+struct inputs Chan_Inputs_Buf[2];
+
+enum active posted[INPUTS];     /* Values the mailbox messages point to */
+
+static alt_u32 overhead;        /* Cycles of an empty measurement section */
+
+static void perf_begin(void)
+{
+  PERF_RESET(PERFORMANCE_COUNTER_BASE);
+  PERF_START_MEASURING(PERFORMANCE_COUNTER_BASE);
+  PERF_BEGIN(PERFORMANCE_COUNTER_BASE, 1);
+}
+
+static alt_u32 perf_end(void)
+{
+  alt_u32 t;
+
+  PERF_END(PERFORMANCE_COUNTER_BASE, 1);
+  PERF_STOP_MEASURING(PERFORMANCE_COUNTER_BASE);
+  t = (alt_u32) perf_get_section_time((void*) PERFORMANCE_COUNTER_BASE, 1);
+  return (t > overhead) ? t - overhead : 0;
+}
+
+/*
+ * Polls the five mailboxes the way ControlTask does, keeping the previous
+ * value of every input whose mailbox is empty.
+ */
+static void poll_mailboxes(enum active* in)
+{
+  INT8U err;
+  void* msg;
+  int i;
+
+  for (i = 0; i < INPUTS; i++) {
+    msg = OSMboxPend(Mbox[i], 1, &err);
+    if (err == OS_NO_ERR)
+      in[i] = *(enum active*) msg;
+  }
+}
+
+/*
+ * Prints the average and minimum of 'n' samples.
+ */
+static void report(const char* what, alt_u32 sum, alt_u32 min, int n)
+{
+  printf("%-10s %10u %10u\n", what, (unsigned) (sum / n), (unsigned) min);
+}
+
+static void run_mbox(int full, int n)
+{
+  enum active in[INPUTS];
+  alt_u32 sum = 0;
+  alt_u32 min = 0xFFFFFFFF;
+  alt_u32 t;
+  int i;
+  int j;
+
+  for (i = 0; i < n; i++) {
+    if (full) {
+      for (j = 0; j < INPUTS; j++) {
+        posted[j] = (i & 1) ? on : off;
+        OSMboxPost(Mbox[j], (void*) &posted[j]);
+      }
+    }
+    perf_begin();
+    poll_mailboxes(in);
+    t = perf_end();
+    sum += t;
+    if (t < min) {
+      min = t;
+    }
+  }
+  report(full ? "mbox full" : "mbox empty", sum, min, n);
+}
+
+static void run_chan(void)
+{
+  struct inputs w;
+  struct inputs in;
+  alt_u32 sum = 0;
+  alt_u32 min = 0xFFFFFFFF;
+  alt_u32 t;
+  INT8U err;
+  int i;
+
+  for (i = 0; i < SAMPLES; i++) {
+    w.gas = w.top_gear = w.cruise = w.engine = w.brake = (i & 1) ? on : off;
+    OSChanWrite(Chan_Inputs, &w);
+    perf_begin();
+    OSChanRead(Chan_Inputs, &in, &err);
+    t = perf_end();
+    sum += t;
+    if (t < min) {
+      min = t;
+    }
+  }
+  report("chan", sum, min, SAMPLES);
+}
+
+void BenchTask(void* pdata)
+{
+  INT8U err;
+  int i;
+
+  overhead = 0xFFFFFFFF;
+  for (i = 0; i < SAMPLES; i++) {
+    alt_u32 t;
+
+    perf_begin();
+    t = perf_end();
+    if (t < overhead) {
+      overhead = t;
+    }
+  }
+  for (i = 0; i < INPUTS; i++) {
+    Mbox[i] = OSMboxCreate((void*) 0);
+  }
+  Chan_Inputs = OSChanCreate(Chan_Inputs_Buf, sizeof(struct inputs), &err);
+
+  printf("Measurement overhead: %u cycles\n", (unsigned) overhead);
+  printf("%-10s %10s %10s\n", "inputs", "avg", "min");
+  run_mbox(1, SAMPLES);
+  run_mbox(0, SAMPLES_EMPTY);
+  run_chan();
+  exit(0);
+}
+
+int main(void)
+{
+  OSTaskCreate(BenchTask, NULL, &Bench_Stack[TASK_STACKSIZE-1], BENCH_PRIO);
+  OSStart();
+  return 0;
+}
@@ -0,0 +1,174 @@
+/* EDF scheduling benchmark
+ *
+ * Description:
+ *
+ *   Finds the largest Extraload, in steps of 2% of its period as set by the
+ *   switches of the Watchdog application, that a task set shaped like the
+ *   cruise control can take without missing a deadline:
+ *
+ *     watchdog   300 ms,   6 ms, fixed priority above the EDF band
+ *     buttonio    50 ms,   5 ms
+ *     switchio    90 ms,   9 ms
+ *     vehicle    130 ms,  13 ms
+ *     extraload  200 ms,   the load under test
+ *     control    300 ms,  30 ms
+ *
+ *   The tasks are periodic tasks (OSTaskCreatePeriodic()), with their
+ *   priorities assigned rate monotonically, the best fixed priority order.
+ *   Every task but watchdog lies in the EDF band (OS_EDF_PRIO_HI to
+ *   OS_EDF_PRIO_LO), so edf_bench schedules them by earliest deadline, while
+ *   edf_bench_fp, the same benchmark with EDF compiled out (OS_EDF_EN set to
+ *   0), schedules them by priority.  The periods are not harmonic, so the
+ *   fixed priorities run out before the CPU does; with the equal periods of
+ *   the lab, both policies would fill the CPU.
+ *
+ *   All tasks are released on the same tick, the worst case for fixed
+ *   priorities.  Up to 100% of the CPU, a deadline that is missed at all is
+ *   missed within the first busy period, which is shorter than RUN_MS.  The
+ *   misses are the deadlines missed by finished jobs (OSTCBPeriodMissCtr)
+ *   and the jobs still running past their deadline at the end, which counts
+ *   the backlog of an overload, and the sweep stops at the first load that
+ *   misses one.  A
+ *   task burns its execution time on its own cycle count, from
+ *   OSTaskProfileQuery(), so that preemption does not shorten it.  Run with
+ *   ALT_HOST_SPEEDUP=4, which leaves the host enough time for the critical
+ *   sections of the busy loops.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "system.h"
+#include "includes.h"
+
+#define TASK_STACKSIZE 2048
+
+#define BENCH_PRIO     1
+#define WATCHDOG_PRIO  7    /* Above the EDF band */
+
+#define RUN_MS         1200 /* ms per load */
+#define LOAD_STEP      2    /* % of the period of extraload */
+
+#define MS_TO_TICKS(ms) ((ms) * OS_TICKS_PER_SEC / 1000)
+
+struct load {
+  const char* name;
+  INT8U prio;
+  INT16U period;                /* ms */
+  INT32U exec;                  /* ms, 0 for extraload */
+};
+
+static const struct load loads[] = {
+  { "watchdog",  WATCHDOG_PRIO,      300,  6 },
+  { "buttonio",  OS_EDF_PRIO_HI,      50,  5 },
+  { "switchio",  OS_EDF_PRIO_HI + 1,  90,  9 },
+  { "vehicle",   OS_EDF_PRIO_HI + 2, 130, 13 },
+  { "extraload", OS_EDF_PRIO_HI + 3, 200,  0 },
+  { "control",   OS_EDF_PRIO_HI + 4, 300, 30 },
+};
+
+#define LOADS      (sizeof(loads) / sizeof(loads[0]))
+#define EXTRALOAD  4
+
+OS_STK Bench_Stack[TASK_STACKSIZE];
+OS_STK Load_Stack[LOADS][TASK_STACKSIZE];
+
+static INT32U exec_cycles[LOADS];
+
+/*
+ * Runs until the calling task has been running for 'cycles' more cycles.
+ */
+static void burn(INT32U cycles)
+{
+  OS_TASK_PROFILE prof;
+  INT32U start;
+
+  OSTaskProfileQuery(OS_PRIO_SELF, &prof, OS_PROFILE_OPT_NONE);
+  start = prof.OSCyclesTot;
+  do {
+    OSTaskProfileQuery(OS_PRIO_SELF, &prof, OS_PROFILE_OPT_NONE);
+  } while (prof.OSCyclesTot - start < cycles);
+}
+
+void LoadTask(void* pdata)
+{
+  INT32U cycles = *(INT32U*) pdata;
+
+  while (1) {
+    burn(cycles);
+    OSTaskWaitNextPeriod();
+  }
+}
+
+/*
+ * Runs the task set with an extraload of 'percent' and returns the number
+ * of deadlines missed.
+ */
+static INT32U run(int percent)
+{
+  OS_TCB tcb;
+  INT32U misses;
+  unsigned i;
+
+  for (i = 0; i < LOADS; i++) {
+    if (i == EXTRALOAD) {
+      exec_cycles[i] = (INT32U) ((alt_u64) loads[i].period * percent *
+                                 (ALT_CPU_FREQ / 1000) / 100);
+    } else {
+      exec_cycles[i] = loads[i].exec * (ALT_CPU_FREQ / 1000);
+    }
+  }
+  OSTimeDly(1);                 /* Release all tasks on the same tick */
+  for (i = 0; i < LOADS; i++) {
+    OSTaskCreatePeriodic(LoadTask, &exec_cycles[i],
+                         &Load_Stack[i][TASK_STACKSIZE-1], loads[i].prio,
+                         loads[i].prio, &Load_Stack[i][0], TASK_STACKSIZE,
+                         NULL, 0, MS_TO_TICKS(loads[i].period));
+  }
+  OSTimeDly(MS_TO_TICKS(RUN_MS));
+
+  misses = 0;
+  for (i = 0; i < LOADS; i++) {
+    OSTaskQuery(loads[i].prio, &tcb);
+    misses += tcb.OSTCBPeriodMissCtr;
+    if ((INT32S) (OSTimeGet() - tcb.OSTCBRelease - tcb.OSTCBPeriod) >= 0) {
+      misses++;                 /* Job still running past its deadline */
+    }
+    OSTaskDel(loads[i].prio);
+  }
+  return misses;
+}
+
+void BenchTask(void* pdata)
+{
+  const char* policy = (OS_EDF_EN > 0) ? "edf" : "fp";
+  int base;
+  int best;
+  int percent;
+  INT32U misses;
+  unsigned i;
+
+  base = 0;                     /* Utilisation of the other tasks, in 0.1% */
+  for (i = 0; i < LOADS; i++) {
+    base += loads[i].exec * 1000 / loads[i].period;
+  }
+
+  printf("%-6s %9s %6s %6s\n", "policy", "extraload", "util", "misses");
+  best = -1;
+  for (percent = 0; percent <= 100; percent += LOAD_STEP) {
+    misses = run(percent);
+    printf("%-6s %8d%% %5d%% %6u\n", policy, percent,
+           (base + percent * 10) / 10, (unsigned) misses);
+    if (misses > 0) {
+      break;
+    }
+    best = percent;
+  }
+  printf("%-6s max extraload %d%%\n", policy, best);
+  exit(0);
+}
+
+int main(void)
+{
+  OSTaskCreate(BenchTask, NULL, &Bench_Stack[TASK_STACKSIZE-1], BENCH_PRIO);
+  OSStart();
+  return 0;
+}
@@ -0,0 +1,32 @@
+/*
+ * system.h for the kernel benchmarks.
+ *
+ * Takes the generated system.h of the BSP and only raises the kernel
+ * limits, so that the benchmarks can create more tasks and timers than
+ * the lab applications do.  Without OS_PRIO_BITSCAN_EN, priorities above 63
+ * select the 16-bit ready table.  A benchmark may set other limits with
+ * BENCH_MAX_TASKS and BENCH_LOWEST_PRIO.
+ */
+
+#ifndef __BENCH_SYSTEM_H_
+#define __BENCH_SYSTEM_H_
+
+#include_next "system.h"
+
+#ifndef BENCH_MAX_TASKS
+#define BENCH_MAX_TASKS 72
+#endif
+#ifndef BENCH_LOWEST_PRIO
+#define BENCH_LOWEST_PRIO 80
+#endif
+
+#undef  OS_MAX_TASKS
+#define OS_MAX_TASKS BENCH_MAX_TASKS
+
+#undef  OS_LOWEST_PRIO
+#define OS_LOWEST_PRIO BENCH_LOWEST_PRIO
+
+#undef  OS_TMR_CFG_MAX
+#define OS_TMR_CFG_MAX 256
+
+#endif /* __BENCH_SYSTEM_H_ */
@@ -0,0 +1,164 @@
+/* Interrupt dispatch benchmark
+ *
+ * Description:
+ *
+ *   Measures the latency from the entry of alt_irq_handler() to the entry of
+ *   the handler of the pending interrupt, for IRQ lines across the 32 lines
+ *   of the interrupt controller, among them those of the JTAG UART, the
+ *   system clock timer and the KEYS4 PIO.  The performance counter starts
+ *   section 1 before alt_irq_handler() is called and the handler ends it.
+ *
+ *   For every sample, the benchmark task disables interrupts, registers its
+ *   own handler on the line in place of the one of the device, asserts the
+ *   line and calls alt_irq_handler(), as the exception entry does.  The
+ *   handler negates the line, and the handler of the device is registered
+ *   again before interrupts are enabled.
+ *
+ *   irq_bench finds the pending line by counting trailing zeros
+ *   (ALT_IRQ_BITSCAN), so the latency is the same for every line;
+ *   irq_bench_loop is the same benchmark with the bit by bit search from
+ *   IRQ 0 (ALT_IRQ_BITSCAN set to 0), whose latency grows with the line
+ *   number, and irq_bench_remap with the priorities of the lines taken from
+ *   alt_irq_priority[] (ALT_IRQ_PRIORITY_REMAP).  The cost of an empty
+ *   measurement section is subtracted from every sample.  Run with
+ *   ALT_HOST_SPEEDUP=20.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "system.h"
+#include "includes.h"
+#include "sys/alt_irq.h"
+#include "priv/alt_irq_table.h"
+#include "altera_avalon_performance_counter.h"
+
+#define TASK_STACKSIZE 2048
+
+#define BENCH_PRIO     1
+
+#define SAMPLES        2000
+
+struct line {
+  const char* name;
+  alt_u32 irq;
+};
+
+static const struct line lines[] = {
+  { "irq0",     0 },
+  { "jtag",     JTAG_UART_0_IRQ },
+  { "timer",    TIMER_0_IRQ },
+  { "keys4",    D2_PIO_KEYS4_IRQ },
+  { "irq16",   16 },
+  { "irq31",   31 },
+};
+
+OS_STK Bench_Stack[TASK_STACKSIZE];
+
+extern void alt_irq_handler(void);
+
+/*
+ * Handler of the measured line: ends the measurement and clears the line.
+ */
+static void bench_isr(void* context)
+{
+  PERF_END(PERFORMANCE_COUNTER_BASE, 1);
+  alt_host_irq_negate((alt_u32) (long) context);
+}
+
+/*
+ * Returns the cycles from the entry of alt_irq_handler() to the entry of the
+ * handler of line 'irq'.
+ */
+static alt_u32 measure_irq(alt_u32 irq)
+{
+  struct ALT_IRQ_HANDLER saved;
+  alt_u32 enabled;
+#if OS_CRITICAL_METHOD == 3
+  OS_CPU_SR cpu_sr = 0;
+#endif
+
+  OS_ENTER_CRITICAL();
+  saved = alt_irq[irq];
+  enabled = alt_ic_irq_enabled(0, irq);
+  alt_ic_isr_register(0, irq, bench_isr, (void*) (long) irq, NULL);
+  alt_host_irq_assert(irq);
+  PERF_RESET(PERFORMANCE_COUNTER_BASE);
+  PERF_START_MEASURING(PERFORMANCE_COUNTER_BASE);
+  PERF_BEGIN(PERFORMANCE_COUNTER_BASE, 1);
+  alt_irq_handler();
+  PERF_STOP_MEASURING(PERFORMANCE_COUNTER_BASE);
+  alt_irq[irq] = saved;
+  if (!enabled) {
+    alt_ic_irq_disable(0, irq);
+  }
+  OS_EXIT_CRITICAL();
+  return (alt_u32) perf_get_section_time((void*) PERFORMANCE_COUNTER_BASE, 1);
+}
+
+/*
+ * Returns the cycles of an empty measurement section.
+ */
+static alt_u32 measure_overhead(void)
+{
+  alt_u32 min = 0xFFFFFFFF;
+  alt_u32 t;
+  int i;
+
+  for (i = 0; i < SAMPLES; i++) {
+    PERF_RESET(PERFORMANCE_COUNTER_BASE);
+    PERF_START_MEASURING(PERFORMANCE_COUNTER_BASE);
+    PERF_BEGIN(PERFORMANCE_COUNTER_BASE, 1);
+    PERF_END(PERFORMANCE_COUNTER_BASE, 1);
+    PERF_STOP_MEASURING(PERFORMANCE_COUNTER_BASE);
+    t = (alt_u32) perf_get_section_time((void*) PERFORMANCE_COUNTER_BASE, 1);
+    if (t < min) {
+      min = t;
+    }
+  }
+  return min;
+}
+
+void BenchTask(void* pdata)
+{
+  const char* search;
+  alt_u32 overhead;
+  alt_u32 sum;
+  alt_u32 min;
+  alt_u32 t;
+  unsigned i;
+  int j;
+
+#if defined(ALT_IRQ_BITSCAN) && !ALT_IRQ_BITSCAN
+  search = "loop";
+#elif defined(ALT_IRQ_PRIORITY_REMAP)
+  search = "remap";
+#else
+  search = "bitscan";
+#endif
+
+  overhead = measure_overhead();
+  printf("Measurement overhead: %u cycles\n", (unsigned) overhead);
+  printf("%-8s %-6s %4s %8s %8s\n", "search", "line", "irq", "avg", "min");
+  for (i = 0; i < sizeof(lines) / sizeof(lines[0]); i++) {
+    sum = 0;
+    min = 0xFFFFFFFF;
+    for (j = 0; j < SAMPLES; j++) {
+      t = measure_irq(lines[i].irq);
+      t = (t > overhead) ? t - overhead : 0;
+      sum += t;
+      if (t < min) {
+        min = t;
+      }
+    }
+    printf("%-8s %-6s %4u %8u %8u\n", search, lines[i].name,
+           (unsigned) lines[i].irq, (unsigned) (sum / SAMPLES),
+           (unsigned) min);
+  }
+  exit(0);
+}
+
+int main(void)
+{
+  OSTaskCreate(BenchTask, NULL, &Bench_Stack[TASK_STACKSIZE-1], BENCH_PRIO);
+  OSStart();
+  return 0;
+}
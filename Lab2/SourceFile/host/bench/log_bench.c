@@ -0,0 +1,163 @@
+/* Logging benchmark
+ *
+ * Description:
+ *
+ *   Measures the time a control task spends logging in every period, with
+ *   printf() and with the deferred logging of OSLogPost().  The benchmark
+ *   task logs the four lines VehicleTask logs per period and is released
+ *   every tick.  Section 1 of the performance counter measures the four
+ *   calls, and the average and worst case over all periods are reported.
+ *
+ *   A lower priority task prints all the time, as the other tasks of the
+ *   application do:
+ *
+ *     printf    it prints its own lines with printf(), so the benchmark task
+ *               may have to wait for the stdio semaphore at any of its calls.
+ *     log       it is the drain, printing the records of the benchmark task.
+ *
+ *   The cost of an empty measurement section is subtracted from every
+ *   sample.  On the host, cycles are derived from the host clock, so run
+ *   with ALT_HOST_SPEEDUP=20 to get a resolution of one host nanosecond.
+ *   The formatted lines go to stdout and the results to stderr, so run with
+ *   stdout redirected, e.g. to /dev/null.  On the board printf() also waits
+ *   for the JTAG UART whenever its buffer is full, which the host does not
+ *   model.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "system.h"
+#include "includes.h"
+#include "altera_avalon_performance_counter.h"
+
+#define TASK_STACKSIZE 2048
+
+#define BENCH_PRIO     1
+#define PRINTER_PRIO   10
+
+#define SAMPLES        2000
+#define LOG_RECORDS    64
+
+OS_STK Bench_Stack[TASK_STACKSIZE];
+OS_STK Printer_Stack[TASK_STACKSIZE];
+
+OS_LOG_REC Log_Buf[LOG_RECORDS];
+
+static alt_u32 overhead;        /* Cycles of an empty measurement section */
+static volatile int stop;       /* Asks the printer to delete itself */
+
+static void perf_begin(void)
+{
+  PERF_RESET(PERFORMANCE_COUNTER_BASE);
+  PERF_START_MEASURING(PERFORMANCE_COUNTER_BASE);
+  PERF_BEGIN(PERFORMANCE_COUNTER_BASE, 1);
+}
+
+static alt_u32 perf_end(void)
+{
+  alt_u32 t;
+
+  PERF_END(PERFORMANCE_COUNTER_BASE, 1);
+  PERF_STOP_MEASURING(PERFORMANCE_COUNTER_BASE);
+  t = (alt_u32) perf_get_section_time((void*) PERFORMANCE_COUNTER_BASE, 1);
+  return (t > overhead) ? t - overhead : 0;
+}
+
+/*
+ * Prints its own lines (pdata == 0) or drains the logs, until 'stop' is
+ * set.  The drain waits for the notification of OSLogPost(), for a tick
+ * at most so that it sees 'stop'.  It deletes itself outside printf(), so
+ * the stdio semaphore is never left taken.
+ */
+void PrinterTask(void* pdata)
+{
+  OS_LOG_REC rec;
+  INT8U err;
+  int i = 0;
+
+  if (pdata != NULL) {
+    OSLogDrainSet(OS_PRIO_SELF);
+  }
+  while (!stop) {
+    if (pdata == NULL) {
+      printf("Background line %d\n", i++);
+    } else if (OSLogAccept(&rec) == OS_ERR_NONE) {
+      printf(rec.OSLogFmt, rec.OSLogArg[0], rec.OSLogArg[1]);
+    } else {
+      OSTaskNotifyPend(1, OS_NOTIFY_OPT_CLR, &err);
+    }
+  }
+  stop = 0;
+  OSTaskDel(OS_PRIO_SELF);
+}
+
+static void run(int deferred)
+{
+  INT16U position = 1200;
+  INT16S velocity = -3;
+  INT16S acceleration = 7;
+  INT8U throttle = 40;
+  alt_u32 sum = 0;
+  alt_u32 max = 0;
+  alt_u32 t;
+  int i;
+
+  OSTaskCreate(PrinterTask, deferred ? (void*) 1 : NULL,
+               &Printer_Stack[TASK_STACKSIZE-1], PRINTER_PRIO);
+  for (i = 0; i < SAMPLES; i++) {
+    OSTimeDly(1);
+    perf_begin();
+    if (deferred) {
+      OSLogPost("Position: %d m\n", position, 0);
+      OSLogPost("Velocity: %d m/s\n", velocity, 0);
+      OSLogPost("Accell: %d m/s2\n", acceleration, 0);
+      OSLogPost("Throttle: %d V\n", throttle, 0);
+    } else {
+      printf("Position: %d m\n", position);
+      printf("Velocity: %d m/s\n", velocity);
+      printf("Accell: %d m/s2\n", acceleration);
+      printf("Throttle: %d V\n", throttle);
+    }
+    t = perf_end();
+    sum += t;
+    if (t > max) {
+      max = t;
+    }
+  }
+  stop = 1;
+  while (stop) {
+    OSTimeDly(1);
+  }
+  fprintf(stderr, "%-8s %10u %10u\n", deferred ? "log" : "printf",
+          (unsigned) (sum / SAMPLES), (unsigned) max);
+}
+
+void BenchTask(void* pdata)
+{
+  INT8U err;
+  int i;
+
+  overhead = 0xFFFFFFFF;
+  for (i = 0; i < SAMPLES; i++) {
+    alt_u32 t;
+
+    perf_begin();
+    t = perf_end();
+    if (t < overhead) {
+      overhead = t;
+    }
+  }
+  OSLogCreate(OS_PRIO_SELF, Log_Buf, LOG_RECORDS, &err);
+
+  fprintf(stderr, "Measurement overhead: %u cycles\n", (unsigned) overhead);
+  fprintf(stderr, "%-8s %10s %10s\n", "logging", "avg", "max");
+  run(0);
+  run(1);
+  exit(0);
+}
+
+int main(void)
+{
+  OSTaskCreate(BenchTask, NULL, &Bench_Stack[TASK_STACKSIZE-1], BENCH_PRIO);
+  OSStart();
+  return 0;
+}
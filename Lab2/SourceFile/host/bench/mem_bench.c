@@ -0,0 +1,253 @@
+/* Memory block benchmark
+ *
+ * Description:
+ *
+ *   Measures a pair of taking a block and returning it, in cycles, with
+ *   section 1 of the performance counter, three ways:
+ *
+ *     get/put   OSMemGet()/OSMemPut() on the partition the caller picks
+ *               for the size by hand, one critical section per call.
+ *     class     OSMemAlloc()/OSMemFree(), which find the size class
+ *               themselves, with no magazine attached.
+ *     magazine  the same with a magazine attached to the task
+ *               (OSMemMagSet()), which serves most pairs without a
+ *               critical section.
+ *
+ *   The pairs are made by one task, and then by four tasks that take turns
+ *   in bursts, each with its own magazine.  The sizes of the requests cycle
+ *   through 12, 24, 40 and 100 bytes, served by classes of 16 to 128
+ *   bytes.  The median and the average of the pairs are printed; the
+ *   average includes the tick interrupts.  At the end the usage of every
+ *   class is printed from OSMemClassQuery(), with the high-water mark of
+ *   each partition and the number of requests that fell back to a larger
+ *   class.  A critical section is a system call on the host, so the gap is
+ *   far larger than on the board.  Run with ALT_HOST_SPEEDUP=20.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "system.h"
+#include "includes.h"
+#include "altera_avalon_performance_counter.h"
+
+#define TASK_STACKSIZE 2048
+
+#define BENCH_PRIO     1
+#define WORKER_PRIO    2
+#define WORKERS        4
+
+#define PAIRS          8000
+#define BURST          50
+
+#define CLASSES        4
+
+enum { MODE_GETPUT, MODE_CLASS, MODE_MAGAZINE, MODES };
+
+static const char* mode_names[MODES] = {"get/put", "class", "magazine"};
+
+static const INT32U class_sizes[CLASSES]  = {16, 32, 64, 128};
+static const INT32U class_blocks[CLASSES] = {32, 32, 32, 16};
+static const INT32U request_sizes[]       = {12, 24, 40, 100};
+
+OS_STK Bench_Stack[TASK_STACKSIZE];
+OS_STK Worker_Stack[WORKERS][TASK_STACKSIZE];
+
+static INT32U Class_Buf[CLASSES][32 * 128 / sizeof(INT32U)];
+static INT32U Part_Buf[CLASSES][32 * 128 / sizeof(INT32U)];
+
+static OS_MEM*   Part[CLASSES];         /* Partitions of the get/put pairs */
+static OS_MEM_MAG Mags[WORKERS];
+
+static alt_u32 samples[PAIRS];
+static int     nsamples;
+
+static int     mode;
+static int     workers;                 /* Workers of the current run */
+
+static alt_u32 overhead;        /* Cycles of an empty measurement section */
+
+static void perf_begin(void)
+{
+  PERF_RESET(PERFORMANCE_COUNTER_BASE);
+  PERF_START_MEASURING(PERFORMANCE_COUNTER_BASE);
+  PERF_BEGIN(PERFORMANCE_COUNTER_BASE, 1);
+}
+
+static alt_u32 perf_end(void)
+{
+  alt_u32 t;
+
+  PERF_END(PERFORMANCE_COUNTER_BASE, 1);
+  PERF_STOP_MEASURING(PERFORMANCE_COUNTER_BASE);
+  t = (alt_u32) perf_get_section_time((void*) PERFORMANCE_COUNTER_BASE, 1);
+  return (t > overhead) ? t - overhead : 0;
+}
+
+/*
+ * Returns the cycles of an empty measurement section.
+ */
+static alt_u32 measure_overhead(void)
+{
+  alt_u32 min = 0xFFFFFFFF;
+  alt_u32 t;
+  int i;
+
+  for (i = 0; i < PAIRS; i++) {
+    perf_begin();
+    t = perf_end();
+    if (t < min) {
+      min = t;
+    }
+  }
+  return min;
+}
+
+/*
+ * Returns the partition a caller of OSMemGet() would pick for 'size'.
+ */
+static OS_MEM* part_for(INT32U size)
+{
+  int i;
+
+  for (i = 0; i < CLASSES; i++) {
+    if (class_sizes[i] >= size) {
+      return Part[i];
+    }
+  }
+  return NULL;
+}
+
+/*
+ * Takes and returns a block of 'size' bytes and returns the cycles.
+ */
+static alt_u32 pair(INT32U size)
+{
+  OS_MEM* pmem;
+  void* pblk;
+  INT8U err;
+  alt_u32 t;
+
+  perf_begin();
+  if (mode == MODE_GETPUT) {
+    pmem = part_for(size);
+    pblk = OSMemGet(pmem, &err);
+    if (pblk != NULL) {
+      err = OSMemPut(pmem, pblk);
+    }
+  } else {
+    pblk = OSMemAlloc(size, &err);
+    if (pblk != NULL) {
+      err = OSMemFree(pblk);
+    }
+  }
+  t = perf_end();
+  if (pblk == NULL || err != OS_NO_ERR) {
+    printf("%s pair of %u bytes failed: %d\n", mode_names[mode],
+           (unsigned) size, err);
+    exit(1);
+  }
+  return t;
+}
+
+/*
+ * Worker task: makes a burst of pairs every time the benchmark task
+ * releases it, then releases the benchmark task.
+ */
+static void WorkerTask(void* pdata)
+{
+  int id = (int) (long) pdata;
+  int attached = 0;
+  INT8U err;
+  int i;
+
+  for (;;) {
+    OSTaskNotifyPend(0, OS_NOTIFY_OPT_CLR, &err);
+    if ((mode == MODE_MAGAZINE) != attached) {
+      attached = !attached;
+      OSMemMagSet(attached ? &Mags[id] : NULL);
+    }
+    for (i = 0; i < BURST && nsamples < PAIRS; i++) {
+      samples[nsamples] = pair(request_sizes[(nsamples + id) % 4]);
+      nsamples++;
+    }
+    OSTaskNotifyPost(BENCH_PRIO, 1, OS_NOTIFY_OPT_SET);
+  }
+}
+
+static int compare(const void* a, const void* b)
+{
+  alt_u32 x = *(const alt_u32*) a;
+  alt_u32 y = *(const alt_u32*) b;
+
+  return (x > y) - (x < y);
+}
+
+static void run(int m, int n)
+{
+  alt_u64 sum = 0;
+  INT8U err;
+  int w = 0;
+  int i;
+
+  mode     = m;
+  workers  = n;
+  nsamples = 0;
+  while (nsamples < PAIRS) {
+    OSTaskNotifyPost(WORKER_PRIO + w, 1, OS_NOTIFY_OPT_SET);
+    OSTaskNotifyPend(0, OS_NOTIFY_OPT_CLR, &err);
+    w = (w + 1) % workers;
+  }
+
+  for (i = 0; i < PAIRS; i++) {
+    sum += samples[i];
+  }
+  qsort(samples, PAIRS, sizeof(samples[0]), compare);
+  printf("%-9s %5d %8u %8u\n", mode_names[m], n,
+         (unsigned) samples[PAIRS / 2], (unsigned) (sum / PAIRS));
+}
+
+void BenchTask(void* pdata)
+{
+  OS_MEM_CLASS_DATA data;
+  INT8U err;
+  int i;
+
+  for (i = 0; i < CLASSES; i++) {
+    Part[i] = OSMemCreate(Part_Buf[i], class_blocks[i], class_sizes[i], &err);
+    if (OSMemClassCreate(Class_Buf[i], class_blocks[i], class_sizes[i],
+                         &err) == NULL || Part[i] == NULL) {
+      printf("Cannot create the partitions: %d\n", err);
+      exit(1);
+    }
+  }
+  for (i = 0; i < WORKERS; i++) {
+    OSTaskCreate(WorkerTask, (void*) (long) i,
+                 &Worker_Stack[i][TASK_STACKSIZE-1], WORKER_PRIO + i);
+  }
+
+  overhead = measure_overhead();
+  printf("%-9s %5s %8s %8s\n", "pair", "tasks", "median", "avg");
+  for (i = 0; i < MODES; i++) {
+    run(i, 1);
+  }
+  for (i = 0; i < MODES; i++) {
+    run(i, WORKERS);
+  }
+
+  printf("\n%-6s %6s %6s %6s %6s %8s %6s\n", "class", "size", "blocks",
+         "free", "peak", "fallback", "fail");
+  for (i = 0; i < CLASSES; i++) {
+    OSMemClassQuery(i, &data);
+    printf("%-6d %6u %6u %6u %6u %8u %6u\n", i, (unsigned) data.OSBlkSize,
+           (unsigned) data.OSNBlks, (unsigned) data.OSNFree,
+           (unsigned) data.OSNUsedMax, (unsigned) data.OSFallbackCtr,
+           (unsigned) data.OSFailCtr);
+  }
+  exit(0);
+}
+
+int main(void)
+{
+  OSTaskCreate(BenchTask, NULL, &Bench_Stack[TASK_STACKSIZE-1], BENCH_PRIO);
+  OSStart();
+  return 0;
+}
@@ -0,0 +1,192 @@
+/* Task release benchmark
+ *
+ * Description:
+ *
+ *   Compares the two ways of releasing a periodic task from a timer
+ *   callback: OSSemPost() to a semaphore the task pends on, and
+ *   OSTaskNotifyPost() to the task's notification word.  Section 1 of the
+ *   performance counter measures, for each of them:
+ *
+ *     release   from the post in the benchmark task until the released
+ *               task, which has a higher priority, returns from its pend.
+ *     post      a post that readies no task, because nobody is waiting.
+ *     pend      a pend that returns at once, because a post is pending.
+ *
+ *   The release path is the one a timer callback takes; the other two are
+ *   measured within the benchmark task.
+ *
+ *   The cost of an empty measurement section is subtracted from every
+ *   sample.  On the host, cycles are derived from the host clock, so run
+ *   with ALT_HOST_SPEEDUP=20 to get a resolution of one host nanosecond.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "system.h"
+#include "includes.h"
+#include "altera_avalon_performance_counter.h"
+
+#define TASK_STACKSIZE 2048
+
+#define WAITER_PRIO    1
+#define BENCH_PRIO     2
+
+#define SAMPLES        2000
+
+OS_STK Bench_Stack[TASK_STACKSIZE];
+OS_STK Waiter_Stack[TASK_STACKSIZE];
+
+OS_EVENT *ReleaseSem;
+
+static alt_u32 overhead;        /* Cycles of an empty measurement section */
+static alt_u32 release_cycles;  /* Cycles of the last release */
+
+static void perf_begin(void)
+{
+  PERF_RESET(PERFORMANCE_COUNTER_BASE);
+  PERF_START_MEASURING(PERFORMANCE_COUNTER_BASE);
+  PERF_BEGIN(PERFORMANCE_COUNTER_BASE, 1);
+}
+
+static alt_u32 perf_end(void)
+{
+  alt_u32 t;
+
+  PERF_END(PERFORMANCE_COUNTER_BASE, 1);
+  PERF_STOP_MEASURING(PERFORMANCE_COUNTER_BASE);
+  t = (alt_u32) perf_get_section_time((void*) PERFORMANCE_COUNTER_BASE, 1);
+  return (t > overhead) ? t - overhead : 0;
+}
+
+/*
+ * Waits on the semaphore (pdata == 0) or on its notification word, and
+ * ends the measurement of every release.
+ */
+void WaiterTask(void* pdata)
+{
+  INT8U err;
+
+  while (1) {
+    if (pdata == NULL) {
+      OSSemPend(ReleaseSem, 0, &err);
+    } else {
+      OSTaskNotifyPend(0, OS_NOTIFY_OPT_DEC, &err);
+    }
+    release_cycles = perf_end();
+  }
+}
+
+/*
+ * Posts to the semaphore, or to the notification word of task 'prio'.
+ */
+static void post(int notify, INT8U prio)
+{
+  if (notify) {
+    OSTaskNotifyPost(prio, 0, OS_NOTIFY_OPT_INC);
+  } else {
+    OSSemPost(ReleaseSem);
+  }
+}
+
+static void pend(int notify)
+{
+  INT8U err;
+
+  if (notify) {
+    OSTaskNotifyPend(0, OS_NOTIFY_OPT_DEC, &err);
+  } else {
+    OSSemPend(ReleaseSem, 0, &err);
+  }
+}
+
+/*
+ * Prints the average and minimum of 'n' samples.
+ */
+static void report(const char* path, const char* what, alt_u32 sum, alt_u32 min)
+{
+  printf("%-8s %-8s %8u %8u\n", path, what, (unsigned) (sum / SAMPLES),
+         (unsigned) min);
+}
+
+static void run(int notify)
+{
+  const char* path = notify ? "notify" : "sem";
+  alt_u32 sum;
+  alt_u32 min;
+  alt_u32 t;
+  int i;
+
+  /* Release of a waiting task */
+  OSTaskCreate(WaiterTask, notify ? (void*) 1 : NULL,
+               &Waiter_Stack[TASK_STACKSIZE-1], WAITER_PRIO);
+  sum = 0;
+  min = 0xFFFFFFFF;
+  for (i = 0; i < SAMPLES; i++) {
+    perf_begin();
+    post(notify, WAITER_PRIO);
+    sum += release_cycles;
+    if (release_cycles < min) {
+      min = release_cycles;
+    }
+  }
+  OSTaskDel(WAITER_PRIO);
+  report(path, "release", sum, min);
+
+  /* Post without a waiting task, to the benchmark task itself for the
+     notification; the posts are consumed by the pends below */
+  sum = 0;
+  min = 0xFFFFFFFF;
+  for (i = 0; i < SAMPLES; i++) {
+    perf_begin();
+    post(notify, OS_PRIO_SELF);
+    t = perf_end();
+    sum += t;
+    if (t < min) {
+      min = t;
+    }
+  }
+  report(path, "post", sum, min);
+
+  /* Pend with a post available */
+  sum = 0;
+  min = 0xFFFFFFFF;
+  for (i = 0; i < SAMPLES; i++) {
+    perf_begin();
+    pend(notify);
+    t = perf_end();
+    sum += t;
+    if (t < min) {
+      min = t;
+    }
+  }
+  report(path, "pend", sum, min);
+}
+
+void BenchTask(void* pdata)
+{
+  int i;
+
+  overhead = 0xFFFFFFFF;
+  for (i = 0; i < SAMPLES; i++) {
+    alt_u32 t;
+
+    perf_begin();
+    t = perf_end();
+    if (t < overhead) {
+      overhead = t;
+    }
+  }
+  ReleaseSem = OSSemCreate(0);
+
+  printf("Measurement overhead: %u cycles\n", (unsigned) overhead);
+  printf("%-8s %-8s %8s %8s\n", "path", "op", "avg", "min");
+  run(0);
+  run(1);
+  exit(0);
+}
+
+int main(void)
+{
+  OSTaskCreate(BenchTask, NULL, &Bench_Stack[TASK_STACKSIZE-1], BENCH_PRIO);
+  OSStart();
+  return 0;
+}
@@ -0,0 +1,304 @@
+/* Placement benchmark
+ *
+ * Description:
+ *
+ *   Counts the accesses that the context switch and the tick make to the
+ *   kernel tables host/tools/memplace moves to onchip_memory, and the
+ *   cycles that moving them saves.  The paths counted are those the
+ *   Watchdog application takes all the time:
+ *
+ *     notify    the benchmark task releases a task of higher priority with
+ *               OSTaskNotifyPost(), which runs and pends again, so two
+ *               context switches, like a release by a timer callback.
+ *     sem       the same with OSSemPost() and OSSemPend(), as the timer
+ *               task is released by the tick.
+ *     tick      OSTimeTick() in interrupt context with TASKS tasks that
+ *               delay for 1 to TASKS ticks.
+ *
+ *   The accesses are counted with the pages of the tables protected: every
+ *   access faults, the fault handler counts it against the table at the
+ *   faulting address, lifts the protection and single-steps the access,
+ *   after which the trap handler protects the pages again.  An instruction
+ *   that reads and writes the same word counts once, where the Nios II
+ *   makes a load and a store, so the counts are lower bounds.  OSRdyTbl[]
+ *   is small data, which stays in the SRAM, and is not counted.  The tick
+ *   of the timer is stopped while the switches are counted, so that only
+ *   the ticks counted as such get into the counts.
+ *
+ *   The tasks' stacks are not the host stacks they run on, so the accesses
+ *   to the stacks are those of the Nios II port instead: a switch saves
+ *   CTX_WORDS words of the task switched out and restores as many of the
+ *   task switched in (OSCtxSw in os_cpu_a.S), and an interrupt saves and
+ *   restores IRQ_WORDS words (alt_exception_entry.S).  The frames of the C
+ *   functions the paths call are left out.
+ *
+ *   Every access to a table or a stack in onchip_memory instead of the
+ *   SRAM saves SRAM_EXTRA_CYCLES cycles, 2 by default, an estimate of the
+ *   wait states the SRAM of the DE2 system adds over onchip_memory; build
+ *   with the number of your system.  The accesses and the cycles saved are
+ *   printed per operation.  They do not depend on the speed of the host.
+ */
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ucontext.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include "system.h"
+#include "includes.h"
+#include "altera_avalon_timer_regs.h"
+
+#define TASK_STACKSIZE 2048
+
+#define WORKER_PRIO    1
+#define BENCH_PRIO     2
+#define LOAD_PRIO      10
+
+#define ROUNDS         2000
+#define TASKS          8
+
+#ifndef SRAM_EXTRA_CYCLES
+#define SRAM_EXTRA_CYCLES 2
+#endif
+
+#define CTX_WORDS      11      /* Frame of OSCtxSw, 'addi sp, sp, -44' */
+#define IRQ_WORDS      19      /* Frame of the exception entry, 76 bytes */
+
+#define PAGE           4096
+#define EFLAGS_TF      0x100
+
+enum { PATH_NOTIFY, PATH_SEM, PATH_TICK, PATHS };
+
+static const char* path_names[PATHS] = {"notify", "sem", "tick"};
+
+OS_STK Bench_Stack[TASK_STACKSIZE];
+OS_STK Worker_Stack[TASK_STACKSIZE];
+OS_STK Load_Stack[TASKS][TASK_STACKSIZE];
+
+static struct {
+  const char* name;
+  void* addr;
+  size_t size;
+} tables[] = {
+  {"OSTCBTbl", OSTCBTbl, sizeof(OSTCBTbl)},
+  {"OSTCBPrioTbl", OSTCBPrioTbl, sizeof(OSTCBPrioTbl)},
+  {"OSEventTbl", OSEventTbl, sizeof(OSEventTbl)},
+};
+
+#define TABLES (sizeof(tables) / sizeof(tables[0]))
+
+/*
+ * State of the handlers, on pages of its own so that it is never
+ * protected
+ */
+static union {
+  struct {
+    unsigned long count[TABLES];
+    int armed;
+  } s;
+  char pages[PAGE];
+} trap __attribute__ ((aligned (PAGE)));
+
+static OS_EVENT* sem;
+static int path;
+
+static void protect(int prot)
+{
+  unsigned long lo;
+  unsigned long hi;
+  unsigned i;
+
+  for (i = 0; i < TABLES; i++) {
+    lo = (unsigned long) tables[i].addr & ~(PAGE - 1UL);
+    hi = ((unsigned long) tables[i].addr + tables[i].size + PAGE - 1) &
+         ~(PAGE - 1UL);
+    if (mprotect((void*) lo, hi - lo, prot) != 0) {
+      abort();
+    }
+  }
+}
+
+/*
+ * Counts an access to a protected page and lets it through.
+ */
+static void on_fault(int sig, siginfo_t* si, void* context)
+{
+  ucontext_t* uc = context;
+  char* addr = si->si_addr;
+  unsigned i;
+
+  if (!trap.s.armed) {
+    signal(SIGSEGV, SIG_DFL);
+    return;
+  }
+  for (i = 0; i < TABLES; i++) {
+    if (addr >= (char*) tables[i].addr &&
+        addr < (char*) tables[i].addr + tables[i].size) {
+      trap.s.count[i]++;
+    }
+  }
+  protect(PROT_READ | PROT_WRITE);
+  uc->uc_mcontext.gregs[REG_EFL] |= EFLAGS_TF;
+}
+
+/*
+ * Protects the pages again after the access was stepped over.
+ */
+static void on_step(int sig, siginfo_t* si, void* context)
+{
+  ucontext_t* uc = context;
+
+  uc->uc_mcontext.gregs[REG_EFL] &= ~EFLAGS_TF;
+  if (trap.s.armed) {
+    protect(PROT_NONE);
+  }
+}
+
+static void arm(void)
+{
+  trap.s.armed = 1;
+  protect(PROT_NONE);
+}
+
+static void disarm(void)
+{
+  protect(PROT_READ | PROT_WRITE);
+  trap.s.armed = 0;
+}
+
+/*
+ * Worker task: pends on the notification or the semaphore, whichever the
+ * benchmark task is posting to.
+ */
+static void WorkerTask(void* pdata)
+{
+  INT8U err;
+
+  for (;;) {
+    if (path == PATH_SEM) {
+      OSSemPend(sem, 0, &err);
+    } else {
+      OSTaskNotifyPend(0, OS_NOTIFY_OPT_CLR, &err);
+    }
+  }
+}
+
+static void LoadTask(void* pdata)
+{
+  INT16U delay = (INT16U) (long) pdata;
+
+  for (;;) {
+    OSTimeDly(delay);
+  }
+}
+
+static void tick(void)
+{
+#if OS_CRITICAL_METHOD == 3
+  OS_CPU_SR cpu_sr = 0;
+#endif
+
+  OS_ENTER_CRITICAL();
+  OSIntNesting++;
+  arm();
+  OSTimeTick();
+  disarm();
+  OSIntNesting--;
+  OS_EXIT_CRITICAL();
+}
+
+/*
+ * Counts ROUNDS operations of path 'p' and prints the accesses and the
+ * cycles saved per operation.
+ */
+static void run(int p)
+{
+  unsigned long stack;
+  unsigned long sum;
+  unsigned i;
+  int r;
+
+  path = p;
+  if (p == PATH_SEM) {
+    OSTaskNotifyPost(WORKER_PRIO, 1, OS_NOTIFY_OPT_SET);  /* Pend on sem */
+  }
+  memset(trap.s.count, 0, sizeof(trap.s.count));
+  if (p == PATH_TICK) {
+    for (r = 0; r < ROUNDS; r++) {
+      tick();
+      OSTimeDly(1);
+    }
+    stack = 2 * IRQ_WORDS;
+  } else {
+    IOWR_ALTERA_AVALON_TIMER_CONTROL(TIMER_0_BASE,
+                                     ALTERA_AVALON_TIMER_CONTROL_STOP_MSK);
+    for (r = 0; r < ROUNDS; r++) {
+      arm();
+      if (p == PATH_SEM) {
+        OSSemPost(sem);
+      } else {
+        OSTaskNotifyPost(WORKER_PRIO, 1, OS_NOTIFY_OPT_SET);
+      }
+      disarm();
+    }
+    IOWR_ALTERA_AVALON_TIMER_CONTROL(TIMER_0_BASE,
+                                     ALTERA_AVALON_TIMER_CONTROL_ITO_MSK |
+                                     ALTERA_AVALON_TIMER_CONTROL_CONT_MSK |
+                                     ALTERA_AVALON_TIMER_CONTROL_START_MSK);
+    stack = 2 * 2 * CTX_WORDS;
+  }
+
+  printf("%-7s", path_names[p]);
+  sum = stack * ROUNDS;
+  for (i = 0; i < TABLES; i++) {
+    printf(" %*.1f", (int) strlen(tables[i].name) > 8 ?
+           (int) strlen(tables[i].name) : 8,
+           (double) trap.s.count[i] / ROUNDS);
+    sum += trap.s.count[i];
+  }
+  printf(" %8lu %8.1f %8.1f\n", stack, (double) sum / ROUNDS,
+         (double) sum * SRAM_EXTRA_CYCLES / ROUNDS);
+}
+
+void BenchTask(void* pdata)
+{
+  struct sigaction action;
+  unsigned i;
+  int p;
+
+  memset(&action, 0, sizeof(action));
+  action.sa_flags = SA_SIGINFO;
+  action.sa_sigaction = on_fault;
+  sigaction(SIGSEGV, &action, NULL);
+  action.sa_sigaction = on_step;
+  sigaction(SIGTRAP, &action, NULL);
+
+  sem = OSSemCreate(0);
+  OSTaskCreate(WorkerTask, NULL, &Worker_Stack[TASK_STACKSIZE-1],
+               WORKER_PRIO);
+  for (i = 0; i < TASKS; i++) {
+    OSTaskCreate(LoadTask, (void*) (long) (1 + i),
+                 &Load_Stack[i][TASK_STACKSIZE-1], LOAD_PRIO + i);
+  }
+  OSTimeDly(1);
+
+  printf("Accesses per operation, %d cycles saved per access to "
+         "onchip_memory\n", SRAM_EXTRA_CYCLES);
+  printf("%-7s", "path");
+  for (i = 0; i < TABLES; i++) {
+    printf(" %8s", tables[i].name);
+  }
+  printf(" %8s %8s %8s\n", "stack", "total", "saved");
+  for (p = 0; p < PATHS; p++) {
+    run(p);
+  }
+  exit(0);
+}
+
+int main(void)
+{
+  OSTaskCreate(BenchTask, NULL, &Bench_Stack[TASK_STACKSIZE-1], BENCH_PRIO);
+  OSStart();
+  return 0;
+}
@@ -0,0 +1,186 @@
+/* ISR to task hand-off benchmark
+ *
+ * Description:
+ *
+ *   Compares two ways of handing samples from an ISR over to a task: a
+ *   message queue of OS_EVENT (OSQPost(), one pointer per sample, taken
+ *   one by one with OSQAccept()), and a single-producer ring (OSRingPost(),
+ *   taken in one batch with OSRingAccept()).  Section 1 of the performance
+ *   counter measures, for bursts of 1 to 32 samples:
+ *
+ *     post      the posts of a burst, made with interrupts disabled and
+ *               OSIntNesting raised, the state an ISR posts in.
+ *     take      taking the burst back out in the benchmark task.
+ *
+ *   Both are printed in cycles per sample.  The queue enters a critical
+ *   section for every post and every take; the ring only for the post that
+ *   makes it non-empty, which notifies the consumer.  The cost of an empty
+ *   measurement section is subtracted from every sample.  A critical
+ *   section is a system call on the host, so the gap is far larger than
+ *   on the board.  Run with ALT_HOST_SPEEDUP=20.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "system.h"
+#include "includes.h"
+#include "altera_avalon_performance_counter.h"
+
+#define TASK_STACKSIZE 2048
+
+#define BENCH_PRIO     1
+
+#define SAMPLES        2000
+#define BURST_MAX      32
+
+static const int bursts[] = {1, 8, 32};
+
+OS_STK Bench_Stack[TASK_STACKSIZE];
+
+static void*  Queue_Buf[BURST_MAX];
+static INT32U Ring_Buf[BURST_MAX];
+
+static OS_EVENT* Queue;
+static OS_RING*  Ring;
+
+static alt_u32 overhead;        /* Cycles of an empty measurement section */
+
+static void perf_begin(void)
+{
+  PERF_RESET(PERFORMANCE_COUNTER_BASE);
+  PERF_START_MEASURING(PERFORMANCE_COUNTER_BASE);
+  PERF_BEGIN(PERFORMANCE_COUNTER_BASE, 1);
+}
+
+static alt_u32 perf_end(void)
+{
+  alt_u32 t;
+
+  PERF_END(PERFORMANCE_COUNTER_BASE, 1);
+  PERF_STOP_MEASURING(PERFORMANCE_COUNTER_BASE);
+  t = (alt_u32) perf_get_section_time((void*) PERFORMANCE_COUNTER_BASE, 1);
+  return (t > overhead) ? t - overhead : 0;
+}
+
+/*
+ * Returns the cycles of an empty measurement section.
+ */
+static alt_u32 measure_overhead(void)
+{
+  alt_u32 min = 0xFFFFFFFF;
+  alt_u32 t;
+  int i;
+
+  for (i = 0; i < SAMPLES; i++) {
+    perf_begin();
+    t = perf_end();
+    if (t < min) {
+      min = t;
+    }
+  }
+  return min;
+}
+
+/*
+ * Posts a burst of 'n' samples in interrupt context, to the queue or to
+ * the ring, and returns the cycles.
+ */
+static alt_u32 post_burst(int ring, int n)
+{
+  INT32U sample;
+  alt_u32 t;
+  int i;
+#if OS_CRITICAL_METHOD == 3
+  OS_CPU_SR cpu_sr = 0;
+#endif
+
+  OS_ENTER_CRITICAL();
+  OSIntNesting++;
+  perf_begin();
+  if (ring) {
+    for (i = 0; i < n; i++) {
+      sample = i;
+      OSRingPost(Ring, &sample);
+    }
+  } else {
+    for (i = 0; i < n; i++) {
+      OSQPost(Queue, (void*) (long) i);
+    }
+  }
+  t = perf_end();
+  OSIntNesting--;
+  OS_EXIT_CRITICAL();
+  return t;
+}
+
+/*
+ * Takes the burst of 'n' samples back out in the task and returns the
+ * cycles.
+ */
+static alt_u32 take_burst(int ring, int n)
+{
+  INT32U samples[BURST_MAX];
+  INT8U err;
+  alt_u32 t;
+  int i;
+
+  perf_begin();
+  if (ring) {
+    OSRingAccept(Ring, samples, n);
+  } else {
+    for (i = 0; i < n; i++) {
+      samples[i] = (INT32U) (long) OSQAccept(Queue, &err);
+    }
+  }
+  t = perf_end();
+  for (i = 0; i < n; i++) {
+    if (samples[i] != (INT32U) i) {
+      printf("Sample %d of a burst of %d is %u\n", i, n,
+             (unsigned) samples[i]);
+      exit(1);
+    }
+  }
+  return t;
+}
+
+static void run(int ring, int n)
+{
+  alt_u32 post = 0;
+  alt_u32 take = 0;
+  int i;
+
+  for (i = 0; i < SAMPLES; i++) {
+    post += post_burst(ring, n);
+    take += take_burst(ring, n);
+  }
+  printf("%-7s %5d %8u %8u\n", ring ? "ring" : "queue", n,
+         (unsigned) (post / SAMPLES / n), (unsigned) (take / SAMPLES / n));
+}
+
+void BenchTask(void* pdata)
+{
+  INT8U err;
+  unsigned i;
+
+  Queue = OSQCreate(Queue_Buf, BURST_MAX);
+  Ring = OSRingCreate(Ring_Buf, BURST_MAX, sizeof(INT32U), OS_PRIO_SELF,
+                      &err);
+  if (Queue == NULL || Ring == NULL) {
+    printf("Cannot create the queue or the ring\n");
+    exit(1);
+  }
+
+  overhead = measure_overhead();
+  printf("%-7s %5s %8s %8s\n", "handoff", "burst", "post", "take");
+  for (i = 0; i < sizeof(bursts) / sizeof(bursts[0]); i++) {
+    run(0, bursts[i]);
+    run(1, bursts[i]);
+  }
+  exit(0);
+}
+
+int main(void)
+{
+  OSTaskCreate(BenchTask, NULL, &Bench_Stack[TASK_STACKSIZE-1], BENCH_PRIO);
+  OSStart();
+  return 0;
+}
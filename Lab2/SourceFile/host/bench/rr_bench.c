@@ -0,0 +1,161 @@
+/* Round-robin benchmark
+ *
+ * Description:
+ *
+ *   Runs the task set of the mixedscheduling experiment of Lab 1: three
+ *   periodic tasks scheduled by priority,
+ *
+ *     task1      300 ms, 100 ms
+ *     task2      400 ms, 100 ms
+ *     task3      600 ms, 100 ms
+ *
+ *   and below them three background tasks that never block, like the
+ *   Round_Robin_Within_Priorities level of the Ada program.  The background
+ *   tasks have the priorities of the round-robin band (OS_RR_PRIO_HI and
+ *   the next two), so rr_bench shares what the periodic tasks leave of the
+ *   CPU between them in time slices of OS_RR_QUANTUM ticks.  rr_bench_off is
+ *   the same benchmark with round robin compiled out (OS_RR_EN set to 0),
+ *   where the first background task takes it all.
+ *
+ *   For every task, the benchmark prints its share of the CPU over RUN_MS,
+ *   from OSTaskProfileQuery(), the number of times it was switched in and,
+ *   for the periodic tasks, the deadlines missed.  Run with
+ *   ALT_HOST_SPEEDUP=4.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "system.h"
+#include "includes.h"
+
+#define TASK_STACKSIZE 2048
+
+#define BENCH_PRIO     1
+#define PERIODIC_PRIO  7    /* Priority of the first periodic task */
+#define PERIODICS      3
+#define BACKGROUNDS    3
+
+#define RUN_MS         6000 /* Five hyperperiods of the periodic tasks */
+
+#define MS_TO_TICKS(ms) ((ms) * OS_TICKS_PER_SEC / 1000)
+
+static const INT16U periods[PERIODICS] = { 300, 400, 600 };  /* ms */
+static const INT32U execs[PERIODICS]   = { 100, 100, 100 };  /* ms */
+
+OS_STK Bench_Stack[TASK_STACKSIZE];
+OS_STK Periodic_Stack[PERIODICS][TASK_STACKSIZE];
+OS_STK Background_Stack[BACKGROUNDS][TASK_STACKSIZE];
+
+static INT32U exec_cycles[PERIODICS];
+
+/*
+ * Runs until the calling task has been running for 'cycles' more cycles.
+ */
+static void burn(INT32U cycles)
+{
+  OS_TASK_PROFILE prof;
+  INT32U start;
+
+  OSTaskProfileQuery(OS_PRIO_SELF, &prof, OS_PROFILE_OPT_NONE);
+  start = prof.OSCyclesTot;
+  do {
+    OSTaskProfileQuery(OS_PRIO_SELF, &prof, OS_PROFILE_OPT_NONE);
+  } while (prof.OSCyclesTot - start < cycles);
+}
+
+void PeriodicTask(void* pdata)
+{
+  INT32U cycles = *(INT32U*) pdata;
+
+  while (1) {
+    burn(cycles);
+    OSTaskWaitNextPeriod();
+  }
+}
+
+void BackgroundTask(void* pdata)
+{
+  volatile INT32U work = 0;
+
+  while (1) {
+    work++;
+  }
+}
+
+static void report(const char* name, INT8U prio, INT32U cycles0,
+                   INT32U ctxsw0, INT32U total)
+{
+  OS_TASK_PROFILE prof;
+  OS_TCB tcb;
+
+  OSTaskProfileQuery(prio, &prof, OS_PROFILE_OPT_NONE);
+  OSTaskQuery(prio, &tcb);
+  printf("%-4s %-8s %5u.%u%% %8u", (OS_RR_EN > 0) ? "on" : "off", name,
+         (unsigned) ((alt_u64) (prof.OSCyclesTot - cycles0) * 1000 / total / 10),
+         (unsigned) ((alt_u64) (prof.OSCyclesTot - cycles0) * 1000 / total % 10),
+         (unsigned) (prof.OSCtxSwCtr - ctxsw0));
+  if (tcb.OSTCBPeriod != 0) {
+    printf(" %8u", (unsigned) tcb.OSTCBPeriodMissCtr);
+  }
+  printf("\n");
+}
+
+void BenchTask(void* pdata)
+{
+  OS_TASK_PROFILE prof;
+  INT32U cycles0[PERIODICS + BACKGROUNDS];
+  INT32U ctxsw0[PERIODICS + BACKGROUNDS];
+  INT32U start;
+  INT32U total;
+  INT8U prio[PERIODICS + BACKGROUNDS];
+  char name[16];
+  int i;
+
+  for (i = 0; i < PERIODICS; i++) {
+    prio[i] = PERIODIC_PRIO + i;
+  }
+  for (i = 0; i < BACKGROUNDS; i++) {
+    prio[PERIODICS + i] = OS_RR_PRIO_HI + i;
+  }
+
+  OSTimeDly(1);                 /* Release all tasks on the same tick */
+  for (i = 0; i < PERIODICS; i++) {
+    exec_cycles[i] = execs[i] * (ALT_CPU_FREQ / 1000);
+    OSTaskCreatePeriodic(PeriodicTask, &exec_cycles[i],
+                         &Periodic_Stack[i][TASK_STACKSIZE-1], prio[i],
+                         prio[i], &Periodic_Stack[i][0], TASK_STACKSIZE,
+                         NULL, 0, MS_TO_TICKS(periods[i]));
+  }
+  for (i = 0; i < BACKGROUNDS; i++) {
+    OSTaskCreateExt(BackgroundTask, NULL,
+                    &Background_Stack[i][TASK_STACKSIZE-1], prio[PERIODICS + i],
+                    prio[PERIODICS + i], &Background_Stack[i][0],
+                    TASK_STACKSIZE, NULL, 0);
+  }
+  for (i = 0; i < PERIODICS + BACKGROUNDS; i++) {
+    OSTaskProfileQuery(prio[i], &prof, OS_PROFILE_OPT_NONE);
+    cycles0[i] = prof.OSCyclesTot;
+    ctxsw0[i] = prof.OSCtxSwCtr;
+  }
+  start = OSCPUCyclesGet();
+  OSTimeDly(MS_TO_TICKS(RUN_MS));
+  total = OSCPUCyclesGet() - start;
+
+  printf("%-4s %-8s %7s %8s %8s\n", "rr", "task", "cpu", "switches",
+         "misses");
+  for (i = 0; i < PERIODICS + BACKGROUNDS; i++) {
+    if (i < PERIODICS) {
+      sprintf(name, "task%d", i + 1);
+    } else {
+      sprintf(name, "bgt%d", i - PERIODICS + 1);
+    }
+    report(name, prio[i], cycles0[i], ctxsw0[i], total);
+  }
+  exit(0);
+}
+
+int main(void)
+{
+  OSTaskCreate(BenchTask, NULL, &Bench_Stack[TASK_STACKSIZE-1], BENCH_PRIO);
+  OSStart();
+  return 0;
+}
@@ -0,0 +1,131 @@
+/* Scheduler benchmark
+ *
+ * Description:
+ *
+ *   Measures the cycles of one call to OS_Sched() that finds the calling
+ *   task still the highest priority ready task, which is the lookup of the
+ *   highest priority in the ready list and nothing else.  The benchmark task
+ *   moves itself to priorities spread over the range of the build with
+ *   OSTaskChangePrio(), so that the highest ready priority lies in the
+ *   first, a middle or the last word of the ready table.
+ *
+ *   The host Makefile builds the benchmark four times, with 64 and with 255
+ *   priorities (OS_LOWEST_PRIO 63 and 254) and with the two ways of finding
+ *   the highest priority:
+ *
+ *     sched_bench         255 priorities, bit scan of 32-bit words
+ *     sched_bench_64       64 priorities, bit scan of 32-bit words
+ *     sched_bench_tbl     255 priorities, OSUnMapTbl[] on 16-bit words
+ *     sched_bench_tbl64    64 priorities, OSUnMapTbl[] on 8-bit words
+ *
+ *   The bit scan (OS_PRIO_BITSCAN_EN) takes two scans for any number of
+ *   priorities, while the table takes two lookups up to priority 63 and two
+ *   to four above.  Every sample is a batch of BATCH calls, and the cost of
+ *   an empty measurement section is subtracted.  OS_Sched() enters a
+ *   critical section, a system call on the host, so compare the columns
+ *   between the builds rather than read them as cycles of the board.  Run
+ *   with ALT_HOST_SPEEDUP=20.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "system.h"
+#include "includes.h"
+#include "altera_avalon_performance_counter.h"
+
+#define TASK_STACKSIZE 2048
+
+#define BENCH_PRIO     1
+
+#define SAMPLES        2000
+#define BATCH          64
+
+OS_STK Bench_Stack[TASK_STACKSIZE];
+
+/* Priorities the benchmark task moves to, clear of the EDF and round-robin
+ * bands; those beyond the statistic task of the build are skipped. */
+static const INT8U prios[] = {1, 31, 61, 127, 252};
+
+/*
+ * Returns the cycles of an empty measurement section.
+ */
+static alt_u32 measure_overhead(void)
+{
+  alt_u32 min = 0xFFFFFFFF;
+  alt_u32 t;
+  int i;
+
+  for (i = 0; i < SAMPLES; i++) {
+    PERF_RESET(PERFORMANCE_COUNTER_BASE);
+    PERF_START_MEASURING(PERFORMANCE_COUNTER_BASE);
+    PERF_BEGIN(PERFORMANCE_COUNTER_BASE, 1);
+    PERF_END(PERFORMANCE_COUNTER_BASE, 1);
+    PERF_STOP_MEASURING(PERFORMANCE_COUNTER_BASE);
+    t = (alt_u32) perf_get_section_time((void*) PERFORMANCE_COUNTER_BASE, 1);
+    if (t < min) {
+      min = t;
+    }
+  }
+  return min;
+}
+
+/*
+ * Measures SAMPLES batches of OS_Sched() at the current priority and prints
+ * the average and minimum cycles per call.
+ */
+static void run(alt_u32 overhead)
+{
+  alt_u32 sum = 0;
+  alt_u32 min = 0xFFFFFFFF;
+  alt_u32 t;
+  int i;
+  int j;
+
+  for (i = 0; i < SAMPLES; i++) {
+    PERF_RESET(PERFORMANCE_COUNTER_BASE);
+    PERF_START_MEASURING(PERFORMANCE_COUNTER_BASE);
+    PERF_BEGIN(PERFORMANCE_COUNTER_BASE, 1);
+    for (j = 0; j < BATCH; j++) {
+      OS_Sched();
+    }
+    PERF_END(PERFORMANCE_COUNTER_BASE, 1);
+    PERF_STOP_MEASURING(PERFORMANCE_COUNTER_BASE);
+    t = (alt_u32) perf_get_section_time((void*) PERFORMANCE_COUNTER_BASE, 1);
+    t = (t > overhead) ? t - overhead : 0;
+    sum += t;
+    if (t < min) {
+      min = t;
+    }
+  }
+  printf("%-6s %5u %4u %5u %8u %8u\n",
+         (OS_PRIO_BITSCAN_EN > 0) ? "bscan" : "table",
+         (unsigned) OS_LOWEST_PRIO + 1, (unsigned) OSPrioCur,
+         (unsigned) OSTCBCur->OSTCBY,
+         (unsigned) (sum / SAMPLES / BATCH), (unsigned) (min / BATCH));
+}
+
+void BenchTask(void* pdata)
+{
+  alt_u32 overhead;
+  unsigned i;
+
+  overhead = measure_overhead();
+  printf("%-6s %5s %4s %5s %8s %8s\n", "lookup", "prios", "prio", "word",
+         "avg", "min");
+  for (i = 0; i < sizeof(prios) / sizeof(prios[0]); i++) {
+    if (prios[i] >= OS_TASK_STAT_PRIO) {
+      continue;
+    }
+    if (prios[i] != OSPrioCur) {
+      OSTaskChangePrio(OS_PRIO_SELF, prios[i]);
+    }
+    run(overhead);
+  }
+  exit(0);
+}
+
+int main(void)
+{
+  OSTaskCreate(BenchTask, NULL, &Bench_Stack[TASK_STACKSIZE-1], BENCH_PRIO);
+  OSStart();
+  return 0;
+}
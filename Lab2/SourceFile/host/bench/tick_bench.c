@@ -0,0 +1,161 @@
+/* Tick processing benchmark
+ *
+ * Description:
+ *
+ *   Measures the number of cycles spent in OSTimeTick() with 8, 32 and 63
+ *   delayed tasks, using section 1 of the performance counter.  The tick is
+ *   called from the benchmark task with interrupts disabled and OSIntNesting
+ *   raised, which is the state the timer ISR calls it in.
+ *
+ *   Two loads are measured for every task count:
+ *
+ *     idle      every task is delayed far beyond the end of the run, so no
+ *               delay expires during a measured tick.
+ *     periodic  every task repeatedly delays for 2..8 ticks, so a measured
+ *               tick also makes some of them ready.
+ *
+ *   The cost of an empty measurement section is subtracted from every sample.
+ *   Build the kernel with OS_TICK_LIST_EN set to 0 to get the linear scan of
+ *   the TCB list; the host Makefile builds both as tick_bench and
+ *   tick_bench_scan.  On the host, cycles are derived from the host clock, so
+ *   run with ALT_HOST_SPEEDUP=20 to get a resolution of one host nanosecond.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "system.h"
+#include "includes.h"
+#include "altera_avalon_performance_counter.h"
+
+#define TASK_STACKSIZE 512
+
+#define BENCH_PRIO     1
+#define LOAD_PRIO      10   /* Priority of the first load task */
+#define LOAD_MAX       63
+
+#define SAMPLES        2000
+#define IDLE_DELAY     60000
+
+OS_STK Bench_Stack[TASK_STACKSIZE];
+OS_STK Load_Stack[LOAD_MAX][TASK_STACKSIZE];
+
+static const int load_sizes[] = {8, 32, 63};
+
+/*
+ * Load task: delays itself forever, for either a long or a short period
+ * (given by pdata).
+ */
+void LoadTask(void* pdata)
+{
+  INT16U delay = (INT16U) (long) pdata;
+
+  while (1) {
+    OSTimeDly(delay);
+  }
+}
+
+/*
+ * Returns the cycles spent in one call to OSTimeTick() in interrupt context.
+ */
+static alt_u32 measure_tick(void)
+{
+#if OS_CRITICAL_METHOD == 3
+  OS_CPU_SR cpu_sr = 0;
+#endif
+
+  OS_ENTER_CRITICAL();
+  OSIntNesting++;
+  PERF_RESET(PERFORMANCE_COUNTER_BASE);
+  PERF_START_MEASURING(PERFORMANCE_COUNTER_BASE);
+  PERF_BEGIN(PERFORMANCE_COUNTER_BASE, 1);
+  OSTimeTick();
+  PERF_END(PERFORMANCE_COUNTER_BASE, 1);
+  PERF_STOP_MEASURING(PERFORMANCE_COUNTER_BASE);
+  OSIntNesting--;
+  OS_EXIT_CRITICAL();
+  return (alt_u32) perf_get_section_time((void*) PERFORMANCE_COUNTER_BASE, 1);
+}
+
+/*
+ * Returns the cycles of an empty measurement section.
+ */
+static alt_u32 measure_overhead(void)
+{
+  alt_u32 min = 0xFFFFFFFF;
+  alt_u32 t;
+  int i;
+
+  for (i = 0; i < SAMPLES; i++) {
+    PERF_RESET(PERFORMANCE_COUNTER_BASE);
+    PERF_START_MEASURING(PERFORMANCE_COUNTER_BASE);
+    PERF_BEGIN(PERFORMANCE_COUNTER_BASE, 1);
+    PERF_END(PERFORMANCE_COUNTER_BASE, 1);
+    PERF_STOP_MEASURING(PERFORMANCE_COUNTER_BASE);
+    t = (alt_u32) perf_get_section_time((void*) PERFORMANCE_COUNTER_BASE, 1);
+    if (t < min) {
+      min = t;
+    }
+  }
+  return min;
+}
+
+/*
+ * Creates 'n' load tasks, measures SAMPLES ticks and deletes the tasks again.
+ * With 'periodic' set, the benchmark task yields after every sample so that
+ * the readied tasks can delay themselves again.
+ */
+static void run(int n, int periodic, alt_u32 overhead)
+{
+  alt_u32 sum = 0;
+  alt_u32 max = 0;
+  alt_u32 t;
+  int i;
+
+  for (i = 0; i < n; i++) {
+    OSTaskCreate(LoadTask,
+                 (void*) (long) (periodic ? 2 + (i % 7) : IDLE_DELAY),
+                 &Load_Stack[i][TASK_STACKSIZE-1],
+                 LOAD_PRIO + i);
+  }
+  OSTimeDly(1);                 /* Let every load task delay itself */
+
+  for (i = 0; i < SAMPLES; i++) {
+    t = measure_tick();
+    t = (t > overhead) ? t - overhead : 0;
+    sum += t;
+    if (t > max) {
+      max = t;
+    }
+    if (periodic) {
+      OSTimeDly(1);
+    }
+  }
+
+  for (i = 0; i < n; i++) {
+    OSTaskDel(LOAD_PRIO + i);
+  }
+  printf("%-9s %5d %10u %10u\n", periodic ? "periodic" : "idle", n,
+         (unsigned) (sum / SAMPLES), (unsigned) max);
+}
+
+void BenchTask(void* pdata)
+{
+  alt_u32 overhead;
+  unsigned i;
+
+  overhead = measure_overhead();
+  printf("OSTimeTick() with OS_TICK_LIST_EN = %d\n", OS_TICK_LIST_EN);
+  printf("Measurement overhead: %u cycles\n", (unsigned) overhead);
+  printf("%-9s %5s %10s %10s\n", "load", "tasks", "avg", "max");
+  for (i = 0; i < sizeof(load_sizes) / sizeof(load_sizes[0]); i++) {
+    run(load_sizes[i], 0, overhead);
+    run(load_sizes[i], 1, overhead);
+  }
+  exit(0);
+}
+
+int main(void)
+{
+  OSTaskCreate(BenchTask, NULL, &Bench_Stack[TASK_STACKSIZE-1], BENCH_PRIO);
+  OSStart();
+  return 0;
+}
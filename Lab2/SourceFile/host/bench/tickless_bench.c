@@ -0,0 +1,164 @@
+/* Tickless idle benchmark
+ *
+ * Description:
+ *
+ *   Counts the ticks the kernel services in one simulated minute of a load
+ *   shaped like the cruise control of the Watchdog application, which is
+ *   idle most of the time:
+ *
+ *     tasks     six periodic tasks (OSTaskCreatePeriodic()) with a period of
+ *               300 ms, which do nothing but wait for their next release.
+ *     alarm     an alt_alarm every 100 ms that signals the timer task, as
+ *               the Watchdog application does.
+ *     timers    two periodic OS_TMRs of 3 timer ticks.
+ *
+ *   With OS_TICKLESS_EN, the idle task stops the tick until the next release,
+ *   alarm or timer expiry, and "serviced" counts the tick interrupts, the
+ *   calls of OSTimeTick() (OSTickCtr); the ticks skipped meanwhile are made
+ *   up for by OSTimeTickN() in the next interrupt.  tickless_bench_off is
+ *   the same benchmark with the tickless idle compiled out (OS_TICKLESS_EN
+ *   set to 0), where every tick is serviced.
+ *
+ *   The other columns check that stopping the tick changes nothing the
+ *   application relies on: the ticks OSTime advanced by, the releases of the
+ *   tasks, the alarms and the timer expiries are the same in both builds.
+ *   "ms" is the simulated time the minute took, read from the performance
+ *   counter, and "late" the latest release, in ticks after its release time,
+ *   of any task.  These two tell the builds apart when the host wakes the
+ *   simulation up more than a tick late, which it does now and then after
+ *   the process slept through a stretched period: with the tick running, a
+ *   timer interrupt that comes that late stands for the ticks it overran,
+ *   which are lost and make "ms" run ahead of "ticks"; with the tick
+ *   stopped, the driver makes up for them at once, so "ms" keeps with
+ *   "ticks", but the overdue tick comes before the released tasks ran and
+ *   "late" is 1.  Run with ALT_HOST_SPEEDUP=4: the host time it takes to
+ *   reprogram the timer model is scaled up with the simulated time, and at
+ *   higher speed-ups it shows as a drift of the "ms" column with the tick
+ *   stopped.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "system.h"
+#include "includes.h"
+#include "sys/alt_alarm.h"
+#include "altera_avalon_performance_counter.h"
+
+#define TASK_STACKSIZE 2048
+
+#define BENCH_PRIO     1
+#define LOAD_PRIO      10   /* Priority of the first load task */
+#define LOADS          6
+
+#define LOAD_PERIOD    300  /* ms */
+#define ALARM_PERIOD   100  /* ms */
+#define TMR_PERIOD     3    /* timer ticks */
+#define TMRS           2
+
+#define RUN_TICKS      (60 * OS_TICKS_PER_SEC)
+
+#define MS_TO_TICKS(ms) ((ms) * OS_TICKS_PER_SEC / 1000)
+
+OS_STK Bench_Stack[TASK_STACKSIZE];
+OS_STK Load_Stack[LOADS][TASK_STACKSIZE];
+
+static alt_alarm bench_alarm;
+
+static volatile alt_u32 releases;
+static volatile alt_u32 alarms;
+static volatile alt_u32 expiries;
+static volatile alt_u32 late_max;
+
+/*
+ * Load task: waits for its next release and notes how late it came.
+ */
+void LoadTask(void* pdata)
+{
+  INT32U late;
+#if OS_CRITICAL_METHOD == 3
+  OS_CPU_SR cpu_sr = 0;
+#endif
+
+  while (1) {
+    OSTaskWaitNextPeriod();
+    OS_ENTER_CRITICAL();
+    late = OSTime - OSTCBCur->OSTCBRelease;
+    releases++;
+    if (late > late_max) {
+      late_max = late;
+    }
+    OS_EXIT_CRITICAL();
+  }
+}
+
+static alt_u32 alarm_handler(void* context)
+{
+  alarms++;
+  OSTmrSignal();
+  return MS_TO_TICKS(ALARM_PERIOD);
+}
+
+static void tmr_callback(void* ptmr, void* callback_arg)
+{
+  expiries++;
+}
+
+void BenchTask(void* pdata)
+{
+  OS_TMR* tmr;
+  INT32U time;
+  alt_u32 serviced;
+  alt_u64 cycles;
+  INT8U err;
+  int i;
+
+  for (i = 0; i < LOADS; i++) {
+    OSTaskCreatePeriodic(LoadTask, NULL, &Load_Stack[i][TASK_STACKSIZE-1],
+                         LOAD_PRIO + i, LOAD_PRIO + i, &Load_Stack[i][0],
+                         TASK_STACKSIZE, NULL, 0, MS_TO_TICKS(LOAD_PERIOD));
+  }
+  alt_alarm_start(&bench_alarm, MS_TO_TICKS(ALARM_PERIOD), alarm_handler, NULL);
+  for (i = 0; i < TMRS; i++) {
+    tmr = OSTmrCreate(TMR_PERIOD, TMR_PERIOD, OS_TMR_OPT_PERIODIC,
+                      tmr_callback, NULL, (INT8U*) "bench", &err);
+    OSTmrStart(tmr, &err);
+  }
+  OSTimeDly(1);                 /* Start on a tick */
+
+  releases = 0;
+  alarms = 0;
+  expiries = 0;
+  late_max = 0;
+  time = OSTimeGet();
+#if OS_TICKLESS_EN > 0
+  serviced = OSTickCtr;
+#endif
+  PERF_RESET(PERFORMANCE_COUNTER_BASE);
+  PERF_START_MEASURING(PERFORMANCE_COUNTER_BASE);
+  PERF_BEGIN(PERFORMANCE_COUNTER_BASE, 1);
+  OSTimeDly(RUN_TICKS);
+  PERF_END(PERFORMANCE_COUNTER_BASE, 1);
+  PERF_STOP_MEASURING(PERFORMANCE_COUNTER_BASE);
+  cycles = perf_get_section_time((void*) PERFORMANCE_COUNTER_BASE, 1);
+  time = OSTimeGet() - time;
+#if OS_TICKLESS_EN > 0
+  serviced = OSTickCtr - serviced;
+#else
+  serviced = time;
+#endif
+
+  printf("%-8s %8s %8s %8s %8s %8s %8s %8s\n", "tickless", "serviced",
+         "ticks", "ms", "releases", "alarms", "expiries", "late");
+  printf("%-8s %8u %8u %8u %8u %8u %8u %8u\n",
+         (OS_TICKLESS_EN > 0) ? "on" : "off", (unsigned) serviced,
+         (unsigned) time, (unsigned) (cycles / (ALT_CPU_FREQ / 1000)),
+         (unsigned) releases, (unsigned) alarms, (unsigned) expiries,
+         (unsigned) late_max);
+  exit(0);
+}
+
+int main(void)
+{
+  OSTaskCreate(BenchTask, NULL, &Bench_Stack[TASK_STACKSIZE-1], BENCH_PRIO);
+  OSStart();
+  return 0;
+}
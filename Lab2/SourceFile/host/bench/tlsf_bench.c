@@ -0,0 +1,319 @@
+/* Heap allocator benchmark
+ *
+ * Description:
+ *
+ *   Compares the TLSF heap of the HAL (alt_tlsf.c) with the malloc() of the
+ *   C library on randomised allocation traces.  A trace keeps up to SLOTS
+ *   blocks alive: every step picks a slot at random and frees its block, or
+ *   allocates one if the slot is empty.  The traces differ in their sizes:
+ *
+ *     small     8 to 64 bytes, like messages and list nodes.
+ *     mixed     8 bytes to 4 KiB, spread evenly over the powers of two.
+ *     control   a few fixed record sizes of a control loop, with a 1 KiB
+ *               buffer now and then.
+ *
+ *   Every malloc() and free() is measured with section 1 of the
+ *   performance counter, with interrupts disabled, and the average, the
+ *   99th percentile and the maximum cycles are printed.  The cost of an
+ *   empty measurement section is subtracted from every sample.  Each trace
+ *   is run once before it is measured, so that the pages of both heaps are
+ *   mapped.  The blocks are filled with a pattern that is checked when they
+ *   are freed.
+ *
+ *   On the board malloc() is newlib's, a Doug Lea allocator like the one
+ *   of the host C library, whose worst case grows with the number of free
+ *   chunks it searches and merges.  The time of TLSF is bounded, but the
+ *   maxima on the host are dominated by the host itself, which the
+ *   percentile is freer of.  After each trace the statistics of the TLSF
+ *   heap are printed, with the trace's blocks still allocated.  Run with
+ *   ALT_HOST_SPEEDUP=20.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "system.h"
+#include "includes.h"
+#include "sys/alt_tlsf.h"
+#include "altera_avalon_performance_counter.h"
+
+#define TASK_STACKSIZE 2048
+
+#define BENCH_PRIO     1
+
+#define SLOTS          256
+#define STEPS          20000
+#define ARENA_BYTES    (1024 * 1024)
+
+enum { TRACE_SMALL, TRACE_MIXED, TRACE_CONTROL, TRACES };
+
+static const char* trace_names[TRACES] = {"small", "mixed", "control"};
+
+static const size_t control_sizes[] = {16, 24, 24, 40, 48, 64, 128, 1024};
+
+OS_STK Bench_Stack[TASK_STACKSIZE];
+
+static char arena[ARENA_BYTES] __attribute__ ((aligned (16)));
+
+static alt_tlsf heap;
+
+static void*  slots[SLOTS];
+static size_t sizes[SLOTS];
+
+static alt_u32 seed;
+
+static alt_u32 overhead;        /* Cycles of an empty measurement section */
+
+struct result {
+  alt_u32 mallocs;
+  alt_u32 frees;
+  alt_u32 malloc_t[STEPS];
+  alt_u32 free_t[STEPS];
+};
+
+static struct result res;
+
+static alt_u32 bench_rand(void)
+{
+  seed = seed * 1103515245 + 12345;
+  return seed >> 8;
+}
+
+static size_t trace_size(int trace)
+{
+  switch (trace) {
+  case TRACE_SMALL:
+    return 8 + bench_rand() % 57;
+  case TRACE_MIXED:
+    return 8 + bench_rand() % (8u << (bench_rand() % 10));
+  default:
+    return control_sizes[bench_rand() % (sizeof(control_sizes) /
+                                         sizeof(control_sizes[0]))];
+  }
+}
+
+static void perf_begin(void)
+{
+  PERF_RESET(PERFORMANCE_COUNTER_BASE);
+  PERF_START_MEASURING(PERFORMANCE_COUNTER_BASE);
+  PERF_BEGIN(PERFORMANCE_COUNTER_BASE, 1);
+}
+
+static alt_u32 perf_end(void)
+{
+  alt_u32 t;
+
+  PERF_END(PERFORMANCE_COUNTER_BASE, 1);
+  PERF_STOP_MEASURING(PERFORMANCE_COUNTER_BASE);
+  t = (alt_u32) perf_get_section_time((void*) PERFORMANCE_COUNTER_BASE, 1);
+  return (t > overhead) ? t - overhead : 0;
+}
+
+/*
+ * Returns the cycles of an empty measurement section.
+ */
+static alt_u32 measure_overhead(void)
+{
+  alt_u32 min = 0xFFFFFFFF;
+  alt_u32 t;
+  int i;
+
+  for (i = 0; i < STEPS; i++) {
+    perf_begin();
+    t = perf_end();
+    if (t < min) {
+      min = t;
+    }
+  }
+  return min;
+}
+
+static void* bench_malloc(int tlsf, size_t size)
+{
+  void* p;
+  alt_u32 t;
+#if OS_CRITICAL_METHOD == 3
+  OS_CPU_SR cpu_sr = 0;
+#endif
+
+  OS_ENTER_CRITICAL();
+  perf_begin();
+  p = tlsf ? alt_tlsf_malloc(&heap, size) : malloc(size);
+  t = perf_end();
+  OS_EXIT_CRITICAL();
+
+  res.malloc_t[res.mallocs++] = t;
+  return p;
+}
+
+static void bench_free(int tlsf, void* p)
+{
+  alt_u32 t;
+#if OS_CRITICAL_METHOD == 3
+  OS_CPU_SR cpu_sr = 0;
+#endif
+
+  OS_ENTER_CRITICAL();
+  perf_begin();
+  if (tlsf) {
+    alt_tlsf_free(&heap, p);
+  } else {
+    free(p);
+  }
+  t = perf_end();
+  OS_EXIT_CRITICAL();
+
+  res.free_t[res.frees++] = t;
+}
+
+/*
+ * Runs a trace against one of the heaps and leaves its blocks allocated.
+ */
+static void run_trace(int tlsf, int trace)
+{
+  unsigned char* p;
+  size_t i;
+  int step;
+  int n;
+
+  res.mallocs = 0;
+  res.frees   = 0;
+  seed = 1 + trace;
+
+  for (step = 0; step < STEPS; step++) {
+    n = bench_rand() % SLOTS;
+    p = slots[n];
+    if (p) {
+      for (i = 0; i < sizes[n]; i++) {
+        if (p[i] != (unsigned char) (n + i)) {
+          printf("Block of slot %d corrupted at byte %u\n", n, (unsigned) i);
+          exit(1);
+        }
+      }
+      bench_free(tlsf, p);
+      slots[n] = NULL;
+    } else {
+      sizes[n] = trace_size(trace);
+      p = bench_malloc(tlsf, sizes[n]);
+      if (p == NULL) {
+        printf("Out of memory in the %s trace\n", trace_names[trace]);
+        exit(1);
+      }
+      for (i = 0; i < sizes[n]; i++) {
+        p[i] = (unsigned char) (n + i);
+      }
+      slots[n] = p;
+    }
+  }
+}
+
+static void release(int tlsf)
+{
+  int n;
+
+  for (n = 0; n < SLOTS; n++) {
+    if (slots[n]) {
+      if (tlsf) {
+        alt_tlsf_free(&heap, slots[n]);
+      } else {
+        free(slots[n]);
+      }
+      slots[n] = NULL;
+    }
+  }
+}
+
+/*
+ * Makes the TLSF heap anew, so that its peak is that of the next trace.
+ */
+static void heap_reset(void)
+{
+  alt_tlsf_create(&heap);
+  if (alt_tlsf_add_pool(&heap, arena, sizeof(arena)) != 0) {
+    printf("Cannot add the arena to the heap\n");
+    exit(1);
+  }
+}
+
+static int compare(const void* a, const void* b)
+{
+  alt_u32 x = *(const alt_u32*) a;
+  alt_u32 y = *(const alt_u32*) b;
+
+  return (x > y) - (x < y);
+}
+
+/*
+ * Prints the average, the 99th percentile and the maximum of 'n'
+ * samples.
+ */
+static void report_samples(alt_u32* t, alt_u32 n)
+{
+  alt_u64 sum = 0;
+  alt_u32 i;
+
+  for (i = 0; i < n; i++) {
+    sum += t[i];
+  }
+  qsort(t, n, sizeof(t[0]), compare);
+  printf(" %7u %7u %7u", (unsigned) (sum / n), (unsigned) t[n * 99 / 100],
+         (unsigned) t[n - 1]);
+}
+
+static void report(int tlsf, int trace)
+{
+  printf("%-8s %-5s", trace_names[trace], tlsf ? "tlsf" : "libc");
+  report_samples(res.malloc_t, res.mallocs);
+  report_samples(res.free_t, res.frees);
+  printf("\n");
+}
+
+void BenchTask(void* pdata)
+{
+  alt_tlsf_stats stats[TRACES];
+  alt_tlsf_stats empty;
+  int trace;
+  int tlsf;
+
+  overhead = measure_overhead();
+  printf("%-8s %-5s %7s %7s %7s %7s %7s %7s\n", "trace", "heap", "malloc",
+         "99%", "max", "free", "99%", "max");
+  for (trace = 0; trace < TRACES; trace++) {
+    heap_reset();
+    for (tlsf = 0; tlsf < 2; tlsf++) {
+      run_trace(tlsf, trace);
+      release(tlsf);
+      run_trace(tlsf, trace);
+      if (tlsf) {
+        alt_tlsf_get_stats(&heap, &stats[trace]);
+      }
+      release(tlsf);
+      report(tlsf, trace);
+    }
+
+    /* Every block freed must have been merged back into one. */
+
+    alt_tlsf_get_stats(&heap, &empty);
+    if (empty.used != 0 || empty.blocks != 0 || empty.free_blocks != 1) {
+      printf("Heap not empty after the %s trace\n", trace_names[trace]);
+      exit(1);
+    }
+  }
+
+  printf("\n%-8s %8s %8s %8s %8s %8s\n", "trace", "used", "peak", "free",
+         "largest", "frag");
+  for (trace = 0; trace < TRACES; trace++) {
+    printf("%-8s %8u %8u %8u %8u %6u.%u%%\n", trace_names[trace],
+           (unsigned) stats[trace].used, (unsigned) stats[trace].peak,
+           (unsigned) stats[trace].free, (unsigned) stats[trace].largest_free,
+           (unsigned) stats[trace].fragmentation / 10,
+           (unsigned) stats[trace].fragmentation % 10);
+  }
+  exit(0);
+}
+
+int main(void)
+{
+  OSTaskCreate(BenchTask, NULL, &Bench_Stack[TASK_STACKSIZE-1], BENCH_PRIO);
+  OSStart();
+  return 0;
+}
@@ -0,0 +1,120 @@
+/* Timer wheel benchmark
+ *
+ * Description:
+ *
+ *   Shows how much work OSTmr_Task() does per timer tick with 8 to 256
+ *   running timers.  Every sample signals the timer task from the benchmark
+ *   task, which it preempts, and reads back OSTmrVisitCtr, the number of
+ *   timers the task looked at on that tick.  For comparison, the length of
+ *   the processed spoke is recorded too: an unsorted spoke has to be scanned
+ *   completely.  Section 1 of the performance counter measures the cycles of
+ *   OSTmrSignal(), which include both context switches.
+ *
+ *   Two loads are measured for every timer count:
+ *
+ *     idle      every timer has a period far beyond the end of the run, so
+ *               no timer expires during a measured tick.
+ *     periodic  the timers have periods of 10..73 ticks and start staggered,
+ *               so every tick expires some of them.
+ *
+ *   tmr_bench uses the wheel size of the BSP's system.h; tmr_bench_auto is
+ *   built with OS_TMR_CFG_WHEEL_AUTO set, which sizes the wheel from
+ *   OS_TMR_CFG_MAX.  Run with ALT_HOST_SPEEDUP=20 to get a resolution of one
+ *   host nanosecond.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "system.h"
+#include "includes.h"
+#include "altera_avalon_performance_counter.h"
+
+#define TASK_STACKSIZE 2048
+
+#define BENCH_PRIO     1
+
+#define SAMPLES        2000
+#define IDLE_PERIOD    100000
+
+OS_STK Bench_Stack[TASK_STACKSIZE];
+
+OS_TMR* Timers[OS_TMR_CFG_MAX];
+
+static const int timer_counts[] = {8, 32, 128, 256};
+
+static alt_u32 expired;         /* Timers expired since the last sample */
+
+void TimerCallback(void* ptmr, void* callback_arg)
+{
+  expired++;
+}
+
+/*
+ * Creates 'n' timers, measures SAMPLES timer ticks and deletes the timers
+ * again.
+ */
+static void run(int n, int periodic)
+{
+  alt_u32 spoke_sum = 0;
+  alt_u32 visit_sum = 0;
+  alt_u32 visit_max = 0;
+  alt_u32 expired_sum = 0;
+  alt_u32 cycle_sum = 0;
+  INT32U period;
+  INT8U err;
+  int i;
+
+  for (i = 0; i < n; i++) {
+    period = periodic ? 10 + (i % 64) : IDLE_PERIOD + i;
+    Timers[i] = OSTmrCreate(periodic ? 1 + (i % period) : 0, period,
+                            OS_TMR_OPT_PERIODIC, TimerCallback, NULL,
+                            (INT8U*) "Bench", &err);
+    OSTmrStart(Timers[i], &err);
+  }
+
+  for (i = 0; i < SAMPLES; i++) {
+    spoke_sum += OSTmrWheelTbl[(OSTmrTime + 1) % OS_TMR_CFG_WHEEL_SIZE].OSTmrEntries;
+    expired = 0;
+    PERF_RESET(PERFORMANCE_COUNTER_BASE);
+    PERF_START_MEASURING(PERFORMANCE_COUNTER_BASE);
+    PERF_BEGIN(PERFORMANCE_COUNTER_BASE, 1);
+    OSTmrSignal();
+    PERF_END(PERFORMANCE_COUNTER_BASE, 1);
+    PERF_STOP_MEASURING(PERFORMANCE_COUNTER_BASE);
+    cycle_sum += (alt_u32) perf_get_section_time((void*) PERFORMANCE_COUNTER_BASE, 1);
+    visit_sum += OSTmrVisitCtr;
+    if (OSTmrVisitCtr > visit_max) {
+      visit_max = OSTmrVisitCtr;
+    }
+    expired_sum += expired;
+  }
+
+  for (i = 0; i < n; i++) {
+    OSTmrDel(Timers[i], &err);
+  }
+  printf("%-9s %6d %8.2f %8.2f %6u %8.2f %8u\n", periodic ? "periodic" : "idle",
+         n, (double) spoke_sum / SAMPLES, (double) visit_sum / SAMPLES,
+         (unsigned) visit_max, (double) expired_sum / SAMPLES,
+         (unsigned) (cycle_sum / SAMPLES));
+}
+
+void BenchTask(void* pdata)
+{
+  unsigned i;
+
+  printf("OSTmr_Task() with OS_TMR_CFG_WHEEL_SIZE = %u\n",
+         (unsigned) OS_TMR_CFG_WHEEL_SIZE);
+  printf("%-9s %6s %8s %8s %6s %8s %8s\n", "load", "timers", "spoke",
+         "visited", "max", "expired", "cycles");
+  for (i = 0; i < sizeof(timer_counts) / sizeof(timer_counts[0]); i++) {
+    run(timer_counts[i], 0);
+    run(timer_counts[i], 1);
+  }
+  exit(0);
+}
+
+int main(void)
+{
+  OSTaskCreate(BenchTask, NULL, &Bench_Stack[TASK_STACKSIZE-1], BENCH_PRIO);
+  OSStart();
+  return 0;
+}
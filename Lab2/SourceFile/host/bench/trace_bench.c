@@ -0,0 +1,190 @@
+/* Event trace benchmark
+ *
+ * Description:
+ *
+ *   Measures what the kernel trace (OS_TRACE_EN) costs.  Section 1 of the
+ *   performance counter measures, with the trace recording and stopped:
+ *
+ *     record    one call of OS_TraceRec(), averaged over a batch of
+ *               RECORDS calls made with interrupts disabled.
+ *     sem       an OSSemPost() nobody waits for and the OSSemPend() that
+ *               takes it, two records.
+ *     release   from an OSSemPost() in the benchmark task until the
+ *               released task, which has a higher priority, returns from
+ *               its pend: a post, a context switch and, when it blocks
+ *               again, a wait, three records.
+ *
+ *   A stopped trace still pays for the call of OS_TraceRec(); trace_bench_off
+ *   is the same benchmark with the trace compiled out (OS_TRACE_EN set to
+ *   0), labelled "none", without the "record" line.
+ *
+ *   The cost of an empty measurement section is subtracted from every
+ *   sample.  On the host, cycles are derived from the host clock, so run
+ *   with ALT_HOST_SPEEDUP=20 to get a resolution of one host nanosecond.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "system.h"
+#include "includes.h"
+#include "altera_avalon_performance_counter.h"
+
+#define TASK_STACKSIZE 2048
+
+#define WAITER_PRIO    1
+#define BENCH_PRIO     2
+
+#define SAMPLES        2000
+#define RECORDS        100
+
+OS_STK Bench_Stack[TASK_STACKSIZE];
+OS_STK Waiter_Stack[TASK_STACKSIZE];
+
+OS_EVENT *BenchSem;
+OS_EVENT *ReleaseSem;
+
+static alt_u32 overhead;        /* Cycles of an empty measurement section */
+static alt_u32 release_cycles;  /* Cycles of the last release */
+
+static void perf_begin(void)
+{
+  PERF_RESET(PERFORMANCE_COUNTER_BASE);
+  PERF_START_MEASURING(PERFORMANCE_COUNTER_BASE);
+  PERF_BEGIN(PERFORMANCE_COUNTER_BASE, 1);
+}
+
+static alt_u32 perf_end(void)
+{
+  alt_u32 t;
+
+  PERF_END(PERFORMANCE_COUNTER_BASE, 1);
+  PERF_STOP_MEASURING(PERFORMANCE_COUNTER_BASE);
+  t = (alt_u32) perf_get_section_time((void*) PERFORMANCE_COUNTER_BASE, 1);
+  return (t > overhead) ? t - overhead : 0;
+}
+
+/*
+ * Waits on ReleaseSem and ends the measurement of every release.
+ */
+void WaiterTask(void* pdata)
+{
+  INT8U err;
+
+  while (1) {
+    OSSemPend(ReleaseSem, 0, &err);
+    release_cycles = perf_end();
+  }
+}
+
+/*
+ * Prints the average and minimum of SAMPLES samples.
+ */
+static void report(const char* trace, const char* what, alt_u32 sum,
+                   alt_u32 min)
+{
+  printf("%-8s %-8s %8u %8u\n", trace, what, (unsigned) (sum / SAMPLES),
+         (unsigned) min);
+}
+
+static void run(int on)
+{
+  const char* trace = (OS_TRACE_EN == 0) ? "none" : on ? "on" : "off";
+  INT8U err;
+  alt_u32 sum;
+  alt_u32 min;
+  alt_u32 t;
+  int i;
+#if OS_TRACE_EN > 0
+  int j;
+#if OS_CRITICAL_METHOD == 3
+  OS_CPU_SR cpu_sr = 0;
+#endif
+
+  if (on) {
+    OSTraceStart();
+  } else {
+    OSTraceStop();
+  }
+
+  /* Records made directly, the fixed cost of every traced event */
+  sum = 0;
+  min = 0xFFFFFFFF;
+  for (i = 0; i < SAMPLES; i++) {
+    perf_begin();
+    OS_ENTER_CRITICAL();
+    for (j = 0; j < RECORDS; j++) {
+      OS_TraceRec(OS_TRACE_SEM_POST, 0);
+    }
+    OS_EXIT_CRITICAL();
+    t = perf_end() / RECORDS;
+    sum += t;
+    if (t < min) {
+      min = t;
+    }
+  }
+  report(trace, "record", sum, min);
+#endif
+
+  /* Post nobody waits for and the pend that takes it */
+  sum = 0;
+  min = 0xFFFFFFFF;
+  for (i = 0; i < SAMPLES; i++) {
+    perf_begin();
+    OSSemPost(BenchSem);
+    OSSemPend(BenchSem, 0, &err);
+    t = perf_end();
+    sum += t;
+    if (t < min) {
+      min = t;
+    }
+  }
+  report(trace, "sem", sum, min);
+
+  /* Release of a waiting task */
+  OSTaskCreate(WaiterTask, NULL, &Waiter_Stack[TASK_STACKSIZE-1],
+               WAITER_PRIO);
+  sum = 0;
+  min = 0xFFFFFFFF;
+  for (i = 0; i < SAMPLES; i++) {
+    perf_begin();
+    OSSemPost(ReleaseSem);
+    sum += release_cycles;
+    if (release_cycles < min) {
+      min = release_cycles;
+    }
+  }
+  OSTaskDel(WAITER_PRIO);
+  report(trace, "release", sum, min);
+}
+
+void BenchTask(void* pdata)
+{
+  int i;
+
+  overhead = 0xFFFFFFFF;
+  for (i = 0; i < SAMPLES; i++) {
+    alt_u32 t;
+
+    perf_begin();
+    t = perf_end();
+    if (t < overhead) {
+      overhead = t;
+    }
+  }
+  BenchSem = OSSemCreate(0);
+  ReleaseSem = OSSemCreate(0);
+
+  printf("Measurement overhead: %u cycles\n", (unsigned) overhead);
+  printf("%-8s %-8s %8s %8s\n", "trace", "op", "avg", "min");
+  run(1);
+#if OS_TRACE_EN > 0
+  run(0);
+#endif
+  exit(0);
+}
+
+int main(void)
+{
+  OSTaskCreate(BenchTask, NULL, &Bench_Stack[TASK_STACKSIZE-1], BENCH_PRIO);
+  OSStart();
+  return 0;
+}
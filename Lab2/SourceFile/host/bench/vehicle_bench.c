@@ -0,0 +1,176 @@
+/* Vehicle model and control law benchmark
+ *
+ * Description:
+ *
+ *   Measures the cycles of one period of VehicleTask's model, vehicle_step()
+ *   with integer arithmetic against the floating point reference
+ *   vehicle_step_ref() (sim/vehicle_ref.c) it replaced, and of one period of
+ *   ControlTask's PID control law, control_step().  All of them run the
+ *   same recorded trajectory: the car accelerates with full throttle, then
+ *   the cruise control holds the velocity over the whole track.  Section 1
+ *   of the performance counter measures every step, and the average and
+ *   worst case are reported after subtracting the cost of an empty section.
+ *
+ *   The host has an FPU, so the difference is far smaller than on the tiny
+ *   Nios II core, where every floating point operation of the reference is
+ *   a call into the software floating point library.  Run with
+ *   ALT_HOST_SPEEDUP=20 to get a resolution of one host nanosecond.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "system.h"
+#include "includes.h"
+#include "altera_avalon_performance_counter.h"
+#include "cruise.h"
+#include "vehicle_ref.h"
+
+#define TASK_STACKSIZE 2048
+
+#define BENCH_PRIO     1
+
+#define PERIOD         300
+#define SAMPLES        5000
+#define GAS_STEPS      3           /* 900 ms of gas, as in cruise_sim */
+
+OS_STK Bench_Stack[TASK_STACKSIZE];
+
+static struct vehicle states[SAMPLES];
+static struct actuators inputs[SAMPLES];
+static struct control controls[SAMPLES];
+static struct buttons buttons[SAMPLES];
+static const struct switches sw = {on, on};
+
+static alt_u32 overhead;        /* Cycles of an empty measurement section */
+
+static void perf_begin(void)
+{
+  PERF_RESET(PERFORMANCE_COUNTER_BASE);
+  PERF_START_MEASURING(PERFORMANCE_COUNTER_BASE);
+  PERF_BEGIN(PERFORMANCE_COUNTER_BASE, 1);
+}
+
+static alt_u32 perf_end(void)
+{
+  alt_u32 t;
+
+  PERF_END(PERFORMANCE_COUNTER_BASE, 1);
+  PERF_STOP_MEASURING(PERFORMANCE_COUNTER_BASE);
+  t = (alt_u32) perf_get_section_time((void*) PERFORMANCE_COUNTER_BASE, 1);
+  return (t > overhead) ? t - overhead : 0;
+}
+
+/*
+ * Records the state and the actuator signals of every period.
+ */
+static void record(void)
+{
+  struct vehicle v;
+  struct control ctrl;
+  struct actuators act = {0, off, off};
+  struct buttons btn = {off, on, off};
+  int i;
+
+  vehicle_init(&v);
+  control_init(&ctrl, &control_default_params, PERIOD);
+  for (i = 0; i < SAMPLES; i++) {
+    if (i == GAS_STEPS) {
+      btn.gas = off;
+      btn.cruise = on;
+    }
+    states[i] = v;
+    inputs[i] = act;
+    controls[i] = ctrl;
+    buttons[i] = btn;
+    vehicle_step(&v, &act, PERIOD);
+    control_step(&ctrl, v.position, v.velocity, &btn, &sw, &act);
+  }
+}
+
+static void run(const char* name,
+                void (*step)(struct vehicle*, const struct actuators*, int))
+{
+  struct vehicle v;
+  alt_u32 sum = 0;
+  alt_u32 max = 0;
+  alt_u32 t;
+  int i;
+
+  for (i = 0; i < SAMPLES; i++) {
+    v = states[i];
+    perf_begin();
+    step(&v, &inputs[i], PERIOD);
+    t = perf_end();
+    if (i + 1 < SAMPLES && v.velocity != states[i+1].velocity) {
+      fprintf(stderr, "%s: velocity %d at step %d, expected %d\n", name,
+              v.velocity, i, states[i+1].velocity);
+      exit(1);
+    }
+    sum += t;
+    if (t > max) {
+      max = t;
+    }
+  }
+  fprintf(stderr, "%-8s %10u %10u\n", name, (unsigned) (sum / SAMPLES),
+          (unsigned) max);
+}
+
+static void run_control(void)
+{
+  struct control ctrl;
+  struct actuators act;
+  alt_u32 sum = 0;
+  alt_u32 max = 0;
+  alt_u32 t;
+  int i;
+
+  for (i = 0; i + 1 < SAMPLES; i++) {
+    ctrl = controls[i];
+    act = inputs[i];
+    perf_begin();
+    control_step(&ctrl, states[i+1].position, states[i+1].velocity,
+                 &buttons[i], &sw, &act);
+    t = perf_end();
+    if (act.throttle != inputs[i+1].throttle) {
+      fprintf(stderr, "control: throttle %u at step %d, expected %u\n",
+              act.throttle, i, inputs[i+1].throttle);
+      exit(1);
+    }
+    sum += t;
+    if (t > max) {
+      max = t;
+    }
+  }
+  fprintf(stderr, "%-8s %10u %10u\n", "control", (unsigned) (sum / i),
+          (unsigned) max);
+}
+
+void BenchTask(void* pdata)
+{
+  int i;
+
+  overhead = 0xFFFFFFFF;
+  for (i = 0; i < SAMPLES; i++) {
+    alt_u32 t;
+
+    perf_begin();
+    t = perf_end();
+    if (t < overhead) {
+      overhead = t;
+    }
+  }
+  record();
+
+  fprintf(stderr, "Measurement overhead: %u cycles\n", (unsigned) overhead);
+  fprintf(stderr, "%-8s %10s %10s\n", "model", "avg", "max");
+  run("integer", vehicle_step);
+  run("float", vehicle_step_ref);
+  run_control();
+  exit(0);
+}
+
+int main(void)
+{
+  OSTaskCreate(BenchTask, NULL, &Bench_Stack[TASK_STACKSIZE-1], BENCH_PRIO);
+  OSStart();
+  return 0;
+}
@@ -0,0 +1,138 @@
+#ifndef __ALT_HOST_H__
+#define __ALT_HOST_H__
+
+/******************************************************************************
+*                                                                             *
+* Host build of the HAL: device models and simulation controls.               *
+*                                                                             *
+* Peripherals are modelled as alt_host_dev objects that own a window of the   *
+* Avalon address map (see alt_host_io.c). A device that is driven by host     *
+* time, such as the interval timer, receives its asynchronous events through  *
+* the 'event' callback, which runs at interrupt level from the exception      *
+* entry in alt_host_irq.c.                                                    *
+*                                                                             *
+* Simulation controls are read from the environment at start-up:              *
+*                                                                             *
+*   ALT_HOST_SPEEDUP   simulated time runs this many times faster than the    *
+*                      host clock (default 1).                                *
+*   ALT_HOST_RUN_MS    stop the process after this many simulated             *
+*                      milliseconds (default: run forever).                   *
+*   ALT_HOST_SWITCHES  initial value of the toggle switches (hex).            *
+*   ALT_HOST_KEYS      mask of push buttons held down from reset (hex).       *
+*   ALT_HOST_INPUTS    later changes of the buttons and switches, see         *
+*                      alt_sys_init.c.                                        *
+*                                                                             *
+******************************************************************************/
+
+#include <signal.h>
+#include <time.h>
+
+#include "alt_types.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+typedef struct alt_host_dev_s alt_host_dev;
+
+struct alt_host_dev_s
+{
+  const char* name;
+  alt_u32     base;                 /* first byte of the register window */
+  alt_u32     span;                 /* size of the register window, in bytes */
+  alt_u32   (*read)  (alt_host_dev* dev, alt_u32 offset);
+  void      (*write) (alt_host_dev* dev, alt_u32 offset, alt_u32 data);
+  void      (*event) (alt_host_dev* dev);
+};
+
+/*
+ * Register a device model. Returns 0, or -ENOSPC if the table is full.
+ */
+
+extern int alt_host_dev_register (alt_host_dev* dev);
+
+/*
+ * Create a POSIX interval timer that delivers events to 'dev' at interrupt
+ * level. Returns 0 on success, or -1 with errno set.
+ */
+
+extern int alt_host_dev_timer_create (alt_host_dev* dev, timer_t* timer);
+
+/*
+ * Arm 'timer' to fire after 'cycles' CPU clock cycles of simulated time,
+ * and then every 'period' cycles (0 for a one-shot). 'cycles' equal to zero
+ * disarms the timer.
+ */
+
+extern void alt_host_dev_timer_arm (timer_t timer, alt_u64 cycles, 
+                                    alt_u64 period);
+
+/*
+ * Simulated CPU clock cycles (ALT_CPU_FREQ) since start-up.
+ */
+
+extern alt_u64 alt_host_cycles (void);
+
+/*
+ * Simulation controls, see above.
+ */
+
+extern double  alt_host_speedup;
+
+/*
+ * Models of the timer and performance counter peripherals.
+ */
+
+typedef struct alt_host_timer_s
+{
+  alt_host_dev dev;
+  alt_u32      irq;
+  alt_u32      freq;
+  alt_u32      status;
+  alt_u32      control;
+  alt_u32      period;
+  alt_u32      snap;
+  alt_u64      start;               /* alt_host_cycles() when started */
+  timer_t      timer;
+} alt_host_timer;
+
+extern void alt_host_timer_init (alt_host_timer* timer, const char* name,
+                                 alt_u32 base, alt_u32 irq, alt_u32 freq,
+                                 alt_u32 load_value);
+
+extern void alt_host_perf_init (alt_u32 base);
+
+/*
+ * Model of the PIO core, for the input ports of the buttons and switches.
+ * 'edge_type' is the EDGE_TYPE of the core in system.h; the pins are driven
+ * with alt_host_pio_set().
+ */
+
+#define ALT_HOST_PIO_RISING  1
+#define ALT_HOST_PIO_FALLING 2
+
+typedef struct alt_host_pio_s
+{
+  alt_host_dev dev;
+  alt_u32      irq;
+  alt_u32      mask;                /* pins of the port */
+  int          edge_type;           /* ALT_HOST_PIO_RISING | _FALLING */
+  int          bit_clearing;
+  alt_u32      data;
+  alt_u32      irq_mask;
+  alt_u32      edge_cap;
+} alt_host_pio;
+
+extern void alt_host_pio_init (alt_host_pio* pio, const char* name,
+                               alt_u32 base, alt_u32 irq, alt_u32 width,
+                               const char* edge_type, int bit_clearing,
+                               alt_u32 value);
+
+extern void alt_host_pio_set (alt_host_pio* pio, alt_u32 value);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __ALT_HOST_H__ */
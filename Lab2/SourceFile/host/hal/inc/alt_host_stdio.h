@@ -0,0 +1,35 @@
+#ifndef __ALT_HOST_STDIO_H__
+#define __ALT_HOST_STDIO_H__
+
+/******************************************************************************
+*                                                                             *
+* Host serialisation of printf().                                             *
+*                                                                             *
+* On the target every task has its own newlib reent structure and the JTAG   *
+* UART driver serialises writers with a semaphore. glibc's stdio lock is     *
+* recursive per thread, and all tasks share the single host thread, so a     *
+* task preempted inside printf() would let the next task walk into the same  *
+* FILE buffer. Applications therefore see printf() as alt_host_printf(),     *
+* which holds an OS semaphore around the call.                               *
+*                                                                             *
+******************************************************************************/
+
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+extern int  alt_host_printf (const char* format, ...)
+            __attribute__ ((format (printf, 1, 2)));
+
+extern void alt_host_stdio_init (void);
+
+#define printf alt_host_printf
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __ALT_HOST_STDIO_H__ */
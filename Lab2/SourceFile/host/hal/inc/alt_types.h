@@ -0,0 +1,32 @@
+#ifndef __ALT_TYPES_H__
+#define __ALT_TYPES_H__
+
+/******************************************************************************
+*                                                                             *
+* Host build of the HAL basic types.                                          *
+*                                                                             *
+* The Nios II HAL declares alt_32/alt_u32 as 'long', which is 64 bits wide on *
+* an LP64 host. The tick counter, the alarm roll-over logic and the register  *
+* models all rely on 32 bit wrap-around, so the host copy pins them to 'int'. *
+*                                                                             *
+******************************************************************************/
+
+/* 
+ * Don't declare these typedefs if this file is included by assembly source.
+ */
+#ifndef ALT_ASM_SRC
+typedef signed char        alt_8;
+typedef unsigned char      alt_u8;
+typedef signed short       alt_16;
+typedef unsigned short     alt_u16;
+typedef signed int         alt_32;
+typedef unsigned int       alt_u32;
+typedef long long          alt_64;
+typedef unsigned long long alt_u64;
+#endif
+
+#define ALT_INLINE        __inline__
+#define ALT_ALWAYS_INLINE __attribute__ ((always_inline))
+#define ALT_WEAK          __attribute__((weak))
+
+#endif /* __ALT_TYPES_H__ */
@@ -0,0 +1,69 @@
+#ifndef __INCLUDES_H__
+#define __INCLUDES_H__
+
+/*
+*********************************************************************************************************
+*                                                uC/OS-II
+*                                          The Real-Time Kernel
+*
+*                        (c) Copyright 1992-1998, Jean J. Labrosse, Plantation, FL
+*                                           All Rights Reserved
+*
+*                                           MASTER INCLUDE FILE
+*
+* Host copy of HAL/inc/includes.h.  It has to live next to the host port so that "os_cpu.h" resolves to
+* host/port/os_cpu.h rather than to the Nios II header in the same directory as the original.  It also
+* pulls in the host stdio serialisation (see alt_host_stdio.h).
+*********************************************************************************************************
+*/
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+#include    "os_cpu.h"
+#include    "os_cfg.h"
+#include    "ucos_ii.h"
+#include    "alt_host_stdio.h"
+
+#ifdef      ONT_GLOBALS
+#define     ONT_EXT
+#else
+#define     ONT_EXT  extern
+#endif
+
+/*
+*********************************************************************************************************
+*                                             DATA TYPES
+*********************************************************************************************************
+*/
+
+typedef struct {
+    char    TaskName[30];
+    INT16U  TaskCtr;
+    INT16U  TaskExecTime;
+    INT32U  TaskTotExecTime;
+} TASK_USER_DATA;
+
+/*
+*********************************************************************************************************
+*                                              VARIABLES
+*********************************************************************************************************
+*/
+
+ONT_EXT  TASK_USER_DATA  TaskUserData[10];
+
+/*
+*********************************************************************************************************
+*                                         FUNCTION PROTOTYPES
+*********************************************************************************************************
+*/
+
+void   DispTaskStat(INT8U id);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __INCLUDES_H__ */
@@ -0,0 +1,66 @@
+#ifndef __IO_H__
+#define __IO_H__
+
+/******************************************************************************
+*                                                                             *
+* Host build of the HAL register access macros.                               *
+*                                                                             *
+* On the target IORD/IOWR compile to ldwio/stwio on the Avalon bus. On the    *
+* host every access is routed through alt_host_io_read()/alt_host_io_write(), *
+* which dispatch to the device models registered in alt_host_io.c. Accesses   *
+* to addresses without a model behave like plain read/write registers.        *
+*                                                                             *
+******************************************************************************/
+
+#include <stddef.h>
+
+#include "alt_types.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+#ifndef SYSTEM_BUS_WIDTH
+#error SYSTEM_BUS_WIDTH undefined
+#endif
+
+extern alt_u32 alt_host_io_read  (alt_u32 addr, int width);
+extern void    alt_host_io_write (alt_u32 addr, int width, alt_u32 data);
+
+/* Dynamic bus access functions */
+
+#define __IO_CALC_ADDRESS_DYNAMIC(BASE, OFFSET) \
+  ((void *)(((alt_u8*)(size_t)(BASE)) + (OFFSET)))
+
+#define IORD_32DIRECT(BASE, OFFSET) \
+  alt_host_io_read ((alt_u32)(size_t)(BASE) + (OFFSET), 32)
+#define IORD_16DIRECT(BASE, OFFSET) \
+  (alt_u16)alt_host_io_read ((alt_u32)(size_t)(BASE) + (OFFSET), 16)
+#define IORD_8DIRECT(BASE, OFFSET) \
+  (alt_u8)alt_host_io_read ((alt_u32)(size_t)(BASE) + (OFFSET), 8)
+
+#define IOWR_32DIRECT(BASE, OFFSET, DATA) \
+  alt_host_io_write ((alt_u32)(size_t)(BASE) + (OFFSET), 32, (DATA))
+#define IOWR_16DIRECT(BASE, OFFSET, DATA) \
+  alt_host_io_write ((alt_u32)(size_t)(BASE) + (OFFSET), 16, (DATA))
+#define IOWR_8DIRECT(BASE, OFFSET, DATA) \
+  alt_host_io_write ((alt_u32)(size_t)(BASE) + (OFFSET), 8, (DATA))
+
+/* Native bus access functions */
+
+#define __IO_CALC_ADDRESS_NATIVE(BASE, REGNUM) \
+  ((void *)(((alt_u8*)(size_t)(BASE)) + ((REGNUM) * (SYSTEM_BUS_WIDTH/8))))
+
+#define IORD(BASE, REGNUM) \
+  alt_host_io_read ((alt_u32)(size_t)(BASE) + ((REGNUM) * (SYSTEM_BUS_WIDTH/8)), \
+                    SYSTEM_BUS_WIDTH)
+#define IOWR(BASE, REGNUM, DATA) \
+  alt_host_io_write ((alt_u32)(size_t)(BASE) + ((REGNUM) * (SYSTEM_BUS_WIDTH/8)), \
+                     SYSTEM_BUS_WIDTH, (DATA))
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __IO_H__ */
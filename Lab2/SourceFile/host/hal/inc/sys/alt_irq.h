@@ -0,0 +1,174 @@
+#ifndef __ALT_IRQ_H__
+#define __ALT_IRQ_H__
+
+/******************************************************************************
+*                                                                             *
+* Host build of the HAL interrupt API.                                        *
+*                                                                             *
+* The Nios II core has a single interrupt enable bit (status.PIE) in front of *
+* 32 level-sensitive IRQ lines. The host model keeps that shape:              *
+*                                                                             *
+*  - ALT_HOST_IRQ_SIGNAL plays the role of the CPU interrupt input. Masking   *
+*    it with sigprocmask() is the equivalent of clearing PIE, so             *
+*    alt_irq_disable_all()/alt_irq_enable_all() (and therefore               *
+*    OS_ENTER_CRITICAL()/OS_EXIT_CRITICAL()) are signal-mask operations.      *
+*                                                                             *
+*  - alt_host_ipending/alt_host_ienable model the ipending and ienable        *
+*    control registers. Device models assert and negate lines with           *
+*    alt_host_irq_assert()/alt_host_irq_negate(), and raise the signal to     *
+*    have the exception entry in alt_host_irq.c run alt_irq_handler().        *
+*                                                                             *
+******************************************************************************/
+
+#include <errno.h>
+#include <signal.h>
+
+#include "alt_types.h"
+#include "system.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+/*
+ * Values returned from alt_irq_enabled() and used as alt_irq_context.
+ */
+
+#define ALT_IRQ_ENABLED  1
+#define ALT_IRQ_DISABLED 0  
+
+/* 
+ * Number of available interrupts.
+ */
+
+#define ALT_NIRQ 32
+
+/*
+ * The host signal standing in for the CPU interrupt input.
+ */
+
+#define ALT_HOST_IRQ_SIGNAL SIGALRM
+
+/*
+ * Used by alt_irq_disable_all() and alt_irq_enable_all().
+ */
+
+typedef int alt_irq_context;
+
+/* ISR Prototype */
+
+#ifdef ALT_ENHANCED_INTERRUPT_API_PRESENT
+typedef void (*alt_isr_func)(void* isr_context);
+#else
+typedef void (*alt_isr_func)(void* isr_context, alt_u32 id);
+#endif
+
+/*
+ * Interrupt controller state, see alt_host_irq.c.
+ */
+
+extern sigset_t         alt_host_irq_sigset;
+extern volatile alt_u32 alt_host_ipending;
+extern volatile alt_u32 alt_host_ienable;
+
+extern void alt_host_irq_assert (alt_u32 irq);
+extern void alt_host_irq_negate (alt_u32 irq);
+
+/*
+ * alt_irq_enabled can be called to determine if the processor's global
+ * interrupt enable is asserted. The return value is zero if interrupts 
+ * are disabled, and non-zero otherwise.
+ */
+
+static ALT_INLINE int ALT_ALWAYS_INLINE alt_irq_enabled (void)
+{
+  sigset_t current;
+
+  sigprocmask (SIG_BLOCK, NULL, &current);
+
+  return !sigismember (&current, ALT_HOST_IRQ_SIGNAL);
+}
+
+/*
+ * alt_irq_disable_all() 
+ *
+ * This routine inhibits all interrupts by blocking the interrupt signal. It
+ * returns the previous enable state so that it can be restored later.
+ */
+
+static ALT_INLINE alt_irq_context ALT_ALWAYS_INLINE 
+       alt_irq_disable_all (void)
+{
+  sigset_t previous;
+
+  sigprocmask (SIG_BLOCK, &alt_host_irq_sigset, &previous);
+
+  return sigismember (&previous, ALT_HOST_IRQ_SIGNAL) ? ALT_IRQ_DISABLED 
+                                                      : ALT_IRQ_ENABLED;
+}
+
+/*
+ * alt_irq_enable_all() 
+ *
+ * Restore the interrupt enable state captured by alt_irq_disable_all().
+ */
+ 
+static ALT_INLINE void ALT_ALWAYS_INLINE 
+       alt_irq_enable_all (alt_irq_context context)
+{
+  if (context == ALT_IRQ_ENABLED)
+  {
+    sigprocmask (SIG_UNBLOCK, &alt_host_irq_sigset, NULL);
+  }
+}
+
+/*
+ * The function alt_irq_init() is defined within the auto-generated file
+ * alt_sys_init.c on the target; on the host it installs the exception
+ * entry (see alt_host_irq.c).
+ */
+
+extern void alt_irq_init (const void* base);
+
+/*
+ * alt_irq_cpu_enable_interrupts() enables the CPU to start taking interrupts.
+ */
+
+static ALT_INLINE void ALT_ALWAYS_INLINE 
+       alt_irq_cpu_enable_interrupts (void)
+{
+  sigprocmask (SIG_UNBLOCK, &alt_host_irq_sigset, NULL);
+}
+
+/*
+ * Enhanced interrupt API, provided for the internal interrupt controller
+ * model by alt_host_irq.c.
+ */
+
+extern int alt_ic_isr_register(alt_u32 ic_id,
+                        alt_u32 irq,
+                        alt_isr_func isr,
+                        void *isr_context,
+                        void *flags);
+
+int alt_ic_irq_enable (alt_u32 ic_id, alt_u32 irq);
+int alt_ic_irq_disable(alt_u32 ic_id, alt_u32 irq);        
+
+alt_u32 alt_ic_irq_enabled(alt_u32 ic_id, alt_u32 irq);
+
+/*
+ * alt_irq_pending() returns a bit list of the current pending interrupts,
+ * i.e. the modelled ipending register (already qualified by ienable).
+ */
+
+static ALT_INLINE alt_u32 ALT_ALWAYS_INLINE alt_irq_pending (void)
+{
+  return alt_host_ipending & alt_host_ienable;
+}
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __ALT_IRQ_H__ */
@@ -0,0 +1,83 @@
+/******************************************************************************
+*                                                                             *
+* Host model of the Avalon bus.                                               *
+*                                                                             *
+* IORD/IOWR (see hal/inc/io.h) land here. An access inside the window of a    *
+* registered device is forwarded to its model; anything else in the          *
+* peripheral region is kept in a plain register file, which is all the       *
+* output PIO cores need (the application only writes their data register).    *
+* The input PIOs of the buttons and switches have a model (alt_host_pio.c).   *
+*                                                                             *
+******************************************************************************/
+
+#include <errno.h>
+#include <string.h>
+
+#include "system.h"
+#include "alt_host.h"
+#include "alt_types.h"
+
+#define ALT_HOST_MAX_DEVS 16
+#define ALT_HOST_IO_SPAN  0x10000
+
+static alt_host_dev* alt_host_devs[ALT_HOST_MAX_DEVS];
+static int           alt_host_ndevs;
+static alt_u8        alt_host_io_regs[ALT_HOST_IO_SPAN];
+
+int alt_host_dev_register (alt_host_dev* dev)
+{
+  if (alt_host_ndevs == ALT_HOST_MAX_DEVS)
+  {
+    return -ENOSPC;
+  }
+  alt_host_devs[alt_host_ndevs++] = dev;
+  return 0;
+}
+
+static alt_host_dev* alt_host_dev_find (alt_u32 addr)
+{
+  int i;
+
+  for (i = 0; i < alt_host_ndevs; i++)
+  {
+    if ((addr - alt_host_devs[i]->base) < alt_host_devs[i]->span)
+    {
+      return alt_host_devs[i];
+    }
+  }
+  return NULL;
+}
+
+alt_u32 alt_host_io_read (alt_u32 addr, int width)
+{
+  alt_host_dev* dev = alt_host_dev_find (addr);
+  alt_u32       data = 0;
+
+  if (dev)
+  {
+    return dev->read ? dev->read (dev, addr - dev->base) : 0;
+  }
+  if (addr < ALT_HOST_IO_SPAN - 3)
+  {
+    memcpy (&data, &alt_host_io_regs[addr], width / 8);
+  }
+  return data;
+}
+
+void alt_host_io_write (alt_u32 addr, int width, alt_u32 data)
+{
+  alt_host_dev* dev = alt_host_dev_find (addr);
+
+  if (dev)
+  {
+    if (dev->write)
+    {
+      dev->write (dev, addr - dev->base, data);
+    }
+    return;
+  }
+  if (addr < ALT_HOST_IO_SPAN - 3)
+  {
+    memcpy (&alt_host_io_regs[addr], &data, width / 8);
+  }
+}
@@ -0,0 +1,162 @@
+/******************************************************************************
+*                                                                             *
+* Host model of the Nios II internal interrupt controller.                    *
+*                                                                             *
+* alt_host_ipending and alt_host_ienable stand in for the ipending and        *
+* ienable control registers. The exception entry is the handler of            *
+* ALT_HOST_IRQ_SIGNAL: it first lets the device that raised the signal update *
+* its state (which may assert its IRQ line), and then runs the unmodified     *
+* HAL alt_irq_handler() if any enabled line is pending. The signal is masked  *
+* while the handler runs, as PIE is cleared on exception entry.               *
+*                                                                             *
+******************************************************************************/
+
+#include <errno.h>
+#include <signal.h>
+#include <string.h>
+
+#include "system.h"
+#include "sys/alt_irq.h"
+#include "priv/alt_irq_table.h"
+#include "alt_host.h"
+#include "alt_types.h"
+
+sigset_t         alt_host_irq_sigset;
+volatile alt_u32 alt_host_ipending = 0;
+volatile alt_u32 alt_host_ienable  = 0;
+
+extern void alt_irq_handler (void);
+
+/*
+ * Level-sensitive IRQ lines, driven by the device models.
+ */
+
+void alt_host_irq_assert (alt_u32 irq)
+{
+  alt_host_ipending |= (1u << irq);
+}
+
+void alt_host_irq_negate (alt_u32 irq)
+{
+  alt_host_ipending &= ~(1u << irq);
+}
+
+/*
+ * alt_host_irq_entry() is the exception entry for hardware interrupts.
+ */
+
+static void alt_host_irq_entry (int sig, siginfo_t* info, void* uc)
+{
+  int           saved_errno = errno;
+  alt_host_dev* dev;
+
+  (void) sig;
+  (void) uc;
+
+  if (info->si_code == SI_TIMER)
+  {
+    dev = (alt_host_dev*) info->si_value.sival_ptr;
+    if (dev && dev->event)
+    {
+      dev->event (dev);
+    }
+  }
+
+  if (alt_irq_pending ())
+  {
+    alt_irq_handler ();
+  }
+
+  errno = saved_errno;
+}
+
+/*
+ * alt_irq_init() installs the exception entry and enables interrupts in the
+ * CPU, like the version generated into alt_sys_init.c on the target.
+ */
+
+void alt_irq_init (const void* base)
+{
+  struct sigaction action;
+
+  (void) base;
+
+  sigemptyset (&alt_host_irq_sigset);
+  sigaddset (&alt_host_irq_sigset, ALT_HOST_IRQ_SIGNAL);
+
+  memset (&action, 0, sizeof (action));
+  action.sa_sigaction = alt_host_irq_entry;
+  action.sa_mask      = alt_host_irq_sigset;
+  action.sa_flags     = SA_SIGINFO | SA_RESTART;
+  sigaction (ALT_HOST_IRQ_SIGNAL, &action, NULL);
+
+  alt_irq_cpu_enable_interrupts ();
+}
+
+/** @Function Description:  This function registers an interrupt handler. 
+  * If the function is succesful, then the requested interrupt will be enabled
+  * upon return. Registering a NULL handler will disable the interrupt.
+  *
+  * @API Type:              External
+  * @param ic_id            Ignored.
+  * @param irq              IRQ ID number
+  * @param isr              Pointer to interrupt service routine
+  * @param isr_context      Opaque pointer passed to ISR
+  * @param flags            
+  * @return                 0 if successful, else error (-1)
+  */
+int alt_ic_isr_register(alt_u32 ic_id, alt_u32 irq, alt_isr_func isr, 
+  void *isr_context, void *flags)
+{
+  int rc = -EINVAL;  
+  alt_irq_context status;
+
+  (void) flags;
+
+  if (irq < ALT_NIRQ)
+  {
+    status = alt_irq_disable_all();
+
+    alt_irq[irq].handler = isr;
+    alt_irq[irq].context = isr_context;
+
+    rc = (isr) ? alt_ic_irq_enable(ic_id, irq) : alt_ic_irq_disable(ic_id, irq);
+
+    alt_irq_enable_all(status);
+  }
+
+  return rc; 
+}
+
+int alt_ic_irq_enable (alt_u32 ic_id, alt_u32 irq)
+{
+  alt_irq_context status;
+
+  (void) ic_id;
+
+  status = alt_irq_disable_all ();
+  alt_host_ienable |= (1u << irq);
+  alt_irq_enable_all (status);
+
+  return 0;
+}
+
+int alt_ic_irq_disable (alt_u32 ic_id, alt_u32 irq)
+{
+  alt_irq_context status;
+
+  (void) ic_id;
+
+  status = alt_irq_disable_all ();
+  alt_host_ienable &= ~(1u << irq);
+  alt_irq_enable_all (status);
+
+  return 0;
+}
+
+alt_u32 alt_ic_irq_enabled (alt_u32 ic_id, alt_u32 irq)
+{
+  (void) ic_id;
+
+  return (alt_host_ienable & (1u << irq)) ? 1: 0;
+}
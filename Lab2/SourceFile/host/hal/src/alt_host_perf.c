@@ -0,0 +1,134 @@
+/******************************************************************************
+*                                                                             *
+* Host model of the altera_avalon_performance_counter core.                   *
+*                                                                             *
+* Register map, per section n (section 0 is the global counter):              *
+*                                                                             *
+*   4n+0  read: time low    write: stop section n (n == 0: 0 stops the        *
+*                           global counter, 1 resets every counter)           *
+*   4n+1  read: time high   write: start section n                            *
+*   4n+2  read: event count                                                   *
+*                                                                             *
+* Time is counted in simulated CPU cycles, and sections only accumulate      *
+* while the global counter runs, as on the hardware.                          *
+*                                                                             *
+******************************************************************************/
+
+#include <string.h>
+
+#include "system.h"
+#include "alt_host.h"
+#include "alt_types.h"
+
+#define ALT_HOST_PERF_SECTIONS 8
+
+typedef struct alt_host_perf_section_s
+{
+  alt_u64 time;
+  alt_u32 events;
+  alt_u64 start;
+  int     running;
+} alt_host_perf_section;
+
+typedef struct alt_host_perf_s
+{
+  alt_host_dev          dev;
+  alt_host_perf_section section[ALT_HOST_PERF_SECTIONS];
+} alt_host_perf;
+
+static alt_host_perf alt_host_perf_dev;
+
+static void alt_host_perf_stop (alt_host_perf_section* s, alt_u64 now)
+{
+  if (s->running)
+  {
+    s->time   += now - s->start;
+    s->running = 0;
+  }
+}
+
+static alt_u32 alt_host_perf_read (alt_host_dev* dev, alt_u32 offset)
+{
+  alt_host_perf*         perf = (alt_host_perf*) dev;
+  alt_host_perf_section* s;
+  alt_u64                time;
+  alt_u32                reg = offset / 4;
+
+  if (reg / 4 >= ALT_HOST_PERF_SECTIONS)
+  {
+    return 0;
+  }
+  s    = &perf->section[reg / 4];
+  time = s->time;
+  if (s->running)
+  {
+    time += alt_host_cycles () - s->start;
+  }
+  switch (reg % 4)
+  {
+  case 0:  return (alt_u32) time;
+  case 1:  return (alt_u32) (time >> 32);
+  case 2:  return s->events;
+  default: return 0;
+  }
+}
+
+static void alt_host_perf_write (alt_host_dev* dev, alt_u32 offset, 
+                                 alt_u32 data)
+{
+  alt_host_perf*         perf = (alt_host_perf*) dev;
+  alt_host_perf_section* s;
+  alt_u64                now = alt_host_cycles ();
+  alt_u32                reg = offset / 4;
+  int                    n = reg / 4;
+  int                    i;
+
+  if (n >= ALT_HOST_PERF_SECTIONS)
+  {
+    return;
+  }
+  s = &perf->section[n];
+  switch (reg % 4)
+  {
+  case 0:
+    if ((n == 0) && (data & 1))
+    {
+      memset (perf->section, 0, sizeof (perf->section));
+    }
+    else if (n == 0)
+    {
+      for (i = 0; i < ALT_HOST_PERF_SECTIONS; i++)
+      {
+        alt_host_perf_stop (&perf->section[i], now);
+      }
+    }
+    else
+    {
+      alt_host_perf_stop (s, now);
+    }
+    break;
+  case 1:
+    if ((n == 0) || perf->section[0].running)
+    {
+      if (!s->running)
+      {
+        s->start   = now;
+        s->running = 1;
+        s->events++;
+      }
+    }
+    break;
+  default:
+    break;
+  }
+}
+
+void alt_host_perf_init (alt_u32 base)
+{
+  alt_host_perf_dev.dev.name  = "performance_counter";
+  alt_host_perf_dev.dev.base  = base;
+  alt_host_perf_dev.dev.span  = ALT_HOST_PERF_SECTIONS * 16;
+  alt_host_perf_dev.dev.read  = alt_host_perf_read;
+  alt_host_perf_dev.dev.write = alt_host_perf_write;
+  alt_host_dev_register (&alt_host_perf_dev.dev);
+}
@@ -0,0 +1,128 @@
+/******************************************************************************
+*                                                                             *
+* Host model of the altera_avalon_pio core, for input ports.                  *
+*                                                                             *
+* Register map:                                                               *
+*                                                                             *
+*   0  data           the levels of the input pins                            *
+*   2  interruptmask  bits whose edge capture asserts the IRQ line            *
+*   3  edgecapture    set on the edges of the configured type; a write        *
+*                     clears the bits written as 1 with the bit clearing      *
+*                     option, and every bit otherwise                         *
+*                                                                             *
+* The pins are driven by the board model through alt_host_pio_set(). As with  *
+* an IRQ type of "EDGE" on the hardware, the line is asserted while a masked  *
+* bit of the edge capture register is set.                                    *
+*                                                                             *
+******************************************************************************/
+
+#include <signal.h>
+#include <string.h>
+
+#include "system.h"
+#include "sys/alt_irq.h"
+#include "alt_host.h"
+#include "alt_types.h"
+
+static void alt_host_pio_irq (alt_host_pio* pio)
+{
+  if (pio->edge_cap & pio->irq_mask)
+  {
+    alt_host_irq_assert (pio->irq);
+  }
+  else
+  {
+    alt_host_irq_negate (pio->irq);
+  }
+}
+
+static alt_u32 alt_host_pio_read (alt_host_dev* dev, alt_u32 offset)
+{
+  alt_host_pio* pio = (alt_host_pio*) dev;
+
+  switch (offset / 4)
+  {
+  case 0:  return pio->data;
+  case 2:  return pio->irq_mask;
+  case 3:  return pio->edge_cap;
+  default: return 0;
+  }
+}
+
+static void alt_host_pio_write (alt_host_dev* dev, alt_u32 offset,
+                                alt_u32 data)
+{
+  alt_host_pio* pio = (alt_host_pio*) dev;
+
+  switch (offset / 4)
+  {
+  case 2:
+    pio->irq_mask = data & pio->mask;
+    break;
+  case 3:
+    pio->edge_cap = pio->bit_clearing ? (pio->edge_cap & ~data) : 0;
+    break;
+  default:
+    return;
+  }
+  alt_host_pio_irq (pio);
+
+  /*
+   * Writes are made by the CPU, outside of the exception entry, so raise the
+   * signal to have a newly asserted line serviced as soon as interrupts are
+   * enabled.
+   */
+
+  if (alt_irq_pending () & (1u << pio->irq))
+  {
+    raise (ALT_HOST_IRQ_SIGNAL);
+  }
+}
+
+void alt_host_pio_set (alt_host_pio* pio, alt_u32 value)
+{
+  alt_u32 old = pio->data;
+
+  value    &= pio->mask;
+  pio->data = value;
+  if (pio->edge_type & ALT_HOST_PIO_RISING)
+  {
+    pio->edge_cap |= ~old & value;
+  }
+  if (pio->edge_type & ALT_HOST_PIO_FALLING)
+  {
+    pio->edge_cap |= old & ~value;
+  }
+  alt_host_pio_irq (pio);
+}
+
+void alt_host_pio_init (alt_host_pio* pio, const char* name, alt_u32 base,
+                        alt_u32 irq, alt_u32 width, const char* edge_type,
+                        int bit_clearing, alt_u32 value)
+{
+  memset (pio, 0, sizeof (*pio));
+  pio->dev.name     = name;
+  pio->dev.base     = base;
+  pio->dev.span     = 16;
+  pio->dev.read     = alt_host_pio_read;
+  pio->dev.write    = alt_host_pio_write;
+  pio->irq          = irq;
+  pio->mask         = (width < 32) ? (1u << width) - 1 : 0xFFFFFFFF;
+  pio->bit_clearing = bit_clearing;
+  pio->data         = value & pio->mask;
+
+  if (strcmp (edge_type, "RISING") == 0)
+  {
+    pio->edge_type = ALT_HOST_PIO_RISING;
+  }
+  else if (strcmp (edge_type, "FALLING") == 0)
+  {
+    pio->edge_type = ALT_HOST_PIO_FALLING;
+  }
+  else if (strcmp (edge_type, "ANY") == 0)
+  {
+    pio->edge_type = ALT_HOST_PIO_RISING | ALT_HOST_PIO_FALLING;
+  }
+
+  alt_host_dev_register (&pio->dev);
+}
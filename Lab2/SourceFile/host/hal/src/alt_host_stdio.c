@@ -0,0 +1,47 @@
+/******************************************************************************
+*                                                                             *
+* Host serialisation of printf(), see alt_host_stdio.h.                       *
+*                                                                             *
+******************************************************************************/
+
+#include <stdarg.h>
+#include <stdio.h>
+
+#include "os_cpu.h"
+#include "os_cfg.h"
+#include "ucos_ii.h"
+
+static OS_EVENT* alt_host_stdio_sem;
+
+void alt_host_stdio_init (void)
+{
+  alt_host_stdio_sem = OSSemCreate (1);
+}
+
+int alt_host_printf (const char* format, ...)
+{
+  va_list args;
+  INT8U   err;
+  int     rc;
+  int     locked;
+
+  /* 
+   * Before OSStart() there is only one context, and ISRs must not print.
+   */
+
+  locked = (alt_host_stdio_sem != (OS_EVENT*) 0) && 
+           (OSRunning == OS_TRUE) && (OSIntNesting == 0);
+
+  if (locked)
+  {
+    OSSemPend (alt_host_stdio_sem, 0, &err);
+  }
+  va_start (args, format);
+  rc = vprintf (format, args);
+  va_end (args);
+  if (locked)
+  {
+    OSSemPost (alt_host_stdio_sem);
+  }
+  return rc;
+}
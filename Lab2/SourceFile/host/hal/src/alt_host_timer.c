@@ -0,0 +1,221 @@
+/******************************************************************************
+*                                                                             *
+* Host model of the altera_avalon_timer core, and the host time base.         *
+*                                                                             *
+* Simulated time is the host CLOCK_MONOTONIC scaled by alt_host_speedup and   *
+* expressed in CPU clock cycles. Each timer core is backed by a POSIX         *
+* interval timer; its expiry sets status.TO and, with control.ITO set,        *
+* asserts the core's IRQ line, after which the unmodified driver              *
+* (altera_avalon_timer_sc.c for the system clock) services it.                *
+*                                                                             *
+******************************************************************************/
+
+#include <signal.h>
+#include <string.h>
+#include <time.h>
+
+#include "system.h"
+#include "sys/alt_irq.h"
+#include "altera_avalon_timer_regs.h"
+#include "alt_host.h"
+#include "alt_types.h"
+
+double alt_host_speedup = 1.0;
+
+static alt_u64 alt_host_ns (void)
+{
+  struct timespec now;
+
+  clock_gettime (CLOCK_MONOTONIC, &now);
+  return (alt_u64) now.tv_sec * 1000000000ull + (alt_u64) now.tv_nsec;
+}
+
+alt_u64 alt_host_cycles (void)
+{
+  static alt_u64 origin;
+  alt_u64        now = alt_host_ns ();
+
+  if (origin == 0)
+  {
+    origin = now;
+  }
+  return (alt_u64) ((double) (now - origin) * alt_host_speedup * 
+                    ((double) ALT_CPU_FREQ / 1e9));
+}
+
+static void alt_host_cycles_to_timespec (alt_u64 cycles, struct timespec* ts)
+{
+  alt_u64 ns = (alt_u64) ((double) cycles * (1e9 / (double) ALT_CPU_FREQ) /
+                          alt_host_speedup);
+
+  if ((ns == 0) && (cycles != 0))
+  {
+    ns = 1;
+  }
+  ts->tv_sec  = (time_t) (ns / 1000000000ull);
+  ts->tv_nsec = (long) (ns % 1000000000ull);
+}
+
+int alt_host_dev_timer_create (alt_host_dev* dev, timer_t* timer)
+{
+  struct sigevent event;
+
+  memset (&event, 0, sizeof (event));
+  event.sigev_notify          = SIGEV_SIGNAL;
+  event.sigev_signo           = ALT_HOST_IRQ_SIGNAL;
+  event.sigev_value.sival_ptr = dev;
+  return timer_create (CLOCK_MONOTONIC, &event, timer);
+}
+
+void alt_host_dev_timer_arm (timer_t timer, alt_u64 cycles, alt_u64 period)
+{
+  struct itimerspec spec;
+
+  alt_host_cycles_to_timespec (cycles, &spec.it_value);
+  alt_host_cycles_to_timespec (period, &spec.it_interval);
+  timer_settime (timer, 0, &spec, NULL);
+}
+
+/*
+ * Convert between timer ticks and CPU cycles (the two clocks are equal on
+ * the DE2 system, but keep the model general).
+ */
+
+static alt_u64 alt_host_timer_cycles (alt_host_timer* t, alt_u64 ticks)
+{
+  return ticks * ALT_CPU_FREQ / t->freq;
+}
+
+static void alt_host_timer_start (alt_host_timer* t)
+{
+  alt_u64 period = alt_host_timer_cycles (t, (alt_u64) t->period + 1);
+
+  t->start   = alt_host_cycles ();
+  t->status |= ALTERA_AVALON_TIMER_STATUS_RUN_MSK;
+  alt_host_dev_timer_arm (t->timer, period,
+    (t->control & ALTERA_AVALON_TIMER_CONTROL_CONT_MSK) ? period : 0);
+}
+
+static void alt_host_timer_stop (alt_host_timer* t)
+{
+  t->status &= ~ALTERA_AVALON_TIMER_STATUS_RUN_MSK;
+  alt_host_dev_timer_arm (t->timer, 0, 0);
+}
+
+static alt_u32 alt_host_timer_counter (alt_host_timer* t)
+{
+  alt_u64 elapsed;
+
+  if (!(t->status & ALTERA_AVALON_TIMER_STATUS_RUN_MSK))
+  {
+    return t->period;
+  }
+  elapsed = (alt_host_cycles () - t->start) * t->freq / ALT_CPU_FREQ;
+  return t->period - (alt_u32) (elapsed % ((alt_u64) t->period + 1));
+}
+
+static alt_u32 alt_host_timer_read (alt_host_dev* dev, alt_u32 offset)
+{
+  alt_host_timer* t = (alt_host_timer*) dev;
+
+  switch (offset / 4)
+  {
+  case ALTERA_AVALON_TIMER_STATUS_REG:  return t->status;
+  case ALTERA_AVALON_TIMER_CONTROL_REG: return t->control;
+  case ALTERA_AVALON_TIMER_PERIODL_REG: return t->period & 0xFFFF;
+  case ALTERA_AVALON_TIMER_PERIODH_REG: return t->period >> 16;
+  case ALTERA_AVALON_TIMER_SNAPL_REG:   return t->snap & 0xFFFF;
+  case ALTERA_AVALON_TIMER_SNAPH_REG:   return t->snap >> 16;
+  default:                              return 0;
+  }
+}
+
+static void alt_host_timer_write (alt_host_dev* dev, alt_u32 offset, 
+                                  alt_u32 data)
+{
+  alt_host_timer* t = (alt_host_timer*) dev;
+
+  switch (offset / 4)
+  {
+  case ALTERA_AVALON_TIMER_STATUS_REG:
+    t->status &= ~ALTERA_AVALON_TIMER_STATUS_TO_MSK;
+    alt_host_irq_negate (t->irq);
+    break;
+  case ALTERA_AVALON_TIMER_CONTROL_REG:
+    t->control = data & (ALTERA_AVALON_TIMER_CONTROL_ITO_MSK |
+                         ALTERA_AVALON_TIMER_CONTROL_CONT_MSK);
+    if (data & ALTERA_AVALON_TIMER_CONTROL_STOP_MSK)
+    {
+      alt_host_timer_stop (t);
+    }
+    else if (data & ALTERA_AVALON_TIMER_CONTROL_START_MSK)
+    {
+      alt_host_timer_start (t);
+    }
+    if ((t->status & ALTERA_AVALON_TIMER_STATUS_TO_MSK) &&
+        (t->control & ALTERA_AVALON_TIMER_CONTROL_ITO_MSK))
+    {
+      alt_host_irq_assert (t->irq);
+    }
+    else
+    {
+      alt_host_irq_negate (t->irq);
+    }
+    break;
+  case ALTERA_AVALON_TIMER_PERIODL_REG:
+    alt_host_timer_stop (t);
+    t->period = (t->period & 0xFFFF0000) | (data & 0xFFFF);
+    break;
+  case ALTERA_AVALON_TIMER_PERIODH_REG:
+    alt_host_timer_stop (t);
+    t->period = (t->period & 0xFFFF) | ((data & 0xFFFF) << 16);
+    break;
+  case ALTERA_AVALON_TIMER_SNAPL_REG:
+  case ALTERA_AVALON_TIMER_SNAPH_REG:
+    t->snap = alt_host_timer_counter (t);
+    break;
+  default:
+    break;
+  }
+}
+
+/*
+ * Time-out: called at interrupt level when the backing POSIX timer expires.
+ */
+
+static void alt_host_timer_event (alt_host_dev* dev)
+{
+  alt_host_timer* t = (alt_host_timer*) dev;
+
+  if (!(t->status & ALTERA_AVALON_TIMER_STATUS_RUN_MSK))
+  {
+    return;
+  }
+  t->status |= ALTERA_AVALON_TIMER_STATUS_TO_MSK;
+  if (!(t->control & ALTERA_AVALON_TIMER_CONTROL_CONT_MSK))
+  {
+    t->status &= ~ALTERA_AVALON_TIMER_STATUS_RUN_MSK;
+  }
+  if (t->control & ALTERA_AVALON_TIMER_CONTROL_ITO_MSK)
+  {
+    alt_host_irq_assert (t->irq);
+  }
+}
+
+void alt_host_timer_init (alt_host_timer* t, const char* name, alt_u32 base,
+                          alt_u32 irq, alt_u32 freq, alt_u32 load_value)
+{
+  memset (t, 0, sizeof (*t));
+  t->dev.name  = name;
+  t->dev.base  = base;
+  t->dev.span  = 32;
+  t->dev.read  = alt_host_timer_read;
+  t->dev.write = alt_host_timer_write;
+  t->dev.event = alt_host_timer_event;
+  t->irq       = irq;
+  t->freq      = freq;
+  t->period    = load_value;
+
+  alt_host_dev_timer_create (&t->dev, &t->timer);
+  alt_host_dev_register (&t->dev);
+}
@@ -0,0 +1,114 @@
+/******************************************************************************
+*                                                                             *
+* Host start-up, the counterpart of HAL/src/alt_main.c.                       *
+*                                                                             *
+* Applications are compiled with main renamed to alt_user_main, so that this  *
+* file can bring the system up in the same order as alt_main() does on the    *
+* target: interrupt controller, operating system, device drivers, and then   *
+* the application.                                                            *
+*                                                                             *
+******************************************************************************/
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "sys/alt_irq.h"
+#include "sys/alt_sys_init.h"
+#include "os/alt_hooks.h"
+#include "alt_host.h"
+#include "alt_host_stdio.h"
+#include "alt_types.h"
+#include "system.h"
+
+/*
+ * Semaphores created by ALT_OS_INIT(). On the target they are defined in
+ * alt_env_lock.c and alt_malloc_lock.c to serialise newlib; glibc does not
+ * use them.
+ */
+
+OS_EVENT* alt_envsem;
+OS_EVENT* alt_heapsem;
+
+/*
+ * Prototype for the entry point to the users application.
+ */
+
+extern int alt_user_main (void);
+
+/*
+ * ALT_HOST_RUN_MS: stop after a given amount of simulated time. Output is
+ * line buffered, so nothing already printed is lost by the _exit().
+ */
+
+static void alt_host_stop (int sig)
+{
+  (void) sig;
+  _exit (0);
+}
+
+static void alt_host_run_limit (const char* run_ms)
+{
+  struct sigevent   event;
+  struct itimerspec spec;
+  timer_t           timer;
+  double            ns;
+
+  signal (SIGUSR1, alt_host_stop);
+
+  memset (&event, 0, sizeof (event));
+  event.sigev_notify = SIGEV_SIGNAL;
+  event.sigev_signo  = SIGUSR1;
+  if (timer_create (CLOCK_MONOTONIC, &event, &timer) != 0)
+  {
+    perror ("ALT_HOST_RUN_MS");
+    return;
+  }
+
+  ns = strtod (run_ms, NULL) * 1e6 / alt_host_speedup;
+  memset (&spec, 0, sizeof (spec));
+  spec.it_value.tv_sec  = (time_t) (ns / 1e9);
+  spec.it_value.tv_nsec = (long) (ns - (double) spec.it_value.tv_sec * 1e9);
+  timer_settime (timer, 0, &spec, NULL);
+}
+
+int main (int argc, char** argv)
+{
+  const char* env;
+
+  (void) argc;
+  (void) argv;
+
+  env = getenv ("ALT_HOST_SPEEDUP");
+  if (env && (strtod (env, NULL) > 0.0))
+  {
+    alt_host_speedup = strtod (env, NULL);
+  }
+  (void) alt_host_cycles ();
+
+  setvbuf (stdout, NULL, _IOLBF, 0);
+
+  /* Initialize the interrupt controller. */
+
+  alt_irq_init (NULL);
+
+  /* Initialize the operating system */
+
+  ALT_OS_INIT();
+  alt_host_stdio_init ();
+
+  /* Initialize the device drivers/software components. */
+
+  alt_sys_init ();
+
+  env = getenv ("ALT_HOST_RUN_MS");
+  if (env)
+  {
+    alt_host_run_limit (env);
+  }
+
+  return alt_user_main ();
+}
@@ -0,0 +1,183 @@
+/******************************************************************************
+*                                                                             *
+* Host counterpart of the generated bsp/alt_sys_init.c.                       *
+*                                                                             *
+* Each peripheral the applications use gets its model first, and is then      *
+* initialised through the same driver macros as on the target. The JTAG UART  *
+* and LCD are not modelled: stdout goes to the host terminal.                 *
+*                                                                             *
+* The board drives the input PIOs of the buttons and switches. Besides their  *
+* values at reset, ALT_HOST_INPUTS gives their later changes as a comma       *
+* separated list of <ms>:k<hex> (the mask of the buttons held down from then  *
+* on) and <ms>:s<hex> (the switches), in simulated milliseconds since reset   *
+* and in ascending order, e.g. "1000:k4,1500:k0,3000:s3". A bouncing contact  *
+* is scripted as a burst of changes one millisecond apart.                    *
+*                                                                             *
+******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "system.h"
+#include "sys/alt_irq.h"
+#include "sys/alt_sys_init.h"
+#include "alt_host.h"
+
+/*
+ * Device headers
+ */
+
+#include "altera_avalon_performance_counter.h"
+#include "altera_avalon_timer.h"
+
+/*
+ * Allocate the device storage
+ */
+
+ALTERA_AVALON_PERFORMANCE_COUNTER_INSTANCE ( PERFORMANCE_COUNTER, performance_counter);
+ALTERA_AVALON_TIMER_INSTANCE ( TIMER_0, timer_0);
+ALTERA_AVALON_TIMER_INSTANCE ( TIMER_1, timer_1);
+
+static alt_host_timer timer_0;
+static alt_host_timer timer_1;
+static alt_host_pio   keys4;
+static alt_host_pio   toggles18;
+
+/*
+ * Changes of the board inputs, applied at interrupt level by the event of
+ * the board when their time has come.
+ */
+
+#define ALT_HOST_INPUTS_MAX 64
+
+typedef struct alt_host_input_s
+{
+  alt_u64       cycles;             /* alt_host_cycles() of the change */
+  alt_host_pio* pio;
+  alt_u32       value;
+} alt_host_input;
+
+static struct
+{
+  alt_host_dev   dev;
+  alt_host_input input[ALT_HOST_INPUTS_MAX];
+  int            inputs;
+  int            next;
+  timer_t        timer;
+} alt_host_board;
+
+static void alt_host_board_arm (void)
+{
+  alt_u64 now = alt_host_cycles ();
+  alt_u64 at;
+
+  if (alt_host_board.next < alt_host_board.inputs)
+  {
+    at = alt_host_board.input[alt_host_board.next].cycles;
+    alt_host_dev_timer_arm (alt_host_board.timer, (at > now) ? at - now : 1, 
+                            0);
+  }
+}
+
+static void alt_host_board_event (alt_host_dev* dev)
+{
+  alt_host_input* in;
+  alt_u64         now = alt_host_cycles ();
+
+  (void) dev;
+
+  while ((alt_host_board.next < alt_host_board.inputs) &&
+         (alt_host_board.input[alt_host_board.next].cycles <= now))
+  {
+    in = &alt_host_board.input[alt_host_board.next++];
+    alt_host_pio_set (in->pio, in->value);
+  }
+  alt_host_board_arm ();
+}
+
+static void alt_host_board_script (const char* script)
+{
+  alt_host_input* in;
+  char*           end;
+  double          ms;
+
+  while (*script && (alt_host_board.inputs < ALT_HOST_INPUTS_MAX))
+  {
+    in = &alt_host_board.input[alt_host_board.inputs];
+    ms = strtod (script, &end);
+    if ((end == script) || (end[0] != ':') || 
+        ((end[1] != 'k') && (end[1] != 's')))
+    {
+      fprintf (stderr, "ALT_HOST_INPUTS: bad change at \"%s\"\n", script);
+      return;
+    }
+    in->cycles = (alt_u64) (ms * (ALT_CPU_FREQ / 1000));
+    in->pio    = (end[1] == 'k') ? &keys4 : &toggles18;
+    in->value  = (alt_u32) strtoul (end + 2, &end, 16);
+    if (in->pio == &keys4)
+    {
+      in->value = ~in->value;       /* the KEY buttons are active low */
+    }
+    alt_host_board.inputs++;
+    script = (*end == ',') ? end + 1 : end;
+  }
+
+  alt_host_board.dev.name  = "board";
+  alt_host_board.dev.event = alt_host_board_event;
+  alt_host_dev_timer_create (&alt_host_board.dev, &alt_host_board.timer);
+  alt_host_board_arm ();
+}
+
+/*
+ * Board inputs at reset: the KEY buttons are active low, the toggle switches
+ * are taken from the environment (see alt_host.h).
+ */
+
+static void alt_host_board_init (void)
+{
+  const char* env;
+  alt_u32     keys     = 0;
+  alt_u32     switches = 0;
+
+  if ((env = getenv ("ALT_HOST_KEYS")) != NULL)
+  {
+    keys = (alt_u32) strtoul (env, NULL, 16);
+  }
+  if ((env = getenv ("ALT_HOST_SWITCHES")) != NULL)
+  {
+    switches = (alt_u32) strtoul (env, NULL, 16);
+  }
+  alt_host_pio_init (&keys4, D2_PIO_KEYS4_NAME, D2_PIO_KEYS4_BASE,
+                     D2_PIO_KEYS4_IRQ, D2_PIO_KEYS4_DATA_WIDTH,
+                     D2_PIO_KEYS4_EDGE_TYPE,
+                     D2_PIO_KEYS4_BIT_CLEARING_EDGE_REGISTER, ~keys);
+  alt_host_pio_init (&toggles18, DE2_PIO_TOGGLES18_NAME, 
+                     DE2_PIO_TOGGLES18_BASE, DE2_PIO_TOGGLES18_IRQ,
+                     DE2_PIO_TOGGLES18_DATA_WIDTH, 
+                     DE2_PIO_TOGGLES18_EDGE_TYPE,
+                     DE2_PIO_TOGGLES18_BIT_CLEARING_EDGE_REGISTER, switches);
+  if ((env = getenv ("ALT_HOST_INPUTS")) != NULL)
+  {
+    alt_host_board_script (env);
+  }
+}
+
+/*
+ * Initialize the non-interrupt controller devices.
+ * Called after alt_irq_init().
+ */
+
+void alt_sys_init( void )
+{
+    alt_host_timer_init (&timer_0, TIMER_0_NAME, TIMER_0_BASE, TIMER_0_IRQ,
+                         TIMER_0_FREQ, TIMER_0_LOAD_VALUE);
+    alt_host_timer_init (&timer_1, TIMER_1_NAME, TIMER_1_BASE, TIMER_1_IRQ,
+                         TIMER_1_FREQ, TIMER_1_LOAD_VALUE);
+    alt_host_perf_init (PERFORMANCE_COUNTER_BASE);
+    alt_host_board_init ();
+
+    ALTERA_AVALON_TIMER_INIT ( TIMER_0, timer_0);
+    ALTERA_AVALON_TIMER_INIT ( TIMER_1, timer_1);
+    ALTERA_AVALON_PERFORMANCE_COUNTER_INIT ( PERFORMANCE_COUNTER, performance_counter);
+}
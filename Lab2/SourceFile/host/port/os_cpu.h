@@ -0,0 +1,110 @@
+#ifndef __OS_CPU_H__
+#define __OS_CPU_H__
+
+/*
+*********************************************************************************************************
+*                                               uC/OS-II
+*                                         The Real-Time Kernel
+*
+* File         : os_cpu.h
+* For          : uC/OS Real-time multitasking kernel, hosted on Linux/POSIX
+* Based on     : the Nios II port in HAL/inc/os_cpu.h
+*
+* The host port runs the unmodified kernel from bsp/UCOSII/src as a single Linux process:
+*
+*   - Tasks are ucontext_t contexts, switched with swapcontext() (see os_cpu_c.c).
+*   - The system tick comes from a POSIX interval timer (timer_create()) driving the model of
+*     timer_0 in host/hal/src/alt_host_timer.c.
+*   - OS_ENTER_CRITICAL()/OS_EXIT_CRITICAL() block and unblock the interrupt signal, exactly as the
+*     Nios II port clears and restores status.PIE.
+*********************************************************************************************************
+*/
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+#include "sys/alt_irq.h"
+
+#ifdef  OS_CPU_GLOBALS
+#define OS_CPU_EXT
+#else
+#define OS_CPU_EXT  extern
+#endif
+
+/*
+*********************************************************************************************************
+*                                              DATA TYPES
+*                                         (Compiler Specific)
+*
+* The integer widths match the Nios II port; INT32U/INT32S are pinned to 'int' because 'long' is 64 bits
+* on an LP64 host.
+*********************************************************************************************************
+*/
+
+typedef unsigned char  BOOLEAN;
+typedef unsigned char  INT8U;                    /* Unsigned  8 bit quantity                           */
+typedef signed   char  INT8S;                    /* Signed    8 bit quantity                           */
+typedef unsigned short INT16U;                   /* Unsigned 16 bit quantity                           */
+typedef signed   short INT16S;                   /* Signed   16 bit quantity                           */
+typedef unsigned int   INT32U;                   /* Unsigned 32 bit quantity                           */
+typedef signed   int   INT32S;                   /* Signed   32 bit quantity                           */
+typedef float          FP32;                     /* Single precision floating point                    */
+typedef double         FP64;                     /* Double precision floating point                    */
+typedef unsigned int   OS_STK;                   /* Each stack entry is 32-bits                        */
+
+/*
+*********************************************************************************************************
+*                                           HOST TASK STACKS
+*
+* A Linux signal frame can be larger than the 512-entry stacks the BSP gives the idle, statistic and
+* timer tasks (11 952 bytes with AMX state), so tasks do not execute on their OS_STK arrays.  Each task
+* runs on a private mapping of OS_CPU_HOST_STK_SIZE bytes, and OSTaskCreateHook() points the TCB's
+* stack bottom and size at it so that OSTaskStkChk() reports real usage.
+*********************************************************************************************************
+*/
+
+#ifndef OS_CPU_HOST_STK_SIZE
+#define  OS_CPU_HOST_STK_SIZE  (64 * 1024)       /* Size of each task's host stack, in bytes           */
+#endif
+
+/*
+*********************************************************************************************************
+*                                             PROCESSOR SPECIFICS
+*********************************************************************************************************
+*/
+
+#define  OS_STK_GROWTH        1                  /* Stack grows from HIGH to LOW memory                */
+#define  OS_TASK_SW           OSCtxSw  
+#define  OS_CPU_CTZ(map)      __builtin_ctz(map) /* Lowest bit set of a ready list word (bsf/tzcnt)   */
+#define  OS_CPU_BARRIER()     __asm__ volatile ("" ::: "memory") /* Compiler barrier, ISRs are signals */
+
+/*
+*********************************************************************************************************
+*                                              CRITICAL SECTIONS
+*********************************************************************************************************
+*/
+
+#define  OS_CRITICAL_METHOD    3    
+
+#if      OS_CRITICAL_METHOD == 3
+#define  OS_CPU_SR alt_irq_context  
+#define  OS_ENTER_CRITICAL() \
+         cpu_sr = alt_irq_disable_all ()
+#define  OS_EXIT_CRITICAL() \
+         alt_irq_enable_all (cpu_sr);
+#else
+#error OS_CRITICAL_METHOD != 3 not supported, please use method 3 instead.
+#endif
+
+/* Prototypes */
+void OSStartHighRdy(void); 
+void OSCtxSw(void); 
+void OSIntCtxSw(void);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __OS_CPU_H__ */
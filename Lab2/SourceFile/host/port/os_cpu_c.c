@@ -0,0 +1,456 @@
+/***********************************************************************************************
+ *                                               uC/OS-II
+ *                                         The Real-Time Kernel
+ * File         : os_cpu_c.c
+ * For          : uC/OS Real-time multitasking kernel, hosted on Linux/POSIX
+ * Based on     : the Nios II port in HAL/src/os_cpu_c.c and HAL/src/os_cpu_a.S
+ *
+ * Functions defined in this module:
+ *
+ *   OSTaskStkInit(), OSStartHighRdy(), OSCtxSw(), OSIntCtxSw(), OSCPUCyclesGet() and the CPU
+ *   hooks.
+ *
+ * Every task owns an OS_CPU_FRAME placed at the top of a private host stack. The frame holds
+ * the task's ucontext_t, and OSTCBStkPtr permanently points at it, so a context switch is a
+ * swapcontext() between the frames of OSTCBCur and OSTCBHighRdy. swapcontext() also saves and
+ * restores the signal mask, which gives every task its own interrupt enable state just like
+ * status.PIE is saved per task on the Nios II.
+ *
+ * OSIntCtxSw() is called from OSIntExit() while the interrupt signal handler is running on the
+ * interrupted task's stack. The switch is done right there: the preempted task resumes later
+ * by returning through the signal handler, which restores its pre-interrupt signal mask.
+ *
+ * Every saved context has the interrupt signal blocked. swapcontext() installs the new signal
+ * mask before it switches stacks, so a context that unblocked the signal would let an interrupt
+ * run on the old task's stack while OSTCBCur already names the new task. New tasks therefore
+ * enable interrupts themselves in OSStartTsk(), as on the Nios II.
+ ***********************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <ucontext.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#define  OS_CPU_GLOBALS
+#include "includes.h"                   /* Standard includes for uC/OS-II */
+
+#include "system.h"
+#include "alt_host.h"
+
+#if OS_TICKLESS_EN > 0
+#include "altera_avalon_timer.h"
+#endif
+
+typedef struct os_cpu_frame {
+    ucontext_t            OSCPUCtx;     /* Saved context of the task                           */
+    void                (*OSCPUTask)(void *pd);
+    void                 *OSCPUPdata;
+    OS_STK               *OSCPUStkBottom;   /* Lowest usable entry of the host stack           */
+    INT32U                OSCPUStkSize;     /* Usable size of the host stack, in OS_STK entries */
+    struct os_cpu_frame  *OSCPUNext;    /* Link in the list of frames of deleted tasks         */
+} OS_CPU_FRAME;
+
+static  OS_CPU_FRAME  *OSCPUFrameFreeList;
+
+#if OS_TMR_EN > 0
+static  INT16U  OSTmrCtr;
+#endif
+
+/***********************************************************************************************
+ *                                   ALLOCATE A HOST STACK AND FRAME
+ *
+ * Description: Returns a frame at the top of a zeroed host stack. Stacks of deleted tasks are
+ *              recycled; new ones are mapped with a PROT_NONE guard page below the stack so an
+ *              overflow faults instead of silently corrupting a neighbour.
+ ***********************************************************************************************/
+
+static OS_CPU_FRAME *OSCPUFrameAlloc (void)
+{
+    OS_CPU_FRAME  *frame;
+    char          *base;
+    size_t         page;
+    size_t         size;
+#if OS_CRITICAL_METHOD == 3
+    OS_CPU_SR      cpu_sr = 0;
+#endif
+
+
+    OS_ENTER_CRITICAL();
+    frame = OSCPUFrameFreeList;
+    if (frame != (OS_CPU_FRAME *)0) {
+        OSCPUFrameFreeList = frame->OSCPUNext;
+    }
+    OS_EXIT_CRITICAL();
+    if (frame != (OS_CPU_FRAME *)0) {
+        memset(frame->OSCPUStkBottom, 0, frame->OSCPUStkSize * sizeof(OS_STK));
+        return (frame);
+    }
+
+    page = (size_t)sysconf(_SC_PAGESIZE);
+    size = (page + OS_CPU_HOST_STK_SIZE + sizeof(OS_CPU_FRAME) + page - 1) & ~(page - 1);
+    base = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK, -1, 0);
+    if (base == MAP_FAILED) {
+        perror("OSTaskStkInit: mmap");
+        abort();
+    }
+    (void)mprotect(base, page, PROT_NONE);
+
+    frame                 = (OS_CPU_FRAME *)(((size_t)(base + size) - sizeof(OS_CPU_FRAME)) & ~(size_t)15);
+    frame->OSCPUStkBottom = (OS_STK *)(base + page);
+    frame->OSCPUStkSize   = (INT32U)(((char *)frame - (base + page)) / sizeof(OS_STK));
+    return (frame);
+}
+
+/***********************************************************************************************
+ *                                         TASK ENTRY POINT
+ *
+ * Description: First code run by every task (the counterpart of OSStartTsk in os_cpu_a.S). The
+ *              frame of the task being started is the one of OSTCBCur.
+ ***********************************************************************************************/
+
+static void OSStartTsk (void)
+{
+    OS_CPU_FRAME  *frame;
+
+
+    frame = (OS_CPU_FRAME *)OSTCBCur->OSTCBStkPtr;
+    alt_irq_cpu_enable_interrupts();    /* Tasks start with interrupts enabled                */
+    frame->OSCPUTask(frame->OSCPUPdata);
+#if OS_TASK_DEL_EN > 0
+    (void)OSTaskDel(OS_PRIO_SELF);      /* A task must not return; treat it as a self-delete  */
+#endif
+    for (;;) {
+        (void)OSTaskSuspend(OS_PRIO_SELF);
+    }
+}
+
+/***********************************************************************************************
+ *                                        INITIALIZE A TASK'S STACK
+ *
+ * Description: This function is called by either OSTaskCreate() or OSTaskCreateExt() to
+ *              initialize the stack frame of the task being created.
+ *
+ * What it does: It allocates the task's host stack and builds a context that starts the task
+ *               in OSStartTsk(), which enables interrupts.
+ *
+ * Arguments  : task          is a pointer to the task code
+ *
+ *              pdata         is a pointer to a user supplied data area that will be passed to the task
+ *                            when the task first executes.
+ *
+ *              pstk          is a pointer to the top of the task's OS_STK array.  It is not used for
+ *                            execution on the host, see OS_CPU_HOST_STK_SIZE in os_cpu.h.
+ *
+ *              opt           specifies options that can be used to alter the behavior of OSTaskStkInit().
+ *                            (see uCOS_II.H for OS_TASK_OPT_???).
+ *
+ * Returns    : The address of the task's OS_CPU_FRAME, which becomes the task's OSTCBStkPtr.
+ ***********************************************************************************************/
+
+OS_STK *OSTaskStkInit(void (*task)(void *pd), void *pdata, OS_STK *pstk, INT16U opt)
+{
+    OS_CPU_FRAME  *frame;
+
+
+    (void)pstk;
+    (void)opt;
+    frame             = OSCPUFrameAlloc();
+    frame->OSCPUTask  = task;
+    frame->OSCPUPdata = pdata;
+    frame->OSCPUNext  = (OS_CPU_FRAME *)0;
+
+    getcontext(&frame->OSCPUCtx);
+    frame->OSCPUCtx.uc_stack.ss_sp   = frame->OSCPUStkBottom;
+    frame->OSCPUCtx.uc_stack.ss_size = frame->OSCPUStkSize * sizeof(OS_STK);
+    frame->OSCPUCtx.uc_link          = (ucontext_t *)0;
+    sigaddset(&frame->OSCPUCtx.uc_sigmask, ALT_HOST_IRQ_SIGNAL);   /* Enabled by OSStartTsk(), see above  */
+    makecontext(&frame->OSCPUCtx, OSStartTsk, 0);
+
+    return ((OS_STK *)frame);
+}
+
+/***********************************************************************************************
+ *                                START HIGHEST PRIORITY TASK READY-TO-RUN
+ *
+ * Description: Called by OSStart() to start the highest priority task that was created by the
+ *              application.  Never returns; the context of main() is abandoned.
+ ***********************************************************************************************/
+
+void OSStartHighRdy (void)
+{
+    (void)alt_irq_disable_all();
+    OSTaskSwHook();
+    OSRunning = OS_TRUE;
+    OSTCBCur  = OSTCBHighRdy;
+    OSPrioCur = OSPrioHighRdy;
+    setcontext(&((OS_CPU_FRAME *)OSTCBHighRdy->OSTCBStkPtr)->OSCPUCtx);
+    perror("OSStartHighRdy: setcontext");
+    abort();
+}
+
+/***********************************************************************************************
+ *                                   TASK LEVEL AND ISR LEVEL CONTEXT SWITCH
+ *
+ * Description: Save the context of OSTCBCur and resume OSTCBHighRdy.  Both are called with
+ *              interrupts disabled; the disabled state is saved with the outgoing context.
+ ***********************************************************************************************/
+
+void OSCtxSw (void)
+{
+    OS_CPU_FRAME  *frame;
+
+
+    frame = (OS_CPU_FRAME *)OSTCBCur->OSTCBStkPtr;
+    OSTaskSwHook();
+    OSTCBCur  = OSTCBHighRdy;
+    OSPrioCur = OSPrioHighRdy;
+    swapcontext(&frame->OSCPUCtx, &((OS_CPU_FRAME *)OSTCBHighRdy->OSTCBStkPtr)->OSCPUCtx);
+}
+
+void OSIntCtxSw (void)
+{
+    OSCtxSw();
+}
+
+#if OS_CPU_HOOKS_EN
+/*
+*********************************************************************************************************
+*                                          TASK CREATION HOOK
+*
+* Description: This function is called when a task is created.  On the host it replaces the stack
+*              bounds recorded by OS_TCBInit() with those of the task's host stack, so that stack
+*              checking measures the stack the task actually runs on.
+*
+* Arguments  : ptcb   is a pointer to the task control block of the task being created.
+*********************************************************************************************************
+*/
+void OSTaskCreateHook (OS_TCB *ptcb)
+{
+#if OS_TASK_CREATE_EXT_EN > 0
+    OS_CPU_FRAME  *frame;
+
+
+    frame                = (OS_CPU_FRAME *)ptcb->OSTCBStkPtr;
+    ptcb->OSTCBStkBottom = frame->OSCPUStkBottom;
+    ptcb->OSTCBStkSize   = frame->OSCPUStkSize;
+#else
+    ptcb = ptcb;                       /* Prevent compiler warning */
+#endif
+}
+
+
+/*
+*********************************************************************************************************
+*                                           TASK DELETION HOOK
+*
+* Description: This function is called when a task is deleted.  The task's host stack is queued for
+*              reuse by the next OSTaskStkInit(); it cannot be unmapped here since a task deleting
+*              itself is still running on it.
+*
+* Arguments  : ptcb   is a pointer to the task control block of the task being deleted.
+*********************************************************************************************************
+*/
+void OSTaskDelHook (OS_TCB *ptcb)
+{
+    OS_CPU_FRAME  *frame;
+#if OS_CRITICAL_METHOD == 3
+    OS_CPU_SR      cpu_sr = 0;
+#endif
+
+
+    frame = (OS_CPU_FRAME *)ptcb->OSTCBStkPtr;
+    OS_ENTER_CRITICAL();
+    frame->OSCPUNext   = OSCPUFrameFreeList;
+    OSCPUFrameFreeList = frame;
+    OS_EXIT_CRITICAL();
+}
+
+/*
+*********************************************************************************************************
+*                                           TASK SWITCH HOOK
+*
+* Description: This function is called when a task switch is performed.  This allows you to perform other
+*              operations during a context switch.
+*
+* Arguments  : none
+*
+* Note(s)    : 1) Interrupts are disabled during this call.
+*              2) It is assumed that the global pointer 'OSTCBHighRdy' points to the TCB of the task that
+*                 will be 'switched in' (i.e. the highest priority task) and, 'OSTCBCur' points to the
+*                 task being switched out (i.e. the preempted task).
+*********************************************************************************************************
+*/
+void OSTaskSwHook (void)
+{
+#if OS_TASK_PROFILE_EN > 0
+    OS_TaskProfileSw();
+#endif
+    OS_TRACE(OS_TRACE_SW, OSPrioHighRdy);
+}
+
+#if OS_TASK_PROFILE_EN > 0
+/*
+*********************************************************************************************************
+*                                             CYCLE COUNTER
+*
+* Description: Returns a free running count of CPU clock cycles, for the task profiling of the kernel.
+*              Cycles are derived from the host clock, as for the timer and performance counter models.
+*********************************************************************************************************
+*/
+INT32U OSCPUCyclesGet (void)
+{
+    return ((INT32U)alt_host_cycles());
+}
+#endif
+
+/*
+*********************************************************************************************************
+*                                           STATISTIC TASK HOOK
+*
+* Description: This function is called every second by uC/OS-II's statistics task.  This allows your
+*              application to add functionality to the statistics task.
+*
+* Arguments  : none
+*********************************************************************************************************
+*/
+void OSTaskStatHook (void)
+{
+}
+
+/*
+*********************************************************************************************************
+*                                               TICK HOOK
+*
+* Description: This function is called every tick.
+*
+* Arguments  : none
+*
+* Note(s)    : 1) Interrupts may or may not be ENABLED during this call.
+*********************************************************************************************************
+*/
+void OSTimeTickHook (void)
+{
+#if OS_TMR_EN > 0
+    OSTmrCtr++;
+    if (OSTmrCtr >= OS_TICKS_PER_TMR) {
+        OSTmrCtr = 0;
+        OSTmrSignal();
+    }
+#endif
+}
+
+/*
+*********************************************************************************************************
+*                                         TICK HOOK FOR SEVERAL TICKS
+*
+* Description: This function is called by OSTimeTickN() for the 'ticks' ticks that elapsed while the
+*              idle task had stopped the tick, instead of OSTimeTickHook() for each.  It signals the
+*              timer task as many times as OSTimeTickHook() would have, in one call.
+*
+* Arguments  : ticks     is the number of ticks that elapsed.
+*
+* Note(s)    : 1) Interrupts are disabled during this call.
+*********************************************************************************************************
+*/
+#if OS_TICKLESS_EN > 0
+void OSTimeTickNHook (INT32U ticks)
+{
+#if OS_TMR_EN > 0
+    INT32U  ctr;
+
+
+    ctr      = OSTmrCtr + ticks;
+    OSTmrCtr = (INT16U)(ctr % OS_TICKS_PER_TMR);
+    OSTmrSignalN(ctr / OS_TICKS_PER_TMR);
+#else
+    ticks = ticks;                     /* Prevent compiler warning */
+#endif
+}
+#endif
+
+void OSInitHookBegin(void)
+{
+#if OS_TMR_EN > 0
+    OSTmrCtr = 0;
+#endif
+}
+
+void OSInitHookEnd(void)
+{
+}
+
+/*
+*********************************************************************************************************
+*                                               IDLE HOOK
+*
+* Description: Sleeps until the next interrupt instead of spinning, so an idle simulation does not burn
+*              a host CPU.  OSIdleCtr then counts idle wake-ups rather than loop iterations; the ratio
+*              that OS_TaskStat() computes from it without OS_TASK_STAT_CYCLES_EN still tracks the
+*              share of ticks the CPU was idle, as long as OS_TICKLESS_EN does not stop the tick.
+*********************************************************************************************************
+*/
+void OSTaskIdleHook(void)
+{
+    sigset_t  mask;
+
+
+    sigprocmask(SIG_BLOCK, NULL, &mask);
+    sigdelset(&mask, ALT_HOST_IRQ_SIGNAL);
+    sigsuspend(&mask);
+}
+
+void OSTCBInitHook(OS_TCB *ptcb)
+{
+    ptcb = ptcb;                       /* Prevent compiler warning */
+}
+
+#endif
+
+#if OS_TICKLESS_EN > 0
+/*
+*********************************************************************************************************
+*                                           STOP AND RESTART THE TICK
+*
+* Description: OSTickSuppressHook() is called by the idle task to stop the tick for up to 'ticks' ticks.
+*              The tick hook signals the timer task every OS_TICKS_PER_TMR ticks, so the time is first
+*              shortened to the signal at which the first running OS_TMR expires.  The system clock
+*              driver shortens it further to the first alarm of the HAL, and stretches the period of
+*              the timer.
+*
+*              OSTickResumeHook() is called by OSIntEnter() on the first interrupt afterwards.  The
+*              driver restarts the tick and announces the ticks that elapsed with OSTimeTickN(), which
+*              calls OSTimeTickNHook() once for all of them.
+*
+* Arguments  : ticks     is the number of ticks until the first delay expires, 0xFFFFFFFF if none.
+*
+* Returns    : OS_TRUE if the tick was stopped, OS_FALSE if it keeps running.
+*
+* Note(s)    : 1) Interrupts are disabled during these calls.
+*********************************************************************************************************
+*/
+BOOLEAN OSTickSuppressHook (INT32U ticks)
+{
+#if OS_TMR_EN > 0
+    INT32U  signals;
+    INT32U  tmr;
+
+
+    signals = OSTmrNextGet();
+    if ((signals != 0) && (signals - 1 < ticks / OS_TICKS_PER_TMR)) {
+        tmr = OS_TICKS_PER_TMR - OSTmrCtr + (signals - 1) * OS_TICKS_PER_TMR;
+        if (tmr < ticks) {
+            ticks = tmr;
+        }
+    }
+#endif
+    return ((alt_avalon_timer_sc_suppress(ticks) != 0) ? OS_TRUE : OS_FALSE);
+}
+
+void OSTickResumeHook (void)
+{
+    alt_avalon_timer_sc_resume();
+}
+#endif
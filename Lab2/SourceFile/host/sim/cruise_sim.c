@@ -0,0 +1,479 @@
+/* Batch simulator of the cruise control
+ *
+ * Description:
+ *
+ *   Runs the vehicle model and the control law of the Watchdog application
+ *   (app/Lab2-4.5_Watchdog/src/vehicle.c and control.c) step by step and as
+ *   fast as possible, without the kernel.  A step is one period of
+ *   VehicleTask followed by one period of ControlTask, in the order their
+ *   priorities give on the board: the vehicle moves with the actuator
+ *   signals of the previous period, then the control law reads the new
+ *   velocity.  The simulation is deterministic.
+ *
+ *   The pedals and switches follow an input script, a text file with one
+ *   event per line:
+ *
+ *     # time in ms, then the inputs that change at that time
+ *     0      engine=on top_gear=on gas=on
+ *     900    gas=off cruise=on
+ *     2000   cruise=off
+ *
+ *   The inputs are engine, top_gear, cruise, gas and brake, and all of them
+ *   are off at time 0.  Without -s the script above is used.
+ *
+ *   For every run, the simulator reports the target velocity the cruise
+ *   control was first activated with, the overshoot above it, the settling
+ *   time, i.e. the time from the activation until the velocity stays within
+ *   the settle band around the target, and the mean and maximum tracking
+ *   error, all as long as the cruise control stays active.  The period and
+ *   the parameters of the control law can be given a range with -T and -p,
+ *   in which case every combination is run, one line each.  The throughput
+ *   in steps per second is reported at the end.
+ *
+ *   Usage: cruise_sim [-s script] [-d ms] [-T ms | -T first:last[:step]]
+ *                     [-r runs] [-b m/s] [-t]
+ *                     [-p name=value | -p name=first:last[:step]] ...
+ *
+ *     -s   input script
+ *     -d   simulated time of a run (default 120000 ms)
+ *     -T   period of the tasks (default 300 ms)
+ *     -r   repeat every run this many times, to measure the throughput
+ *     -b   settle band (default 2 m/s)
+ *     -t   print every step of the first run
+ *     -p   set or sweep a parameter of the control law (see control_params
+ *          in cruise.h).  The gains kp, ki, kd and bias are set for every
+ *          segment, or for segment n with a suffix, e.g. bias2=4.
+ */
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include "cruise.h"
+
+#define MAX_EVENTS 256
+#define MAX_SWEEPS 9
+#define DEFAULT_BAND 2
+
+struct event {
+  long time;               // ms
+  int input;               // index into input_names
+  enum active value;
+};
+
+static const char* const input_names[] = {
+  "engine", "top_gear", "cruise", "gas", "brake"
+};
+
+#define INPUTS (sizeof(input_names) / sizeof(input_names[0]))
+
+static const char* const default_script[] = {
+  "0      engine=on top_gear=on gas=on",
+  "900    gas=off cruise=on",
+  "2000   cruise=off",
+};
+
+static struct event events[MAX_EVENTS];
+static int n_events;
+
+// Parameters of the control law that can be set or swept
+enum param_type {PARAM_U8, PARAM_S8, PARAM_U16};
+
+struct param {
+  const char* name;
+  size_t offset;           // of the first one in control_params
+  enum param_type type;
+  int count;               // one per segment or one
+};
+
+struct sweep {
+  const struct param* param;
+  int segment;             // -1 for every segment
+  const char* name;
+  int first;
+  int last;
+  int step;
+  int value;
+};
+
+static struct control_params params;
+static struct sweep sweeps[MAX_SWEEPS];
+static int n_sweeps;
+
+struct result {
+  int activated;
+  long time_on;            // ms, first activation
+  INT16S target;
+  int overshoot;           // m/s above the target while active
+  long settle;             // ms after the activation, -1 if never settled
+  double mean_error;       // m/s, mean of |target - velocity| while active
+  int max_error;           // m/s
+};
+
+static const struct param param_names[] = {
+#define GAIN(field, type) \
+  { #field, offsetof(struct control_params, gains[0].field), type, \
+    CONTROL_SEGMENTS }
+#define PARAM(field) \
+  { #field, offsetof(struct control_params, field), PARAM_U8, 1 }
+  GAIN(kp, PARAM_U16), GAIN(ki, PARAM_U16), GAIN(kd, PARAM_U16),
+  GAIN(bias, PARAM_S8),
+  PARAM(integral_limit), PARAM(min_target), PARAM(min_activation),
+#undef GAIN
+#undef PARAM
+};
+
+/*
+ * Finds the parameter 'name', with an optional segment number for the
+ * gains. Returns 0 on success.
+ */
+static int param_by_name(const char* name, struct sweep* s)
+{
+  size_t len;
+  char* end;
+  unsigned i;
+
+  for (i = 0; i < sizeof(param_names) / sizeof(param_names[0]); i++) {
+    len = strlen(param_names[i].name);
+    if (strncmp(param_names[i].name, name, len) != 0) {
+      continue;
+    }
+    s->param = &param_names[i];
+    s->segment = -1;
+    if (name[len] == '\0') {
+      return 0;
+    }
+    if (param_names[i].count > 1) {
+      s->segment = strtol(name + len, &end, 10);
+      if (*end == '\0' && s->segment >= 0 &&
+          s->segment < param_names[i].count) {
+        return 0;
+      }
+    }
+  }
+  return -1;
+}
+
+static void set_param(const struct sweep* s)
+{
+  INT8U* p = (INT8U*) &params + s->param->offset;
+  int i;
+
+  for (i = 0; i < s->param->count; i++, p += sizeof(struct control_gains)) {
+    if (s->segment >= 0 && s->segment != i) {
+      continue;
+    }
+    switch (s->param->type) {
+    case PARAM_U8:  *p = (INT8U) s->value; break;
+    case PARAM_S8:  *(INT8S*) p = (INT8S) s->value; break;
+    case PARAM_U16: *(INT16U*) p = (INT16U) s->value; break;
+    }
+  }
+}
+
+/*
+ * Parses one line of an input script into events. Returns 0 on success.
+ */
+static int parse_line(char* line)
+{
+  char* tok;
+  char* value;
+  long time;
+  unsigned i;
+
+  tok = strtok(line, " \t\r\n");
+  if (tok == NULL || tok[0] == '#') {
+    return 0;
+  }
+  time = strtol(tok, &value, 10);
+  if (*value != '\0' || time < 0) {
+    return -1;
+  }
+  while ((tok = strtok(NULL, " \t\r\n")) != NULL) {
+    value = strchr(tok, '=');
+    if (value == NULL || n_events == MAX_EVENTS) {
+      return -1;
+    }
+    *value++ = '\0';
+    for (i = 0; i < INPUTS && strcmp(input_names[i], tok) != 0; i++)
+      ;
+    if (i == INPUTS) {
+      return -1;
+    }
+    events[n_events].time = time;
+    events[n_events].input = i;
+    if (strcmp(value, "on") == 0) {
+      events[n_events].value = on;
+    } else if (strcmp(value, "off") == 0) {
+      events[n_events].value = off;
+    } else {
+      return -1;
+    }
+    if (n_events > 0 && time < events[n_events-1].time) {
+      return -1;           // events must be in order
+    }
+    n_events++;
+  }
+  return 0;
+}
+
+static void load_script(const char* path)
+{
+  char line[256];
+  FILE* f;
+  int n = 0;
+  unsigned i;
+
+  if (path == NULL) {
+    for (i = 0; i < sizeof(default_script) / sizeof(default_script[0]); i++) {
+      strcpy(line, default_script[i]);
+      parse_line(line);
+    }
+    return;
+  }
+  f = fopen(path, "r");
+  if (f == NULL) {
+    perror(path);
+    exit(1);
+  }
+  while (fgets(line, sizeof(line), f) != NULL) {
+    n++;
+    if (parse_line(line) != 0) {
+      fprintf(stderr, "%s:%d: invalid event\n", path, n);
+      exit(1);
+    }
+  }
+  fclose(f);
+}
+
+/*
+ * Runs the script for 'duration' ms and fills 'r'. With 'trace' set,
+ * prints every step.
+ */
+static long simulate(long duration, int period, int band, int trace,
+                     struct result* r)
+{
+  struct vehicle v;
+  struct control ctrl;
+  struct actuators act = {0, off, off};
+  enum active in[INPUTS] = {off, off, off, off, off};
+  struct buttons btn;
+  struct switches sw;
+  long t;
+  long last_out = 0;        // end of the last step out of the band
+  long last_active = 0;     // end of the last step of the activation
+  long steps = 0;
+  long active_steps = 0;
+  long error_sum = 0;
+  int next = 0;
+  int active = 0;
+  int d;
+
+  vehicle_init(&v);
+  control_init(&ctrl, &params, period);
+  memset(r, 0, sizeof(*r));
+  r->settle = -1;
+
+  for (t = 0; t < duration; t += period) {
+    while (next < n_events && events[next].time <= t) {
+      in[events[next].input] = events[next].value;
+      next++;
+    }
+    vehicle_step(&v, &act, period);
+    sw.engine = in[0];
+    sw.top_gear = in[1];
+    btn.cruise = in[2];
+    btn.gas = in[3];
+    btn.brake = in[4];
+    control_step(&ctrl, v.position, v.velocity, &btn, &sw, &act);
+    steps++;
+
+    if (ctrl.cruise_activated == on && !r->activated) {
+      r->activated = 1;
+      r->time_on = t;
+      r->target = ctrl.target_velocity;
+      active = 1;
+    }
+    if (active && ctrl.cruise_activated == on) {
+      d = v.velocity - r->target;
+      if (d > r->overshoot) {
+        r->overshoot = d;
+      }
+      if (d > band || d < -band) {
+        last_out = t + period;
+      }
+      if (d < 0) {
+        d = -d;
+      }
+      if (d > r->max_error) {
+        r->max_error = d;
+      }
+      error_sum += d;
+      active_steps++;
+      last_active = t + period;
+    } else if (active) {
+      active = 0;          // only the first activation is measured
+    }
+    if (trace) {
+      printf("%ld,%u,%d,%d,%u,%d\n", t + period, v.position, v.velocity,
+             v.acceleration, act.throttle, ctrl.cruise_activated == on);
+    }
+  }
+  if (r->activated && last_out < last_active) {
+    r->settle = last_out > r->time_on ? last_out - r->time_on : 0;
+  }
+  if (active_steps > 0) {
+    r->mean_error = (double) error_sum / active_steps;
+  }
+  return steps;
+}
+
+static void usage(void)
+{
+  fprintf(stderr, "usage: cruise_sim [-s script] [-d ms] "
+          "[-T ms|first:last[:step]] [-r runs] [-b m/s] [-t] "
+          "[-p name=value|name=first:last[:step]] ...\n");
+  exit(2);
+}
+
+/*
+ * Parses "first[:last[:step]]" into 's'. Returns 0 on success.
+ */
+static int parse_range(const char* value, struct sweep* s)
+{
+  char* end;
+
+  s->first = strtol(value, &end, 10);
+  s->last = s->first;
+  s->step = 1;
+  if (*end == ':') {
+    s->last = strtol(end + 1, &end, 10);
+  }
+  if (*end == ':') {
+    s->step = strtol(end + 1, &end, 10);
+  }
+  s->value = s->first;
+  return (*end != '\0' || s->step <= 0 || s->last < s->first) ? -1 : 0;
+}
+
+static void add_sweep(char* arg)
+{
+  static const int min[] = {0, -128, 0};
+  static const int max[] = {255, 127, 65535};
+  char* value = strchr(arg, '=');
+  struct sweep* s;
+
+  if (value == NULL || n_sweeps == MAX_SWEEPS) {
+    usage();
+  }
+  *value++ = '\0';
+  s = &sweeps[n_sweeps];
+  s->name = arg;
+  if (param_by_name(arg, s) != 0) {
+    fprintf(stderr, "cruise_sim: unknown parameter %s\n", arg);
+    exit(2);
+  }
+  if (parse_range(value, s) != 0 || s->first < min[s->param->type] ||
+      s->last > max[s->param->type]) {
+    usage();
+  }
+  n_sweeps++;
+}
+
+int main(int argc, char** argv)
+{
+  const char* script = NULL;
+  long duration = 120000;
+  struct sweep period = {NULL, -1, "period", 300, 300, 1, 300};
+  int runs = 1;
+  int band = DEFAULT_BAND;
+  int trace = 0;
+  struct result r;
+  struct timespec t0, t1;
+  long long steps = 0;
+  double seconds;
+  int done;
+  int opt;
+  int i;
+  int j;
+
+  params = control_default_params;
+  while ((opt = getopt(argc, argv, "s:d:T:r:b:tp:")) != -1) {
+    switch (opt) {
+    case 's': script = optarg; break;
+    case 'd': duration = atol(optarg); break;
+    case 'T': if (parse_range(optarg, &period) != 0) usage(); break;
+    case 'r': runs = atoi(optarg); break;
+    case 'b': band = atoi(optarg); break;
+    case 't': trace = 1; break;
+    case 'p': add_sweep(optarg); break;
+    default: usage();
+    }
+  }
+  if (optind != argc || period.first <= 0 || runs <= 0 || duration <= 0) {
+    usage();
+  }
+  load_script(script);
+  for (i = 0; i < n_sweeps; i++) {
+    set_param(&sweeps[i]);
+  }
+
+  if (trace) {
+    printf("time_ms,position,velocity,acceleration,throttle,cruise\n");
+  } else {
+    printf("%s ", period.name);
+    for (i = 0; i < n_sweeps; i++) {
+      printf("%s ", sweeps[i].name);
+    }
+    printf("%8s %6s %9s %9s %9s %9s\n", "on_ms", "target", "overshoot",
+           "settle_ms", "mean_err", "max_err");
+  }
+
+  clock_gettime(CLOCK_MONOTONIC, &t0);
+  do {
+    for (j = 0; j < runs; j++) {
+      steps += simulate(duration, period.value, band, trace && j == 0, &r);
+    }
+    if (!trace) {
+      printf("%*d ", (int) strlen(period.name), period.value);
+      for (i = 0; i < n_sweeps; i++) {
+        printf("%*d ", (int) strlen(sweeps[i].name), sweeps[i].value);
+      }
+      if (r.activated) {
+        printf("%8ld %6d %9d ", r.time_on, r.target, r.overshoot);
+        if (r.settle >= 0) {
+          printf("%9ld ", r.settle);
+        } else {
+          printf("%9s ", "-");
+        }
+        printf("%9.2f %9d\n", r.mean_error, r.max_error);
+      } else {
+        printf("%8s %6s %9s %9s %9s %9s\n", "-", "-", "-", "-", "-", "-");
+      }
+    }
+    trace = 0;             // trace the first combination only
+
+    // Next combination of the swept parameters, then of the period
+    done = 1;
+    for (i = n_sweeps - 1; i >= 0 && done; i--) {
+      if (sweeps[i].value + sweeps[i].step <= sweeps[i].last) {
+        sweeps[i].value += sweeps[i].step;
+        done = 0;
+      } else {
+        sweeps[i].value = sweeps[i].first;
+      }
+      set_param(&sweeps[i]);
+    }
+    if (done && period.value + period.step <= period.last) {
+      period.value += period.step;
+      done = 0;
+    }
+  } while (!done);
+  clock_gettime(CLOCK_MONOTONIC, &t1);
+
+  seconds = (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) / 1e9;
+  fprintf(stderr, "%lld steps in %.3f s, %.0f steps/s\n", steps, seconds,
+          seconds > 0 ? steps / seconds : 0.0);
+  return 0;
+}
@@ -0,0 +1,201 @@
+/* Bit-exact check of the integer vehicle model
+ *
+ * Description:
+ *
+ *   Compares vehicle_step() (app/Lab2-4.5_Watchdog/src/vehicle.c) with the
+ *   floating point reference vehicle_step_ref() (vehicle_ref.c) and the
+ *   reciprocal division of fixed.h with the '/' operator:
+ *
+ *     div    FIX_DIV_CONST() by reciprocal for a set of divisors, for every
+ *            dividend in [-2^24, 2^24] and random ones up to |2^31 - 1|
+ *     step   one step from every position, velocity in [-300, 300],
+ *            throttle, pedal and period in a grid around the track segments
+ *     sim    both models in lockstep under the control law with random
+ *            inputs, from the same state every step
+ *
+ *   Prints the first mismatch and exits with 1, or reports the number of
+ *   cases and exits with 0.
+ *
+ *   Usage: vehicle_check [-n steps] [-S seed]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "cruise.h"
+#include "fixed.h"
+#include "vehicle_ref.h"
+
+static const int divisors[] = {
+  2, 3, 7, 10, 60, 100, 641, 1000, 1024, 4095, 50000, 65535, 65536
+};
+
+#define DIVISORS (sizeof(divisors) / sizeof(divisors[0]))
+
+static unsigned long long cases;
+
+static int check_div(unsigned seed)
+{
+  unsigned i;
+  INT32S x;
+  INT32S q;
+  int n;
+  int d;
+
+  srand(seed);
+  for (i = 0; i < DIVISORS; i++) {
+    d = divisors[i];
+    for (x = -(1 << 24); x <= (1 << 24); x++) {
+      q = fix_div_magic(x, FIX_DIV_MAGIC(d), FIX_DIV_SHIFT(d));
+      if (q != x / d) {
+        printf("div: %d / %d = %d, expected %d\n", x, d, q, x / d);
+        return 1;
+      }
+    }
+    for (n = 0; n < 1000000; n++) {
+      x = (INT32S) (((INT32U) rand() << 16) ^ (INT32U) rand());
+      if (x == FIX_MIN) {
+        continue;
+      }
+      q = fix_div_magic(x, FIX_DIV_MAGIC(d), FIX_DIV_SHIFT(d));
+      if (q != x / d) {
+        printf("div: %d / %d = %d, expected %d\n", x, d, q, x / d);
+        return 1;
+      }
+    }
+    cases += (2 << 24) + 1 + n;
+  }
+  return 0;
+}
+
+static int compare(const struct vehicle* v, const struct actuators* act,
+                   int period)
+{
+  struct vehicle a = *v;
+  struct vehicle b = *v;
+
+  vehicle_step(&a, act, period);
+  vehicle_step_ref(&b, act, period);
+  cases++;
+  if (a.position != b.position || a.velocity != b.velocity ||
+      a.acceleration != b.acceleration) {
+    printf("step: position %u velocity %d throttle %u engine %d brake %d "
+           "period %d: (%u, %d, %d), expected (%u, %d, %d)\n",
+           v->position, v->velocity, act->throttle, act->engine == on,
+           act->brake == on, period, a.position, a.velocity, a.acceleration,
+           b.position, b.velocity, b.acceleration);
+    return 1;
+  }
+  return 0;
+}
+
+static int check_step(void)
+{
+  static const INT16U boundaries[] = {
+    0, 399, 400, 799, 800, 1199, 1200, 1599, 1600, 1999, 2000, 2399, 2400
+  };
+  static const INT8U throttles[] = {0, 40, 80};
+  struct vehicle v;
+  struct actuators act;
+  int period;
+  int pedals;
+  int t;
+  unsigned p;
+
+  v.acceleration = 0;
+  for (pedals = 0; pedals < 4; pedals++) {
+    act.engine = (pedals & 1) ? on : off;
+    act.brake = (pedals & 2) ? on : off;
+    for (v.position = 0; v.position <= TRACK_LENGTH; v.position++) {
+      for (v.velocity = -300; v.velocity <= 300; v.velocity++) {
+        for (t = 0; t <= 90; t += 5) {
+          act.throttle = t;
+          if (compare(&v, &act, 300)) {
+            return 1;
+          }
+        }
+      }
+    }
+    for (period = 1; period <= 1000; period++) {
+      for (p = 0; p < sizeof(boundaries) / sizeof(boundaries[0]); p++) {
+        v.position = boundaries[p];
+        for (v.velocity = -300; v.velocity <= 300; v.velocity++) {
+          for (t = 0; t < 3; t++) {
+            act.throttle = throttles[t];
+            if (compare(&v, &act, period)) {
+              return 1;
+            }
+          }
+        }
+      }
+    }
+  }
+  return 0;
+}
+
+static enum active random_active(void)
+{
+  return (rand() & 1) ? on : off;
+}
+
+static int check_sim(long steps, unsigned seed)
+{
+  struct vehicle v;
+  struct control ctrl;
+  struct actuators act = {0, off, off};
+  struct buttons btn = {off, off, off};
+  struct switches sw = {on, on};
+  long n;
+
+  srand(seed);
+  vehicle_init(&v);
+  control_init(&ctrl, &control_default_params, 300);
+  for (n = 0; n < steps; n++) {
+    // Change one input now and then, so that the car gets up to speed
+    switch (rand() % 64) {
+    case 0: sw.engine = random_active(); break;
+    case 1: sw.top_gear = random_active(); break;
+    case 2: btn.cruise = random_active(); break;
+    case 3: btn.gas = random_active(); break;
+    case 4: btn.brake = random_active(); break;
+    }
+    if (compare(&v, &act, 300)) {
+      printf("sim: after %ld steps\n", n);
+      return 1;
+    }
+    vehicle_step(&v, &act, 300);
+    control_step(&ctrl, v.position, v.velocity, &btn, &sw, &act);
+  }
+  return 0;
+}
+
+int main(int argc, char** argv)
+{
+  long steps = 10000000;
+  unsigned seed = 1;
+  int opt;
+
+  while ((opt = getopt(argc, argv, "n:S:")) != -1) {
+    switch (opt) {
+    case 'n': steps = atol(optarg); break;
+    case 'S': seed = strtoul(optarg, NULL, 0); break;
+    default:
+      fprintf(stderr, "usage: vehicle_check [-n steps] [-S seed]\n");
+      return 2;
+    }
+  }
+  if (check_div(seed)) {
+    return 1;
+  }
+  printf("div:  %llu cases ok\n", cases);
+  cases = 0;
+  if (check_step()) {
+    return 1;
+  }
+  printf("step: %llu cases ok\n", cases);
+  cases = 0;
+  if (check_sim(steps, seed)) {
+    return 1;
+  }
+  printf("sim:  %llu steps ok\n", cases);
+  return 0;
+}
@@ -0,0 +1,53 @@
+/* Floating point reference of the vehicle model
+ *
+ * Description:
+ *
+ *   vehicle_step() as it was before the vehicle model was moved onto
+ *   integer arithmetic (app/Lab2-4.5_Watchdog/src/fixed.h), with the new
+ *   velocity computed in double precision.  vehicle_check.c and
+ *   bench/vehicle_bench.c compare the two.
+ */
+#include "cruise.h"
+
+static const unsigned int wind_factor = 1;
+static const unsigned int brake_factor = 4;
+static const unsigned int gravity_factor = 2;
+
+void vehicle_step_ref(struct vehicle* v, const struct actuators* act,
+                      int period_ms)
+{
+  INT8U throttle = act->throttle;
+  INT16U position = v->position;
+  INT16S velocity = v->velocity;
+  INT16S acceleration;
+
+  if (throttle > 80) throttle = 80;
+
+  if (act->brake == off)
+  {
+    acceleration = - wind_factor*velocity;
+    if (act->engine == on) {
+      acceleration += throttle;
+    }
+
+    if (400 <= position && position < 800)
+      acceleration -= gravity_factor;
+    else if (800 <= position && position < 1200)
+      acceleration -= 2*gravity_factor;
+    else if (1600 <= position && position < 2000)
+      acceleration += 2*gravity_factor;
+    else if (2000 <= position)
+      acceleration += gravity_factor;
+  }
+  else
+    acceleration = - brake_factor*velocity;
+
+  position = position + velocity * period_ms / 1000;
+  velocity = velocity  + acceleration * period_ms / 1000.0;
+  if(position > TRACK_LENGTH)
+    position = 0;
+
+  v->position = position;
+  v->velocity = velocity;
+  v->acceleration = acceleration;
+}
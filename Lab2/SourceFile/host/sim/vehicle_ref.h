@@ -0,0 +1,10 @@
+/* Floating point reference of the vehicle model, see vehicle_ref.c */
+#ifndef __VEHICLE_REF_H__
+#define __VEHICLE_REF_H__
+
+#include "cruise.h"
+
+void vehicle_step_ref(struct vehicle* v, const struct actuators* act,
+                      int period_ms);
+
+#endif /* __VEHICLE_REF_H__ */
@@ -0,0 +1,418 @@
+/* Placement of hot kernel data and task stacks in onchip_memory
+ *
+ * Description:
+ *
+ *   Reads the output of the Watchdog application, picks out the last
+ *   report of the stack usage and writes a linker script that moves the
+ *   kernel tables and the busiest task stacks from the SRAM, where the BSP
+ *   puts all data, to the single cycle onchip_memory.  Any other output is
+ *   skipped, so the console log of the board can be fed in as it is.  A
+ *   report is a block of lines
+ *
+ *     @place <context switches> <ticks>
+ *     @data <name> <bytes>                           one per kernel table
+ *     @stack <name> <size macro> <bytes> <used> <switches> <cycles>
+ *     @end
+ *
+ *   with one @stack line per task: the bytes of its stack and the bytes
+ *   used that a full scan of the stack found (OSTaskStkChk()), and the
+ *   switches into the task and the cycles it ran from its profile.  The size macro is the one the
+ *   application sizes the stack with, or "-" for the stacks of the kernel,
+ *   whose size the BSP sets.
+ *
+ *   The kernel tables come first: every context switch and every tick goes
+ *   through OSTCBTbl[], OSTCBPrioTbl[] and OSRdyTbl[], and every post and
+ *   pend through OSEventTbl[].  Tables of -G bytes or less are small data,
+ *   which is addressed relative to gp and has to stay in the SRAM with it.
+ *   The rest of onchip_memory goes to the stacks that make the most
+ *   accesses, which are estimated from the profile: every switch into a
+ *   task restores its context and later saves it (-c accesses, 30 by
+ *   default: the 11 words of OSCtxSw in os_cpu_a.S or the 19 of the
+ *   exception entry, each saved and restored), and while it runs the task
+ *   accesses its stack about once every -r cycles.  The Nios II/e core of
+ *   the board has no data cache, so every one of them goes to memory.  The
+ *   stacks of the application are right-sized to the bytes used plus a
+ *   margin (-m).  The bytes used must come from a full scan of the stack,
+ *   as the application prints them; the margin only covers interrupt
+ *   frames deeper than those the run left on the stack, which the tasks'
+ *   stacks take as there is no separate exception stack under MicroC/OS-II.
+ *   It is no allowance for bytes used that were not counted.
+ *   The stacks are picked to make the most accesses within the space left
+ *   (a 0/1 knapsack), not the densest first.
+ *
+ *   The script puts the objects in a NOLOAD section at the base of
+ *   onchip_memory, inserted before .bss so that its patterns match first.
+ *   It is given to the linker before the BSP's linker.x, which it does not
+ *   change, and requires the BSP and the application to be compiled with
+ *   -fno-common -fdata-sections, so that every object has a section of its
+ *   own.  The partition of the BSP in onchip_memory (.onchip_memory) must
+ *   be empty.  Nothing in the section is cleared at reset: OSInit() clears
+ *   the kernel tables and the tasks must be created with
+ *   OS_TASK_OPT_STK_CLR.  With -k, the settings for Makefile.conf of the
+ *   application that do all this are written as well.
+ *
+ *   Usage: memplace [-c accesses] [-r cycles] [-m bytes] [-s bytes]
+ *                   [-G bytes] [-k file] [-o file] [file]
+ *
+ *     -c   stack accesses per switch into a task
+ *     -r   cycles per stack access while a task runs
+ *     -m   margin of a right-sized stack above the bytes used, for the
+ *          interrupt frames
+ *     -s   bytes of onchip_memory to fill
+ *     -G   size limit of small data (-G of the compiler)
+ *     -k   write the settings for Makefile.conf to this file, needs -o
+ *     -o   write the linker script to this file instead of stdout
+ */
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "system.h"
+
+#define MAX_LINE 256
+#define MAX_NAME 64
+#define MAX_OBJECTS 32
+#define STACK_ALIGN 8            // alignment of a right-sized stack
+#define STK_ENTRY 4              // bytes of an OS_STK of the Nios II port
+
+struct object {
+  char name[MAX_NAME];
+  char macro[MAX_NAME];          // size macro of a stack, "-" if fixed
+  int order;                     // in the report
+  int stack;
+  unsigned long bytes;           // as built
+  unsigned long used;            // bytes of the stack used
+  unsigned long switches;
+  unsigned long cycles;
+  unsigned long size;            // once placed
+  double accesses;               // estimated, stacks only
+  const char* why;               // why it is not placed, NULL if placed
+};
+
+// Last complete report, and the one being read
+static struct object objects[MAX_OBJECTS];
+static int n_objects;
+static unsigned long ctxsw;
+static unsigned long ticks;
+
+static struct object reading[MAX_OBJECTS];
+static int n_reading;
+static unsigned long reading_ctxsw;
+static unsigned long reading_ticks;
+
+static unsigned long per_switch = 30;
+static unsigned long per_access = 24;
+static unsigned long margin = 256;
+static unsigned long span = ONCHIP_MEMORY_SPAN;
+static unsigned long small = 8;
+
+static void usage(void)
+{
+  fprintf(stderr, "usage: memplace [-c accesses] [-r cycles] [-m bytes] "
+          "[-s bytes] [-G bytes] [-k file] [-o file] [file]\n");
+  exit(2);
+}
+
+static unsigned long number(const char* arg)
+{
+  char* end;
+  unsigned long n = strtoul(arg, &end, 0);
+
+  if (*arg == '\0' || *end != '\0') {
+    usage();
+  }
+  return n;
+}
+
+static unsigned long align(unsigned long n, unsigned long a)
+{
+  return (n + a - 1) / a * a;
+}
+
+static struct object* add(void)
+{
+  struct object* o;
+
+  if (n_reading == MAX_OBJECTS) {
+    fprintf(stderr, "memplace: more than %d objects\n", MAX_OBJECTS);
+    exit(1);
+  }
+  o = &reading[n_reading];
+  memset(o, 0, sizeof(*o));
+  o->order = n_reading++;
+  return o;
+}
+
+/*
+ * Places the kernel tables in the order of the report, and returns the
+ * bytes left.
+ */
+static unsigned long place_data(unsigned long avail)
+{
+  struct object* o;
+  int i;
+
+  for (i = 0; i < n_objects; i++) {
+    o = &objects[i];
+    if (o->stack) {
+      continue;
+    }
+    o->size = o->bytes;
+    if (o->bytes <= small) {
+      o->why = "small data";
+    } else if (align(o->bytes, STK_ENTRY) > avail) {
+      o->why = "does not fit";
+    } else {
+      avail -= align(o->bytes, STK_ENTRY);
+    }
+  }
+  return avail;
+}
+
+/*
+ * Right-sizes the stacks and picks those with the most accesses that fit
+ * in 'avail' bytes.
+ */
+static void place_stacks(unsigned long avail)
+{
+  unsigned long units = avail / STACK_ALIGN;
+  unsigned long w;
+  unsigned long u;
+  double* best;
+  char* take;
+  struct object* o;
+  int i;
+
+  best = calloc(units + 1, sizeof(*best));
+  take = calloc((size_t) n_objects * (units + 1), 1);
+  if (best == NULL || take == NULL) {
+    fprintf(stderr, "memplace: out of memory\n");
+    exit(1);
+  }
+  for (i = 0; i < n_objects; i++) {
+    o = &objects[i];
+    if (!o->stack) {
+      continue;
+    }
+    o->size = o->bytes;
+    if (strcmp(o->macro, "-") != 0 &&
+        align(o->used + margin, STACK_ALIGN) < o->bytes) {
+      o->size = align(o->used + margin, STACK_ALIGN);
+    }
+    o->accesses = (double) o->switches * per_switch +
+                  (double) o->cycles / per_access;
+    u = align(o->size, STACK_ALIGN) / STACK_ALIGN;
+    o->why = (u > units) ? "does not fit" : "not among the busiest";
+    for (w = units; w >= u && u > 0; w--) {
+      if (best[w - u] + o->accesses > best[w]) {
+        best[w] = best[w - u] + o->accesses;
+        take[i * (units + 1) + w] = 1;
+      }
+    }
+  }
+  w = units;
+  for (i = n_objects - 1; i >= 0; i--) {
+    o = &objects[i];
+    if (o->stack && take[i * (units + 1) + w]) {
+      o->why = NULL;
+      w -= align(o->size, STACK_ALIGN) / STACK_ALIGN;
+    }
+  }
+  free(best);
+  free(take);
+}
+
+static int by_accesses(const void* a, const void* b)
+{
+  const struct object* x = a;
+  const struct object* y = b;
+
+  if (x->stack != y->stack) {
+    return x->stack - y->stack;
+  }
+  if (x->accesses != y->accesses) {
+    return (x->accesses < y->accesses) - (x->accesses > y->accesses);
+  }
+  return x->order - y->order;
+}
+
+static void write_script(FILE* out, const char* input)
+{
+  unsigned long total = 0;
+  struct object* o;
+  int i;
+
+  fprintf(out, "/* Placement of hot data in onchip_memory, written by memplace "
+          "from %s\n *\n", input);
+  fprintf(out, " *   %lu context switches and %lu ticks, %lu bytes of "
+          "onchip_memory\n *\n", ctxsw, ticks, span);
+  fprintf(out, " *   %-20s %6s %6s %6s %12s\n", "object", "bytes", "used",
+          "placed", "accesses");
+  for (i = 0; i < n_objects; i++) {
+    o = &objects[i];
+    if (o->why == NULL) {
+      total += align(o->size, o->stack ? STACK_ALIGN : STK_ENTRY);
+    }
+    if (o->stack) {
+      fprintf(out, " *   %-20s %6lu %6lu %6lu %12.0f", o->name, o->bytes,
+              o->used, o->why ? 0 : o->size, o->accesses);
+    } else {
+      fprintf(out, " *   %-20s %6lu %6s %6lu %12s", o->name, o->bytes, "-",
+              o->why ? 0 : o->size, "-");
+    }
+    fprintf(out, "%s%s\n", o->why ? "  " : "", o->why ? o->why : "");
+  }
+  fprintf(out, " *\n *   %lu bytes placed.  Compile the BSP and the "
+          "application with\n *   -fno-common -fdata-sections and give "
+          "this script to the linker before\n *   linker.x.\n */\n", total);
+
+  fprintf(out, "SECTIONS\n{\n");
+  fprintf(out, "    .onchip_hot __alt_mem_onchip_memory (NOLOAD) :\n    {\n");
+  fprintf(out, "        PROVIDE (_alt_onchip_hot_start = ABSOLUTE(.));\n");
+  for (i = 0; i < n_objects; i++) {
+    o = &objects[i];
+    if (o->why == NULL) {
+      fprintf(out, "        *(.bss.%s)\n", o->name);
+    }
+  }
+  fprintf(out, "        . = ALIGN(4);\n");
+  fprintf(out, "        PROVIDE (_alt_onchip_hot_end = ABSOLUTE(.));\n");
+  fprintf(out, "    }\n}\nINSERT BEFORE .bss;\n\n");
+  fprintf(out, "ASSERT (SIZEOF (.onchip_hot) <= %lu, "
+          "\"memplace: onchip_memory is full\")\n", span);
+}
+
+static void write_conf(FILE* conf, const char* script)
+{
+  char path[PATH_MAX];
+  struct object* o;
+  int i;
+
+  if (realpath(script, path) == NULL) {
+    perror(script);
+    exit(1);
+  }
+  fprintf(conf, "# Placement of hot data in onchip_memory, written by "
+          "memplace, for Makefile.conf\n");
+  fprintf(conf, "MEMPLACE_CFLAGS := -fno-common -fdata-sections\n");
+  fprintf(conf, "MEMPLACE_STACKS :=");
+  for (i = 0; i < n_objects; i++) {
+    o = &objects[i];
+    if (o->why == NULL && o->stack && strcmp(o->macro, "-") != 0) {
+      fprintf(conf, " -D%s=%lu", o->macro, o->size / STK_ENTRY);
+    }
+  }
+  fprintf(conf, "\nNIOS2_BSP_COMMANDS += "
+          "--set hal.make.bsp_cflags_user_flags \"$(MEMPLACE_CFLAGS)\"\n");
+  fprintf(conf, "MAKEFILE_COMMANDS += "
+          "--set APP_CFLAGS_USER_FLAGS \"$(MEMPLACE_CFLAGS)\" \\\n"
+          "    --set APP_CFLAGS_DEFINED_SYMBOLS \"$(MEMPLACE_STACKS)\" \\\n"
+          "    --set APP_LDFLAGS_USER \"-T'%s'\"\n", path);
+}
+
+int main(int argc, char** argv)
+{
+  char line[MAX_LINE];
+  const char* input = "stdin";
+  const char* script = NULL;
+  const char* conf_name = NULL;
+  struct object* o;
+  FILE* in = stdin;
+  FILE* out = stdout;
+  FILE* conf;
+  unsigned long a;
+  unsigned long b;
+  int in_report = 0;
+  int placed = 0;
+  int opt;
+  int i;
+
+  while ((opt = getopt(argc, argv, "c:r:m:s:G:k:o:")) != -1) {
+    switch (opt) {
+    case 'c': per_switch = number(optarg); break;
+    case 'r': per_access = number(optarg); break;
+    case 'm': margin = number(optarg); break;
+    case 's': span = number(optarg); break;
+    case 'G': small = number(optarg); break;
+    case 'k': conf_name = optarg; break;
+    case 'o': script = optarg; break;
+    default: usage();
+    }
+  }
+  if (optind + 1 < argc || per_access == 0 || (conf_name && !script)) {
+    usage();
+  }
+  if (optind < argc) {
+    input = argv[optind];
+    in = fopen(input, "r");
+    if (in == NULL) {
+      perror(input);
+      return 1;
+    }
+  }
+
+  while (fgets(line, sizeof(line), in) != NULL) {
+    if (sscanf(line, "@place %lu %lu", &a, &b) == 2) {
+      n_reading = 0;
+      reading_ctxsw = a;
+      reading_ticks = b;
+      in_report = 1;
+    } else if (!in_report) {
+      continue;
+    } else if (strncmp(line, "@data ", 6) == 0) {
+      o = add();
+      if (sscanf(line, "@data %63s %lu", o->name, &o->bytes) != 2) {
+        n_reading--;
+      }
+    } else if (strncmp(line, "@stack ", 7) == 0) {
+      o = add();
+      o->stack = 1;
+      if (sscanf(line, "@stack %63s %63s %lu %lu %lu %lu", o->name, o->macro,
+                 &o->bytes, &o->used, &o->switches, &o->cycles) != 6) {
+        n_reading--;
+      }
+    } else if (strncmp(line, "@end", 4) == 0) {
+      memcpy(objects, reading, sizeof(objects));
+      n_objects = n_reading;
+      ctxsw = reading_ctxsw;
+      ticks = reading_ticks;
+      in_report = 0;
+    }
+  }
+  if (n_objects == 0) {
+    fprintf(stderr, "memplace: no report of the stack usage in %s\n", input);
+    return 1;
+  }
+
+  place_stacks(place_data(span));
+  qsort(objects, n_objects, sizeof(objects[0]), by_accesses);
+
+  if (script != NULL) {
+    out = fopen(script, "w");
+    if (out == NULL) {
+      perror(script);
+      return 1;
+    }
+  }
+  write_script(out, input);
+  if (ferror(out) || fclose(out) != 0) {
+    return 1;
+  }
+  if (conf_name != NULL) {
+    conf = fopen(conf_name, "w");
+    if (conf == NULL) {
+      perror(conf_name);
+      return 1;
+    }
+    write_conf(conf, script);
+    if (ferror(conf) || fclose(conf) != 0) {
+      return 1;
+    }
+  }
+  for (i = 0; i < n_objects; i++) {
+    placed += objects[i].why == NULL;
+  }
+  fprintf(stderr, "%d of %d objects placed\n", placed, n_objects);
+  return 0;
+}
@@ -0,0 +1,294 @@
+/* Converter of kernel trace dumps to the Chrome trace format
+ *
+ * Description:
+ *
+ *   Reads the output of the Watchdog application, picks out the dumps of
+ *   the kernel trace (OS_TRACE_EN, see os_trace.c) and writes them as one
+ *   Chrome trace, which chrome://tracing and ui.perfetto.dev display as a
+ *   timeline.  Any other output is skipped, so the console log of the board
+ *   or of the host build can be fed in as it is.  A dump is a block of
+ *   lines
+ *
+ *     @trace <cpu frequency in Hz> <records made>
+ *     @task <prio> <name>                         one per named task
+ *     @r <time in cycles, hex> <type> <prio> <arg>  one per record
+ *     @end
+ *
+ *   where type, prio and arg are the fields of OS_TRACE_REC.
+ *
+ *   Each dump becomes a process of the timeline, with one row per task and
+ *   one for the ISRs.  A task's row shows when it was running and, after a
+ *   pend that blocked it, how long it waited for the semaphore, mailbox or
+ *   notification until it was switched in again.  Posts and pends that did
+ *   not block are marked as instants.  Time starts at the first record of
+ *   each dump.
+ *
+ *   Usage: trace2json [-o file] [file]
+ *
+ *     -o   write the trace to this file instead of stdout
+ */
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "ucos_ii.h"
+
+#define MAX_LINE 256
+#define MAX_NAME 32
+#define TID_ISR 1000             // row of the ISRs, below all tasks
+#define MAX_NESTING 8
+
+struct task {
+  char name[MAX_NAME];
+  int seen;                      // has a row
+  double wait_start;             // < 0 if not blocked by a pend
+  const char* wait_what;
+  unsigned wait_arg;
+};
+
+// State of the dump being converted
+static unsigned long freq;
+static unsigned long recs;       // records made, some may have been lost
+static unsigned long n_recs;     // records in the dump
+static struct task tasks[OS_LOWEST_PRIO + 1];
+static int dump;                 // pid of the dump
+static int started;              // a record was read
+static unsigned long long cycles;
+static unsigned long last_time;
+static int cur;                  // running task, -1 if unknown
+static double run_start;
+static double isr_start[MAX_NESTING];
+static int nesting;
+
+static FILE* out;
+static int n_events;
+
+static void event(const char* fmt, ...) __attribute__((format(printf, 1, 2)));
+
+static void event(const char* fmt, ...)
+{
+  va_list ap;
+
+  fprintf(out, "%s\n  {", n_events++ > 0 ? "," : "");
+  va_start(ap, fmt);
+  vfprintf(out, fmt, ap);
+  va_end(ap);
+  fputc('}', out);
+}
+
+static void name_row(int tid, const char* name)
+{
+  event("\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"name\":\"thread_name\","
+        "\"args\":{\"name\":\"%s\"}", dump, tid, name);
+  event("\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"name\":\"thread_sort_index\","
+        "\"args\":{\"sort_index\":%d}", dump, tid, tid);
+}
+
+static void use_row(int prio)
+{
+  char name[MAX_NAME + 16];
+
+  if (tasks[prio].seen) {
+    return;
+  }
+  tasks[prio].seen = 1;
+  if (tasks[prio].name[0] != '\0' && strcmp(tasks[prio].name, "?") != 0) {
+    snprintf(name, sizeof(name), "%s (%d)", tasks[prio].name, prio);
+  } else {
+    snprintf(name, sizeof(name), "prio %d", prio);
+  }
+  name_row(prio, name);
+}
+
+static void slice(int tid, const char* name, double start, double end)
+{
+  event("\"ph\":\"X\",\"pid\":%d,\"tid\":%d,\"name\":\"%s\","
+        "\"ts\":%.3f,\"dur\":%.3f", dump, tid, name, start, end - start);
+}
+
+static void instant(int tid, const char* name, unsigned arg)
+{
+  event("\"ph\":\"i\",\"s\":\"t\",\"pid\":%d,\"tid\":%d,\"name\":\"%s %u\","
+        "\"ts\":%.3f", dump, tid, name, arg, cycles * 1e6 / freq);
+}
+
+static void dump_begin(unsigned long f, unsigned long r)
+{
+  int prio;
+
+  dump++;
+  freq = f > 0 ? f : 1;
+  recs = r;
+  n_recs = 0;
+  started = 0;
+  cycles = 0;
+  cur = -1;
+  nesting = 0;
+  for (prio = 0; prio <= OS_LOWEST_PRIO; prio++) {
+    tasks[prio].name[0] = '\0';
+    tasks[prio].seen = 0;
+    tasks[prio].wait_start = -1;
+  }
+}
+
+static void dump_end(void)
+{
+  double now = cycles * 1e6 / freq;
+
+  if (cur >= 0) {
+    slice(cur, "run", run_start, now);
+  }
+  event("\"ph\":\"M\",\"pid\":%d,\"name\":\"process_name\","
+        "\"args\":{\"name\":\"dump %d: %lu records, %lu lost\"}", dump, dump,
+        n_recs, recs > n_recs ? recs - n_recs : 0);
+  name_row(TID_ISR, "ISR");
+}
+
+static void wait(int prio, const char* what, unsigned arg, double now)
+{
+  tasks[prio].wait_start = now;
+  tasks[prio].wait_what = what;
+  tasks[prio].wait_arg = arg;
+}
+
+static void record(unsigned long time, unsigned type, unsigned prio,
+                   unsigned arg)
+{
+  char name[MAX_NAME];
+  double now;
+  int tid;
+
+  if (prio > OS_LOWEST_PRIO) {
+    return;
+  }
+  if (started) {
+    cycles += (unsigned long) ((time - last_time) & 0xFFFFFFFFUL);
+  }
+  last_time = time;
+  now = cycles * 1e6 / freq;
+  if (!started) {
+    started = 1;
+    cur = prio;                  // running since before the first record
+    run_start = now;
+    use_row(prio);
+  }
+  n_recs++;
+  tid = nesting > 0 ? TID_ISR : (int) prio;
+  switch (type) {
+  case OS_TRACE_SW:
+    if (arg > OS_LOWEST_PRIO) {
+      break;
+    }
+    if (cur >= 0 && cur != (int) arg) {
+      slice(cur, "run", run_start, now);
+    }
+    use_row(arg);
+    if (tasks[arg].wait_start >= 0) {
+      snprintf(name, sizeof(name), "wait %s %u", tasks[arg].wait_what,
+               tasks[arg].wait_arg);
+      slice(arg, name, tasks[arg].wait_start, now);
+      tasks[arg].wait_start = -1;
+    }
+    cur = arg;
+    run_start = now;
+    break;
+  case OS_TRACE_INT_ENTER:
+    if (nesting < MAX_NESTING) {
+      isr_start[nesting] = now;
+    }
+    nesting++;
+    break;
+  case OS_TRACE_INT_EXIT:
+    if (nesting > 0) {
+      nesting--;
+      if (nesting < MAX_NESTING) {
+        slice(TID_ISR, "ISR", isr_start[nesting], now);
+      }
+    }
+    break;
+  case OS_TRACE_SEM_POST:    instant(tid, "post sem", arg); break;
+  case OS_TRACE_SEM_PEND:    instant(tid, "pend sem", arg); break;
+  case OS_TRACE_SEM_WAIT:    wait(prio, "sem", arg, now); break;
+  case OS_TRACE_MBOX_POST:   instant(tid, "post mbox", arg); break;
+  case OS_TRACE_MBOX_PEND:   instant(tid, "pend mbox", arg); break;
+  case OS_TRACE_MBOX_WAIT:   wait(prio, "mbox", arg, now); break;
+  case OS_TRACE_NOTIFY_POST: instant(tid, "notify", arg); break;
+  case OS_TRACE_NOTIFY_WAIT: wait(prio, "notify", prio, now); break;
+  default: break;
+  }
+}
+
+static void usage(void)
+{
+  fprintf(stderr, "usage: trace2json [-o file] [file]\n");
+  exit(2);
+}
+
+int main(int argc, char** argv)
+{
+  char line[MAX_LINE];
+  char name[MAX_NAME];
+  FILE* in = stdin;
+  unsigned long time;
+  unsigned long a;
+  unsigned long b;
+  unsigned type;
+  unsigned prio;
+  unsigned arg;
+  int in_dump = 0;
+  int opt;
+
+  out = stdout;
+  while ((opt = getopt(argc, argv, "o:")) != -1) {
+    switch (opt) {
+    case 'o':
+      out = fopen(optarg, "w");
+      if (out == NULL) {
+        perror(optarg);
+        return 1;
+      }
+      break;
+    default: usage();
+    }
+  }
+  if (optind + 1 < argc) {
+    usage();
+  }
+  if (optind < argc) {
+    in = fopen(argv[optind], "r");
+    if (in == NULL) {
+      perror(argv[optind]);
+      return 1;
+    }
+  }
+
+  fprintf(out, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+  while (fgets(line, sizeof(line), in) != NULL) {
+    if (sscanf(line, "@trace %lu %lu", &a, &b) == 2) {
+      if (in_dump) {
+        dump_end();              // truncated dump
+      }
+      dump_begin(a, b);
+      in_dump = 1;
+    } else if (!in_dump) {
+      continue;
+    } else if (sscanf(line, "@task %u %31[^\n]", &prio, name) == 2) {
+      if (prio <= OS_LOWEST_PRIO) {
+        strcpy(tasks[prio].name, name);
+      }
+    } else if (sscanf(line, "@r %lx %u %u %u", &time, &type, &prio,
+                      &arg) == 4) {
+      record(time, type, prio, arg);
+    } else if (strncmp(line, "@end", 4) == 0) {
+      dump_end();
+      in_dump = 0;
+    }
+  }
+  if (in_dump) {
+    dump_end();
+  }
+  fprintf(out, "\n]}\n");
+  fprintf(stderr, "%d dumps\n", dump);
+  return ferror(out) || fclose(out) != 0;
+}